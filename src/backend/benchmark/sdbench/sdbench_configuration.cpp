@@ -32,7 +32,8 @@ void Usage() {
           "   -e --experiment_type   :  Experiment Type"
           "   -c --column_count      :  # of columns"
           "   -w --write_ratio       :  Fraction of writes"
-          "   -g --tuples_per_tg     :  # of tuples per tilegroup");
+          "   -g --tuples_per_tg     :  # of tuples per tilegroup"
+          "   -x --execution_mode    :  Execution mode (0: pull, 1: push)");
   exit(EXIT_FAILURE);
 }
 
@@ -47,6 +48,7 @@ static struct option opts[] = {
     {"column_count", optional_argument, NULL, 'c'},
     {"write_ratio", optional_argument, NULL, 'w'},
     {"tuples_per_tg", optional_argument, NULL, 'g'},
+    {"execution_mode", optional_argument, NULL, 'x'},
     {NULL, 0, NULL, 0}};
 
 void GenerateSequence(oid_t column_count) {
@@ -159,6 +161,16 @@ static void ValidateWriteRatio(const configuration &state) {
   LOG_TRACE("%s : %lf", "write_ratio", state.write_ratio);
 }
 
+static void ValidateExecutionMode(const configuration &state) {
+  if (state.execution_mode < EXECUTION_TYPE_PULL ||
+      state.execution_mode > EXECUTION_TYPE_PUSH) {
+    LOG_ERROR("Invalid execution_mode :: %d", state.execution_mode);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_TRACE("%s : %d", "execution_mode", state.execution_mode);
+}
+
 static void ValidateTuplesPerTileGroup(const configuration &state) {
   if (state.tuples_per_tilegroup <= 0) {
     LOG_ERROR("Invalid tuples_per_tilegroup :: %d", state.tuples_per_tilegroup);
@@ -190,10 +202,12 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
 
   state.adapt = false;
 
+  state.execution_mode = EXECUTION_TYPE_PULL;
+
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "aho:k:s:p:l:t:e:c:w:g:", opts, &idx);
+    int c = getopt_long(argc, argv, "aho:k:s:p:l:t:e:c:w:g:x:", opts, &idx);
 
     if (c == -1) break;
 
@@ -228,6 +242,9 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'g':
         state.tuples_per_tilegroup = atoi(optarg);
         break;
+      case 'x':
+        state.execution_mode = (ExecutionType)atoi(optarg);
+        break;
       case 'h':
         Usage();
         break;
@@ -248,6 +265,7 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
     ValidateColumnCount(state);
     ValidateWriteRatio(state);
     ValidateTuplesPerTileGroup(state);
+    ValidateExecutionMode(state);
 
     LOG_TRACE("%s : %lu", "transactions", state.transactions);
   } else {
@@ -79,6 +79,9 @@ class configuration {
   bool adapt;
 
   bool fsm;
+
+  // pull-based executors or push-based pipelines
+  ExecutionType execution_mode;
 };
 
 void Usage(FILE *out);
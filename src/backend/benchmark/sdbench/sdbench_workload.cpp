@@ -48,6 +48,7 @@
 #include "backend/executor/insert_executor.h"
 #include "backend/executor/update_executor.h"
 #include "backend/executor/nested_loop_join_executor.h"
+#include "backend/executor/pipeline_executor.h"
 
 #include "backend/expression/abstract_expression.h"
 #include "backend/expression/constant_value_expression.h"
@@ -110,8 +111,8 @@ static void WriteOutput(double duration) {
   duration *= 1000;
 
   LOG_TRACE("----------------------------------------------------------");
-  LOG_TRACE("%d %d %lf %lf %lf %d %d %d :: %lf ms",
-           state.layout_mode, state.operator_type,
+  LOG_TRACE("%d %d %d %lf %lf %lf %d %d %d :: %lf ms",
+           state.layout_mode, state.operator_type, state.execution_mode,
            state.projectivity, state.selectivity,
            state.write_ratio, state.scale_factor,
            state.column_count,
@@ -120,6 +121,7 @@ static void WriteOutput(double duration) {
 
   out << state.layout_mode << " ";
   out << state.operator_type << " ";
+  out << state.execution_mode << " ";
   out << state.selectivity << " ";
   out << state.projectivity << " ";
   out << state.column_count << " ";
@@ -138,6 +140,14 @@ static int GetLowerBound() {
   return lower_bound;
 }
 
+// Pick the executor tree or the pipelines for the plan
+static executor::AbstractExecutor *GetRootExecutor(
+    executor::AbstractExecutor *executor_tree,
+    executor::AbstractExecutor *pipeline_executor) {
+  if (state.execution_mode == EXECUTION_TYPE_PUSH) return pipeline_executor;
+  return executor_tree;
+}
+
 static void ExecuteTest(std::vector<executor::AbstractExecutor *> &executors,
                         std::vector<double> columns_accessed, double cost) {
   Timer<> timer;
@@ -240,9 +250,11 @@ void RunDirectTest() {
 
   // Create and set up seq scan executor
   auto predicate = CreatePredicate(lower_bound);
-  planner::SeqScanPlan seq_scan_node(sdbench_table.get(), predicate, column_ids);
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(sdbench_table.get(), predicate, column_ids));
 
-  executor::SeqScanExecutor seq_scan_executor(&seq_scan_node, context.get());
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
 
   /////////////////////////////////////////////////////////
   // MATERIALIZE
@@ -271,6 +283,10 @@ void RunDirectTest() {
   executor::MaterializationExecutor mat_executor(&mat_node, nullptr);
   mat_executor.AddChild(&seq_scan_executor);
 
+  // Same plan, run as a pipeline
+  mat_node.AddChild(std::move(seq_scan_node));
+  executor::PipelineExecutor pipeline_executor(&mat_node, context.get());
+
   /////////////////////////////////////////////////////////
   // INSERT
   /////////////////////////////////////////////////////////
@@ -302,7 +318,7 @@ void RunDirectTest() {
   /////////////////////////////////////////////////////////
 
   std::vector<executor::AbstractExecutor *> executors;
-  executors.push_back(&mat_executor);
+  executors.push_back(GetRootExecutor(&mat_executor, &pipeline_executor));
   executors.push_back(&insert_executor);
 
   /////////////////////////////////////////////////////////
@@ -343,9 +359,11 @@ void RunAggregateTest() {
 
   // Create and set up seq scan executor
   auto predicate = CreatePredicate(lower_bound);
-  planner::SeqScanPlan seq_scan_node(sdbench_table.get(), predicate, column_ids);
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(sdbench_table.get(), predicate, column_ids));
 
-  executor::SeqScanExecutor seq_scan_executor(&seq_scan_node, context.get());
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
 
   /////////////////////////////////////////////////////////
   // AGGREGATION
@@ -395,13 +413,16 @@ void RunAggregateTest() {
   std::shared_ptr<const catalog::Schema> output_table_schema(new catalog::Schema(columns));
 
   // OK) Create the plan node
-  planner::AggregatePlan aggregation_node(
-      std::move(proj_info), std::move(aggregate_predicate), std::move(agg_terms),
-      std::move(group_by_columns), output_table_schema, AGGREGATE_TYPE_PLAIN);
+  std::unique_ptr<planner::AggregatePlan> aggregation_node(
+      new planner::AggregatePlan(
+          std::move(proj_info), std::move(aggregate_predicate),
+          std::move(agg_terms), std::move(group_by_columns),
+          output_table_schema, AGGREGATE_TYPE_PLAIN));
 
-  executor::AggregateExecutor aggregation_executor(&aggregation_node,
+  executor::AggregateExecutor aggregation_executor(aggregation_node.get(),
                                                    context.get());
   aggregation_executor.AddChild(&seq_scan_executor);
+  aggregation_node->AddChild(std::move(seq_scan_node));
 
   /////////////////////////////////////////////////////////
   // MATERIALIZE
@@ -430,6 +451,10 @@ void RunAggregateTest() {
   executor::MaterializationExecutor mat_executor(&mat_node, nullptr);
   mat_executor.AddChild(&aggregation_executor);
 
+  // Same plan, run as pipelines
+  mat_node.AddChild(std::move(aggregation_node));
+  executor::PipelineExecutor pipeline_executor(&mat_node, context.get());
+
   /////////////////////////////////////////////////////////
   // INSERT
   /////////////////////////////////////////////////////////
@@ -461,7 +486,7 @@ void RunAggregateTest() {
   /////////////////////////////////////////////////////////
 
   std::vector<executor::AbstractExecutor *> executors;
-  executors.push_back(&mat_executor);
+  executors.push_back(GetRootExecutor(&mat_executor, &pipeline_executor));
   executors.push_back(&insert_executor);
 
   /////////////////////////////////////////////////////////
@@ -502,9 +527,11 @@ void RunArithmeticTest() {
 
   // Create and set up seq scan executor
   auto predicate = CreatePredicate(lower_bound);
-  planner::SeqScanPlan seq_scan_node(sdbench_table.get(), predicate, column_ids);
+  std::unique_ptr<planner::SeqScanPlan> seq_scan_node(
+      new planner::SeqScanPlan(sdbench_table.get(), predicate, column_ids));
 
-  executor::SeqScanExecutor seq_scan_executor(&seq_scan_node, context.get());
+  executor::SeqScanExecutor seq_scan_executor(seq_scan_node.get(),
+                                              context.get());
 
   /////////////////////////////////////////////////////////
   // PROJECTION
@@ -548,11 +575,13 @@ void RunArithmeticTest() {
       new planner::ProjectInfo(std::move(target_list),
                                std::move(direct_map_list)));
 
-  planner::ProjectionPlan node(std::move(project_info), projection_schema);
+  std::unique_ptr<planner::ProjectionPlan> node(
+      new planner::ProjectionPlan(std::move(project_info), projection_schema));
 
   // Create and set up executor
-  executor::ProjectionExecutor projection_executor(&node, nullptr);
+  executor::ProjectionExecutor projection_executor(node.get(), nullptr);
   projection_executor.AddChild(&seq_scan_executor);
+  node->AddChild(std::move(seq_scan_node));
 
   /////////////////////////////////////////////////////////
   // MATERIALIZE
@@ -577,6 +606,10 @@ void RunArithmeticTest() {
   executor::MaterializationExecutor mat_executor(&mat_node, nullptr);
   mat_executor.AddChild(&projection_executor);
 
+  // Same plan, run as a pipeline
+  mat_node.AddChild(std::move(node));
+  executor::PipelineExecutor pipeline_executor(&mat_node, context.get());
+
   /////////////////////////////////////////////////////////
   // INSERT
   /////////////////////////////////////////////////////////
@@ -607,7 +640,7 @@ void RunArithmeticTest() {
   /////////////////////////////////////////////////////////
 
   std::vector<executor::AbstractExecutor *> executors;
-  executors.push_back(&mat_executor);
+  executors.push_back(GetRootExecutor(&mat_executor, &pipeline_executor));
   executors.push_back(&insert_executor);
 
   /////////////////////////////////////////////////////////
@@ -966,6 +999,9 @@ std::vector<double> op_projectivity = {0.01, 0.1, 1.0};
 std::vector<double> op_selectivity = {0.1, 0.2, 0.3, 0.4, 0.5,
                                       0.6, 0.7, 0.8, 0.9, 1.0};
 
+std::vector<ExecutionType> execution_modes = {EXECUTION_TYPE_PULL,
+                                              EXECUTION_TYPE_PUSH};
+
 void RunOperatorExperiment() {
   state.column_count = op_column_count;
 
@@ -994,9 +1030,14 @@ void RunOperatorExperiment() {
           // Load in the table with layout
           CreateAndLoadTable(layout);
 
-          // Run operator
-          state.operator_type = OPERATOR_TYPE_ARITHMETIC;
-          RunDirectTest();
+          // Compare the executor models on the same table
+          for (auto execution_mode : execution_modes) {
+            state.execution_mode = execution_mode;
+
+            // Run operator
+            state.operator_type = OPERATOR_TYPE_ARITHMETIC;
+            RunDirectTest();
+          }
         }
       }
     }
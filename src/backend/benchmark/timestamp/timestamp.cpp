@@ -0,0 +1,73 @@
+//===----------------------------------------------------------------------===//
+//
+//                         PelotonDB
+//
+// timestamp.cpp
+//
+// Identification: benchmark/timestamp/timestamp.cpp
+//
+// Copyright (c) 2015, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#undef NDEBUG
+
+#include <iostream>
+#include <fstream>
+
+#include "backend/common/logger.h"
+#include "backend/benchmark/timestamp/timestamp_configuration.h"
+#include "backend/benchmark/timestamp/timestamp_workload.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+configuration state;
+
+std::ofstream out("outputfile.summary");
+
+static void WriteOutput(TimestampType timestamp_type, int backend_count,
+                        double stat) {
+  LOG_INFO("----------------------------------------------------------");
+  LOG_INFO("%d %d %d :: %lf",
+           state.protocol,
+           timestamp_type,
+           backend_count,
+           stat);
+
+  out << state.protocol << " ";
+  out << timestamp_type << " ";
+  out << backend_count << " ";
+  out << stat << "\n";
+  out.flush();
+}
+
+// Main Entry Point
+void RunBenchmark() {
+
+  for (auto timestamp_type : state.timestamp_types) {
+    // Double the number of backends up to the maximum
+    for (int backend_count = 1; backend_count <= state.backend_count;
+         backend_count *= 2) {
+      RunWorkload(timestamp_type, backend_count);
+
+      // Emit throughput
+      WriteOutput(timestamp_type, backend_count, state.throughput);
+    }
+  }
+
+}
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
+
+int main(int argc, char **argv) {
+  peloton::benchmark::timestamp::ParseArguments(
+      argc, argv, peloton::benchmark::timestamp::state);
+
+  peloton::benchmark::timestamp::RunBenchmark();
+
+  return 0;
+}
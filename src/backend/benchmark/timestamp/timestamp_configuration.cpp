@@ -0,0 +1,135 @@
+//===----------------------------------------------------------------------===//
+//
+//                         PelotonDB
+//
+// timestamp_configuration.cpp
+//
+// Identification: benchmark/timestamp/timestamp_configuration.cpp
+//
+// Copyright (c) 2015, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <iomanip>
+#include <algorithm>
+
+#include "backend/benchmark/timestamp/timestamp_configuration.h"
+#include "backend/common/logger.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+void Usage(FILE *out) {
+  fprintf(out,
+          "Command line options : timestamp <options> \n"
+          "   -h --help              :  Print help message \n"
+          "   -b --backend-count     :  Max # of backends \n"
+          "   -d --duration          :  execution duration of each run \n"
+          "   -p --protocol          :  Concurrency control protocol \n"
+          "   -t --timestamp-type    :  1 = centralized, 2 = decentralized \n"
+          "                             (both by default) \n"
+          );
+}
+
+static struct option opts[] = {
+    {"backend-count", optional_argument, NULL, 'b'},
+    {"duration", optional_argument, NULL, 'd'},
+    {"protocol", optional_argument, NULL, 'p'},
+    {"timestamp-type", optional_argument, NULL, 't'},
+    {NULL, 0, NULL, 0}};
+
+void ValidateBackendCount(const configuration &state) {
+  if (state.backend_count <= 0) {
+    LOG_ERROR("Invalid backend_count :: %d", state.backend_count);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "backend_count", state.backend_count);
+}
+
+void ValidateDuration(const configuration &state) {
+  if (state.duration <= 0) {
+    LOG_ERROR("Invalid duration :: %d", state.duration);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "duration", state.duration);
+}
+
+void ValidateProtocol(const configuration &state) {
+  if (state.protocol < CONCURRENCY_TYPE_OPTIMISTIC ||
+      state.protocol > CONCURRENCY_TYPE_OCC_RB) {
+    LOG_ERROR("Invalid protocol :: %d", state.protocol);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "protocol", state.protocol);
+}
+
+void ValidateTimestampTypes(const configuration &state) {
+  for (auto timestamp_type : state.timestamp_types) {
+    if (timestamp_type != TIMESTAMP_TYPE_CENTRALIZED &&
+        timestamp_type != TIMESTAMP_TYPE_DECENTRALIZED) {
+      LOG_ERROR("Invalid timestamp_type :: %d", timestamp_type);
+      exit(EXIT_FAILURE);
+    }
+
+    LOG_INFO("%s : %d", "timestamp_type", timestamp_type);
+  }
+}
+
+void ParseArguments(int argc, char *argv[], configuration &state) {
+
+  // Default Values
+  state.backend_count = 64;
+  state.duration = 1000;
+  state.protocol = CONCURRENCY_TYPE_OPTIMISTIC;
+  state.timestamp_types = {TIMESTAMP_TYPE_CENTRALIZED,
+                           TIMESTAMP_TYPE_DECENTRALIZED};
+
+  // Parse args
+  while (1) {
+    int idx = 0;
+    int c = getopt_long(argc, argv, "hb:d:p:t:", opts, &idx);
+
+    if (c == -1) break;
+
+    switch (c) {
+      case 'b':
+        state.backend_count = atoi(optarg);
+        break;
+      case 'd':
+        state.duration = atoi(optarg);
+        break;
+      case 'p':
+        state.protocol = (ConcurrencyType)atoi(optarg);
+        break;
+      case 't':
+        state.timestamp_types = {(TimestampType)atoi(optarg)};
+        break;
+
+      case 'h':
+        Usage(stderr);
+        exit(EXIT_FAILURE);
+        break;
+
+      default:
+        fprintf(stderr, "\nUnknown option: -%c-\n", c);
+        Usage(stderr);
+        exit(EXIT_FAILURE);
+        break;
+    }
+  }
+
+  // Print configuration
+  ValidateBackendCount(state);
+  ValidateDuration(state);
+  ValidateProtocol(state);
+  ValidateTimestampTypes(state);
+
+}
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
@@ -0,0 +1,61 @@
+//===----------------------------------------------------------------------===//
+//
+//                         PelotonDB
+//
+// timestamp_configuration.h
+//
+// Identification: benchmark/timestamp/timestamp_configuration.h
+//
+// Copyright (c) 2015, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <string>
+#include <getopt.h>
+#include <vector>
+#include <sys/time.h>
+#include <iostream>
+
+#include "backend/common/types.h"
+
+namespace peloton {
+namespace benchmark {
+namespace timestamp {
+
+class configuration {
+ public:
+  // maximum number of backends (doubled from 1 up to this count)
+  int backend_count;
+
+  // execution duration of each run (in ms)
+  int duration;
+
+  // concurrency control protocol
+  ConcurrencyType protocol;
+
+  // timestamp allocation schemes to compare
+  std::vector<TimestampType> timestamp_types;
+
+  // throughput of the last run
+  double throughput;
+};
+
+extern configuration state;
+
+void Usage(FILE *out);
+
+void ParseArguments(int argc, char *argv[], configuration &state);
+
+void ValidateBackendCount(const configuration &state);
+
+void ValidateDuration(const configuration &state);
+
+void ValidateProtocol(const configuration &state);
+
+void ValidateTimestampTypes(const configuration &state);
+
+}  // namespace timestamp
+}  // namespace benchmark
+}  // namespace peloton
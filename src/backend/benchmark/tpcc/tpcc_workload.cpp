@@ -10,9 +10,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <array>
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <chrono>
 #include <iostream>
@@ -36,6 +38,7 @@
 #include "backend/common/logger.h"
 #include "backend/common/timer.h"
 #include "backend/common/generator.h"
+#include "backend/common/latency_histogram.h"
 
 #include "backend/concurrency/transaction.h"
 #include "backend/concurrency/transaction_manager_factory.h"
@@ -46,6 +49,8 @@
 #include "backend/executor/logical_tile_factory.h"
 #include "backend/executor/materialization_executor.h"
 #include "backend/executor/update_executor.h"
+#include "backend/executor/delete_executor.h"
+#include "backend/executor/insert_executor.h"
 #include "backend/executor/index_scan_executor.h"
 
 #include "backend/expression/abstract_expression.h"
@@ -63,6 +68,7 @@
 #include "backend/planner/materialization_plan.h"
 #include "backend/planner/insert_plan.h"
 #include "backend/planner/update_plan.h"
+#include "backend/planner/delete_plan.h"
 #include "backend/planner/index_scan_plan.h"
 
 #include "backend/storage/data_table.h"
@@ -76,15 +82,43 @@ namespace tpcc {
 // TRANSACTION TYPES
 /////////////////////////////////////////////////////////
 
-bool RunStockLevel();
+bool RunStockLevel(const int warehouse_id);
 
-bool RunDelivery();
+bool RunDelivery(const int warehouse_id);
 
-bool RunOrderStatus();
+bool RunOrderStatus(const int warehouse_id);
 
-bool RunPayment();
+bool RunPayment(const int warehouse_id);
 
-bool RunNewOrder();
+bool RunNewOrder(const int warehouse_id);
+
+enum TransactionType {
+  TRANSACTION_TYPE_NEW_ORDER = 0,
+  TRANSACTION_TYPE_PAYMENT = 1,
+  TRANSACTION_TYPE_ORDER_STATUS = 2,
+  TRANSACTION_TYPE_DELIVERY = 3,
+  TRANSACTION_TYPE_STOCK_LEVEL = 4,
+
+  TRANSACTION_TYPE_COUNT = 5
+};
+
+static const char *transaction_type_names[TRANSACTION_TYPE_COUNT] = {
+    "NewOrder", "Payment", "OrderStatus", "Delivery", "StockLevel"};
+
+// Why a transaction did not commit
+enum AbortReason {
+  ABORT_REASON_READ = 0,           // conflict on a read
+  ABORT_REASON_UPDATE = 1,         // conflict on an update
+  ABORT_REASON_INSERT = 2,         // insert failed
+  ABORT_REASON_DELETE = 3,         // conflict on a delete
+  ABORT_REASON_MISSING_TUPLE = 4,  // a tuple that must exist was not found
+  ABORT_REASON_COMMIT = 5,         // commit (validation) failed
+
+  ABORT_REASON_COUNT = 6
+};
+
+static const char *abort_reason_names[ABORT_REASON_COUNT] = {
+    "read", "update", "insert", "delete", "missing tuple", "commit"};
 
 /////////////////////////////////////////////////////////
 // WORKLOAD
@@ -93,11 +127,49 @@ bool RunNewOrder();
 // Used to control backend execution
 volatile bool run_backends = true;
 
-// Committed transaction counts
-std::vector<double> transaction_counts;
+// Statistics of a transaction type on a backend
+struct TransactionStatistics {
+  uint64_t commit_count = 0;
+
+  uint64_t abort_counts[ABORT_REASON_COUNT] = {};
+
+  // Latency of the committed transactions (us)
+  LatencyHistogram latency;
+};
+
+typedef std::array<TransactionStatistics, TRANSACTION_TYPE_COUNT>
+    BackendStatistics;
+
+// Statistics of each backend
+std::vector<BackendStatistics> backend_statistics;
+
+// Set by a transaction that did not commit
+thread_local AbortReason abort_reason;
+
+// Pick a transaction type following the standard TPC-C mix
+static TransactionType GetTransactionType() {
+  auto sample = GetRandomInteger(1, 100);
+
+  if (sample <= 45) {
+    return TRANSACTION_TYPE_NEW_ORDER;
+  } else if (sample <= 88) {
+    return TRANSACTION_TYPE_PAYMENT;
+  } else if (sample <= 92) {
+    return TRANSACTION_TYPE_ORDER_STATUS;
+  } else if (sample <= 96) {
+    return TRANSACTION_TYPE_DELIVERY;
+  } else {
+    return TRANSACTION_TYPE_STOCK_LEVEL;
+  }
+}
 
 void RunBackend(oid_t thread_id) {
-  auto committed_transaction_count = 0;
+  // Every backend works on its own home warehouse, like a terminal in the
+  // specification. With at least as many warehouses as backends, backends
+  // only conflict on remote accesses.
+  int warehouse_id = thread_id % state.warehouse_count;
+
+  auto &statistics = backend_statistics[thread_id];
 
   // Run these many transactions
   while (true) {
@@ -106,24 +178,92 @@ void RunBackend(oid_t thread_id) {
       break;
     }
 
-    // We only run new order txns
-    auto transaction_status = RunNewOrder();
+    auto transaction_type = GetTransactionType();
+    bool transaction_status = false;
+
+    Timer<std::micro> timer;
+    timer.Start();
+
+    switch (transaction_type) {
+      case TRANSACTION_TYPE_NEW_ORDER:
+        transaction_status = RunNewOrder(warehouse_id);
+        break;
+      case TRANSACTION_TYPE_PAYMENT:
+        transaction_status = RunPayment(warehouse_id);
+        break;
+      case TRANSACTION_TYPE_ORDER_STATUS:
+        transaction_status = RunOrderStatus(warehouse_id);
+        break;
+      case TRANSACTION_TYPE_DELIVERY:
+        transaction_status = RunDelivery(warehouse_id);
+        break;
+      case TRANSACTION_TYPE_STOCK_LEVEL:
+        transaction_status = RunStockLevel(warehouse_id);
+        break;
+      default:
+        PL_ASSERT(false);
+        break;
+    }
+
+    timer.Stop();
 
-    // Update transaction count if it committed
-    if(transaction_status == true){
-      committed_transaction_count++;
+    // Update statistics
+    auto &transaction_statistics = statistics[transaction_type];
+    if (transaction_status == true) {
+      transaction_statistics.commit_count++;
+      transaction_statistics.latency.Record(timer.GetDuration());
+    } else {
+      transaction_statistics.abort_counts[abort_reason]++;
     }
   }
+}
+
+static void WriteStatistics() {
+  uint64_t total_commit_count = 0, total_abort_count = 0;
 
-  // Set committed_transaction_count
-  transaction_counts[thread_id] = committed_transaction_count;
+  for (int type_itr = 0; type_itr < TRANSACTION_TYPE_COUNT; type_itr++) {
+    TransactionStatistics merged;
+
+    // Merge the statistics of all backends
+    for (auto &statistics : backend_statistics) {
+      auto &transaction_statistics = statistics[type_itr];
+      merged.commit_count += transaction_statistics.commit_count;
+      merged.latency.Merge(transaction_statistics.latency);
+      for (int reason_itr = 0; reason_itr < ABORT_REASON_COUNT; reason_itr++) {
+        merged.abort_counts[reason_itr] +=
+            transaction_statistics.abort_counts[reason_itr];
+      }
+    }
+
+    uint64_t abort_count = 0;
+    std::string abort_info;
+    for (int reason_itr = 0; reason_itr < ABORT_REASON_COUNT; reason_itr++) {
+      if (merged.abort_counts[reason_itr] == 0) continue;
+      abort_count += merged.abort_counts[reason_itr];
+      abort_info += std::string(" ") + abort_reason_names[reason_itr] + ": " +
+                    std::to_string(merged.abort_counts[reason_itr]);
+    }
+
+    LOG_INFO("%-12s commits: %lu aborts: %lu (%s )",
+             transaction_type_names[type_itr], merged.commit_count,
+             abort_count, abort_info.c_str());
+    LOG_INFO("%-12s latency (us) :: %s", transaction_type_names[type_itr],
+             merged.latency.GetInfo().c_str());
+
+    total_commit_count += merged.commit_count;
+    total_abort_count += abort_count;
+  }
+
+  LOG_INFO("total commits: %lu aborts: %lu", total_commit_count,
+           total_abort_count);
 }
 
 void RunWorkload() {
   // Execute the workload to build the log
   std::vector<std::thread> thread_group;
   oid_t num_threads = state.backend_count;
-  transaction_counts.resize(num_threads);
+  backend_statistics.clear();
+  backend_statistics.resize(num_threads);
 
   // Launch a group of threads
   for (oid_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
@@ -141,11 +281,15 @@ void RunWorkload() {
   }
 
   // Compute total committed transactions
-  auto sum_transaction_count = 0;
-  for(auto transaction_count : transaction_counts){
-    sum_transaction_count += transaction_count;
+  uint64_t sum_transaction_count = 0;
+  for (auto &statistics : backend_statistics) {
+    for (auto &transaction_statistics : statistics) {
+      sum_transaction_count += transaction_statistics.commit_count;
+    }
   }
 
+  WriteStatistics();
+
   // Compute average throughput and latency
   state.throughput = (sum_transaction_count * 1000)/state.duration;
   state.latency = state.backend_count/state.throughput;
@@ -243,7 +387,160 @@ void ExecuteUpdateTest(executor::AbstractExecutor* executor) {
   while (executor->Execute() == true);
 }
 
-bool RunNewOrder(){
+// Abort the current transaction and remember why
+static bool AbortTransaction(const AbortReason reason) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.AbortTransaction();
+
+  abort_reason = reason;
+  return false;
+}
+
+static bool CommitTransaction() {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto result = txn_manager.CommitTransaction();
+
+  if (result == Result::RESULT_SUCCESS) {
+    return true;
+  }
+
+  PL_ASSERT(result == Result::RESULT_ABORTED ||
+            result == Result::RESULT_FAILURE);
+  abort_reason = ABORT_REASON_COMMIT;
+  return false;
+}
+
+static std::vector<ExpressionType> GetEqualityTypes(size_t key_count) {
+  return std::vector<ExpressionType>(
+      key_count, ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL);
+}
+
+// Read the given columns of the tuples matching the key predicates.
+// The key column ids are offsets in the key schema of the index.
+static std::vector<std::vector<Value>> ExecuteIndexScan(
+    storage::DataTable *table, const oid_t index_oid,
+    const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const std::vector<Value> &key_values, const std::vector<oid_t> &column_ids,
+    executor::ExecutorContext *context) {
+  std::vector<expression::AbstractExpression *> runtime_keys;
+  auto index = table->GetIndexWithOid(index_oid);
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, key_values, runtime_keys);
+
+  planner::IndexScanPlan index_scan_node(table, nullptr, column_ids,
+                                         index_scan_desc);
+  executor::IndexScanExecutor index_scan_executor(&index_scan_node, context);
+
+  return ExecuteReadTest(&index_scan_executor);
+}
+
+// Set the given columns of the tuples whose index key equals the key values
+static void ExecuteIndexUpdate(
+    storage::DataTable *table, const oid_t index_oid,
+    const std::vector<oid_t> &key_column_ids,
+    const std::vector<Value> &key_values,
+    const std::vector<std::pair<oid_t, Value>> &update_values,
+    executor::ExecutorContext *context) {
+  std::vector<expression::AbstractExpression *> runtime_keys;
+  auto index = table->GetIndexWithOid(index_oid);
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, GetEqualityTypes(key_column_ids.size()),
+      key_values, runtime_keys);
+
+  std::vector<oid_t> column_ids;
+  for (auto &update_value : update_values) {
+    column_ids.push_back(update_value.first);
+  }
+
+  planner::IndexScanPlan index_scan_node(table, nullptr, column_ids,
+                                         index_scan_desc);
+  executor::IndexScanExecutor index_scan_executor(&index_scan_node, context);
+
+  TargetList target_list;
+  DirectMapList direct_map_list;
+
+  // Keep the other attributes
+  auto column_count = table->GetSchema()->GetColumnCount();
+  for (oid_t col_itr = 0; col_itr < column_count; col_itr++) {
+    if (std::find(column_ids.begin(), column_ids.end(), col_itr) ==
+        column_ids.end()) {
+      direct_map_list.emplace_back(col_itr,
+                                   std::pair<oid_t, oid_t>(0, col_itr));
+    }
+  }
+
+  for (auto &update_value : update_values) {
+    target_list.emplace_back(
+        update_value.first,
+        expression::ExpressionUtil::ConstantValueFactory(update_value.second));
+  }
+
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+  planner::UpdatePlan update_node(table, std::move(project_info));
+
+  executor::UpdateExecutor update_executor(&update_node, context);
+  update_executor.AddChild(&index_scan_executor);
+
+  ExecuteUpdateTest(&update_executor);
+}
+
+// Delete the tuples whose index key equals the key values
+static void ExecuteIndexDelete(storage::DataTable *table,
+                               const oid_t index_oid,
+                               const std::vector<oid_t> &key_column_ids,
+                               const std::vector<Value> &key_values,
+                               executor::ExecutorContext *context) {
+  std::vector<expression::AbstractExpression *> runtime_keys;
+  auto index = table->GetIndexWithOid(index_oid);
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, GetEqualityTypes(key_column_ids.size()),
+      key_values, runtime_keys);
+
+  std::vector<oid_t> column_ids = {0};
+  planner::IndexScanPlan index_scan_node(table, nullptr, column_ids,
+                                         index_scan_desc);
+  executor::IndexScanExecutor index_scan_executor(&index_scan_node, context);
+
+  planner::DeletePlan delete_node(table, false);
+  executor::DeleteExecutor delete_executor(&delete_node, context);
+  delete_executor.AddChild(&index_scan_executor);
+
+  ExecuteUpdateTest(&delete_executor);
+}
+
+static void ExecuteInsert(storage::DataTable *table,
+                          std::unique_ptr<storage::Tuple> tuple,
+                          executor::ExecutorContext *context) {
+  planner::InsertPlan insert_node(table, std::move(tuple));
+  executor::InsertExecutor insert_executor(&insert_node, context);
+  insert_executor.Execute();
+}
+
+static double GetDoubleValue(const Value &value) {
+  return ValuePeeker::PeekDouble(value.CastAs(VALUE_TYPE_DOUBLE));
+}
+
+// Pick the customer in the middle of the customers sharing a last name,
+// ordered by first name. The first name is at the given offset.
+static std::vector<Value> GetMiddleCustomer(
+    std::vector<std::vector<Value>> &customers, const oid_t first_name_offset) {
+  std::sort(customers.begin(), customers.end(),
+            [first_name_offset](const std::vector<Value> &lhs,
+                                const std::vector<Value> &rhs) {
+    return lhs[first_name_offset].Compare(rhs[first_name_offset]) ==
+           VALUE_COMPARE_LESSTHAN;
+  });
+
+  return customers[(customers.size() - 1) / 2];
+}
+
+bool RunNewOrder(const int warehouse_id){
    /*
      "NEW_ORDER": {
      "getWarehouseTaxRate": "SELECT W_TAX FROM WAREHOUSE WHERE W_ID = ?", # w_id
@@ -263,7 +560,6 @@ bool RunNewOrder(){
   // PREPARE ARGUMENTS
   /////////////////////////////////////////////////////////
 
-  int warehouse_id = GetRandomInteger(0, state.warehouse_count - 1);
   int district_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
   int customer_id = GetRandomInteger(0, state.customers_per_district - 1);
   int o_ol_cnt = GetRandomInteger(orders_min_ol_cnt, orders_max_ol_cnt);
@@ -319,9 +615,9 @@ bool RunNewOrder(){
     // Create plan node.
     auto predicate = nullptr;
 
-    static planner::IndexScanPlan item_index_scan_node(item_table, predicate,
-                                                       item_column_ids,
-                                                       item_index_scan_desc);
+    planner::IndexScanPlan item_index_scan_node(item_table, predicate,
+                                                item_column_ids,
+                                                item_index_scan_desc);
 
     executor::IndexScanExecutor item_index_scan_executor(&item_index_scan_node,
                                                          context.get());
@@ -329,8 +625,7 @@ bool RunNewOrder(){
     auto gii_lists_values = ExecuteReadTest(&item_index_scan_executor);
 
     if (txn->GetResult() != Result::RESULT_SUCCESS) {
-      txn_manager.AbortTransaction();
-      return false;
+      return AbortTransaction(ABORT_REASON_READ);
     }
 
     if (gii_lists_values.size() != 1) {
@@ -374,8 +669,7 @@ bool RunNewOrder(){
   auto gwtr_lists_values = ExecuteReadTest(&warehouse_index_scan_executor);
 
   if (txn->GetResult() != Result::RESULT_SUCCESS) {
-    txn_manager.AbortTransaction();
-    return false;
+    return AbortTransaction(ABORT_REASON_READ);
   }
 
   if (gwtr_lists_values.size() != 1) {
@@ -421,8 +715,7 @@ bool RunNewOrder(){
   auto gd_lists_values = ExecuteReadTest(&district_index_scan_executor);
 
   if (txn->GetResult() != Result::RESULT_SUCCESS) {
-    txn_manager.AbortTransaction();
-    return false;
+    return AbortTransaction(ABORT_REASON_READ);
   }
 
   if (gd_lists_values.size() != 1) {
@@ -471,13 +764,12 @@ bool RunNewOrder(){
   auto gc_lists_values = ExecuteReadTest(&customer_index_scan_executor);
 
   if (txn->GetResult() != Result::RESULT_SUCCESS) {
-    txn_manager.AbortTransaction();
-    return false;
+    return AbortTransaction(ABORT_REASON_READ);
   }
 
   if (gc_lists_values.size() != 1) {
     LOG_ERROR("Could not find customer : %d", customer_id);
-    return false;
+    return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
   }
 
   // auto c_last = gd_lists_values[0][0];
@@ -522,8 +814,7 @@ bool RunNewOrder(){
   ExecuteUpdateTest(&district_update_executor);
 
   if (txn->GetResult() != Result::RESULT_SUCCESS) {
-    txn_manager.AbortTransaction();
-    return false;
+    return AbortTransaction(ABORT_REASON_UPDATE);
   }
 
   LOG_TRACE("createOrder: INSERT INTO ORDERS (O_ID, O_D_ID, O_W_ID, O_C_ID, O_ENTRY_D, O_CARRIER_ID, O_OL_CNT, O_ALL_LOCAL)");
@@ -552,6 +843,9 @@ bool RunNewOrder(){
   executor::InsertExecutor orders_executor(&orders_node, context.get());
   orders_executor.Execute();
 
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_INSERT);
+  }
 
   LOG_TRACE("createNewOrder: INSERT INTO NEW_ORDER (NO_O_ID, NO_D_ID, NO_W_ID) VALUES (?, ?, ?)");
   std::unique_ptr<storage::Tuple> new_order_tuple(new storage::Tuple(new_order_table->GetSchema(), true));
@@ -567,6 +861,10 @@ bool RunNewOrder(){
   executor::InsertExecutor new_order_executor(&new_order_node, context.get());
   new_order_executor.Execute();
 
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_INSERT);
+  }
+
   for (size_t i = 0; i < i_ids.size(); ++i) {
     int item_id = i_ids.at(i);
     int ol_w_id = ol_w_ids.at(i);
@@ -587,7 +885,7 @@ bool RunNewOrder(){
         ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL);
     stock_expr_types.push_back(
         ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL);
-    stock_key_values.push_back(ValueFactory::GetTinyIntValue(item_id));
+    stock_key_values.push_back(ValueFactory::GetIntegerValue(item_id));
     stock_key_values.push_back(ValueFactory::GetSmallIntValue(ol_w_id));
 
     auto stock_pkey_index = stock_table->GetIndexWithOid(
@@ -610,8 +908,7 @@ bool RunNewOrder(){
     auto gsi_lists_values = ExecuteReadTest(&stock_index_scan_executor);
 
     if (txn->GetResult() != Result::RESULT_SUCCESS) {
-      txn_manager.AbortTransaction();
-      return false;
+      return AbortTransaction(ABORT_REASON_READ);
     }
 
     if (gsi_lists_values.size() != 1) {
@@ -680,8 +977,7 @@ bool RunNewOrder(){
     ExecuteUpdateTest(&stock_update_executor);
 
     if (txn->GetResult() != Result::RESULT_SUCCESS) {
-      txn_manager.AbortTransaction();
-      return false;
+      return AbortTransaction(ABORT_REASON_UPDATE);
     }
 
     LOG_TRACE("createOrderLine: INSERT INTO ORDER_LINE (OL_O_ID, OL_D_ID, OL_W_ID, OL_NUMBER, OL_I_ID, OL_SUPPLY_W_ID, OL_DELIVERY_D, OL_QUANTITY, OL_AMOUNT, OL_DIST_INFO) VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)");
@@ -714,26 +1010,21 @@ bool RunNewOrder(){
     executor::InsertExecutor order_line_executor(&order_line_node, context.get());
     order_line_executor.Execute();
 
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_INSERT);
+    }
   }
 
   // transaction passed execution.
   PL_ASSERT(txn->GetResult() == Result::RESULT_SUCCESS);
 
-  auto result = txn_manager.CommitTransaction();
+  LOG_TRACE("D_TAX: %s", gd_lists_values[0][0].GetInfo().c_str());
+  LOG_TRACE("D_NEXT_O_ID: %s", gd_lists_values[0][1].GetInfo().c_str());
 
-  if (result == Result::RESULT_SUCCESS) {
-    LOG_TRACE("D_TAX: %s", gd_lists_values[0][0].GetInfo().c_str());
-    LOG_TRACE("D_NEXT_O_ID: %s", gd_lists_values[0][1].GetInfo().c_str());
-
-    return true;
-  } else {
-    PL_ASSERT(result == Result::RESULT_ABORTED ||
-           result == Result::RESULT_FAILURE);
-    return false;
-  }
+  return CommitTransaction();
 }
 
-bool RunPayment(){
+bool RunPayment(const int warehouse_id) {
   /*
      "PAYMENT": {
      "getWarehouse": "SELECT W_NAME, W_STREET_1, W_STREET_2, W_CITY, W_STATE, W_ZIP FROM WAREHOUSE WHERE W_ID = ?", # w_id
@@ -748,14 +1039,230 @@ bool RunPayment(){
      }
    */
 
-  LOG_TRACE("-------------------------------------");
+  /////////////////////////////////////////////////////////
+  // PREPARE ARGUMENTS
+  /////////////////////////////////////////////////////////
+
+  int district_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
+  double h_amount = GetRandomDouble(payment_min_amount, payment_max_amount);
+
+  // 85% of the customers belong to the home warehouse
+  int customer_warehouse_id = warehouse_id;
+  int customer_district_id = district_id;
+  if (state.warehouse_count > 1 && GetRandomInteger(1, 100) > 85) {
+    customer_warehouse_id = GetRandomIntegerExcluding(
+        0, state.warehouse_count - 1, warehouse_id);
+    customer_district_id =
+        GetRandomInteger(0, state.districts_per_warehouse - 1);
+  }
+
+  // 60% of the customers are selected by last name
+  bool by_last_name = GetRandomBoolean(0.6);
+  int customer_id = GetNURand(1023, 0, state.customers_per_district - 1);
+  auto customer_last_name = GetRandomLastName(state.customers_per_district);
+
+  /////////////////////////////////////////////////////////
+  // BEGIN TRANSACTION
+  /////////////////////////////////////////////////////////
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  LOG_TRACE("getWarehouse: SELECT W_NAME, W_STREET_1, W_STREET_2, W_CITY, W_STATE, W_ZIP FROM WAREHOUSE WHERE W_ID = ?");
+
+  std::vector<oid_t> warehouse_key_column_ids = {0}; // W_ID
+  std::vector<Value> warehouse_key_values = {
+      ValueFactory::GetSmallIntValue(warehouse_id)};
+
+  // W_NAME, W_STREET_1, W_STREET_2, W_CITY, W_STATE, W_ZIP, W_YTD
+  std::vector<oid_t> warehouse_column_ids = {1, 2, 3, 4, 5, 6, 8};
+
+  auto gw_lists_values = ExecuteIndexScan(
+      warehouse_table, warehouse_table_pkey_index_oid,
+      warehouse_key_column_ids, GetEqualityTypes(1), warehouse_key_values,
+      warehouse_column_ids, context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  if (gw_lists_values.size() != 1) {
+    return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
+  }
+
+  auto w_name = ValuePeeker::PeekStringCopyWithoutNull(gw_lists_values[0][0]);
+  double w_ytd = GetDoubleValue(gw_lists_values[0][6]);
+
+  LOG_TRACE("updateWarehouseBalance: UPDATE WAREHOUSE SET W_YTD = W_YTD + ? WHERE W_ID = ?");
+
+  ExecuteIndexUpdate(warehouse_table, warehouse_table_pkey_index_oid,
+                     warehouse_key_column_ids, warehouse_key_values,
+                     {{8, ValueFactory::GetDoubleValue(w_ytd + h_amount)}},
+                     context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_UPDATE);
+  }
+
+  LOG_TRACE("getDistrict: SELECT D_NAME, D_STREET_1, D_STREET_2, D_CITY, D_STATE, D_ZIP FROM DISTRICT WHERE D_W_ID = ? AND D_ID = ?");
+
+  std::vector<oid_t> district_key_column_ids = {0, 1}; // D_ID, D_W_ID
+  std::vector<Value> district_key_values = {
+      ValueFactory::GetTinyIntValue(district_id),
+      ValueFactory::GetSmallIntValue(warehouse_id)};
+
+  // D_NAME, D_STREET_1, D_STREET_2, D_CITY, D_STATE, D_ZIP, D_YTD
+  std::vector<oid_t> district_column_ids = {2, 3, 4, 5, 6, 7, 9};
+
+  auto gd_lists_values = ExecuteIndexScan(
+      district_table, district_table_pkey_index_oid, district_key_column_ids,
+      GetEqualityTypes(2), district_key_values, district_column_ids,
+      context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  if (gd_lists_values.size() != 1) {
+    return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
+  }
+
+  auto d_name = ValuePeeker::PeekStringCopyWithoutNull(gd_lists_values[0][0]);
+  double d_ytd = GetDoubleValue(gd_lists_values[0][6]);
+
+  LOG_TRACE("updateDistrictBalance: UPDATE DISTRICT SET D_YTD = D_YTD + ? WHERE D_W_ID = ? AND D_ID = ?");
+
+  ExecuteIndexUpdate(district_table, district_table_pkey_index_oid,
+                     district_key_column_ids, district_key_values,
+                     {{9, ValueFactory::GetDoubleValue(d_ytd + h_amount)}},
+                     context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_UPDATE);
+  }
+
+  // C_ID, C_FIRST, C_MIDDLE, C_LAST, C_STREET_1, C_STREET_2, C_CITY, C_STATE,
+  // C_ZIP, C_PHONE, C_SINCE, C_CREDIT, C_CREDIT_LIM, C_DISCOUNT, C_BALANCE,
+  // C_YTD_PAYMENT, C_PAYMENT_CNT, C_DATA
+  std::vector<oid_t> customer_column_ids = {0,  3,  4,  5,  6,  7,  8,  9, 10,
+                                            11, 12, 13, 14, 15, 16, 17, 18, 20};
+
+  std::vector<std::vector<Value>> gc_lists_values;
+
+  if (by_last_name == true) {
+    LOG_TRACE("getCustomersByLastName: SELECT C_ID, ... FROM CUSTOMER WHERE C_W_ID = ? AND C_D_ID = ? AND C_LAST = ? ORDER BY C_FIRST");
+
+    std::vector<oid_t> customer_key_column_ids = {0, 1, 2}; // C_D_ID, C_W_ID, C_LAST
+    std::vector<Value> customer_key_values = {
+        ValueFactory::GetTinyIntValue(customer_district_id),
+        ValueFactory::GetSmallIntValue(customer_warehouse_id),
+        ValueFactory::GetStringValue(customer_last_name)};
+
+    gc_lists_values = ExecuteIndexScan(
+        customer_table, customer_table_skey_index_oid, customer_key_column_ids,
+        GetEqualityTypes(3), customer_key_values, customer_column_ids,
+        context.get());
+  } else {
+    LOG_TRACE("getCustomerByCustomerId: SELECT C_ID, ... FROM CUSTOMER WHERE C_W_ID = ? AND C_D_ID = ? AND C_ID = ?");
+
+    std::vector<oid_t> customer_key_column_ids = {0, 1, 2}; // C_ID, C_D_ID, C_W_ID
+    std::vector<Value> customer_key_values = {
+        ValueFactory::GetIntegerValue(customer_id),
+        ValueFactory::GetTinyIntValue(customer_district_id),
+        ValueFactory::GetSmallIntValue(customer_warehouse_id)};
+
+    gc_lists_values = ExecuteIndexScan(
+        customer_table, customer_table_pkey_index_oid, customer_key_column_ids,
+        GetEqualityTypes(3), customer_key_values, customer_column_ids,
+        context.get());
+  }
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  if (gc_lists_values.empty()) {
+    return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
+  }
+
+  auto customer = GetMiddleCustomer(gc_lists_values, 1);
+
+  customer_id = ValuePeeker::PeekAsInteger(customer[0]);
+  auto c_credit = ValuePeeker::PeekStringCopyWithoutNull(customer[11]);
+  double c_balance = GetDoubleValue(customer[14]) - h_amount;
+  double c_ytd_payment = GetDoubleValue(customer[15]) + h_amount;
+  int c_payment_cnt = ValuePeeker::PeekAsInteger(customer[16]) + 1;
+
+  std::vector<std::pair<oid_t, Value>> customer_update_values = {
+      {16, ValueFactory::GetDoubleValue(c_balance)},
+      {17, ValueFactory::GetDoubleValue(c_ytd_payment)},
+      {18, ValueFactory::GetIntegerValue(c_payment_cnt)}};
+
+  if (c_credit == customers_bad_credit) {
+    LOG_TRACE("updateBCCustomer: UPDATE CUSTOMER SET C_BALANCE = ?, C_YTD_PAYMENT = ?, C_PAYMENT_CNT = ?, C_DATA = ? WHERE C_W_ID = ? AND C_D_ID = ? AND C_ID = ?");
+
+    // Prepend the payment to the customer data
+    auto c_data = std::to_string(customer_id) + " " +
+                  std::to_string(customer_district_id) + " " +
+                  std::to_string(customer_warehouse_id) + " " +
+                  std::to_string(district_id) + " " +
+                  std::to_string(warehouse_id) + " " +
+                  std::to_string(h_amount) + " | " +
+                  ValuePeeker::PeekStringCopyWithoutNull(customer[17]);
+    c_data.resize(std::min(c_data.size(), data_length));
+
+    customer_update_values.emplace_back(20,
+                                        ValueFactory::GetStringValue(c_data));
+  } else {
+    LOG_TRACE("updateGCCustomer: UPDATE CUSTOMER SET C_BALANCE = ?, C_YTD_PAYMENT = ?, C_PAYMENT_CNT = ? WHERE C_W_ID = ? AND C_D_ID = ? AND C_ID = ?");
+  }
+
+  ExecuteIndexUpdate(customer_table, customer_table_pkey_index_oid, {0, 1, 2},
+                     {ValueFactory::GetIntegerValue(customer_id),
+                      ValueFactory::GetTinyIntValue(customer_district_id),
+                      ValueFactory::GetSmallIntValue(customer_warehouse_id)},
+                     customer_update_values, context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_UPDATE);
+  }
+
+  LOG_TRACE("insertHistory: INSERT INTO HISTORY VALUES (?, ?, ?, ?, ?, ?, ?, ?)");
+
+  std::unique_ptr<storage::Tuple> history_tuple(new storage::Tuple(history_table->GetSchema(), true));
+
+  auto h_data = w_name + "    " + d_name;
+  h_data.resize(std::min(h_data.size(), history_data_length));
+
+  // H_C_ID
+  history_tuple->SetValue(0, ValueFactory::GetIntegerValue(customer_id), nullptr);
+  // H_C_D_ID
+  history_tuple->SetValue(1, ValueFactory::GetTinyIntValue(customer_district_id), nullptr);
+  // H_C_W_ID
+  history_tuple->SetValue(2, ValueFactory::GetSmallIntValue(customer_warehouse_id), nullptr);
+  // H_D_ID
+  history_tuple->SetValue(3, ValueFactory::GetTinyIntValue(district_id), nullptr);
+  // H_W_ID
+  history_tuple->SetValue(4, ValueFactory::GetSmallIntValue(warehouse_id), nullptr);
+  // H_DATE
+  history_tuple->SetValue(5, ValueFactory::GetTimestampValue(GetTimeStamp()), nullptr);
+  // H_AMOUNT
+  history_tuple->SetValue(6, ValueFactory::GetDoubleValue(h_amount), nullptr);
+  // H_DATA
+  history_tuple->SetValue(7, ValueFactory::GetStringValue(h_data), nullptr);
+
+  ExecuteInsert(history_table, std::move(history_tuple), context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_INSERT);
+  }
 
-  //int warehouse_id = GetRandomInteger(0, state.warehouse_count - 1);
-  //int district_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
-  return true;
+  return CommitTransaction();
 }
 
-bool RunOrderStatus(){
+bool RunOrderStatus(const int warehouse_id) {
   /*
     "ORDER_STATUS": {
     "getCustomerByCustomerId": "SELECT C_ID, C_FIRST, C_MIDDLE, C_LAST, C_BALANCE FROM CUSTOMER WHERE C_W_ID = ? AND C_D_ID = ? AND C_ID = ?", # w_id, d_id, c_id
@@ -764,10 +1271,129 @@ bool RunOrderStatus(){
     "getOrderLines": "SELECT OL_SUPPLY_W_ID, OL_I_ID, OL_QUANTITY, OL_AMOUNT, OL_DELIVERY_D FROM ORDER_LINE WHERE OL_W_ID = ? AND OL_D_ID = ? AND OL_O_ID = ?", # w_id, d_id, o_id
     }
    */
-  return true;
+
+  /////////////////////////////////////////////////////////
+  // PREPARE ARGUMENTS
+  /////////////////////////////////////////////////////////
+
+  int district_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
+
+  // 60% of the customers are selected by last name
+  bool by_last_name = GetRandomBoolean(0.6);
+  int customer_id = GetNURand(1023, 0, state.customers_per_district - 1);
+  auto customer_last_name = GetRandomLastName(state.customers_per_district);
+
+  /////////////////////////////////////////////////////////
+  // BEGIN TRANSACTION
+  /////////////////////////////////////////////////////////
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // C_ID, C_FIRST, C_MIDDLE, C_LAST, C_BALANCE
+  std::vector<oid_t> customer_column_ids = {0, 3, 4, 5, 16};
+
+  std::vector<std::vector<Value>> gc_lists_values;
+
+  if (by_last_name == true) {
+    LOG_TRACE("getCustomersByLastName: SELECT C_ID, C_FIRST, C_MIDDLE, C_LAST, C_BALANCE FROM CUSTOMER WHERE C_W_ID = ? AND C_D_ID = ? AND C_LAST = ? ORDER BY C_FIRST");
+
+    std::vector<oid_t> customer_key_column_ids = {0, 1, 2}; // C_D_ID, C_W_ID, C_LAST
+    std::vector<Value> customer_key_values = {
+        ValueFactory::GetTinyIntValue(district_id),
+        ValueFactory::GetSmallIntValue(warehouse_id),
+        ValueFactory::GetStringValue(customer_last_name)};
+
+    gc_lists_values = ExecuteIndexScan(
+        customer_table, customer_table_skey_index_oid, customer_key_column_ids,
+        GetEqualityTypes(3), customer_key_values, customer_column_ids,
+        context.get());
+  } else {
+    LOG_TRACE("getCustomerByCustomerId: SELECT C_ID, C_FIRST, C_MIDDLE, C_LAST, C_BALANCE FROM CUSTOMER WHERE C_W_ID = ? AND C_D_ID = ? AND C_ID = ?");
+
+    std::vector<oid_t> customer_key_column_ids = {0, 1, 2}; // C_ID, C_D_ID, C_W_ID
+    std::vector<Value> customer_key_values = {
+        ValueFactory::GetIntegerValue(customer_id),
+        ValueFactory::GetTinyIntValue(district_id),
+        ValueFactory::GetSmallIntValue(warehouse_id)};
+
+    gc_lists_values = ExecuteIndexScan(
+        customer_table, customer_table_pkey_index_oid, customer_key_column_ids,
+        GetEqualityTypes(3), customer_key_values, customer_column_ids,
+        context.get());
+  }
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  if (gc_lists_values.empty()) {
+    return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
+  }
+
+  auto customer = GetMiddleCustomer(gc_lists_values, 1);
+  customer_id = ValuePeeker::PeekAsInteger(customer[0]);
+
+  LOG_TRACE("getLastOrder: SELECT O_ID, O_CARRIER_ID, O_ENTRY_D FROM ORDERS WHERE O_W_ID = ? AND O_D_ID = ? AND O_C_ID = ? ORDER BY O_ID DESC LIMIT 1");
+
+  std::vector<oid_t> orders_key_column_ids = {0, 1, 2}; // O_C_ID, O_D_ID, O_W_ID
+  std::vector<Value> orders_key_values = {
+      ValueFactory::GetIntegerValue(customer_id),
+      ValueFactory::GetTinyIntValue(district_id),
+      ValueFactory::GetSmallIntValue(warehouse_id)};
+
+  // O_ID, O_CARRIER_ID, O_ENTRY_D
+  std::vector<oid_t> orders_column_ids = {0, 5, 4};
+
+  auto go_lists_values = ExecuteIndexScan(
+      orders_table, orders_table_skey_index_oid, orders_key_column_ids,
+      GetEqualityTypes(3), orders_key_values, orders_column_ids,
+      context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  // The loader assigns the initial orders to random customers, so a customer
+  // might not have placed any order yet
+  if (go_lists_values.empty()) {
+    return CommitTransaction();
+  }
+
+  auto last_order = std::max_element(
+      go_lists_values.begin(), go_lists_values.end(),
+      [](const std::vector<Value> &lhs, const std::vector<Value> &rhs) {
+        return lhs[0].Compare(rhs[0]) == VALUE_COMPARE_LESSTHAN;
+      });
+  auto o_id = (*last_order)[0];
+
+  LOG_TRACE("getOrderLines: SELECT OL_SUPPLY_W_ID, OL_I_ID, OL_QUANTITY, OL_AMOUNT, OL_DELIVERY_D FROM ORDER_LINE WHERE OL_W_ID = ? AND OL_D_ID = ? AND OL_O_ID = ?");
+
+  std::vector<oid_t> order_line_key_column_ids = {0, 1, 2}; // OL_O_ID, OL_D_ID, OL_W_ID
+  std::vector<Value> order_line_key_values = {
+      o_id, ValueFactory::GetTinyIntValue(district_id),
+      ValueFactory::GetSmallIntValue(warehouse_id)};
+
+  // OL_SUPPLY_W_ID, OL_I_ID, OL_QUANTITY, OL_AMOUNT, OL_DELIVERY_D
+  std::vector<oid_t> order_line_column_ids = {5, 4, 7, 8, 6};
+
+  auto gol_lists_values = ExecuteIndexScan(
+      order_line_table, order_line_table_skey_index_oid,
+      order_line_key_column_ids, GetEqualityTypes(3), order_line_key_values,
+      order_line_column_ids, context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  LOG_TRACE("order lines: %lu", gol_lists_values.size());
+
+  return CommitTransaction();
 }
 
-bool RunDelivery(){
+bool RunDelivery(const int warehouse_id) {
   /*
    "DELIVERY": {
    "getNewOrder": "SELECT NO_O_ID FROM NEW_ORDER WHERE NO_D_ID = ? AND NO_W_ID = ? AND NO_O_ID > -1 LIMIT 1", #
@@ -779,17 +1405,295 @@ bool RunDelivery(){
    "updateCustomer": "UPDATE CUSTOMER SET C_BALANCE = C_BALANCE + ? WHERE C_ID = ? AND C_D_ID = ? AND C_W_ID = ?", # ol_total, c_id, d_id, w_id
    }
    */
-  return true;
+
+  /////////////////////////////////////////////////////////
+  // PREPARE ARGUMENTS
+  /////////////////////////////////////////////////////////
+
+  int o_carrier_id =
+      GetRandomInteger(orders_min_carrier_id, orders_max_carrier_id);
+  auto ol_delivery_d = GetTimeStamp();
+
+  /////////////////////////////////////////////////////////
+  // BEGIN TRANSACTION
+  /////////////////////////////////////////////////////////
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  // Deliver the oldest undelivered order of every district
+  for (int district_id = 0; district_id < state.districts_per_warehouse;
+       district_id++) {
+    LOG_TRACE("getNewOrder: SELECT NO_O_ID FROM NEW_ORDER WHERE NO_D_ID = ? AND NO_W_ID = ? AND NO_O_ID > -1 LIMIT 1");
+
+    std::vector<oid_t> new_order_key_column_ids = {0, 1, 2}; // NO_O_ID, NO_D_ID, NO_W_ID
+    std::vector<ExpressionType> new_order_expr_types = {
+        ExpressionType::EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+        ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL,
+        ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL};
+    std::vector<Value> new_order_key_values = {
+        ValueFactory::GetIntegerValue(-1),
+        ValueFactory::GetTinyIntValue(district_id),
+        ValueFactory::GetSmallIntValue(warehouse_id)};
+
+    // NO_O_ID
+    std::vector<oid_t> new_order_column_ids = {0};
+
+    auto gno_lists_values = ExecuteIndexScan(
+        new_order_table, new_order_table_pkey_index_oid,
+        new_order_key_column_ids, new_order_expr_types, new_order_key_values,
+        new_order_column_ids, context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_READ);
+    }
+
+    // No order left to deliver in this district
+    if (gno_lists_values.empty()) {
+      continue;
+    }
+
+    auto oldest_new_order = std::min_element(
+        gno_lists_values.begin(), gno_lists_values.end(),
+        [](const std::vector<Value> &lhs, const std::vector<Value> &rhs) {
+          return lhs[0].Compare(rhs[0]) == VALUE_COMPARE_LESSTHAN;
+        });
+    auto no_o_id = (*oldest_new_order)[0];
+
+    // The keys of NEW_ORDER, ORDERS and ORDER_LINE (secondary index) all
+    // begin with the order, district and warehouse ids
+    std::vector<oid_t> order_key_column_ids = {0, 1, 2};
+    std::vector<Value> order_key_values = {
+        no_o_id, ValueFactory::GetTinyIntValue(district_id),
+        ValueFactory::GetSmallIntValue(warehouse_id)};
+
+    LOG_TRACE("deleteNewOrder: DELETE FROM NEW_ORDER WHERE NO_D_ID = ? AND NO_W_ID = ? AND NO_O_ID = ?");
+
+    ExecuteIndexDelete(new_order_table, new_order_table_pkey_index_oid,
+                       order_key_column_ids, order_key_values, context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_DELETE);
+    }
+
+    LOG_TRACE("getCId: SELECT O_C_ID FROM ORDERS WHERE O_ID = ? AND O_D_ID = ? AND O_W_ID = ?");
+
+    // O_C_ID
+    std::vector<oid_t> orders_column_ids = {1};
+
+    auto gci_lists_values = ExecuteIndexScan(
+        orders_table, orders_table_pkey_index_oid, order_key_column_ids,
+        GetEqualityTypes(3), order_key_values, orders_column_ids,
+        context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_READ);
+    }
+
+    if (gci_lists_values.size() != 1) {
+      return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
+    }
+
+    auto c_id = gci_lists_values[0][0];
+
+    LOG_TRACE("updateOrders: UPDATE ORDERS SET O_CARRIER_ID = ? WHERE O_ID = ? AND O_D_ID = ? AND O_W_ID = ?");
+
+    ExecuteIndexUpdate(orders_table, orders_table_pkey_index_oid,
+                       order_key_column_ids, order_key_values,
+                       {{5, ValueFactory::GetIntegerValue(o_carrier_id)}},
+                       context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_UPDATE);
+    }
+
+    LOG_TRACE("updateOrderLine: UPDATE ORDER_LINE SET OL_DELIVERY_D = ? WHERE OL_O_ID = ? AND OL_D_ID = ? AND OL_W_ID = ?");
+
+    ExecuteIndexUpdate(order_line_table, order_line_table_skey_index_oid,
+                       order_key_column_ids, order_key_values,
+                       {{6, ValueFactory::GetTimestampValue(ol_delivery_d)}},
+                       context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_UPDATE);
+    }
+
+    LOG_TRACE("sumOLAmount: SELECT SUM(OL_AMOUNT) FROM ORDER_LINE WHERE OL_O_ID = ? AND OL_D_ID = ? AND OL_W_ID = ?");
+
+    // OL_AMOUNT
+    std::vector<oid_t> order_line_column_ids = {8};
+
+    auto gol_lists_values = ExecuteIndexScan(
+        order_line_table, order_line_table_skey_index_oid,
+        order_key_column_ids, GetEqualityTypes(3), order_key_values,
+        order_line_column_ids, context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_READ);
+    }
+
+    double ol_total = 0;
+    for (auto &order_line : gol_lists_values) {
+      ol_total += GetDoubleValue(order_line[0]);
+    }
+
+    LOG_TRACE("updateCustomer: UPDATE CUSTOMER SET C_BALANCE = C_BALANCE + ? WHERE C_ID = ? AND C_D_ID = ? AND C_W_ID = ?");
+
+    std::vector<oid_t> customer_key_column_ids = {0, 1, 2}; // C_ID, C_D_ID, C_W_ID
+    std::vector<Value> customer_key_values = {
+        c_id, ValueFactory::GetTinyIntValue(district_id),
+        ValueFactory::GetSmallIntValue(warehouse_id)};
+
+    // C_BALANCE, C_DELIVERY_CNT
+    std::vector<oid_t> customer_column_ids = {16, 19};
+
+    auto gc_lists_values = ExecuteIndexScan(
+        customer_table, customer_table_pkey_index_oid, customer_key_column_ids,
+        GetEqualityTypes(3), customer_key_values, customer_column_ids,
+        context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_READ);
+    }
+
+    if (gc_lists_values.size() != 1) {
+      return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
+    }
+
+    double c_balance = GetDoubleValue(gc_lists_values[0][0]) + ol_total;
+    int c_delivery_cnt = ValuePeeker::PeekAsInteger(gc_lists_values[0][1]) + 1;
+
+    ExecuteIndexUpdate(customer_table, customer_table_pkey_index_oid,
+                       customer_key_column_ids, customer_key_values,
+                       {{16, ValueFactory::GetDoubleValue(c_balance)},
+                        {19, ValueFactory::GetIntegerValue(c_delivery_cnt)}},
+                       context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_UPDATE);
+    }
+  }
+
+  return CommitTransaction();
 }
 
-bool RunStockLevel() {
+bool RunStockLevel(const int warehouse_id) {
   /*
      "STOCK_LEVEL": {
      "getOId": "SELECT D_NEXT_O_ID FROM DISTRICT WHERE D_W_ID = ? AND D_ID = ?",
      "getStockCount": "SELECT COUNT(DISTINCT(OL_I_ID)) FROM ORDER_LINE, STOCK  WHERE OL_W_ID = ? AND OL_D_ID = ? AND OL_O_ID < ? AND OL_O_ID >= ? AND S_W_ID = ? AND S_I_ID = OL_I_ID AND S_QUANTITY < ?
      }
    */
-  return true;
+
+  /////////////////////////////////////////////////////////
+  // PREPARE ARGUMENTS
+  /////////////////////////////////////////////////////////
+
+  int district_id = GetRandomInteger(0, state.districts_per_warehouse - 1);
+  int threshold = GetRandomInteger(stock_min_threshold, stock_max_threshold);
+
+  /////////////////////////////////////////////////////////
+  // BEGIN TRANSACTION
+  /////////////////////////////////////////////////////////
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  LOG_TRACE("getOId: SELECT D_NEXT_O_ID FROM DISTRICT WHERE D_W_ID = ? AND D_ID = ?");
+
+  std::vector<oid_t> district_key_column_ids = {0, 1}; // D_ID, D_W_ID
+  std::vector<Value> district_key_values = {
+      ValueFactory::GetTinyIntValue(district_id),
+      ValueFactory::GetSmallIntValue(warehouse_id)};
+
+  // D_NEXT_O_ID
+  std::vector<oid_t> district_column_ids = {10};
+
+  auto gd_lists_values = ExecuteIndexScan(
+      district_table, district_table_pkey_index_oid, district_key_column_ids,
+      GetEqualityTypes(2), district_key_values, district_column_ids,
+      context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  if (gd_lists_values.size() != 1) {
+    return AbortTransaction(ABORT_REASON_MISSING_TUPLE);
+  }
+
+  int d_next_o_id = ValuePeeker::PeekAsInteger(gd_lists_values[0][0]);
+
+  LOG_TRACE("getStockCount: SELECT COUNT(DISTINCT(OL_I_ID)) FROM ORDER_LINE, STOCK WHERE OL_W_ID = ? AND OL_D_ID = ? AND OL_O_ID < ? AND OL_O_ID >= ? AND S_W_ID = ? AND S_I_ID = OL_I_ID AND S_QUANTITY < ?");
+
+  // The join is run as a range scan over the order lines of the last 20
+  // orders, followed by a stock lookup for every distinct item
+  std::vector<oid_t> order_line_key_column_ids = {0, 0, 1, 2}; // OL_O_ID, OL_O_ID, OL_D_ID, OL_W_ID
+  std::vector<ExpressionType> order_line_expr_types = {
+      ExpressionType::EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+      ExpressionType::EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL,
+      ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL};
+  std::vector<Value> order_line_key_values = {
+      ValueFactory::GetIntegerValue(d_next_o_id - 20),
+      ValueFactory::GetIntegerValue(d_next_o_id),
+      ValueFactory::GetTinyIntValue(district_id),
+      ValueFactory::GetSmallIntValue(warehouse_id)};
+
+  // OL_I_ID
+  std::vector<oid_t> order_line_column_ids = {4};
+
+  auto gol_lists_values = ExecuteIndexScan(
+      order_line_table, order_line_table_skey_index_oid,
+      order_line_key_column_ids, order_line_expr_types, order_line_key_values,
+      order_line_column_ids, context.get());
+
+  if (txn->GetResult() != Result::RESULT_SUCCESS) {
+    return AbortTransaction(ABORT_REASON_READ);
+  }
+
+  std::unordered_set<int> item_ids;
+  for (auto &order_line : gol_lists_values) {
+    item_ids.insert(ValuePeeker::PeekAsInteger(order_line[0]));
+  }
+
+  int low_stock_count = 0;
+
+  for (auto item_id : item_ids) {
+    std::vector<oid_t> stock_key_column_ids = {0, 1}; // S_I_ID, S_W_ID
+    std::vector<Value> stock_key_values = {
+        ValueFactory::GetIntegerValue(item_id),
+        ValueFactory::GetSmallIntValue(warehouse_id)};
+
+    // S_QUANTITY
+    std::vector<oid_t> stock_column_ids = {2};
+
+    auto gs_lists_values = ExecuteIndexScan(
+        stock_table, stock_table_pkey_index_oid, stock_key_column_ids,
+        GetEqualityTypes(2), stock_key_values, stock_column_ids,
+        context.get());
+
+    if (txn->GetResult() != Result::RESULT_SUCCESS) {
+      return AbortTransaction(ABORT_REASON_READ);
+    }
+
+    // The initial order lines may refer to an item past the last one
+    if (gs_lists_values.size() != 1) {
+      continue;
+    }
+
+    if (ValuePeeker::PeekAsInteger(gs_lists_values[0][0]) < threshold) {
+      low_stock_count++;
+    }
+  }
+
+  LOG_TRACE("low stock count: %d", low_stock_count);
+
+  return CommitTransaction();
 }
 
 
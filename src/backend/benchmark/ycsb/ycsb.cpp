@@ -28,6 +28,10 @@ configuration state;
 
 std::ofstream out("outputfile.summary");
 
+std::ofstream timeseries_out("outputfile.timeseries");
+
+std::ofstream latency_out("outputfile.latency");
+
 static void WriteOutput(double stat) {
   LOG_INFO("----------------------------------------------------------");
   LOG_INFO("%lf %d %d %d %d :: %lf",
@@ -47,6 +51,32 @@ static void WriteOutput(double stat) {
   out.flush();
 }
 
+static void WriteTimeSeries() {
+  // Throughput at the end of each snapshot interval
+  for (auto throughput : state.snapshot_throughput) {
+    timeseries_out << throughput << "\n";
+  }
+  timeseries_out.flush();
+}
+
+static void WriteLatencies() {
+  // Latency percentiles (us) of each operation type
+  for (int type_itr = 0; type_itr < OPERATION_TYPE_COUNT; type_itr++) {
+    auto &latency = state.operation_latency[type_itr];
+    if (latency.GetCount() == 0) continue;
+
+    latency_out << operation_type_names[type_itr] << " ";
+    latency_out << latency.GetCount() << " ";
+    latency_out << latency.GetMean() << " ";
+    latency_out << latency.GetPercentile(50) << " ";
+    latency_out << latency.GetPercentile(90) << " ";
+    latency_out << latency.GetPercentile(99) << " ";
+    latency_out << latency.GetPercentile(99.9) << " ";
+    latency_out << latency.GetMax() << "\n";
+  }
+  latency_out.flush();
+}
+
 // Main Entry Point
 void RunBenchmark() {
 
@@ -60,6 +90,10 @@ void RunBenchmark() {
 
   // Emit throughput
   WriteOutput(state.throughput);
+
+  WriteTimeSeries();
+
+  WriteLatencies();
 }
 
 }  // namespace ycsb
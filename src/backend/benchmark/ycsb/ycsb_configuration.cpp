@@ -12,6 +12,7 @@
 
 #include <iomanip>
 #include <algorithm>
+#include <cctype>
 
 #include "backend/benchmark/ycsb/ycsb_configuration.h"
 #include "backend/common/logger.h"
@@ -30,9 +31,16 @@ void Usage(FILE *out) {
           "   -k --scale-factor      :  # of tuples \n"
           "   -s --skew              :  Skew factor \n"
           "   -u --update-ratio      :  Fraction of updates \n"
+          "   -w --workload          :  YCSB workload (A-F) \n"
+          "   -z --zipf-theta        :  Zipfian constant in [0, 1) \n"
+          "   -l --scan-length       :  Max # of tuples per scan \n"
+          "   -i --snapshot-interval :  Throughput snapshot interval (ms) \n"
           );
 }
 
+const char *operation_type_names[OPERATION_TYPE_COUNT] = {
+    "read", "update", "insert", "scan", "read-modify-write"};
+
 static struct option opts[] = {
     {"backend-count", optional_argument, NULL, 'b'},
     {"column-count", optional_argument, NULL, 'c'},
@@ -40,6 +48,10 @@ static struct option opts[] = {
     {"scale-factor", optional_argument, NULL, 'k'},
     {"skew", optional_argument, NULL, 's'},
     {"update-ratio", optional_argument, NULL, 'u'},
+    {"workload", optional_argument, NULL, 'w'},
+    {"zipf-theta", optional_argument, NULL, 'z'},
+    {"scan-length", optional_argument, NULL, 'l'},
+    {"snapshot-interval", optional_argument, NULL, 'i'},
     {NULL, 0, NULL, 0}};
 
 void ValidateScaleFactor(const configuration &state) {
@@ -96,6 +108,72 @@ void ValidateSkewFactor(const configuration &state) {
   LOG_INFO("%s : %d", "skew_factor", state.skew_factor);
 }
 
+void ValidateZipfTheta(const configuration &state) {
+  if (state.zipf_theta < 0 || state.zipf_theta >= 1) {
+    LOG_ERROR("Invalid zipf_theta :: %lf", state.zipf_theta);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %lf", "zipf_theta", GetZipfTheta(state));
+}
+
+void ValidateWorkloadType(const configuration &state) {
+  if (state.workload_type < WORKLOAD_TYPE_CUSTOM ||
+      state.workload_type > WORKLOAD_TYPE_F) {
+    LOG_ERROR("Invalid workload_type :: %d", state.workload_type);
+    exit(EXIT_FAILURE);
+  }
+
+  if (state.workload_type == WORKLOAD_TYPE_CUSTOM) {
+    LOG_INFO("%s : %s", "workload_type", "custom");
+  } else {
+    LOG_INFO("%s : %c", "workload_type",
+             'A' + state.workload_type - WORKLOAD_TYPE_A);
+  }
+}
+
+void ValidateScanLength(const configuration &state) {
+  if (state.scan_length <= 0) {
+    LOG_ERROR("Invalid scan_length :: %d", state.scan_length);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "scan_length", state.scan_length);
+}
+
+void ValidateSnapshotInterval(const configuration &state) {
+  if (state.snapshot_interval <= 0) {
+    LOG_ERROR("Invalid snapshot_interval :: %d", state.snapshot_interval);
+    exit(EXIT_FAILURE);
+  }
+
+  LOG_INFO("%s : %d", "snapshot_interval", state.snapshot_interval);
+}
+
+double GetZipfTheta(const configuration &state) {
+  if (state.zipf_theta > 0) {
+    return state.zipf_theta;
+  }
+
+  if (state.skew_factor == SKEW_FACTOR_HIGH) {
+    return 0.5;
+  }
+
+  return 0;
+}
+
+static WorkloadType StringToWorkloadType(const std::string &str) {
+  if (str.size() == 1) {
+    auto workload = std::toupper(str[0]);
+    if (workload >= 'A' && workload <= 'F') {
+      return (WorkloadType)(WORKLOAD_TYPE_A + workload - 'A');
+    }
+  }
+
+  LOG_ERROR("Invalid workload :: %s", str.c_str());
+  exit(EXIT_FAILURE);
+}
+
 void ParseArguments(int argc, char *argv[], configuration &state) {
 
   // Default Values
@@ -105,11 +183,15 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   state.update_ratio = 1;
   state.backend_count = 2;
   state.skew_factor = SKEW_FACTOR_LOW;
+  state.zipf_theta = 0;
+  state.workload_type = WORKLOAD_TYPE_CUSTOM;
+  state.scan_length = 100;
+  state.snapshot_interval = 1000;
 
   // Parse args
   while (1) {
     int idx = 0;
-    int c = getopt_long(argc, argv, "hb:c:d:k:s:u:", opts, &idx);
+    int c = getopt_long(argc, argv, "hb:c:d:k:s:u:w:z:l:i:", opts, &idx);
 
     if (c == -1) break;
 
@@ -132,6 +214,18 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
       case 'u':
         state.update_ratio = atof(optarg);
         break;
+      case 'w':
+        state.workload_type = StringToWorkloadType(optarg);
+        break;
+      case 'z':
+        state.zipf_theta = atof(optarg);
+        break;
+      case 'l':
+        state.scan_length = atoi(optarg);
+        break;
+      case 'i':
+        state.snapshot_interval = atoi(optarg);
+        break;
 
       case 'h':
         Usage(stderr);
@@ -153,6 +247,10 @@ void ParseArguments(int argc, char *argv[], configuration &state) {
   ValidateUpdateRatio(state);
   ValidateDuration(state);
   ValidateSkewFactor(state);
+  ValidateZipfTheta(state);
+  ValidateWorkloadType(state);
+  ValidateScanLength(state);
+  ValidateSnapshotInterval(state);
 
 }
 
@@ -19,6 +19,7 @@
 #include <iostream>
 
 #include "backend/common/types.h"
+#include "backend/common/latency_histogram.h"
 
 namespace peloton {
 namespace benchmark {
@@ -39,6 +40,30 @@ enum SkewFactor {
   SKEW_FACTOR_HIGH = 2
 };
 
+// Standard YCSB workloads
+enum WorkloadType {
+  WORKLOAD_TYPE_CUSTOM = 0,  // reads and inserts, mixed by the update ratio
+
+  WORKLOAD_TYPE_A = 1,  // 50% reads, 50% updates
+  WORKLOAD_TYPE_B = 2,  // 95% reads, 5% updates
+  WORKLOAD_TYPE_C = 3,  // 100% reads
+  WORKLOAD_TYPE_D = 4,  // 95% reads of the latest keys, 5% inserts
+  WORKLOAD_TYPE_E = 5,  // 95% short range scans, 5% inserts
+  WORKLOAD_TYPE_F = 6   // 50% reads, 50% read-modify-writes
+};
+
+enum OperationType {
+  OPERATION_TYPE_READ = 0,
+  OPERATION_TYPE_UPDATE = 1,
+  OPERATION_TYPE_INSERT = 2,
+  OPERATION_TYPE_SCAN = 3,
+  OPERATION_TYPE_READ_MODIFY_WRITE = 4,
+
+  OPERATION_TYPE_COUNT = 5
+};
+
+extern const char *operation_type_names[OPERATION_TYPE_COUNT];
+
 class configuration {
  public:
   // size of the table
@@ -62,8 +87,26 @@ class configuration {
   // skew
   SkewFactor skew_factor;
 
+  // zipfian constant (overrides the skew factor when set)
+  double zipf_theta;
+
+  // workload
+  WorkloadType workload_type;
+
+  // max number of tuples read by a scan
+  int scan_length;
+
+  // interval of the throughput time series (in ms)
+  int snapshot_interval;
+
   // latency average
   double latency;
+
+  // throughput of every snapshot interval
+  std::vector<double> snapshot_throughput;
+
+  // latency of the committed operations of each type (in us)
+  std::vector<LatencyHistogram> operation_latency;
 };
 
 extern configuration state;
@@ -84,6 +127,17 @@ void ValidateDuration(const configuration &state);
 
 void ValidateSkewFactor(const configuration &state);
 
+void ValidateZipfTheta(const configuration &state);
+
+void ValidateWorkloadType(const configuration &state);
+
+void ValidateScanLength(const configuration &state);
+
+void ValidateSnapshotInterval(const configuration &state);
+
+// Zipfian constant of the key distribution
+double GetZipfTheta(const configuration &state);
+
 }  // namespace ycsb
 }  // namespace benchmark
 }  // namespace peloton
@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <array>
+#include <atomic>
 #include <memory>
 #include <string>
 #include <unordered_map>
@@ -36,6 +38,7 @@
 #include "backend/common/logger.h"
 #include "backend/common/timer.h"
 #include "backend/common/generator.h"
+#include "backend/common/latency_histogram.h"
 #include "backend/common/platform.h"
 
 #include "backend/concurrency/transaction.h"
@@ -175,9 +178,15 @@ class ZipfDistribution {
 // TRANSACTION TYPES
 /////////////////////////////////////////////////////////
 
-bool RunRead(ZipfDistribution &zipf);
+bool RunRead(const oid_t lookup_key);
 
-bool RunInsert(ZipfDistribution &zipf, oid_t next_insert_key);
+bool RunUpdate(const oid_t lookup_key, fast_random &rng);
+
+bool RunInsert(const oid_t insert_key);
+
+bool RunScan(const oid_t start_key, const oid_t scan_length);
+
+bool RunReadModifyWrite(const oid_t lookup_key, fast_random &rng);
 
 /////////////////////////////////////////////////////////
 // WORKLOAD
@@ -186,25 +195,70 @@ bool RunInsert(ZipfDistribution &zipf, oid_t next_insert_key);
 // Used to control backend execution
 volatile bool run_backends = true;
 
-// Committed transaction counts
-std::vector<double> transaction_counts;
+// Statistics of an operation type on a backend
+struct OperationStatistics {
+  uint64_t commit_count = 0;
 
-void RunBackend(oid_t thread_id) {
-  auto update_ratio = state.update_ratio;
+  uint64_t abort_count = 0;
+
+  // Latency of the committed operations (us)
+  LatencyHistogram latency;
+};
+
+typedef std::array<OperationStatistics, OPERATION_TYPE_COUNT>
+    BackendStatistics;
+
+// Statistics of each backend
+std::vector<BackendStatistics> backend_statistics;
+
+// Committed operation counts of each backend, sampled during the run
+std::unique_ptr<std::atomic<uint64_t>[]> commit_counts;
+
+// Next key to insert, shared by all backends so that the key space grows
+// contiguously and the latest keys are known
+std::atomic<oid_t> next_insert_key;
+
+static OperationType GetOperationType(fast_random &rng) {
+  auto sample = rng.next_uniform();
+
+  switch (state.workload_type) {
+    case WORKLOAD_TYPE_A:
+      return (sample < 0.5) ? OPERATION_TYPE_READ : OPERATION_TYPE_UPDATE;
+    case WORKLOAD_TYPE_B:
+      return (sample < 0.95) ? OPERATION_TYPE_READ : OPERATION_TYPE_UPDATE;
+    case WORKLOAD_TYPE_C:
+      return OPERATION_TYPE_READ;
+    case WORKLOAD_TYPE_D:
+      return (sample < 0.95) ? OPERATION_TYPE_READ : OPERATION_TYPE_INSERT;
+    case WORKLOAD_TYPE_E:
+      return (sample < 0.95) ? OPERATION_TYPE_SCAN : OPERATION_TYPE_INSERT;
+    case WORKLOAD_TYPE_F:
+      return (sample < 0.5) ? OPERATION_TYPE_READ
+                            : OPERATION_TYPE_READ_MODIFY_WRITE;
+    case WORKLOAD_TYPE_CUSTOM:
+    default:
+      return (sample < state.update_ratio) ? OPERATION_TYPE_INSERT
+                                           : OPERATION_TYPE_READ;
+  }
+}
 
-  // Set zipfian skew
-  auto zipf_theta = 0.0;
-  if(state.skew_factor == SKEW_FACTOR_HIGH) {
-    zipf_theta = 0.5;
+static oid_t GetLookupKey(ZipfDistribution &zipf) {
+  // Read latest : the most recently inserted keys are the most popular
+  if (state.workload_type == WORKLOAD_TYPE_D) {
+    oid_t latest_key = next_insert_key.load() - 1;
+    oid_t offset = zipf.GetNextNumber() - 1;
+    return (offset > latest_key) ? 0 : latest_key - offset;
   }
 
+  return zipf.GetNextNumber();
+}
+
+void RunBackend(oid_t thread_id) {
   fast_random rng(rand());
-  ZipfDistribution zipf((state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP) - 1, zipf_theta);
-  auto committed_transaction_count = 0;
+  ZipfDistribution zipf((state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP) - 1,
+                        GetZipfTheta(state));
 
-  // Partition the domain across backends
-  auto insert_key_offset = state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP;
-  auto next_insert_key = insert_key_offset + thread_id + 1;
+  auto &statistics = backend_statistics[thread_id];
 
   // Run these many transactions
   while (true) {
@@ -213,42 +267,99 @@ void RunBackend(oid_t thread_id) {
       break;
     }
 
-    auto rng_val = rng.next_uniform();
+    auto operation_type = GetOperationType(rng);
     auto transaction_status = false;
 
+    Timer<std::micro> timer;
+    timer.Start();
+
     // Run transaction
-    if (rng_val < update_ratio) {
-      next_insert_key += state.backend_count;
-      transaction_status = RunInsert(zipf, next_insert_key);
-    }
-    else {
-      transaction_status = RunRead(zipf);
+    switch (operation_type) {
+      case OPERATION_TYPE_READ:
+        transaction_status = RunRead(GetLookupKey(zipf));
+        break;
+      case OPERATION_TYPE_UPDATE:
+        transaction_status = RunUpdate(GetLookupKey(zipf), rng);
+        break;
+      case OPERATION_TYPE_INSERT:
+        transaction_status = RunInsert(next_insert_key++);
+        break;
+      case OPERATION_TYPE_SCAN: {
+        oid_t scan_length = zipf.GenerateInteger(1, state.scan_length);
+        transaction_status = RunScan(GetLookupKey(zipf), scan_length);
+      } break;
+      case OPERATION_TYPE_READ_MODIFY_WRITE:
+        transaction_status = RunReadModifyWrite(GetLookupKey(zipf), rng);
+        break;
+      default:
+        PL_ASSERT(false);
+        break;
     }
 
-    // Update transaction count if it committed
-    if(transaction_status == true){
-      committed_transaction_count++;
+    timer.Stop();
+
+    // Update statistics
+    auto &operation_statistics = statistics[operation_type];
+    if (transaction_status == true) {
+      operation_statistics.commit_count++;
+      operation_statistics.latency.Record(timer.GetDuration());
+      commit_counts[thread_id].fetch_add(1, std::memory_order_relaxed);
+    } else {
+      operation_statistics.abort_count++;
     }
   }
+}
 
-  // Set committed_transaction_count
-  transaction_counts[thread_id] = committed_transaction_count;
+static uint64_t GetCommitCount() {
+  uint64_t commit_count = 0;
+  for (int thread_itr = 0; thread_itr < state.backend_count; thread_itr++) {
+    commit_count += commit_counts[thread_itr].load(std::memory_order_relaxed);
+  }
+
+  return commit_count;
 }
 
 void RunWorkload() {
   // Execute the workload to build the log
   std::vector<std::thread> thread_group;
   oid_t num_threads = state.backend_count;
-  transaction_counts.resize(num_threads);
+
+  backend_statistics.clear();
+  backend_statistics.resize(num_threads);
+  commit_counts.reset(new std::atomic<uint64_t>[num_threads]);
+  for (oid_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
+    commit_counts[thread_itr] = 0;
+  }
+
+  // Inserted keys follow the loaded ones
+  next_insert_key = state.scale_factor * DEFAULT_TUPLES_PER_TILEGROUP;
 
   // Launch a group of threads
   for (oid_t thread_itr = 0; thread_itr < num_threads; ++thread_itr) {
     thread_group.push_back(std::move(std::thread(RunBackend, thread_itr)));
   }
 
-  // Sleep for duration specified by user and then stop the backends
-  auto sleep_period = std::chrono::milliseconds(state.duration);
-  std::this_thread::sleep_for(sleep_period);
+  // Sleep for duration specified by user, sampling the throughput at every
+  // snapshot interval, and then stop the backends
+  auto snapshot_interval = state.snapshot_interval;
+  if (snapshot_interval <= 0) {
+    snapshot_interval = state.duration;
+  }
+
+  state.snapshot_throughput.clear();
+  uint64_t last_commit_count = 0;
+
+  for (int elapsed = 0; elapsed < state.duration;) {
+    auto sleep_period = std::min(snapshot_interval, state.duration - elapsed);
+    std::this_thread::sleep_for(std::chrono::milliseconds(sleep_period));
+    elapsed += sleep_period;
+
+    auto commit_count = GetCommitCount();
+    state.snapshot_throughput.push_back(
+        ((commit_count - last_commit_count) * 1000.0) / sleep_period);
+    last_commit_count = commit_count;
+  }
+
   run_backends = false;
 
   // Join the threads with the main thread
@@ -256,10 +367,25 @@ void RunWorkload() {
     thread_group[thread_itr].join();
   }
 
-  // Compute total committed transactions
-  auto sum_transaction_count = 0;
-  for(auto transaction_count : transaction_counts){
-    sum_transaction_count += transaction_count;
+  // Merge the statistics of all backends
+  uint64_t sum_transaction_count = 0;
+  state.operation_latency.assign(OPERATION_TYPE_COUNT, LatencyHistogram());
+
+  for (int type_itr = 0; type_itr < OPERATION_TYPE_COUNT; type_itr++) {
+    uint64_t commit_count = 0, abort_count = 0;
+    for (auto &statistics : backend_statistics) {
+      commit_count += statistics[type_itr].commit_count;
+      abort_count += statistics[type_itr].abort_count;
+      state.operation_latency[type_itr].Merge(statistics[type_itr].latency);
+    }
+
+    sum_transaction_count += commit_count;
+
+    if (commit_count + abort_count == 0) continue;
+    LOG_INFO("%-18s commits: %lu aborts: %lu", operation_type_names[type_itr],
+             commit_count, abort_count);
+    LOG_INFO("%-18s latency (us) :: %s", operation_type_names[type_itr],
+             state.operation_latency[type_itr].GetInfo().c_str());
   }
 
   // Compute average throughput and latency
@@ -318,23 +444,10 @@ static bool EndTransaction(concurrency::Transaction *txn) {
   }
 }
 
-/////////////////////////////////////////////////////////
-// TRANSACTIONS
-/////////////////////////////////////////////////////////
-
-bool RunRead(ZipfDistribution &zipf) {
-  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
-
-
-  auto txn = txn_manager.BeginTransaction();
-
-  /////////////////////////////////////////////////////////
-  // INDEX SCAN + PREDICATE
-  /////////////////////////////////////////////////////////
-
-  std::unique_ptr<executor::ExecutorContext> context(
-      new executor::ExecutorContext(txn));
-
+// Read all the columns of the tuples matching the key predicates
+static void ExecuteIndexScan(const std::vector<ExpressionType> &expr_types,
+                             const std::vector<Value> &values,
+                             executor::ExecutorContext *context) {
   // Column ids to be added to logical tile after scan.
   std::vector<oid_t> column_ids;
   oid_t column_count = state.column_count + 1;
@@ -344,19 +457,9 @@ bool RunRead(ZipfDistribution &zipf) {
   }
 
   // Create and set up index scan executor
-
-  std::vector<oid_t> key_column_ids;
-  std::vector<ExpressionType> expr_types;
-  std::vector<Value> values;
+  std::vector<oid_t> key_column_ids(values.size(), 0);
   std::vector<expression::AbstractExpression *> runtime_keys;
 
-  auto lookup_key = zipf.GetNextNumber();
-
-  key_column_ids.push_back(0);
-  expr_types.push_back(
-      ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL);
-  values.push_back(ValueFactory::GetIntegerValue(lookup_key));
-
   auto ycsb_pkey_index = user_table->GetIndexWithOid(
       user_table_pkey_index_oid);
 
@@ -372,7 +475,7 @@ bool RunRead(ZipfDistribution &zipf) {
 
   // Run the executor
   executor::IndexScanExecutor index_scan_executor(&index_scan_node,
-                                                  context.get());
+                                                  context);
 
   /////////////////////////////////////////////////////////
   // MATERIALIZE
@@ -404,13 +507,150 @@ bool RunRead(ZipfDistribution &zipf) {
   executors.push_back(&mat_executor);
 
   ExecuteTest(executors);
+}
+
+// Overwrite a random field of the tuple with the given key
+static void ExecuteIndexUpdate(const oid_t lookup_key, fast_random &rng,
+                               executor::ExecutorContext *context) {
+  oid_t column_count = state.column_count + 1;
+  oid_t update_column_id = 1 + rng.next() % state.column_count;
+
+  std::vector<oid_t> key_column_ids = {0};
+  std::vector<ExpressionType> expr_types = {
+      ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL};
+  std::vector<Value> values = {ValueFactory::GetIntegerValue(lookup_key)};
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  auto ycsb_pkey_index = user_table->GetIndexWithOid(
+      user_table_pkey_index_oid);
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      ycsb_pkey_index, key_column_ids, expr_types, values, runtime_keys);
+
+  std::vector<oid_t> column_ids = {update_column_id};
+  planner::IndexScanPlan index_scan_node(user_table, nullptr, column_ids,
+                                         index_scan_desc);
+  executor::IndexScanExecutor index_scan_executor(&index_scan_node, context);
+
+  TargetList target_list;
+  DirectMapList direct_map_list;
+
+  // Keep the other fields
+  for (oid_t col_itr = 0; col_itr < column_count; col_itr++) {
+    if (col_itr != update_column_id) {
+      direct_map_list.emplace_back(col_itr,
+                                   std::pair<oid_t, oid_t>(0, col_itr));
+    }
+  }
+
+  std::string field_raw_value = rng.next_readable_string(ycsb_field_length - 1);
+  target_list.emplace_back(
+      update_column_id, expression::ExpressionUtil::ConstantValueFactory(
+                            ValueFactory::GetStringValue(field_raw_value)));
+
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+  planner::UpdatePlan update_node(user_table, std::move(project_info));
+
+  executor::UpdateExecutor update_executor(&update_node, context);
+  update_executor.AddChild(&index_scan_executor);
+
+  std::vector<executor::AbstractExecutor *> executors;
+  executors.push_back(&update_executor);
+
+  ExecuteTest(executors);
+}
+
+/////////////////////////////////////////////////////////
+// TRANSACTIONS
+/////////////////////////////////////////////////////////
+
+bool RunRead(const oid_t lookup_key) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  /////////////////////////////////////////////////////////
+  // INDEX SCAN + MATERIALIZE
+  /////////////////////////////////////////////////////////
+
+  ExecuteIndexScan({ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL},
+                   {ValueFactory::GetIntegerValue(lookup_key)}, context.get());
+
+  auto txn_status = EndTransaction(txn);
+  return txn_status;
+}
+
+bool RunUpdate(const oid_t lookup_key, fast_random &rng) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  /////////////////////////////////////////////////////////
+  // INDEX SCAN + UPDATE
+  /////////////////////////////////////////////////////////
+
+  ExecuteIndexUpdate(lookup_key, rng, context.get());
+
+  auto txn_status = EndTransaction(txn);
+  return txn_status;
+}
+
+bool RunScan(const oid_t start_key, const oid_t scan_length) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  /////////////////////////////////////////////////////////
+  // INDEX RANGE SCAN + MATERIALIZE
+  /////////////////////////////////////////////////////////
+
+  // Keys are dense, so the range holds the next scan_length tuples
+  ExecuteIndexScan(
+      {ExpressionType::EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+       ExpressionType::EXPRESSION_TYPE_COMPARE_LESSTHAN},
+      {ValueFactory::GetIntegerValue(start_key),
+       ValueFactory::GetIntegerValue(start_key + scan_length)},
+      context.get());
+
+  auto txn_status = EndTransaction(txn);
+  return txn_status;
+}
+
+bool RunReadModifyWrite(const oid_t lookup_key, fast_random &rng) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  /////////////////////////////////////////////////////////
+  // INDEX SCAN + MATERIALIZE, then INDEX SCAN + UPDATE
+  /////////////////////////////////////////////////////////
+
+  ExecuteIndexScan({ExpressionType::EXPRESSION_TYPE_COMPARE_EQUAL},
+                   {ValueFactory::GetIntegerValue(lookup_key)}, context.get());
+
+  if (txn->GetResult() == Result::RESULT_SUCCESS) {
+    ExecuteIndexUpdate(lookup_key, rng, context.get());
+  }
 
   auto txn_status = EndTransaction(txn);
   return txn_status;
 }
 
-bool RunInsert(UNUSED_ATTRIBUTE ZipfDistribution &zipf,
-               oid_t next_insert_key) {
+bool RunInsert(const oid_t insert_key) {
   auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
 
   const oid_t col_count = state.column_count + 1;
@@ -429,7 +669,7 @@ bool RunInsert(UNUSED_ATTRIBUTE ZipfDistribution &zipf,
   /////////////////////////////////////////////////////////
 
   std::unique_ptr<storage::Tuple> tuple(new storage::Tuple(table_schema, allocate));
-  auto key_value = ValueFactory::GetIntegerValue(next_insert_key);
+  auto key_value = ValueFactory::GetIntegerValue(insert_key);
   auto field_value = ValueFactory::GetStringValue(field_raw_value);
 
   tuple->SetValue(0, key_value, nullptr);
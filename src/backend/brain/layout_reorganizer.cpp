@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// layout_reorganizer.cpp
+//
+// Identification: src/backend/brain/layout_reorganizer.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "backend/brain/layout_reorganizer.h"
+#include "backend/catalog/manager.h"
+#include "backend/common/logger.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/database.h"
+#include "backend/storage/tile_group.h"
+
+namespace peloton {
+namespace brain {
+
+LayoutReorganizer &LayoutReorganizer::GetInstance() {
+  static LayoutReorganizer layout_reorganizer;
+  return layout_reorganizer;
+}
+
+void LayoutReorganizer::StartReorganizer(const int interval_ms) {
+  LOG_TRACE("Starting layout reorganizer");
+  if (this->is_running_ == true) {
+    return;
+  }
+  this->is_running_ = true;
+  reorganizer_thread_.reset(
+      new std::thread(&LayoutReorganizer::Running, this, interval_ms));
+}
+
+void LayoutReorganizer::StopReorganizer() {
+  LOG_TRACE("Stopping layout reorganizer");
+  if (this->is_running_ == false) {
+    return;
+  }
+  this->is_running_ = false;
+  this->reorganizer_thread_->join();
+}
+
+void LayoutReorganizer::Running(const int interval_ms) {
+  while (is_running_ == true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+    LOG_TRACE("layout reorganizer thread...");
+    Reorganize();
+  }
+}
+
+oid_t LayoutReorganizer::Reorganize() {
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t transform_count = 0;
+
+  auto database_count = manager.GetDatabaseCount();
+  for (oid_t database_itr = 0; database_itr < database_count;
+       database_itr++) {
+    auto database = manager.GetDatabase(database_itr);
+
+    auto table_count = database->GetTableCount();
+    for (oid_t table_itr = 0; table_itr < table_count; table_itr++) {
+      // Rate limit the transformations over all the tables
+      oid_t remaining_count =
+          REORGANIZER_MAX_TRANSFORM_COUNT - transform_count;
+      if (remaining_count == 0) break;
+
+      transform_count +=
+          Reorganize(database->GetTable(table_itr), remaining_count);
+    }
+  }
+
+  pass_count_++;
+
+  return transform_count;
+}
+
+oid_t LayoutReorganizer::Reorganize(storage::DataTable *table,
+                                    const oid_t max_transform_count) {
+  // The clusterer needs at least two columns to split
+  if (table->IsAdaptTable() == false ||
+      table->GetSchema()->GetColumnCount() < 2) {
+    return 0;
+  }
+
+  // First, update the default partition if the workload was sampled enough
+  if (table->GetSampleCount() >= REORGANIZER_MIN_SAMPLE_COUNT) {
+    table->UpdateDefaultPartition();
+    partition_update_count_++;
+  }
+
+  auto default_partition = table->GetDefaultPartition();
+
+  // Then, transform tile groups incrementally, resuming where the last
+  // pass stopped
+  auto tile_group_count = table->GetTileGroupCount();
+  if (tile_group_count == 0) return 0;
+
+  auto &cursor = table_cursors_[table->GetOid()];
+  oid_t transform_count = 0;
+
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count &&
+                                 transform_count < max_transform_count;
+       tile_group_itr++) {
+    oid_t tile_group_offset = (cursor + tile_group_itr) % tile_group_count;
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+
+    // Already in the right layout, or can not be swapped safely
+    if (tile_group->IsCompressed() ||
+        tile_group->GetSchemaDifference(default_partition) <=
+            REORGANIZER_THETA ||
+        table->IsTileGroupImmutable(tile_group_offset) == false) {
+      continue;
+    }
+
+    if (table->TransformTileGroup(tile_group_offset, REORGANIZER_THETA) !=
+        nullptr) {
+      LOG_TRACE("Transformed tile group %u in table %u",
+                tile_group->GetTileGroupId(), table->GetOid());
+      transform_count++;
+      cursor = tile_group_offset + 1;
+    }
+  }
+
+  transform_count_ += transform_count;
+
+  return transform_count;
+}
+
+}  // End brain namespace
+}  // End peloton namespace
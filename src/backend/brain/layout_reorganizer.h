@@ -0,0 +1,123 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// layout_reorganizer.h
+//
+// Identification: src/backend/brain/layout_reorganizer.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include "backend/common/types.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+}
+
+namespace brain {
+
+//===--------------------------------------------------------------------===//
+// Layout Reorganizer
+//===--------------------------------------------------------------------===//
+
+#define REORGANIZER_PERIOD_MILLISECONDS 1000
+
+// Minimum number of new samples before a table is repartitioned
+#define REORGANIZER_MIN_SAMPLE_COUNT 10
+
+// Maximum number of tile groups transformed per pass, over all tables
+#define REORGANIZER_MAX_TRANSFORM_COUNT 8
+
+// Minimum fraction of columns that must move before transforming
+#define REORGANIZER_THETA 0.0
+
+/**
+ * Background service that adapts table layouts to the workload.
+ *
+ * Scans record column access samples in their tables while the service is
+ * running. On every pass, the reorganizer recomputes the default partition
+ * of tables with enough new samples using the clusterer, and transforms a
+ * bounded number of tile groups into that partition.
+ *
+ * Only immutable tile groups are transformed (see
+ * DataTable::IsTileGroupImmutable). The transformed tile group shares the
+ * header of the orig one, so transactions running during the swap keep
+ * seeing the same MVCC metadata.
+ */
+class LayoutReorganizer {
+ public:
+  LayoutReorganizer(const LayoutReorganizer &) = delete;
+  LayoutReorganizer &operator=(const LayoutReorganizer &) = delete;
+  LayoutReorganizer(LayoutReorganizer &&) = delete;
+  LayoutReorganizer &operator=(LayoutReorganizer &&) = delete;
+
+  LayoutReorganizer()
+      : is_running_(false),
+        pass_count_(0),
+        partition_update_count_(0),
+        transform_count_(0) {}
+
+  ~LayoutReorganizer() { StopReorganizer(); }
+
+  // global singleton
+  static LayoutReorganizer &GetInstance();
+
+  // Get status of whether reorganizer thread is running or not
+  bool GetStatus() { return this->is_running_; }
+
+  void StartReorganizer(const int interval_ms = REORGANIZER_PERIOD_MILLISECONDS);
+
+  void StopReorganizer();
+
+  // Do a single pass over all the tables, returns the number of tile groups
+  // transformed
+  oid_t Reorganize();
+
+  // Do a single pass over the given table, transforming at most
+  // max_transform_count tile groups
+  oid_t Reorganize(storage::DataTable *table, const oid_t max_transform_count);
+
+  //===--------------------------------------------------------------------===//
+  // Stats
+  //===--------------------------------------------------------------------===//
+
+  uint64_t GetPassCount() const { return pass_count_; }
+
+  uint64_t GetPartitionUpdateCount() const { return partition_update_count_; }
+
+  uint64_t GetTransformCount() const { return transform_count_; }
+
+ private:
+  void Running(const int interval_ms);
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  volatile bool is_running_;
+
+  std::unique_ptr<std::thread> reorganizer_thread_;
+
+  // table oid -> next tile group offset to look at
+  std::unordered_map<oid_t, oid_t> table_cursors_;
+
+  std::atomic<uint64_t> pass_count_;
+
+  std::atomic<uint64_t> partition_update_count_;
+
+  std::atomic<uint64_t> transform_count_;
+};
+
+}  // End brain namespace
+}  // End peloton namespace
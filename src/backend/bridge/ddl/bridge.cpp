@@ -10,13 +10,17 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <cmath>
 #include <iostream>
 #include <sys/types.h>
 #include <unistd.h>
 
 #include "backend/bridge/ddl/bridge.h"
+#include "backend/bridge/dml/tuple/tuple_transformer.h"
 #include "backend/common/logger.h"
 #include "backend/common/macros.h"
+#include "backend/storage/table_stats.h"
 
 #include "postgres.h"
 #include "c.h"
@@ -31,6 +35,7 @@
 #include "catalog/pg_class.h"
 #include "catalog/pg_database.h"
 #include "catalog/pg_namespace.h"
+#include "catalog/pg_statistic.h"
 #include "catalog/pg_type.h"
 #include "common/fe_memutils.h"
 #include "utils/rel.h"
@@ -39,7 +44,9 @@
 #include "utils/lsyscache.h"
 #include "utils/snapmgr.h"
 #include "utils/syscache.h"
+#include "parser/parse_oper.h"
 #include "parser/parse_type.h"
+#include "utils/array.h"
 
 namespace peloton {
 namespace bridge {
@@ -289,7 +296,8 @@ void Bridge::GetDatabaseList(void) {
  * @param relation_id relation id
  * @param num_tuples number of tuples
  */
-void Bridge::SetNumberOfTuples(Oid relation_id, float num_tuples) {
+void Bridge::SetNumberOfTuples(Oid relation_id, float num_tuples,
+                               double data_size) {
   PL_ASSERT(relation_id);
 
   Relation pg_class_rel;
@@ -304,7 +312,7 @@ void Bridge::SetNumberOfTuples(Oid relation_id, float num_tuples) {
   } else {
     pgclass = (Form_pg_class)GETSTRUCT(tuple);
     pgclass->reltuples = (float4)num_tuples;
-    pgclass->relpages = (int32)1;
+    pgclass->relpages = (int32)std::max(1.0, std::ceil(data_size / BLCKSZ));
 
     // update tuple
     simple_heap_update(pg_class_rel, &tuple->t_self, tuple);
@@ -318,5 +326,171 @@ void Bridge::SetNumberOfTuples(Oid relation_id, float num_tuples) {
   heap_close(pg_class_rel, RowExclusiveLock);
 }
 
+// Can the datum of a Peloton value stand for a value of the postgres type ?
+static bool IsDatumOfType(ValueType value_type, int16 type_length) {
+  switch (value_type) {
+    case VALUE_TYPE_SMALLINT:
+      return (type_length == 2);
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_REAL:
+      return (type_length == 4);
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_TIMESTAMP:
+    case VALUE_TYPE_DOUBLE:
+      return (type_length == 8);
+    case VALUE_TYPE_VARCHAR:
+    case VALUE_TYPE_DECIMAL:
+      return (type_length == -1);
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Write the stats of a column into pg_statistic, as ANALYZE does.
+ * @param relation_id relation id
+ * @param attribute_number attribute number of the column
+ * @param column_stats stats of the column
+ * @param num_tuples number of tuples
+ */
+void Bridge::SetColumnStats(Oid relation_id, int16 attribute_number,
+                            const storage::ColumnStats &column_stats,
+                            float num_tuples) {
+  PL_ASSERT(relation_id);
+
+  Oid type_id = get_atttype(relation_id, attribute_number);
+  if (type_id == InvalidOid) {
+    elog(DEBUG2, "cache lookup failed for attribute %d of relation %u",
+         attribute_number, relation_id);
+    return;
+  }
+
+  Oid lt_operator, eq_operator;
+  get_sort_group_operators(type_id, false, false, false, &lt_operator,
+                           &eq_operator, NULL, NULL);
+
+  int16 type_length;
+  bool type_by_value;
+  char type_align;
+  get_typlenbyvalalign(type_id, &type_length, &type_by_value, &type_align);
+
+  Datum values[Natts_pg_statistic];
+  bool nulls[Natts_pg_statistic];
+  bool replaces[Natts_pg_statistic];
+
+  for (int attr_itr = 0; attr_itr < Natts_pg_statistic; attr_itr++) {
+    values[attr_itr] = (Datum)0;
+    nulls[attr_itr] = false;
+    replaces[attr_itr] = true;
+  }
+
+  // Many distinct values are stored as a (negated) fraction of the rows, so
+  // that the estimate scales with the table
+  float distinct = column_stats.distinct_count;
+  if (num_tuples > 0 && distinct > 0.1 * num_tuples) {
+    distinct = -std::min(1.0f, distinct / num_tuples);
+  }
+
+  values[Anum_pg_statistic_starelid - 1] = ObjectIdGetDatum(relation_id);
+  values[Anum_pg_statistic_staattnum - 1] = Int16GetDatum(attribute_number);
+  values[Anum_pg_statistic_stainherit - 1] = BoolGetDatum(false);
+  values[Anum_pg_statistic_stanullfrac - 1] =
+      Float4GetDatum(column_stats.null_fraction);
+  values[Anum_pg_statistic_stawidth - 1] =
+      Int32GetDatum(column_stats.average_width);
+  values[Anum_pg_statistic_stadistinct - 1] = Float4GetDatum(distinct);
+
+  for (int slot_itr = 0; slot_itr < STATISTIC_NUM_SLOTS; slot_itr++) {
+    values[Anum_pg_statistic_stakind1 - 1 + slot_itr] = Int16GetDatum(0);
+    values[Anum_pg_statistic_staop1 - 1 + slot_itr] = ObjectIdGetDatum(0);
+    nulls[Anum_pg_statistic_stanumbers1 - 1 + slot_itr] = true;
+    nulls[Anum_pg_statistic_stavalues1 - 1 + slot_itr] = true;
+  }
+
+  // The values are only stored if postgres can read their datums
+  auto value_type = (column_stats.most_common_values.empty() == false)
+                        ? column_stats.most_common_values[0].GetValueType()
+                        : (column_stats.histogram_bounds.empty() == false)
+                              ? column_stats.histogram_bounds[0].GetValueType()
+                              : VALUE_TYPE_INVALID;
+  bool store_values = IsDatumOfType(value_type, type_length);
+
+  int slot_itr = 0;
+  auto &mcv_values = column_stats.most_common_values;
+  if (store_values == true && eq_operator != InvalidOid &&
+      mcv_values.empty() == false) {
+    Datum *value_datums = (Datum *)palloc(mcv_values.size() * sizeof(Datum));
+    Datum *number_datums = (Datum *)palloc(mcv_values.size() * sizeof(Datum));
+    for (size_t value_itr = 0; value_itr < mcv_values.size(); value_itr++) {
+      value_datums[value_itr] =
+          TupleTransformer::GetDatum(mcv_values[value_itr]);
+      number_datums[value_itr] =
+          Float4GetDatum(column_stats.most_common_frequencies[value_itr]);
+    }
+
+    values[Anum_pg_statistic_stakind1 - 1 + slot_itr] =
+        Int16GetDatum(STATISTIC_KIND_MCV);
+    values[Anum_pg_statistic_staop1 - 1 + slot_itr] =
+        ObjectIdGetDatum(eq_operator);
+    values[Anum_pg_statistic_stanumbers1 - 1 + slot_itr] =
+        PointerGetDatum(construct_array(number_datums, mcv_values.size(),
+                                        FLOAT4OID, sizeof(float4),
+                                        FLOAT4PASSBYVAL, 'i'));
+    nulls[Anum_pg_statistic_stanumbers1 - 1 + slot_itr] = false;
+    values[Anum_pg_statistic_stavalues1 - 1 + slot_itr] =
+        PointerGetDatum(construct_array(value_datums, mcv_values.size(),
+                                        type_id, type_length, type_by_value,
+                                        type_align));
+    nulls[Anum_pg_statistic_stavalues1 - 1 + slot_itr] = false;
+    slot_itr++;
+  }
+
+  auto &bound_values = column_stats.histogram_bounds;
+  if (store_values == true && lt_operator != InvalidOid &&
+      bound_values.empty() == false) {
+    Datum *value_datums = (Datum *)palloc(bound_values.size() * sizeof(Datum));
+    for (size_t value_itr = 0; value_itr < bound_values.size(); value_itr++) {
+      value_datums[value_itr] =
+          TupleTransformer::GetDatum(bound_values[value_itr]);
+    }
+
+    values[Anum_pg_statistic_stakind1 - 1 + slot_itr] =
+        Int16GetDatum(STATISTIC_KIND_HISTOGRAM);
+    values[Anum_pg_statistic_staop1 - 1 + slot_itr] =
+        ObjectIdGetDatum(lt_operator);
+    values[Anum_pg_statistic_stavalues1 - 1 + slot_itr] =
+        PointerGetDatum(construct_array(value_datums, bound_values.size(),
+                                        type_id, type_length, type_by_value,
+                                        type_align));
+    nulls[Anum_pg_statistic_stavalues1 - 1 + slot_itr] = false;
+    slot_itr++;
+  }
+
+  Relation pg_statistic_rel = heap_open(StatisticRelationId, RowExclusiveLock);
+  HeapTuple stats_tuple;
+
+  // Replace the stats of the column if it already has some
+  HeapTuple old_tuple = SearchSysCache3(
+      STATRELATTINH, ObjectIdGetDatum(relation_id),
+      Int16GetDatum(attribute_number), BoolGetDatum(false));
+  if (HeapTupleIsValid(old_tuple)) {
+    stats_tuple = heap_modify_tuple(old_tuple, RelationGetDescr(pg_statistic_rel),
+                                    values, nulls, replaces);
+    ReleaseSysCache(old_tuple);
+    simple_heap_update(pg_statistic_rel, &stats_tuple->t_self, stats_tuple);
+  } else {
+    stats_tuple =
+        heap_form_tuple(RelationGetDescr(pg_statistic_rel), values, nulls);
+    simple_heap_insert(pg_statistic_rel, stats_tuple);
+  }
+
+  /* keep the catalog indexes up to date */
+  CatalogUpdateIndexes(pg_statistic_rel, stats_tuple);
+
+  heap_freetuple(stats_tuple);
+  heap_close(pg_statistic_rel, RowExclusiveLock);
+}
+
 }  // namespace bridge
 }  // namespace peloton
@@ -16,6 +16,11 @@
 #include "access/htup.h"
 
 namespace peloton {
+
+namespace storage {
+struct ColumnStats;
+}
+
 namespace bridge {
 
 //===--------------------------------------------------------------------===//
@@ -53,7 +58,14 @@ class Bridge {
   // Setters
   //===--------------------------------------------------------------------===//
 
-  static void SetNumberOfTuples(Oid relation_id, float num_of_tuples);
+  // The # of pages is estimated from the size of the relation in bytes
+  static void SetNumberOfTuples(Oid relation_id, float num_of_tuples,
+                                double data_size = 0);
+
+  // Write the stats of a column into pg_statistic
+  static void SetColumnStats(Oid relation_id, int16 attribute_number,
+                             const storage::ColumnStats &column_stats,
+                             float num_of_tuples);
 };
 
 }  // namespace bridge
@@ -18,9 +18,11 @@
 #include "backend/bridge/ddl/bridge.h"
 #include "backend/catalog/manager.h"
 #include "backend/catalog/schema.h"
+#include "backend/common/exception.h"
 #include "backend/common/logger.h"
 #include "backend/common/macros.h"
 #include "backend/index/index.h"
+#include "backend/index/index_builder.h"
 #include "backend/index/index_factory.h"
 #include "backend/storage/data_table.h"
 #include "backend/storage/database.h"
@@ -29,6 +31,7 @@
 #include "postgres.h"
 #include "c.h"
 #include "nodes/parsenodes.h"
+#include "commands/defrem.h"
 
 namespace peloton {
 namespace bridge {
@@ -140,8 +143,16 @@ bool DDLIndex::CreateIndex(IndexInfo index_info) {
       key_schema, unique_keys);
   index::Index *index = index::IndexFactory::GetInstance(metadata);
 
-  // Record the built index in the table
-  data_table->AddIndex(index);
+  // Populate the index with the existing tuples and record it in the table
+  try {
+    index::IndexBuilder::BuildIndex(data_table, index,
+                                    index_info.GetFillFactor());
+  } catch (IndexException &e) {
+    LOG_ERROR("Could not create index %s on %s : %s", index_name.c_str(),
+              table_name.c_str(), e.what());
+    delete index;
+    return false;
+  }
 
   LOG_TRACE("Created index(%u)  %s on %s.", index_oid, index_name.c_str(),
            table_name.c_str());
@@ -206,6 +217,15 @@ IndexInfo *DDLIndex::ConstructIndexInfoByParsingIndexStmt(IndexStmt *Istmt) {
   IndexInfo *index_info =
       new IndexInfo(index_name, index_oid, table_name, method_type, type,
                     Istmt->unique, key_column_names);
+
+  // Storage parameters (WITH clause)
+  foreach (entry, Istmt->options) {
+    DefElem *def = static_cast<DefElem *>(lfirst(entry));
+    if (strcmp(def->defname, "fillfactor") == 0) {
+      index_info->SetFillFactor(defGetInt64(def));
+    }
+  }
+
   return index_info;
 }
 
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "backend/common/types.h"
+#include "backend/index/index_builder.h"
 
 #include "postgres.h"
 #include "c.h"
@@ -93,6 +94,10 @@ class IndexInfo {
 
   std::vector<std::string> GetKeyColumnNames() { return key_column_names; }
 
+  int GetFillFactor() { return fill_factor; }
+
+  void SetFillFactor(const int fill_factor_) { fill_factor = fill_factor_; }
+
  private:
   std::string index_name;
 
@@ -108,6 +113,9 @@ class IndexInfo {
   bool unique_keys = false;
 
   std::vector<std::string> key_column_names;
+
+  // % of the leaf slots filled when the index is built
+  int fill_factor = INDEX_BUILD_DEFAULT_FILL_FACTOR;
 };
 
 }  // namespace bridge
@@ -20,6 +20,7 @@
 #include "backend/concurrency/transaction_manager_factory.h"
 #include "backend/executor/executors.h"
 #include "backend/executor/executor_context.h"
+#include "backend/executor/executor_stats.h"
 #include "backend/storage/tuple_iterator.h"
 
 #include "access/tupdesc.h"
@@ -53,7 +54,8 @@ void CleanExecutorTree(executor::AbstractExecutor *root);
  */
 peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
                                          const std::vector<Value> &params,
-                                         TupleDesc tuple_desc) {
+                                         TupleDesc tuple_desc,
+                                         bool collect_stats) {
   peloton_status p_status;
 
   if (plan == nullptr) return p_status;
@@ -86,6 +88,10 @@ peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   std::unique_ptr<executor::AbstractExecutor> executor_tree(
       BuildExecutorTree(nullptr, plan, executor_context.get()));
 
+  if (collect_stats == true) {
+    executor_tree->EnableStats();
+  }
+
   LOG_TRACE("Initializing the executor tree");
 
   // Initialize the executor tree
@@ -134,6 +140,11 @@ peloton_status PlanExecutor::ExecutePlan(const planner::AbstractPlan *plan,
   p_status.m_processed = executor_context->num_processed;
   p_status.m_result_slots = slots;
 
+  if (collect_stats == true) {
+    p_status.m_executor_stats =
+        executor::GetExecutorStatsInfo(executor_tree.get());
+  }
+
 // final cleanup
 cleanup:
 
@@ -319,6 +330,17 @@ executor::AbstractExecutor *BuildExecutorTree(
 
   executor::AbstractExecutor *child_executor = nullptr;
 
+  // Run the whole subtree as pipelines if possible
+  if (peloton_execution_mode == EXECUTION_TYPE_PUSH &&
+      executor::PipelineExecutor::IsSupported(plan)) {
+    child_executor = new executor::PipelineExecutor(plan, executor_context);
+    if (root != nullptr)
+      root->AddChild(child_executor);
+    else
+      root = child_executor;
+    return root;
+  }
+
   auto plan_node_type = plan->GetPlanNodeType();
   switch (plan_node_type) {
     case PLAN_NODE_TYPE_INVALID:
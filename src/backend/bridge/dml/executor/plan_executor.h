@@ -48,10 +48,13 @@ class PlanExecutor {
    * @brief Use std::vector<Value> as params to make it more elegant for networking
    *        Before ExecutePlan, a node first receives value list, so we should pass
    *        value list directly rather than passing Postgres's ParamListInfo
+   *        If collect_stats is set, the runtime statistics of the executors
+   *        are returned in the status (EXPLAIN ANALYZE)
    */
   static peloton_status ExecutePlan(const planner::AbstractPlan *plan,
                                     const std::vector<Value> &params,
-                                    TupleDesc m_tuple_desc);
+                                    TupleDesc m_tuple_desc,
+                                    bool collect_stats = false);
 
   /*
    * @brief When a peloton node recvs a query plan, this function is invoked
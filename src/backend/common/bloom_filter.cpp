@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bloom_filter.cpp
+//
+// Identification: src/backend/common/bloom_filter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+
+#include "backend/common/bloom_filter.h"
+
+namespace peloton {
+
+// Odd constants deriving the bit of each word from the same hash
+static const uint32_t bloom_filter_salts[BLOOM_FILTER_BLOCK_WORD_COUNT] = {
+    0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU,
+    0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+BloomFilter::BloomFilter(const size_t key_count, const size_t bits_per_key) {
+  const size_t block_bits = BLOOM_FILTER_BLOCK_WORD_COUNT * 64;
+  block_count_ =
+      std::max<size_t>(1, (key_count * bits_per_key + block_bits - 1) /
+                              block_bits);
+  words_.resize(block_count_ * BLOOM_FILTER_BLOCK_WORD_COUNT, 0);
+}
+
+uint64_t BloomFilter::Mix(uint64_t hash) {
+  // 64-bit MurmurHash3 finalizer
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+  return hash;
+}
+
+size_t BloomFilter::GetBlockOffset(const uint64_t hash) const {
+  // The high bits pick the block, without a division
+  size_t block_itr = ((hash >> 32) * block_count_) >> 32;
+  return block_itr * BLOOM_FILTER_BLOCK_WORD_COUNT;
+}
+
+void BloomFilter::Insert(const uint64_t hash) {
+  uint64_t mixed_hash = Mix(hash);
+  size_t block_offset = GetBlockOffset(mixed_hash);
+  uint32_t key = static_cast<uint32_t>(mixed_hash);
+
+  for (size_t word_itr = 0; word_itr < BLOOM_FILTER_BLOCK_WORD_COUNT;
+       word_itr++) {
+    uint32_t bit = (key * bloom_filter_salts[word_itr]) >> 26;
+    words_[block_offset + word_itr] |= (1ULL << bit);
+  }
+}
+
+bool BloomFilter::MayContain(const uint64_t hash) const {
+  uint64_t mixed_hash = Mix(hash);
+  size_t block_offset = GetBlockOffset(mixed_hash);
+  uint32_t key = static_cast<uint32_t>(mixed_hash);
+
+  for (size_t word_itr = 0; word_itr < BLOOM_FILTER_BLOCK_WORD_COUNT;
+       word_itr++) {
+    uint32_t bit = (key * bloom_filter_salts[word_itr]) >> 26;
+    if ((words_[block_offset + word_itr] & (1ULL << bit)) == 0) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // End peloton namespace
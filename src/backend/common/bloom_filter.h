@@ -0,0 +1,62 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// bloom_filter.h
+//
+// Identification: src/backend/common/bloom_filter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace peloton {
+
+// Bits set per key, one in each word of a block
+#define BLOOM_FILTER_BLOCK_WORD_COUNT 8
+
+// With 8 bits set per key, about 2% of the absent keys pass
+#define BLOOM_FILTER_DEFAULT_BITS_PER_KEY 10
+
+//===--------------------------------------------------------------------===//
+// Bloom Filter
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Blocked Bloom filter over 64-bit hashes (split block Bloom filter,
+ * as in Impala and Parquet).
+ *
+ * A key only touches one block of 512 bits, i.e. one cache line, and sets
+ * one bit in each of its 8 words. A lookup is a single cache miss at most.
+ */
+class BloomFilter {
+ public:
+  BloomFilter(const size_t key_count,
+              const size_t bits_per_key = BLOOM_FILTER_DEFAULT_BITS_PER_KEY);
+
+  void Insert(const uint64_t hash);
+
+  // False if the hash was never inserted, true if it probably was
+  bool MayContain(const uint64_t hash) const;
+
+  // Size of the filter in bytes
+  size_t GetSize() const { return words_.size() * sizeof(uint64_t); }
+
+ private:
+  // The hashes of values are not well mixed, finish them before use
+  static uint64_t Mix(uint64_t hash);
+
+  size_t GetBlockOffset(const uint64_t hash) const;
+
+  size_t block_count_;
+
+  std::vector<uint64_t> words_;
+};
+
+}  // End peloton namespace
@@ -0,0 +1,86 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.cpp
+//
+// Identification: src/backend/common/hyperloglog.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <cmath>
+
+#include "backend/common/hyperloglog.h"
+#include "backend/common/macros.h"
+#include "backend/common/value.h"
+
+namespace peloton {
+
+HyperLogLog::HyperLogLog(const uint32_t precision)
+    : precision_(precision), registers_(1UL << precision, 0) {
+  PL_ASSERT(precision >= 4 && precision <= 18);
+}
+
+void HyperLogLog::Add(const Value &value) {
+  std::size_t seed = 0;
+  value.HashCombine(seed);
+
+  // The value hashes are not well mixed (integers hash to themselves), so
+  // finish them with the 64-bit MurmurHash3 finalizer
+  uint64_t hash = seed;
+  hash ^= hash >> 33;
+  hash *= 0xff51afd7ed558ccdULL;
+  hash ^= hash >> 33;
+  hash *= 0xc4ceb9fe1a85ec53ULL;
+  hash ^= hash >> 33;
+
+  AddHash(hash);
+}
+
+void HyperLogLog::AddHash(uint64_t hash) {
+  size_t register_index = hash >> (64 - precision_);
+
+  // Position of the first 1 bit in the remaining bits
+  uint64_t remaining = (hash << precision_) | (1ULL << (precision_ - 1));
+  uint8_t rank = __builtin_clzll(remaining) + 1;
+
+  if (rank > registers_[register_index]) {
+    registers_[register_index] = rank;
+  }
+}
+
+void HyperLogLog::Merge(const HyperLogLog &other) {
+  PL_ASSERT(precision_ == other.precision_);
+
+  for (size_t register_itr = 0; register_itr < registers_.size();
+       register_itr++) {
+    if (other.registers_[register_itr] > registers_[register_itr]) {
+      registers_[register_itr] = other.registers_[register_itr];
+    }
+  }
+}
+
+double HyperLogLog::Estimate() const {
+  const double register_count = registers_.size();
+  const double alpha = 0.7213 / (1.0 + 1.079 / register_count);
+
+  double sum = 0;
+  size_t zero_count = 0;
+  for (auto reg : registers_) {
+    sum += std::ldexp(1.0, -reg);
+    if (reg == 0) zero_count++;
+  }
+
+  double estimate = alpha * register_count * register_count / sum;
+
+  // Small range correction : linear counting of the empty registers
+  if (estimate <= 2.5 * register_count && zero_count > 0) {
+    estimate = register_count * std::log(register_count / zero_count);
+  }
+
+  return estimate;
+}
+
+}  // End peloton namespace
@@ -0,0 +1,55 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// hyperloglog.h
+//
+// Identification: src/backend/common/hyperloglog.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace peloton {
+
+class Value;
+
+//===--------------------------------------------------------------------===//
+// HyperLogLog
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Estimates the number of distinct values in a stream (Flajolet et
+ * al., with the small range correction).
+ *
+ * Each value is hashed to 64 bits. The first precision bits pick one of
+ * 2^precision registers, which keeps the longest run of leading zeros seen
+ * in the other bits. With the default precision of 12, the 4 KB of registers
+ * give a standard error of about 1.6%.
+ */
+class HyperLogLog {
+ public:
+  HyperLogLog(const uint32_t precision = 12);
+
+  void Add(const Value &value);
+
+  // Add an already hashed value
+  void AddHash(uint64_t hash);
+
+  // Add the values of another estimator with the same precision
+  void Merge(const HyperLogLog &other);
+
+  double Estimate() const;
+
+ private:
+  uint32_t precision_;
+
+  std::vector<uint8_t> registers_;
+};
+
+}  // End peloton namespace
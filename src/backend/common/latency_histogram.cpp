@@ -0,0 +1,117 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.cpp
+//
+// Identification: src/backend/common/latency_histogram.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+#include "backend/common/latency_histogram.h"
+
+namespace peloton {
+
+// Number of linear buckets in each power of two range
+static const uint64_t sub_bucket_count = 1ULL
+                                         << LatencyHistogram::precision_bits;
+
+// Exact buckets for the small values, then one bucket range for each of the
+// remaining powers of two
+static const size_t bucket_count =
+    (64 - LatencyHistogram::precision_bits + 1) * sub_bucket_count;
+
+LatencyHistogram::LatencyHistogram() : counts_(bucket_count, 0) { Reset(); }
+
+size_t LatencyHistogram::GetBucketIndex(uint64_t value) {
+  if (value < sub_bucket_count) return value;
+
+  // Position of the highest set bit decides the bucket range, the following
+  // precision_bits bits decide the bucket within the range
+  uint32_t magnitude = 63 - __builtin_clzll(value);
+  uint32_t shift = magnitude - precision_bits;
+  uint64_t sub_bucket = (value >> shift) - sub_bucket_count;
+
+  return (shift + 1) * sub_bucket_count + sub_bucket;
+}
+
+uint64_t LatencyHistogram::GetBucketValue(size_t bucket_index) {
+  if (bucket_index < sub_bucket_count) return bucket_index;
+
+  uint32_t shift = bucket_index / sub_bucket_count - 1;
+  uint64_t sub_bucket = bucket_index % sub_bucket_count + sub_bucket_count;
+
+  // Wraps around to the max value for the last bucket
+  return ((sub_bucket + 1) << shift) - 1;
+}
+
+void LatencyHistogram::Record(uint64_t value) {
+  counts_[GetBucketIndex(value)]++;
+  count_++;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+  sum_ += value;
+}
+
+void LatencyHistogram::Merge(const LatencyHistogram &other) {
+  for (size_t bucket_itr = 0; bucket_itr < bucket_count; bucket_itr++) {
+    counts_[bucket_itr] += other.counts_[bucket_itr];
+  }
+
+  count_ += other.count_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+  sum_ += other.sum_;
+}
+
+void LatencyHistogram::Reset() {
+  std::fill(counts_.begin(), counts_.end(), 0);
+  count_ = 0;
+  min_ = std::numeric_limits<uint64_t>::max();
+  max_ = 0;
+  sum_ = 0;
+}
+
+double LatencyHistogram::GetMean() const {
+  if (count_ == 0) return 0;
+  return sum_ / count_;
+}
+
+uint64_t LatencyHistogram::GetPercentile(double percentile) const {
+  if (count_ == 0) return 0;
+
+  percentile = std::min(std::max(percentile, 0.0), 100.0);
+  uint64_t rank = std::ceil(percentile / 100 * count_);
+  if (rank == 0) rank = 1;
+
+  uint64_t seen = 0;
+  for (size_t bucket_itr = 0; bucket_itr < bucket_count; bucket_itr++) {
+    seen += counts_[bucket_itr];
+    if (seen >= rank) {
+      auto value = GetBucketValue(bucket_itr);
+      return std::max(std::min(value, max_), min_);
+    }
+  }
+
+  return max_;
+}
+
+const std::string LatencyHistogram::GetInfo() const {
+  std::ostringstream os;
+
+  os << "count: " << GetCount() << " mean: " << GetMean()
+     << " min: " << GetMin() << " p50: " << GetPercentile(50)
+     << " p90: " << GetPercentile(90) << " p99: " << GetPercentile(99)
+     << " p99.9: " << GetPercentile(99.9) << " max: " << GetMax();
+
+  return os.str();
+}
+
+}  // End peloton namespace
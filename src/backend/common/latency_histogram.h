@@ -0,0 +1,84 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram.h
+//
+// Identification: src/backend/common/latency_histogram.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "backend/common/printable.h"
+
+namespace peloton {
+
+//===--------------------------------------------------------------------===//
+// Latency Histogram
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Log-linear histogram of non-negative integer samples (HDR style).
+ *
+ * Samples below 2^precision_bits are counted exactly. Above that, each power
+ * of two range is split into 2^precision_bits linear buckets, so a recorded
+ * value is reported with a relative error of at most 2^-precision_bits
+ * (about 3%) while the whole 64-bit range fits in a couple of thousand
+ * counters.
+ *
+ * Recording is not synchronized : every thread records into its own
+ * histogram and the histograms are merged once the run is over.
+ */
+class LatencyHistogram : public Printable {
+ public:
+  LatencyHistogram();
+
+  // Record a single sample
+  void Record(uint64_t value);
+
+  // Add the samples of another histogram to this one
+  void Merge(const LatencyHistogram &other);
+
+  void Reset();
+
+  uint64_t GetCount() const { return count_; }
+
+  uint64_t GetMin() const { return count_ == 0 ? 0 : min_; }
+
+  uint64_t GetMax() const { return max_; }
+
+  double GetMean() const;
+
+  // Smallest recorded value such that the given percentage (0-100) of the
+  // samples are lower or equivalent to it
+  uint64_t GetPercentile(double percentile) const;
+
+  // Get a string representation for debugging
+  const std::string GetInfo() const;
+
+  static const uint32_t precision_bits = 5;
+
+ private:
+  static size_t GetBucketIndex(uint64_t value);
+
+  // Highest value that falls in the bucket
+  static uint64_t GetBucketValue(size_t bucket_index);
+
+  std::vector<uint64_t> counts_;
+
+  uint64_t count_;
+
+  uint64_t min_;
+
+  uint64_t max_;
+
+  double sum_;
+};
+
+}  // End peloton namespace
@@ -0,0 +1,312 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metrics.cpp
+//
+// Identification: src/backend/common/metrics.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+
+#include "backend/common/metrics.h"
+#include "backend/common/exception.h"
+#include "backend/common/logger.h"
+
+namespace peloton {
+
+thread_local ThreadMetrics *current_thread_metrics = nullptr;
+
+ThreadMetrics::ThreadMetrics() {
+  for (auto &counter : counters) {
+    counter.store(0, std::memory_order_relaxed);
+  }
+}
+
+// Hands the metrics of the thread back to the registry when the thread exits
+struct ThreadMetricsHolder {
+  ~ThreadMetricsHolder() {
+    if (thread_metrics != nullptr) {
+      MetricsRegistry::GetInstance().UnregisterThread(thread_metrics);
+      current_thread_metrics = nullptr;
+    }
+  }
+
+  ThreadMetrics *thread_metrics = nullptr;
+};
+
+static thread_local ThreadMetricsHolder thread_metrics_holder;
+
+MetricsRegistry::MetricsRegistry() {
+  std::fill(retired_counters_, retired_counters_ + MAX_METRIC_COUNTER_COUNT, 0);
+  std::fill(reset_counters_, reset_counters_ + MAX_METRIC_COUNTER_COUNT, 0);
+
+  for (auto &gauge : gauges_) {
+    gauge.store(0, std::memory_order_relaxed);
+  }
+}
+
+MetricsRegistry &MetricsRegistry::GetInstance() {
+  // Never destroyed, threads may still update metrics while the process exits
+  static MetricsRegistry *registry = new MetricsRegistry();
+  return *registry;
+}
+
+//===--------------------------------------------------------------------===//
+// Registration
+//===--------------------------------------------------------------------===//
+
+static oid_t RegisterMetric(std::unordered_map<std::string, oid_t> &ids,
+                            std::vector<std::string> &names,
+                            const std::string &name, const size_t max_count) {
+  auto itr = ids.find(name);
+  if (itr != ids.end()) return itr->second;
+
+  if (names.size() == max_count) {
+    throw Exception("Too many metrics registered : " + name);
+  }
+
+  oid_t id = names.size();
+  ids[name] = id;
+  names.push_back(name);
+
+  return id;
+}
+
+oid_t MetricsRegistry::RegisterCounter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  return RegisterMetric(counter_ids_, counter_names_, name,
+                        MAX_METRIC_COUNTER_COUNT);
+}
+
+oid_t MetricsRegistry::RegisterHistogram(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  auto histogram_id = RegisterMetric(histogram_ids_, histogram_names_, name,
+                                     MAX_METRIC_HISTOGRAM_COUNT);
+  if (retired_histograms_.size() < histogram_names_.size()) {
+    retired_histograms_.resize(histogram_names_.size());
+  }
+
+  return histogram_id;
+}
+
+oid_t MetricsRegistry::RegisterGauge(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  return RegisterMetric(gauge_ids_, gauge_names_, name, MAX_METRIC_GAUGE_COUNT);
+}
+
+void MetricsRegistry::RegisterThread() {
+  auto thread_metrics = new ThreadMetrics();
+
+  {
+    std::lock_guard<std::mutex> lock(registry_mutex_);
+    threads_.push_back(thread_metrics);
+  }
+
+  thread_metrics_holder.thread_metrics = thread_metrics;
+  current_thread_metrics = thread_metrics;
+}
+
+void MetricsRegistry::UnregisterThread(ThreadMetrics *thread_metrics) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  for (oid_t counter_id = 0; counter_id < counter_names_.size();
+       counter_id++) {
+    retired_counters_[counter_id] +=
+        thread_metrics->counters[counter_id].load(std::memory_order_relaxed);
+  }
+
+  for (oid_t histogram_id = 0; histogram_id < histogram_names_.size();
+       histogram_id++) {
+    auto &histogram = thread_metrics->histograms[histogram_id];
+    if (histogram != nullptr) {
+      retired_histograms_[histogram_id].Merge(*histogram);
+    }
+  }
+
+  threads_.erase(std::remove(threads_.begin(), threads_.end(), thread_metrics),
+                 threads_.end());
+  delete thread_metrics;
+}
+
+//===--------------------------------------------------------------------===//
+// Updates
+//===--------------------------------------------------------------------===//
+
+void MetricsRegistry::Record(const oid_t histogram_id, const uint64_t value) {
+  if (current_thread_metrics == nullptr) RegisterThread();
+
+  auto thread_metrics = current_thread_metrics;
+  thread_metrics->histogram_lock.Lock();
+
+  auto &histogram = thread_metrics->histograms[histogram_id];
+  if (histogram == nullptr) {
+    histogram.reset(new LatencyHistogram());
+  }
+  histogram->Record(value);
+
+  thread_metrics->histogram_lock.Unlock();
+}
+
+//===--------------------------------------------------------------------===//
+// Reads
+//===--------------------------------------------------------------------===//
+
+// Must be called with the registry mutex held
+uint64_t MetricsRegistry::GetCounterTotal(const oid_t counter_id) {
+  uint64_t total = retired_counters_[counter_id];
+
+  for (auto thread_metrics : threads_) {
+    total += thread_metrics->counters[counter_id].load(std::memory_order_relaxed);
+  }
+
+  return total;
+}
+
+// Must be called with the registry mutex held
+LatencyHistogram MetricsRegistry::GetHistogramTotal(const oid_t histogram_id) {
+  LatencyHistogram total;
+  total.Merge(retired_histograms_[histogram_id]);
+
+  for (auto thread_metrics : threads_) {
+    thread_metrics->histogram_lock.Lock();
+    auto &histogram = thread_metrics->histograms[histogram_id];
+    if (histogram != nullptr) {
+      total.Merge(*histogram);
+    }
+    thread_metrics->histogram_lock.Unlock();
+  }
+
+  return total;
+}
+
+uint64_t MetricsRegistry::GetCounter(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  auto itr = counter_ids_.find(name);
+  if (itr == counter_ids_.end()) return 0;
+
+  return GetCounterTotal(itr->second) - reset_counters_[itr->second];
+}
+
+LatencyHistogram MetricsRegistry::GetHistogram(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  auto itr = histogram_ids_.find(name);
+  if (itr == histogram_ids_.end()) return LatencyHistogram();
+
+  return GetHistogramTotal(itr->second);
+}
+
+int64_t MetricsRegistry::GetGauge(const std::string &name) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  auto itr = gauge_ids_.find(name);
+  if (itr == gauge_ids_.end()) return 0;
+
+  return gauges_[itr->second].load(std::memory_order_relaxed);
+}
+
+void MetricsRegistry::Reset() {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  // The counters are only written by their threads, so remember where they
+  // are instead of clearing them
+  for (oid_t counter_id = 0; counter_id < counter_names_.size();
+       counter_id++) {
+    reset_counters_[counter_id] = GetCounterTotal(counter_id);
+  }
+
+  for (auto &histogram : retired_histograms_) {
+    histogram.Reset();
+  }
+
+  for (auto thread_metrics : threads_) {
+    thread_metrics->histogram_lock.Lock();
+    for (auto &histogram : thread_metrics->histograms) {
+      if (histogram != nullptr) histogram->Reset();
+    }
+    thread_metrics->histogram_lock.Unlock();
+  }
+}
+
+void MetricsRegistry::Dump(std::ostream &out) {
+  std::lock_guard<std::mutex> lock(registry_mutex_);
+
+  for (oid_t counter_id = 0; counter_id < counter_names_.size();
+       counter_id++) {
+    out << "counter " << counter_names_[counter_id] << " "
+        << GetCounterTotal(counter_id) - reset_counters_[counter_id] << "\n";
+  }
+
+  for (oid_t gauge_id = 0; gauge_id < gauge_names_.size(); gauge_id++) {
+    out << "gauge " << gauge_names_[gauge_id] << " "
+        << gauges_[gauge_id].load(std::memory_order_relaxed) << "\n";
+  }
+
+  for (oid_t histogram_id = 0; histogram_id < histogram_names_.size();
+       histogram_id++) {
+    out << "histogram " << histogram_names_[histogram_id] << " "
+        << GetHistogramTotal(histogram_id).GetInfo() << "\n";
+  }
+
+  out.flush();
+}
+
+//===--------------------------------------------------------------------===//
+// Stats file
+//===--------------------------------------------------------------------===//
+
+void MetricsRegistry::StartReporter(const std::string &file_name,
+                                    const int interval_ms) {
+  std::lock_guard<std::mutex> lock(reporter_mutex_);
+  if (reporter_running_ == true) return;
+
+  reporter_running_ = true;
+  reporter_thread_ = std::thread(&MetricsRegistry::RunReporter, this,
+                                 file_name, interval_ms);
+
+  LOG_INFO("Writing metrics to %s every %d ms", file_name.c_str(),
+           interval_ms);
+}
+
+void MetricsRegistry::StopReporter() {
+  {
+    std::lock_guard<std::mutex> lock(reporter_mutex_);
+    if (reporter_running_ == false) return;
+
+    reporter_running_ = false;
+  }
+
+  reporter_cv_.notify_all();
+  reporter_thread_.join();
+}
+
+void MetricsRegistry::RunReporter(const std::string file_name,
+                                  const int interval_ms) {
+  std::unique_lock<std::mutex> lock(reporter_mutex_);
+
+  while (reporter_running_ == true) {
+    reporter_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms),
+                          [this] { return reporter_running_ == false; });
+
+    // Readers always see a complete snapshot of the metrics
+    std::ofstream out(file_name, std::ofstream::trunc);
+    if (out.is_open() == false) {
+      LOG_ERROR("Could not open metrics file %s", file_name.c_str());
+      continue;
+    }
+
+    Dump(out);
+  }
+}
+
+}  // End peloton namespace
@@ -0,0 +1,206 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metrics.h
+//
+// Identification: src/backend/common/metrics.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "backend/common/latency_histogram.h"
+#include "backend/common/platform.h"
+#include "backend/common/types.h"
+
+namespace peloton {
+
+// Max # of metrics of each kind that can be registered
+#define MAX_METRIC_COUNTER_COUNT 256
+#define MAX_METRIC_HISTOGRAM_COUNT 32
+#define MAX_METRIC_GAUGE_COUNT 32
+
+//===--------------------------------------------------------------------===//
+// Thread Metrics
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Metrics updated by a single thread.
+ *
+ * The counters are only written by their thread, with relaxed loads and
+ * stores, and are padded so that they never share a cache line with the
+ * counters of another thread. The histograms are guarded by a spinlock that
+ * is only contended while the metrics are read.
+ */
+struct ThreadMetrics {
+  ThreadMetrics();
+
+  char padding_before[CACHELINE_SIZE];
+
+  std::atomic<uint64_t> counters[MAX_METRIC_COUNTER_COUNT];
+
+  char padding_after[CACHELINE_SIZE];
+
+  Spinlock histogram_lock;
+
+  // Allocated on the first sample
+  std::unique_ptr<LatencyHistogram> histograms[MAX_METRIC_HISTOGRAM_COUNT];
+};
+
+// Metrics of the current thread, nullptr until it updates a metric
+extern thread_local ThreadMetrics *current_thread_metrics;
+
+//===--------------------------------------------------------------------===//
+// Metrics Registry
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Global registry of named counters, histograms and gauges.
+ *
+ * Metrics are registered once by name, usually into a function-local static,
+ * and then updated through their id. Counters and histograms are kept per
+ * thread and only aggregated when they are read, so updating them on a hot
+ * path costs a thread-local access and a couple of instructions. The metrics
+ * of the threads that exit are folded into the registry.
+ *
+ * The registry can dump the metrics periodically into a stats file, so that
+ * a running server can be observed without tracing.
+ */
+class MetricsRegistry {
+ public:
+  MetricsRegistry(const MetricsRegistry &) = delete;
+  MetricsRegistry &operator=(const MetricsRegistry &) = delete;
+  MetricsRegistry(MetricsRegistry &&) = delete;
+  MetricsRegistry &operator=(MetricsRegistry &&) = delete;
+
+  static MetricsRegistry &GetInstance();
+
+  //===--------------------------------------------------------------------===//
+  // Registration
+  //===--------------------------------------------------------------------===//
+
+  // Get the id of the metric with the given name, registering it if needed
+  oid_t RegisterCounter(const std::string &name);
+
+  oid_t RegisterHistogram(const std::string &name);
+
+  oid_t RegisterGauge(const std::string &name);
+
+  //===--------------------------------------------------------------------===//
+  // Updates
+  //===--------------------------------------------------------------------===//
+
+  inline void Increment(const oid_t counter_id, const uint64_t delta = 1) {
+    if (current_thread_metrics == nullptr) RegisterThread();
+
+    // Only this thread writes the counter, no need for an atomic add
+    auto &counter = current_thread_metrics->counters[counter_id];
+    counter.store(counter.load(std::memory_order_relaxed) + delta,
+                  std::memory_order_relaxed);
+  }
+
+  // Add a sample (e.g. a latency in us) to a histogram
+  void Record(const oid_t histogram_id, const uint64_t value);
+
+  // Gauges hold the last value set by any thread (e.g. a queue length)
+  void SetGauge(const oid_t gauge_id, const int64_t value) {
+    gauges_[gauge_id].store(value, std::memory_order_relaxed);
+  }
+
+  //===--------------------------------------------------------------------===//
+  // Reads
+  //===--------------------------------------------------------------------===//
+
+  // Sum over all the threads since the last reset (0 if not registered)
+  uint64_t GetCounter(const std::string &name);
+
+  LatencyHistogram GetHistogram(const std::string &name);
+
+  int64_t GetGauge(const std::string &name);
+
+  // Restart the counters and histograms from zero
+  void Reset();
+
+  // Write one line per registered metric
+  void Dump(std::ostream &out);
+
+  //===--------------------------------------------------------------------===//
+  // Stats file
+  //===--------------------------------------------------------------------===//
+
+  // Rewrite the file with the current metrics every interval
+  void StartReporter(const std::string &file_name, const int interval_ms);
+
+  void StopReporter();
+
+ private:
+  MetricsRegistry();
+
+  void RegisterThread();
+
+  // Fold the metrics of an exiting thread into the registry
+  void UnregisterThread(ThreadMetrics *thread_metrics);
+
+  uint64_t GetCounterTotal(const oid_t counter_id);
+
+  LatencyHistogram GetHistogramTotal(const oid_t histogram_id);
+
+  void RunReporter(const std::string file_name, const int interval_ms);
+
+  friend struct ThreadMetricsHolder;
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  // Guards the registration of metrics and threads
+  std::mutex registry_mutex_;
+
+  std::unordered_map<std::string, oid_t> counter_ids_;
+
+  std::unordered_map<std::string, oid_t> histogram_ids_;
+
+  std::unordered_map<std::string, oid_t> gauge_ids_;
+
+  std::vector<std::string> counter_names_;
+
+  std::vector<std::string> histogram_names_;
+
+  std::vector<std::string> gauge_names_;
+
+  std::vector<ThreadMetrics *> threads_;
+
+  // Metrics of the threads that exited
+  uint64_t retired_counters_[MAX_METRIC_COUNTER_COUNT];
+
+  std::vector<LatencyHistogram> retired_histograms_;
+
+  // Counter values at the last reset
+  uint64_t reset_counters_[MAX_METRIC_COUNTER_COUNT];
+
+  std::atomic<int64_t> gauges_[MAX_METRIC_GAUGE_COUNT];
+
+  // Stats file reporter
+  std::thread reporter_thread_;
+
+  std::mutex reporter_mutex_;
+
+  std::condition_variable reporter_cv_;
+
+  bool reporter_running_ = false;
+};
+
+}  // End peloton namespace
@@ -198,6 +198,21 @@ BackendType StringToBackendType(std::string str) {
   return BACKEND_TYPE_INVALID;
 }
 
+std::string CompressionTypeToString(CompressionType type) {
+  switch (type) {
+    case COMPRESSION_TYPE_NONE:
+      return "NONE";
+    case COMPRESSION_TYPE_DICTIONARY:
+      return "DICTIONARY";
+    case COMPRESSION_TYPE_FOR:
+      return "FOR";
+    case COMPRESSION_TYPE_RLE:
+      return "RLE";
+    default: { return "UNKNOWN " + std::to_string(type); }
+  }
+  return "INVALID";
+}
+
 //===--------------------------------------------------------------------===//
 // Value <--> String Utilities
 //===--------------------------------------------------------------------===//
@@ -1048,6 +1063,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_TUPLE_UPDATE: {
       return "LOGRECORD_TYPE_TUPLE_UPDATE";
     }
+    case LOGRECORD_TYPE_TILE_GROUP_INSERT: {
+      return "LOGRECORD_TYPE_TILE_GROUP_INSERT";
+    }
     case LOGRECORD_TYPE_WAL_TUPLE_INSERT: {
       return "LOGRECORD_TYPE_WAL_TUPLE_INSERT";
     }
@@ -1057,6 +1075,9 @@ std::string LogRecordTypeToString(LogRecordType type) {
     case LOGRECORD_TYPE_WAL_TUPLE_UPDATE: {
       return "LOGRECORD_TYPE_WAL_TUPLE_UPDATE";
     }
+    case LOGRECORD_TYPE_WAL_TILE_GROUP_INSERT: {
+      return "LOGRECORD_TYPE_WAL_TILE_GROUP_INSERT";
+    }
     case LOGRECORD_TYPE_WBL_TUPLE_INSERT: {
       return "LOGRECORD_TYPE_WBL_TUPLE_INSERT";
     }
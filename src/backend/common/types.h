@@ -62,6 +62,12 @@ enum GCType {
   GC_TYPE_ON = 1
 };
 
+// Executor model
+enum ExecutionType {
+  EXECUTION_TYPE_PULL = 0,  // tile-at-a-time iterators
+  EXECUTION_TYPE_PUSH = 1   // pipelines (see executor::PipelineExecutor)
+};
+
 //===--------------------------------------------------------------------===//
 // Filesystem directories
 //===--------------------------------------------------------------------===//
@@ -391,6 +397,30 @@ enum IsolationLevelType {
   ISOLATION_LEVEL_TYPE_REPEATABLE_READ = 2  // repeatable read
 };
 
+enum TimestampType {
+  TIMESTAMP_TYPE_INVALID = 0,
+  TIMESTAMP_TYPE_CENTRALIZED = 1,   // shared txn id and commit id counters
+  TIMESTAMP_TYPE_DECENTRALIZED = 2  // per-thread txn id ranges, clock cids
+};
+
+enum EpochType {
+  EPOCH_TYPE_INVALID = 0,
+  EPOCH_TYPE_QUEUE = 1,  // shared ring of epochs
+  EPOCH_TYPE_SLOT = 2    // per-thread slots scanned by the epoch thread
+};
+
+enum LockWaitType {
+  LOCK_WAIT_TYPE_INVALID = 0,
+  LOCK_WAIT_TYPE_NO_WAIT = 1,  // abort on any lock conflict
+  LOCK_WAIT_TYPE_WAIT_DIE = 2  // older txns wait for younger ones
+};
+
+enum HeaderLayoutType {
+  HEADER_LAYOUT_TYPE_INVALID = 0,
+  HEADER_LAYOUT_TYPE_ROW = 1,    // one record per tuple slot
+  HEADER_LAYOUT_TYPE_COLUMN = 2  // txn id and begin/end cid in own arrays
+};
+
 enum BackendType {
   BACKEND_TYPE_INVALID = 0,  // invalid backend type
 
@@ -400,6 +430,17 @@ enum BackendType {
   BACKEND_TYPE_HDD = 4   // on hdd
 };
 
+//===--------------------------------------------------------------------===//
+// Compression Types
+//===--------------------------------------------------------------------===//
+
+enum CompressionType {
+  COMPRESSION_TYPE_NONE = 0,        // uncompressed values
+  COMPRESSION_TYPE_DICTIONARY = 1,  // dictionary codes, bit-packed
+  COMPRESSION_TYPE_FOR = 2,         // frame of reference, bit-packed
+  COMPRESSION_TYPE_RLE = 3          // run-length encoding
+};
+
 //===--------------------------------------------------------------------===//
 // Index Types
 //===--------------------------------------------------------------------===//
@@ -696,11 +737,13 @@ enum LogRecordType {
   LOGRECORD_TYPE_TUPLE_INSERT = 11,
   LOGRECORD_TYPE_TUPLE_DELETE = 12,
   LOGRECORD_TYPE_TUPLE_UPDATE = 13,
+  LOGRECORD_TYPE_TILE_GROUP_INSERT = 14,
 
   // DML records for Write ahead logging
   LOGRECORD_TYPE_WAL_TUPLE_INSERT = 21,
   LOGRECORD_TYPE_WAL_TUPLE_DELETE = 22,
   LOGRECORD_TYPE_WAL_TUPLE_UPDATE = 23,
+  LOGRECORD_TYPE_WAL_TILE_GROUP_INSERT = 24,
 
   // DML records for Write behind logging
   LOGRECORD_TYPE_WBL_TUPLE_INSERT = 31,
@@ -881,6 +924,8 @@ void AtomicUpdateItemPointer(ItemPointer *src_ptr, const ItemPointer &value);
 std::string BackendTypeToString(BackendType type);
 BackendType StringToBackendType(std::string str);
 
+std::string CompressionTypeToString(CompressionType type);
+
 std::string ValueTypeToString(ValueType type);
 ValueType StringToValueType(std::string str);
 
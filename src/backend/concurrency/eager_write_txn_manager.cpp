@@ -383,7 +383,7 @@ void EagerWriteTxnManager::PerformDelete(const ItemPointer &location) {
   }
 }
 
-Result EagerWriteTxnManager::CommitTransaction() {
+Result EagerWriteTxnManager::DCommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
   auto &manager = catalog::Manager::GetInstance();
@@ -434,6 +434,8 @@ Result EagerWriteTxnManager::CommitTransaction() {
     oid_t tile_group_id = tile_group_entry.first;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
+    // the inserts into the tile group are logged together
+    std::vector<oid_t> insert_slots;
     for (auto &tuple_entry : tile_group_entry.second) {
       auto tuple_slot = tuple_entry.first;
       if (tuple_entry.second == RW_TYPE_UPDATE) {
@@ -492,8 +494,7 @@ Result EagerWriteTxnManager::CommitTransaction() {
 
       } else if (tuple_entry.second == RW_TYPE_INSERT) {
         // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
+        insert_slots.push_back(tuple_slot);
 
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
         tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
@@ -512,6 +513,9 @@ Result EagerWriteTxnManager::CommitTransaction() {
         tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
       }
     }
+    if (insert_slots.empty() == false) {
+      log_manager.LogInserts(end_commit_id, tile_group_id, insert_slots);
+    }
   }
   log_manager.LogCommitTransaction(end_commit_id);
 
@@ -520,7 +524,7 @@ Result EagerWriteTxnManager::CommitTransaction() {
   return Result::RESULT_SUCCESS;
 }
 
-Result EagerWriteTxnManager::AbortTransaction() {
+Result EagerWriteTxnManager::DAbortTransaction() {
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
   auto &manager = catalog::Manager::GetInstance();
 
@@ -11,12 +11,130 @@
 //===----------------------------------------------------------------------===//
 
 
+#include <algorithm>
+
 #include "epoch_manager.h"
+#include "backend/common/exception.h"
+#include "backend/concurrency/transaction_manager_factory.h"
 
 namespace peloton {
 namespace concurrency {
 
 //  volatile cid_t EpochManager::curr_epoch_ = 1;
 
+namespace {
+
+// Slot held by the thread, given back when the thread exits
+struct EpochSlotHandle {
+  EpochManager *manager = nullptr;
+  size_t slot_id = 0;
+
+  ~EpochSlotHandle() {
+    if (manager != nullptr) {
+      manager->ReleaseSlot(slot_id);
+    }
+  }
+};
+
+thread_local EpochSlotHandle epoch_slot_handle;
+
+}  // End anonymous namespace
+
+void EpochManager::ResetStates() {
+  queue_tail_ = 0;
+  current_epoch_ = 0;
+  epoch_queue_[0].Init();
+  queue_tail_gc = true;
+  max_cid = 0;
+
+  // slots stay with the threads holding them
+  for (size_t slot_id = 0; slot_id < slot_high_water_.load(); slot_id++) {
+    slots_[slot_id].Init();
+  }
+  slot_max_cid_ = 0;
+}
+
+size_t EpochManager::GetThreadSlot() {
+  auto &handle = epoch_slot_handle;
+  if (handle.manager == this) {
+    return handle.slot_id;
+  }
+
+  for (size_t slot_id = 0; slot_id < EPOCH_SLOT_COUNT; slot_id++) {
+    bool expected = false;
+    if (slots_[slot_id].owned_.compare_exchange_strong(expected, true) ==
+        false) {
+      continue;
+    }
+
+    // make the slot visible to the epoch thread
+    auto high_water = slot_high_water_.load();
+    while (high_water <= slot_id &&
+           slot_high_water_.compare_exchange_weak(high_water, slot_id + 1) ==
+               false)
+      ;
+
+    handle.manager = this;
+    handle.slot_id = slot_id;
+    return slot_id;
+  }
+
+  throw Exception("No free epoch slot, more than " +
+                  std::to_string(EPOCH_SLOT_COUNT) + " threads");
+}
+
+void EpochManager::ReleaseSlot(size_t slot_id) {
+  slots_[slot_id].Init();
+  slots_[slot_id].owned_ = false;
+}
+
+void EpochManager::PublishBeginCidBound(cid_t lower_bound) {
+  auto &slot = slots_[GetThreadSlot()];
+
+  // an older running transaction of the thread already holds back the horizon
+  if (slot.txn_ref_count_.load() == 0) {
+    slot.begin_cid_ = lower_bound;
+  }
+}
+
+size_t EpochManager::EnterSlot(cid_t begin_cid) {
+  auto slot_id = GetThreadSlot();
+  auto &slot = slots_[slot_id];
+
+  // the oldest running transaction of the thread holds back the horizon
+  if (slot.txn_ref_count_.load() == 0) {
+    slot.begin_cid_ = begin_cid;
+  }
+  slot.txn_ref_count_++;
+
+  return slot_id;
+}
+
+void EpochManager::ExitSlot(size_t slot_id) {
+  auto &slot = slots_[slot_id];
+
+  if (--slot.txn_ref_count_ == 0) {
+    slot.begin_cid_ = MAX_CID;
+  }
+}
+
+void EpochManager::AdvanceSlotHorizon() {
+  // A thread whose lower bound is not seen by the scan below published it
+  // after the scan started, so it draws its begin cid after this read
+  cid_t horizon =
+      TransactionManagerFactory::GetInstance().GetCurrentCommitId();
+
+  auto slot_count = slot_high_water_.load();
+  for (size_t slot_id = 0; slot_id < slot_count; slot_id++) {
+    horizon = std::min(horizon, slots_[slot_id].begin_cid_.load());
+  }
+
+  if (horizon > slot_max_cid_.load()) {
+    slot_max_cid_ = horizon;
+  }
+
+  current_epoch_++;
+}
+
+}
 }
-}
\ No newline at end of file
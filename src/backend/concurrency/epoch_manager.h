@@ -11,6 +11,7 @@
 //===----------------------------------------------------------------------===//
 #pragma once
 
+#include <atomic>
 #include <thread>
 #include <vector>
 
@@ -23,6 +24,9 @@ namespace concurrency {
 
 #define EPOCH_LENGTH 40
 
+// maximum number of threads holding an epoch slot at the same time
+#define EPOCH_SLOT_COUNT 1024
+
 struct Epoch {
   std::atomic<int> txn_ref_count_;
   cid_t max_cid_;
@@ -35,6 +39,41 @@ struct Epoch {
   }
 };
 
+/**
+ * Running transactions of one thread in the slot mode. The slot is only
+ * written by its thread, and read by the epoch thread.
+ */
+struct EpochSlot {
+  // is the slot held by a thread ?
+  std::atomic<bool> owned_;
+
+  // number of running transactions of the thread
+  std::atomic<int> txn_ref_count_;
+
+  // begin cid of the oldest running transaction, MAX_CID if there is none.
+  // While the thread draws the begin cid of its first transaction, a lower
+  // bound of it.
+  std::atomic<cid_t> begin_cid_;
+
+  EpochSlot() : owned_(false), txn_ref_count_(0), begin_cid_(MAX_CID) {}
+
+  void Init() {
+    txn_ref_count_ = 0;
+    begin_cid_ = MAX_CID;
+  }
+} CACHE_ALIGNED;
+
+/**
+ * In the queue mode, transactions register in the epoch that is current
+ * when they begin, and the epochs form a shared ring.
+ *
+ * In the slot mode, each thread publishes its running transactions in its
+ * own cache-aligned slot. Every epoch, the epoch thread scans the slots and
+ * advances the GC horizon to the oldest running transaction, so that
+ * beginning and ending transactions share no cache line. A thread publishes
+ * a lower bound of its begin cid (see PublishBeginCidBound) before drawing
+ * it, so a transaction missed by the scan begins after the scan started.
+ */
 class EpochManager {
  public:
   EpochManager()
@@ -48,16 +87,30 @@ class EpochManager {
     finish_ = true;
     ts_thread_.join();
 
-    queue_tail_ = 0;
-    current_epoch_ = 0;
-    epoch_queue_[0].Init();
-    queue_tail_gc = true;
-    max_cid = 0;
+    ResetStates();
+
+    finish_ = false;
+    ts_thread_ = std::thread(&EpochManager::Start, this);
+  }
+
+  // Switch between the queue and the slot mode, and set the length of an
+  // epoch (in ms). Must not be called while transactions are running.
+  void Configure(EpochType epoch_type, size_t epoch_length = EPOCH_LENGTH) {
+    finish_ = true;
+    ts_thread_.join();
+
+    epoch_type_ = epoch_type;
+    epoch_length_ = epoch_length;
+    ResetStates();
 
     finish_ = false;
     ts_thread_ = std::thread(&EpochManager::Start, this);
   }
 
+  EpochType GetEpochType() const { return epoch_type_; }
+
+  size_t GetEpochLength() const { return epoch_length_; }
+
   ~EpochManager() {
     finish_ = true;
     ts_thread_.join();
@@ -75,7 +128,16 @@ class EpochManager {
   //    }
 
 
+  // Slot mode : called with the current commit id before the begin cid of a
+  // transaction is drawn, the begin cid being at least that
+  void PublishBeginCidBound(cid_t lower_bound);
+
+  // Returns the epoch of the transaction, or its slot in the slot mode
   size_t EnterEpoch(cid_t begin_cid) {
+    if (epoch_type_ == EPOCH_TYPE_SLOT) {
+      return EnterSlot(begin_cid);
+    }
+
     auto epoch = current_epoch_.load();
 
     size_t epoch_idx = epoch % epoch_queue_size_;
@@ -89,6 +151,11 @@ class EpochManager {
   }
 
   void ExitEpoch(size_t epoch) {
+    if (epoch_type_ == EPOCH_TYPE_SLOT) {
+      ExitSlot(epoch);
+      return;
+    }
+
     PL_ASSERT(epoch >= queue_tail_);
     PL_ASSERT(epoch <= current_epoch_);
 
@@ -100,6 +167,10 @@ class EpochManager {
   }
   // assume we store epoch_store max_store previously
   cid_t GetMaxDeadTxnCid() {
+    if (epoch_type_ == EPOCH_TYPE_SLOT) {
+      return slot_max_cid_.load();
+    }
+
     // TODO:
     // change to:
     // increase tail
@@ -135,12 +206,19 @@ class EpochManager {
     return max_cid;
   }
 
+  // Give back the slot of an exiting thread
+  void ReleaseSlot(size_t slot_id);
+
  private:
   void Start() {
     while (!finish_) {
-      // the epoch advances every 40 milliseconds.
-      std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
+      // the epoch advances every epoch_length_ milliseconds.
+      std::this_thread::sleep_for(std::chrono::milliseconds(epoch_length_));
 
+      if (epoch_type_ == EPOCH_TYPE_SLOT) {
+        AdvanceSlotHorizon();
+        continue;
+      }
 
 
       auto next_idx = (current_epoch_.load() + 1) % epoch_queue_size_;
@@ -201,6 +279,22 @@ class EpochManager {
   }
 
 
+  void ResetStates();
+
+  //===--------------------------------------------------------------------===//
+  // Slot mode
+  //===--------------------------------------------------------------------===//
+
+  // Get the slot of the calling thread, claiming one on first use
+  size_t GetThreadSlot();
+
+  size_t EnterSlot(cid_t begin_cid);
+
+  void ExitSlot(size_t slot_id);
+
+  // Scan the slots and move the GC horizon forward
+  void AdvanceSlotHorizon();
+
   void AtomicMax(cid_t* addr, cid_t max) {
     while(true) {
       auto old = *addr;
@@ -225,6 +319,20 @@ class EpochManager {
   cid_t max_cid;
   bool finish_;
 
+  EpochType epoch_type_ = EPOCH_TYPE_QUEUE;
+
+  // length of an epoch (in ms)
+  size_t epoch_length_ = EPOCH_LENGTH;
+
+  // Per-thread slots
+  EpochSlot slots_[EPOCH_SLOT_COUNT];
+
+  // slots at and above this offset have never been claimed
+  std::atomic<size_t> slot_high_water_{0};
+
+  // GC horizon in the slot mode
+  std::atomic<cid_t> slot_max_cid_{0};
+
   std::thread ts_thread_;
 };
 
@@ -235,6 +343,11 @@ class EpochManagerFactory {
     static EpochManager epoch_manager;
     return epoch_manager;
   }
+
+  static void Configure(EpochType epoch_type,
+                        size_t epoch_length = EPOCH_LENGTH) {
+    GetInstance().Configure(epoch_type, epoch_length);
+  }
 };
 
 }
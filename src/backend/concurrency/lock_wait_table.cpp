@@ -0,0 +1,175 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// lock_wait_table.cpp
+//
+// Identification: src/backend/concurrency/lock_wait_table.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "backend/concurrency/lock_wait_table.h"
+
+namespace peloton {
+namespace concurrency {
+
+void LockWaitTable::AddReader(const ItemPointer &location,
+                              const txn_id_t txn_id) {
+  auto key = GetKey(location);
+  auto &bucket = GetBucket(key);
+
+  std::lock_guard<std::mutex> lock(bucket.mutex);
+  bucket.tuples[key].readers.insert(txn_id);
+}
+
+void LockWaitTable::RemoveReader(const ItemPointer &location,
+                                 const txn_id_t txn_id) {
+  auto key = GetKey(location);
+  auto &bucket = GetBucket(key);
+
+  std::lock_guard<std::mutex> lock(bucket.mutex);
+  auto tuple_itr = bucket.tuples.find(key);
+  if (tuple_itr == bucket.tuples.end()) {
+    return;
+  }
+
+  auto &tuple_locks = tuple_itr->second;
+  auto reader_itr = tuple_locks.readers.find(txn_id);
+  if (reader_itr != tuple_locks.readers.end()) {
+    tuple_locks.readers.erase(reader_itr);
+  }
+
+  if (tuple_locks.waiters.empty() == false) {
+    bucket.cv.notify_all();
+  } else if (tuple_locks.readers.empty()) {
+    bucket.tuples.erase(tuple_itr);
+  }
+}
+
+void LockWaitTable::Release(const ItemPointer &location) {
+  auto key = GetKey(location);
+  auto &bucket = GetBucket(key);
+
+  // pairs with the increment of the waiter count in Wait, so that either
+  // the waiter sees the released lock or we see the waiter
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (bucket.waiter_count.load() == 0) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(bucket.mutex);
+  bucket.cv.notify_all();
+}
+
+bool LockWaitTable::CanWait(const TupleLocks &tuple_locks,
+                            const txn_id_t txn_id, const txn_id_t writer_id) {
+  // The txn ids give the age of the txns, so the pessimistic manager does
+  // not allow wait-die with decentralized timestamps
+  if (writer_id != INITIAL_TXN_ID && writer_id != INVALID_TXN_ID &&
+      writer_id < txn_id) {
+    return false;
+  }
+
+  for (auto reader_id : tuple_locks.readers) {
+    // readers are sorted, the oldest one comes first
+    if (reader_id == txn_id) {
+      continue;
+    }
+    return reader_id > txn_id;
+  }
+
+  return true;
+}
+
+bool LockWaitTable::Wait(const ItemPointer &location, const txn_id_t txn_id,
+                         const txn_id_t writer_id, const bool is_read,
+                         const std::function<bool()> &try_lock) {
+  auto key = GetKey(location);
+  auto &bucket = GetBucket(key);
+
+  std::unique_lock<std::mutex> lock(bucket.mutex);
+  auto &tuple_locks = bucket.tuples[key];
+
+  if (CanWait(tuple_locks, txn_id, writer_id) == false) {
+    die_count_++;
+    if (tuple_locks.readers.empty() && tuple_locks.waiters.empty()) {
+      bucket.tuples.erase(key);
+    }
+    return false;
+  }
+
+  tuple_locks.waiters.push_back(txn_id);
+  bucket.waiter_count++;
+  wait_count_++;
+
+  auto start = std::chrono::steady_clock::now();
+  auto deadline = start + std::chrono::microseconds(timeout_);
+  bool locked = false;
+
+  while (true) {
+    // only the head of the queue tries to take the lock
+    if (tuple_locks.waiters.front() == txn_id && try_lock()) {
+      locked = true;
+      break;
+    }
+
+    if (bucket.cv.wait_until(lock, deadline) == std::cv_status::timeout) {
+      timeout_count_++;
+      break;
+    }
+  }
+
+  auto wait_time = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start).count();
+  wait_time_ += wait_time;
+
+  for (auto waiter_itr = tuple_locks.waiters.begin();
+       waiter_itr != tuple_locks.waiters.end(); ++waiter_itr) {
+    if (*waiter_itr == txn_id) {
+      tuple_locks.waiters.erase(waiter_itr);
+      break;
+    }
+  }
+  bucket.waiter_count--;
+
+  if (locked == false) {
+    die_count_++;
+  } else if (is_read) {
+    tuple_locks.readers.insert(txn_id);
+  }
+
+  // hand the head of the queue over to the next waiter
+  if (tuple_locks.waiters.empty() == false) {
+    bucket.cv.notify_all();
+  } else if (tuple_locks.readers.empty()) {
+    bucket.tuples.erase(key);
+  }
+
+  return locked;
+}
+
+LockWaitStats LockWaitTable::GetStats() const {
+  LockWaitStats stats;
+  stats.wait_count = wait_count_.load();
+  stats.die_count = die_count_.load();
+  stats.timeout_count = timeout_count_.load();
+  if (stats.wait_count != 0) {
+    stats.average_wait_time =
+        static_cast<double>(wait_time_.load()) / stats.wait_count;
+  }
+  return stats;
+}
+
+void LockWaitTable::ResetStats() {
+  wait_count_ = 0;
+  die_count_ = 0;
+  timeout_count_ = 0;
+  wait_time_ = 0;
+}
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -0,0 +1,132 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// lock_wait_table.h
+//
+// Identification: src/backend/concurrency/lock_wait_table.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+
+#include "backend/common/types.h"
+#include "backend/common/platform.h"
+
+namespace peloton {
+namespace concurrency {
+
+// number of buckets the tuples are hashed into
+#define LOCK_WAIT_BUCKET_COUNT 1024
+
+// default bound on the time a txn waits for a lock (in us)
+#define LOCK_WAIT_TIMEOUT 10000
+
+struct LockWaitStats {
+  // number of times a txn waited for a lock
+  uint64_t wait_count = 0;
+
+  // number of txns aborted because a holder was older (or on timeout)
+  uint64_t die_count = 0;
+
+  // number of waits that ran out of time
+  uint64_t timeout_count = 0;
+
+  // average time spent waiting (in us)
+  double average_wait_time = 0;
+};
+
+/**
+ * Wait queues for the tuple locks of the pessimistic txn manager.
+ *
+ * The locks themselves stay in the tuple headers. The table records the
+ * read lock holders of the tuples, so that the age of every holder is known,
+ * and queues the txns that wait for a lock.
+ *
+ * Waiting follows wait-die : a txn may only wait for younger holders
+ * (larger txn ids), otherwise it dies. Waiters are served in arrival order :
+ * only the head of the queue of a tuple tries to take the lock, the others
+ * are woken up once it is done.
+ */
+class LockWaitTable {
+ public:
+  LockWaitTable(const LockWaitTable &) = delete;
+  LockWaitTable &operator=(const LockWaitTable &) = delete;
+
+  LockWaitTable() {}
+
+  // Record / forget a read lock holder
+  void AddReader(const ItemPointer &location, const txn_id_t txn_id);
+
+  void RemoveReader(const ItemPointer &location, const txn_id_t txn_id);
+
+  // Wake up the txns waiting for the tuple, after a lock was released
+  void Release(const ItemPointer &location);
+
+  // Wait until try_lock succeeds. writer_id is the holder of the write lock,
+  // if any. A read lock taken this way is recorded. Returns false if the txn
+  // must die.
+  bool Wait(const ItemPointer &location, const txn_id_t txn_id,
+            const txn_id_t writer_id, const bool is_read,
+            const std::function<bool()> &try_lock);
+
+  void SetTimeout(const uint64_t timeout) { timeout_ = timeout; }
+
+  LockWaitStats GetStats() const;
+
+  void ResetStats();
+
+ private:
+  struct TupleLocks {
+    // read lock holders
+    std::multiset<txn_id_t> readers;
+
+    // waiting txns, in arrival order
+    std::deque<txn_id_t> waiters;
+  };
+
+  struct Bucket {
+    std::mutex mutex;
+    std::condition_variable cv;
+
+    // number of waiting txns, checked without the mutex on release
+    std::atomic<size_t> waiter_count{0};
+
+    std::unordered_map<uint64_t, TupleLocks> tuples;
+  };
+
+  static uint64_t GetKey(const ItemPointer &location) {
+    return (static_cast<uint64_t>(location.block) << 32) | location.offset;
+  }
+
+  Bucket &GetBucket(const uint64_t key) {
+    return buckets_[std::hash<uint64_t>()(key) % LOCK_WAIT_BUCKET_COUNT];
+  }
+
+  // wait-die : can the txn wait for the current holders of the tuple ?
+  static bool CanWait(const TupleLocks &tuple_locks, const txn_id_t txn_id,
+                      const txn_id_t writer_id);
+
+  Bucket buckets_[LOCK_WAIT_BUCKET_COUNT];
+
+  // bound on the waiting time (in us)
+  uint64_t timeout_ = LOCK_WAIT_TIMEOUT;
+
+  std::atomic<uint64_t> wait_count_{0};
+  std::atomic<uint64_t> die_count_{0};
+  std::atomic<uint64_t> timeout_count_{0};
+  std::atomic<uint64_t> wait_time_{0};
+};
+
+}  // End concurrency namespace
+}  // End peloton namespace
@@ -274,7 +274,7 @@ bool OptimisticRbTxnManager::ValidateRead(const storage::TileGroupHeader *const
   return end_cid >= storage::RollbackSegmentPool::GetTimeStamp(evidence);
 }
 
-Result OptimisticRbTxnManager::CommitTransaction() {
+Result OptimisticRbTxnManager::DCommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
   auto &manager = catalog::Manager::GetInstance();
@@ -447,7 +447,7 @@ Result OptimisticRbTxnManager::CommitTransaction() {
   return Result::RESULT_SUCCESS;
 }
 
-Result OptimisticRbTxnManager::AbortTransaction() {
+Result OptimisticRbTxnManager::DAbortTransaction() {
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
   auto &manager = catalog::Manager::GetInstance();
 
@@ -558,10 +558,10 @@ char* OptimisticRbTxnManager::GetActivatedEvidence(const storage::TileGroupHeade
   return prev_visible;
 }
 
-Transaction *OptimisticRbTxnManager::BeginTransaction() {
+Transaction *OptimisticRbTxnManager::DBeginTransaction() {
   // Set current transaction
   txn_id_t txn_id = GetNextTransactionId();
-  cid_t begin_cid = GetNextCommitId();
+  cid_t begin_cid = GetNextBeginCommitId();
 
   LOG_TRACE("Beginning transaction %lu", txn_id);
 
@@ -33,7 +33,7 @@ class OptimisticRbTxnManager : public TransactionManager {
   public:
   typedef char* RBSegType;
 
-  OptimisticRbTxnManager() {}
+  OptimisticRbTxnManager() : TransactionManager(CONCURRENCY_TYPE_OCC_RB) {}
 
   virtual ~OptimisticRbTxnManager() {}
 
@@ -119,11 +119,11 @@ class OptimisticRbTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Result CommitTransaction();
+  virtual Result DCommitTransaction();
 
-  virtual Result AbortTransaction();
+  virtual Result DAbortTransaction();
 
-  virtual Transaction *BeginTransaction();
+  virtual Transaction *DBeginTransaction();
 
   virtual void EndTransaction();
 
@@ -124,6 +124,58 @@ bool OptimisticTxnManager::PerformRead(const ItemPointer &location) {
   return true;
 }
 
+// a range is only recorded while its tile group is all-visible, otherwise
+// the tuples are recorded one by one.
+bool OptimisticTxnManager::PerformReadRange(const oid_t tile_group_id,
+                                            const oid_t begin_tuple_id,
+                                            const oid_t end_tuple_id) {
+  auto tile_group_header =
+      catalog::Manager::GetInstance().GetTileGroup(tile_group_id)->GetHeader();
+
+  uint64_t generation;
+  if (tile_group_header->GetAllVisibleGeneration(generation) == false) {
+    return TransactionManager::PerformReadRange(tile_group_id, begin_tuple_id,
+                                                end_tuple_id);
+  }
+
+  current_txn->RecordReadRange(
+      {tile_group_id, begin_tuple_id, end_tuple_id, generation});
+  return true;
+}
+
+// The tile groups that have not been modified since they were read are
+// validated at once. The others are validated tuple by tuple, like the
+// tuples of the read set.
+bool OptimisticTxnManager::ValidateReadRanges(const cid_t validation_cid) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  for (auto &read_range : current_txn->GetReadRanges()) {
+    auto tile_group_header =
+        manager.GetTileGroup(read_range.tile_group_id)->GetHeader();
+    if (tile_group_header->IsAllVisibleSince(read_range.generation)) {
+      continue;
+    }
+
+    for (oid_t tuple_slot = read_range.begin_tuple_id;
+         tuple_slot < read_range.end_tuple_id; tuple_slot++) {
+      txn_id_t tuple_txn_id = tile_group_header->GetTransactionId(tuple_slot);
+      if (tuple_txn_id == current_txn->GetTransactionId()) {
+        // the version is owned by the transaction.
+        continue;
+      }
+      if (tuple_txn_id == INITIAL_TXN_ID &&
+          tile_group_header->GetBeginCommitId(tuple_slot) <= validation_cid &&
+          tile_group_header->GetEndCommitId(tuple_slot) >= validation_cid) {
+        // the version is not owned by other txns and is still visible.
+        continue;
+      }
+      return false;
+    }
+  }
+
+  return true;
+}
+
 bool OptimisticTxnManager::PerformInsert(const ItemPointer &location) {
   oid_t tile_group_id = location.block;
   oid_t tuple_id = location.offset;
@@ -258,7 +310,7 @@ void OptimisticTxnManager::PerformDelete(const ItemPointer &location) {
   }
 }
 
-Result OptimisticTxnManager::CommitTransaction() {
+Result OptimisticTxnManager::DCommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
   auto &manager = catalog::Manager::GetInstance();
@@ -293,6 +345,9 @@ Result OptimisticTxnManager::CommitTransaction() {
         }
       }
     }
+    if (ValidateReadRanges(current_txn->GetBeginCommitId()) == false) {
+      return AbortTransaction();
+    }
     // is it always true???
     Result ret = current_txn->GetResult();
     EndTransaction();
@@ -343,6 +398,10 @@ Result OptimisticTxnManager::CommitTransaction() {
       }
     }
   }
+  if (ValidateReadRanges(end_commit_id) == false) {
+    log_manager.DoneLogging();
+    return AbortTransaction();
+  }
   //////////////////////////////////////////////////////////
 
   log_manager.LogBeginTransaction(end_commit_id);
@@ -351,6 +410,8 @@ Result OptimisticTxnManager::CommitTransaction() {
     oid_t tile_group_id = tile_group_entry.first;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
+    // the inserts into the tile group are logged together
+    std::vector<oid_t> insert_slots;
     for (auto &tuple_entry : tile_group_entry.second) {
       auto tuple_slot = tuple_entry.first;
       if (tuple_entry.second == RW_TYPE_UPDATE) {
@@ -412,8 +473,7 @@ Result OptimisticTxnManager::CommitTransaction() {
         PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
                current_txn->GetTransactionId());
         // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
+        insert_slots.push_back(tuple_slot);
 
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
         tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
@@ -435,6 +495,9 @@ Result OptimisticTxnManager::CommitTransaction() {
         tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
       }
     }
+    if (insert_slots.empty() == false) {
+      log_manager.LogInserts(end_commit_id, tile_group_id, insert_slots);
+    }
   }
   log_manager.LogCommitTransaction(end_commit_id);
   EndTransaction();
@@ -442,7 +505,7 @@ Result OptimisticTxnManager::CommitTransaction() {
   return Result::RESULT_SUCCESS;
 }
 
-Result OptimisticTxnManager::AbortTransaction() {
+Result OptimisticTxnManager::DAbortTransaction() {
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
   auto &manager = catalog::Manager::GetInstance();
 
@@ -24,7 +24,7 @@ namespace concurrency {
 
 class OptimisticTxnManager : public TransactionManager {
  public:
-  OptimisticTxnManager()  {}
+  OptimisticTxnManager() : TransactionManager(CONCURRENCY_TYPE_OPTIMISTIC) {}
 
   virtual ~OptimisticTxnManager() {}
 
@@ -34,6 +34,14 @@ class OptimisticTxnManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void GetVisibleTuples(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t begin_tuple_id, const oid_t end_tuple_id,
+      std::vector<oid_t> &selection) {
+    GetSnapshotVisibleTuples(tile_group_header, begin_tuple_id, end_tuple_id,
+                             selection);
+  }
+
   virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
                        const oid_t &tuple_id);
 
@@ -49,6 +57,12 @@ class OptimisticTxnManager : public TransactionManager {
 
   virtual bool PerformRead(const ItemPointer &location);
 
+  virtual bool PerformReadRange(const oid_t tile_group_id,
+                                const oid_t begin_tuple_id,
+                                const oid_t end_tuple_id);
+
+  virtual bool IsReadRangeTracked() const { return true; }
+
   virtual void PerformUpdate(const ItemPointer &old_location,
                              const ItemPointer &new_location);
 
@@ -59,13 +73,13 @@ class OptimisticTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Result CommitTransaction();
+  virtual Result DCommitTransaction();
 
-  virtual Result AbortTransaction();
+  virtual Result DAbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *DBeginTransaction() {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
+    cid_t begin_cid = GetNextBeginCommitId();
     Transaction *txn = new Transaction(txn_id, begin_cid);
 
     auto eid = EpochManagerFactory::GetInstance().EnterEpoch(begin_cid);
@@ -84,6 +98,8 @@ class OptimisticTxnManager : public TransactionManager {
     current_txn = nullptr;
   }
 
+ private:
+  bool ValidateReadRanges(const cid_t validation_cid);
 };
 }
 }
\ No newline at end of file
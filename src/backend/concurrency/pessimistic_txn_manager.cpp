@@ -121,7 +121,7 @@ bool PessimisticTxnManager::AcquireOwnership(
 
   // First release read lock that is acquired before, the executor will always
   // read the tuple before calling AcquireOwnership().
-  ReleaseReadLock(tile_group_header, tuple_id);
+  ReleaseReadLock(tile_group_header, tile_group_id, tuple_id);
 
   // Mark the tuple as released
   pessimistic_released_rdlock[tile_group_id].insert(tuple_id);
@@ -131,6 +131,26 @@ bool PessimisticTxnManager::AcquireOwnership(
   bool res = tile_group_header->SetAtomicTransactionId(
       tuple_id, PACK_TXNID(current_txn_id, 0));
 
+  if (res == false && lock_wait_type_ == LOCK_WAIT_TYPE_WAIT_DIE) {
+    auto writer_id =
+        EXTRACT_TXNID(tile_group_header->GetTransactionId(tuple_id));
+    res = lock_wait_table_.Wait(
+        ItemPointer(tile_group_id, tuple_id), current_txn_id, writer_id,
+        false, [&]() {
+          return tile_group_header->SetAtomicTransactionId(
+              tuple_id, PACK_TXNID(current_txn_id, 0));
+        });
+
+    // the writer we waited for has committed a newer version
+    if (res && tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+      tile_group_header->SetAtomicTransactionId(
+          tuple_id, PACK_TXNID(current_txn_id, 0),
+          PACK_TXNID(INITIAL_TXN_ID, 0));
+      NotifyLockWaiters(tile_group_id, tuple_id);
+      res = false;
+    }
+  }
+
   if (res) {
     return true;
   } else {
@@ -141,7 +161,7 @@ bool PessimisticTxnManager::AcquireOwnership(
 
 void PessimisticTxnManager::ReleaseReadLock(
     const storage::TileGroupHeader *const tile_group_header,
-    const oid_t &tuple_id) {
+    const oid_t &tile_group_id, const oid_t &tuple_id) {
   auto old_txn_id = tile_group_header->GetTransactionId(tuple_id);
 
   LOG_TRACE("ReleaseReadLock on %lx", old_txn_id);
@@ -169,6 +189,63 @@ void PessimisticTxnManager::ReleaseReadLock(
       break;
     }
   }
+
+  if (lock_wait_type_ == LOCK_WAIT_TYPE_WAIT_DIE) {
+    lock_wait_table_.RemoveReader(ItemPointer(tile_group_id, tuple_id),
+                                  current_txn->GetTransactionId());
+  }
+}
+
+void PessimisticTxnManager::NotifyLockWaiters(const oid_t &tile_group_id,
+                                              const oid_t &tuple_id) {
+  if (lock_wait_type_ == LOCK_WAIT_TYPE_WAIT_DIE) {
+    lock_wait_table_.Release(ItemPointer(tile_group_id, tuple_id));
+  }
+}
+
+bool PessimisticTxnManager::TryAcquireReadLock(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t &tuple_id) {
+  auto old_txn_id = tile_group_header->GetTransactionId(tuple_id);
+  // Someone is holding the write lock
+  if (EXTRACT_TXNID(old_txn_id) != INITIAL_TXN_ID) {
+    return false;
+  }
+
+  LOG_TRACE("No one holding the lock");
+  while (true) {
+    LOG_TRACE("Current read count is %lu", EXTRACT_READ_COUNT(old_txn_id));
+    if (EXTRACT_READ_COUNT(old_txn_id) == 0xFF) {
+      LOG_TRACE("Reader limit reached, read failed");
+      return false;
+    }
+    auto new_read_count = EXTRACT_READ_COUNT(old_txn_id) + 1;
+    // Try add read count
+    auto new_txn_id = PACK_TXNID(INITIAL_TXN_ID, new_read_count);
+    LOG_TRACE("New txn id %lx", new_txn_id);
+    txn_id_t real_txn_id = tile_group_header->SetAtomicTransactionId(
+        tuple_id, old_txn_id, new_txn_id);
+
+    if (real_txn_id != old_txn_id) {
+      // See if there's writer
+      if (EXTRACT_TXNID(real_txn_id) != INITIAL_TXN_ID) return false;
+      old_txn_id = real_txn_id;
+    } else {
+      return true;
+    }
+  }
+}
+
+void PessimisticTxnManager::SetLockWaitType(const LockWaitType lock_wait_type,
+                                            const uint64_t timeout) {
+  if (lock_wait_type == LOCK_WAIT_TYPE_WAIT_DIE &&
+      GetTimestampType() == TIMESTAMP_TYPE_DECENTRALIZED) {
+    throw Exception(
+        "Wait-die is not supported with decentralized timestamps");
+  }
+
+  lock_wait_type_ = lock_wait_type;
+  lock_wait_table_.SetTimeout(timeout);
 }
 
 bool PessimisticTxnManager::PerformRead(const ItemPointer &location) {
@@ -194,34 +271,28 @@ bool PessimisticTxnManager::PerformRead(const ItemPointer &location) {
   }
 
   // Try to acquire read lock.
-  auto old_txn_id = tile_group_header->GetTransactionId(tuple_id);
-  // No one is holding the write lock
-  if (EXTRACT_TXNID(old_txn_id) == INITIAL_TXN_ID) {
-    LOG_TRACE("No one holding the lock");
-    while (true) {
-      LOG_TRACE("Current read count is %lu", EXTRACT_READ_COUNT(old_txn_id));
-      if (EXTRACT_READ_COUNT(old_txn_id) == 0xFF) {
-        LOG_TRACE("Reader limit reached, read failed");
-        return false;
-      }
-      auto new_read_count = EXTRACT_READ_COUNT(old_txn_id) + 1;
-      // Try add read count
-      auto new_txn_id = PACK_TXNID(INITIAL_TXN_ID, new_read_count);
-      LOG_TRACE("New txn id %lx", new_txn_id);
-      txn_id_t real_txn_id = tile_group_header->SetAtomicTransactionId(
-          tuple_id, old_txn_id, new_txn_id);
-
-      if (real_txn_id != old_txn_id) {
-        // See if there's writer
-        if (EXTRACT_TXNID(real_txn_id) != INITIAL_TXN_ID) return false;
-        old_txn_id = real_txn_id;
-      } else {
-        break;
-      }
-      
+  auto txn_id = current_txn->GetTransactionId();
+  if (TryAcquireReadLock(tile_group_header, tuple_id) == false) {
+    if (lock_wait_type_ != LOCK_WAIT_TYPE_WAIT_DIE) {
+      return false;
     }
-  } else {
-    return false;
+
+    auto writer_id =
+        EXTRACT_TXNID(tile_group_header->GetTransactionId(tuple_id));
+    bool res = lock_wait_table_.Wait(location, txn_id, writer_id, true, [&]() {
+      return TryAcquireReadLock(tile_group_header, tuple_id);
+    });
+    if (res == false) {
+      return false;
+    }
+
+    // the writer we waited for has committed a newer version
+    if (tile_group_header->GetEndCommitId(tuple_id) != MAX_CID) {
+      ReleaseReadLock(tile_group_header, tile_group_id, tuple_id);
+      return false;
+    }
+  } else if (lock_wait_type_ == LOCK_WAIT_TYPE_WAIT_DIE) {
+    lock_wait_table_.AddReader(location, txn_id);
   }
 
   current_txn->RecordRead(location);
@@ -367,7 +438,7 @@ void PessimisticTxnManager::PerformDelete(const ItemPointer &location) {
   }
 }
 
-Result PessimisticTxnManager::CommitTransaction() {
+Result PessimisticTxnManager::DCommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
   auto &manager = catalog::Manager::GetInstance();
@@ -391,7 +462,7 @@ Result PessimisticTxnManager::CommitTransaction() {
                   pessimistic_released_rdlock.end() ||
               pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
                   pessimistic_released_rdlock[tile_group_id].end()) {
-            ReleaseReadLock(tile_group_header, tuple_slot);
+            ReleaseReadLock(tile_group_header, tile_group_id, tuple_slot);
             pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
           }
         } else {
@@ -418,6 +489,8 @@ Result PessimisticTxnManager::CommitTransaction() {
     oid_t tile_group_id = tile_group_entry.first;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
+    // the inserts into the tile group are logged together
+    std::vector<oid_t> insert_slots;
     for (auto &tuple_entry : tile_group_entry.second) {
       auto tuple_slot = tuple_entry.first;
       if (tuple_entry.second == RW_TYPE_READ) {
@@ -426,7 +499,7 @@ Result PessimisticTxnManager::CommitTransaction() {
                 pessimistic_released_rdlock.end() ||
             pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
                 pessimistic_released_rdlock[tile_group_id].end()) {
-          ReleaseReadLock(tile_group_header, tuple_slot);
+          ReleaseReadLock(tile_group_header, tile_group_id, tuple_slot);
           pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
         }
       } else if (tuple_entry.second == RW_TYPE_UPDATE) {
@@ -455,6 +528,7 @@ Result PessimisticTxnManager::CommitTransaction() {
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INITIAL_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyLockWaiters(tile_group_id, tuple_slot);
 
       } else if (tuple_entry.second == RW_TYPE_DELETE) {
         ItemPointer new_version =
@@ -481,13 +555,13 @@ Result PessimisticTxnManager::CommitTransaction() {
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INVALID_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyLockWaiters(tile_group_id, tuple_slot);
 
       } else if (tuple_entry.second == RW_TYPE_INSERT) {
         PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
                current_txn->GetTransactionId());
         // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
+        insert_slots.push_back(tuple_slot);
 
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
         tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
@@ -509,6 +583,9 @@ Result PessimisticTxnManager::CommitTransaction() {
         tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
       }
     }
+    if (insert_slots.empty() == false) {
+      log_manager.LogInserts(end_commit_id, tile_group_id, insert_slots);
+    }
   }
   log_manager.LogCommitTransaction(end_commit_id);
 
@@ -517,7 +594,7 @@ Result PessimisticTxnManager::CommitTransaction() {
   return Result::RESULT_SUCCESS;
 }
 
-Result PessimisticTxnManager::AbortTransaction() {
+Result PessimisticTxnManager::DAbortTransaction() {
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
   auto &manager = catalog::Manager::GetInstance();
 
@@ -535,7 +612,7 @@ Result PessimisticTxnManager::AbortTransaction() {
                 pessimistic_released_rdlock.end() ||
             pessimistic_released_rdlock[tile_group_id].find(tuple_slot) ==
                 pessimistic_released_rdlock[tile_group_id].end()) {
-          ReleaseReadLock(tile_group_header, tuple_slot);
+          ReleaseReadLock(tile_group_header, tile_group_id, tuple_slot);
           pessimistic_released_rdlock[tile_group_id].insert(tuple_slot);
         }
       } else if (tuple_entry.second == RW_TYPE_UPDATE) {
@@ -559,6 +636,7 @@ Result PessimisticTxnManager::AbortTransaction() {
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INVALID_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyLockWaiters(tile_group_id, tuple_slot);
 
       } else if (tuple_entry.second == RW_TYPE_DELETE) {
         ItemPointer new_version =
@@ -583,6 +661,7 @@ Result PessimisticTxnManager::AbortTransaction() {
         new_tile_group_header->SetTransactionId(new_version.offset,
                                                 INVALID_TXN_ID);
         tile_group_header->SetTransactionId(tuple_slot, INITIAL_TXN_ID);
+        NotifyLockWaiters(tile_group_id, tuple_slot);
 
       } else if (tuple_entry.second == RW_TYPE_INSERT) {
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "backend/concurrency/transaction_manager.h"
+#include "backend/concurrency/lock_wait_table.h"
 
 namespace peloton {
 namespace concurrency {
@@ -22,10 +23,16 @@ extern thread_local std::unordered_map<oid_t, std::unordered_set<oid_t>>
 
 //===--------------------------------------------------------------------===//
 // pessimistic concurrency control
+//
+// By default, a txn aborts as soon as a lock it needs is held by another
+// txn. With LOCK_WAIT_TYPE_WAIT_DIE, it waits (for a bounded time) if every
+// holder is younger, and aborts otherwise. The age of a txn is its txn id, so
+// wait-die can not be used with TIMESTAMP_TYPE_DECENTRALIZED, where txn ids
+// are drawn from per-thread ranges and do not follow the begin order.
 //===--------------------------------------------------------------------===//
 class PessimisticTxnManager : public TransactionManager {
  public:
-  PessimisticTxnManager(){}
+  PessimisticTxnManager() : TransactionManager(CONCURRENCY_TYPE_PESSIMISTIC) {}
   virtual ~PessimisticTxnManager() {}
 
   static PessimisticTxnManager &GetInstance();
@@ -34,6 +41,14 @@ class PessimisticTxnManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void GetVisibleTuples(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t begin_tuple_id, const oid_t end_tuple_id,
+      std::vector<oid_t> &selection) {
+    GetSnapshotVisibleTuples(tile_group_header, begin_tuple_id, end_tuple_id,
+                             selection);
+  }
+
   virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
                        const oid_t &tuple_id);
 
@@ -59,13 +74,13 @@ class PessimisticTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Result CommitTransaction();
+  virtual Result DCommitTransaction();
 
-  virtual Result AbortTransaction();
+  virtual Result DAbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *DBeginTransaction() {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
+    cid_t begin_cid = GetNextBeginCommitId();
     Transaction *txn = new Transaction(txn_id, begin_cid);
     current_txn = txn;
 
@@ -88,6 +103,25 @@ class PessimisticTxnManager : public TransactionManager {
     pessimistic_released_rdlock.clear();
   }
 
+  // Must not be called while txns are running. Throws for wait-die with
+  // decentralized timestamps.
+  void SetLockWaitType(const LockWaitType lock_wait_type,
+                       const uint64_t timeout = LOCK_WAIT_TIMEOUT);
+
+  LockWaitType GetLockWaitType() const { return lock_wait_type_; }
+
+  LockWaitStats GetLockWaitStats() const {
+    return lock_wait_table_.GetStats();
+  }
+
+  void ResetLockWaitStats() { lock_wait_table_.ResetStats(); }
+
+ protected:
+  virtual bool SupportsTimestampType(const TimestampType timestamp_type) const {
+    return timestamp_type != TIMESTAMP_TYPE_DECENTRALIZED ||
+           lock_wait_type_ != LOCK_WAIT_TYPE_WAIT_DIE;
+  }
+
  private:
 #define READ_COUNT_MASK 0xFF
 #define TXNID_MASK 0x00FFFFFFFFFFFFFF
@@ -100,7 +134,18 @@ class PessimisticTxnManager : public TransactionManager {
   }
 
   void ReleaseReadLock(const storage::TileGroupHeader *const tile_group_header,
-                       const oid_t &tuple_id);
+                       const oid_t &tile_group_id, const oid_t &tuple_id);
+
+  bool TryAcquireReadLock(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id);
+
+  // Wake up the txns waiting for a lock on the tuple
+  void NotifyLockWaiters(const oid_t &tile_group_id, const oid_t &tuple_id);
+
+  LockWaitType lock_wait_type_ = LOCK_WAIT_TYPE_NO_WAIT;
+
+  LockWaitTable lock_wait_table_;
 
 };
 }
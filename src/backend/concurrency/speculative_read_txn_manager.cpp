@@ -291,7 +291,7 @@ void SpeculativeReadTxnManager::PerformDelete(const ItemPointer &location) {
   }
 }
 
-Result SpeculativeReadTxnManager::CommitTransaction() {
+Result SpeculativeReadTxnManager::DCommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
   auto &manager = catalog::Manager::GetInstance();
@@ -415,7 +415,7 @@ Result SpeculativeReadTxnManager::CommitTransaction() {
   return ret;
 }
 
-Result SpeculativeReadTxnManager::AbortTransaction() {
+Result SpeculativeReadTxnManager::DAbortTransaction() {
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
   auto &manager = catalog::Manager::GetInstance();
 
@@ -66,7 +66,8 @@ extern thread_local SpecTxnContext spec_txn_context;
 
 class SpeculativeReadTxnManager : public TransactionManager {
  public:
-  SpeculativeReadTxnManager() {}
+  SpeculativeReadTxnManager()
+      : TransactionManager(CONCURRENCY_TYPE_SPECULATIVE_READ) {}
 
   virtual ~SpeculativeReadTxnManager() {}
 
@@ -101,9 +102,9 @@ class SpeculativeReadTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *DBeginTransaction() {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
+    cid_t begin_cid = GetNextBeginCommitId();
     Transaction *txn = new Transaction(txn_id, begin_cid);
     current_txn = txn;
     spec_txn_context.SetBeginCid(begin_cid);
@@ -202,9 +203,9 @@ class SpeculativeReadTxnManager : public TransactionManager {
     spec_txn_context.inner_dep_set_lock_.Unlock();
   }
 
-  virtual Result CommitTransaction();
+  virtual Result DCommitTransaction();
 
-  virtual Result AbortTransaction();
+  virtual Result DAbortTransaction();
 
  private:
   // records all running transactions.
@@ -120,11 +120,18 @@ bool SsiTxnManager::AcquireOwnership(
   }
 
   {
-    GetReadLock(tile_group_header, tuple_id);
-    ReadList *header = GetReaderList(tile_group_header, tuple_id);
+    ReadList *header = GetReaderList(tile_group_header, tuple_id)->load();
 
     bool should_abort = false;
     while (header != nullptr) {
+      auto next = header->next.load();
+
+      // skip the entries being removed
+      if (IsRemoved(next)) {
+        header = Unmarked(next);
+        continue;
+      }
+
       // For all owner of siread lock on this version
       auto owner_ctx = header->txn_ctx;
 
@@ -134,7 +141,7 @@ bool SsiTxnManager::AcquireOwnership(
       // Myself || owner is (or should be) aborted
       // skip
       if (owner_ctx == current_ssi_txn_ctx || owner_ctx->is_abort()) {
-        header = header->next;
+        header = next;
 
         // Unlock the transaction context
         owner_ctx->lock_.Unlock();
@@ -162,12 +169,11 @@ bool SsiTxnManager::AcquireOwnership(
         }
       }
 
-      header = header->next;
+      header = next;
 
       // Unlock the transaction context
       owner_ctx->lock_.Unlock();
     }
-    ReleaseReadLock(tile_group_header, tuple_id);
 
     if (should_abort) return false;
   }
@@ -418,7 +424,7 @@ void SsiTxnManager::PerformDelete(const ItemPointer &location) {
   }
 }
 
-Result SsiTxnManager::CommitTransaction() {
+Result SsiTxnManager::DCommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
   auto &manager = catalog::Manager::GetInstance();
@@ -460,6 +466,8 @@ Result SsiTxnManager::CommitTransaction() {
     oid_t tile_group_id = tile_group_entry.first;
     auto tile_group = manager.GetTileGroup(tile_group_id);
     auto tile_group_header = tile_group->GetHeader();
+    // the inserts into the tile group are logged together
+    std::vector<oid_t> insert_slots;
     for (auto &tuple_entry : tile_group_entry.second) {
       auto tuple_slot = tuple_entry.first;
       if (tuple_entry.second == RW_TYPE_UPDATE) {
@@ -506,8 +514,7 @@ Result SsiTxnManager::CommitTransaction() {
         PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot) ==
                current_txn->GetTransactionId());
         // set the begin commit id to persist insert
-        ItemPointer insert_location(tile_group_id, tuple_slot);
-        log_manager.LogInsert(end_commit_id, insert_location);
+        insert_slots.push_back(tuple_slot);
 
         tile_group_header->SetBeginCommitId(tuple_slot, end_commit_id);
         tile_group_header->SetEndCommitId(tuple_slot, MAX_CID);
@@ -528,18 +535,21 @@ Result SsiTxnManager::CommitTransaction() {
         tile_group_header->SetTransactionId(tuple_slot, INVALID_TXN_ID);
       }
     }
+    if (insert_slots.empty() == false) {
+      log_manager.LogInserts(end_commit_id, tile_group_id, insert_slots);
+    }
   }
   log_manager.LogCommitTransaction(end_commit_id);
   current_txn = nullptr;
   current_ssi_txn_ctx->is_finish_ = true;
 
-  end_txn_table_[current_ssi_txn_ctx->transaction_->GetEndCommitId()] = current_ssi_txn_ctx;
   EpochManagerFactory::GetInstance().ExitEpoch(current_ssi_txn_ctx->transaction_->GetEpochId());
+  AddFinishedTxn(current_ssi_txn_ctx);
 
   return ret;
 }
 
-Result SsiTxnManager::AbortTransaction() {
+Result SsiTxnManager::DAbortTransaction() {
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
 
   if (current_ssi_txn_ctx->is_abort_ == false) {
@@ -613,15 +623,14 @@ Result SsiTxnManager::AbortTransaction() {
   }
 
 
-  RemoveReader(current_txn);
+  RemoveReader(current_ssi_txn_ctx);
 
   if(current_ssi_txn_ctx->transaction_->GetEndCommitId() == MAX_CID) {
     current_ssi_txn_ctx->transaction_->SetEndCommitId(GetNextCommitId());
   }
-  end_txn_table_[current_ssi_txn_ctx->transaction_->GetEndCommitId()] = current_ssi_txn_ctx;
-
 
   EpochManagerFactory::GetInstance().ExitEpoch(current_txn->GetEpochId());
+  AddFinishedTxn(current_ssi_txn_ctx);
 
   // delete current_ssi_txn_ctx;
   // delete current_txn;
@@ -630,94 +639,127 @@ Result SsiTxnManager::AbortTransaction() {
   return Result::RESULT_ABORTED;
 }
 
-void SsiTxnManager::RemoveReader(Transaction *txn) {
-  LOG_TRACE("release SILock");
-
-  // Remove from the read list of accessed tuples
-  auto &rw_set = txn->GetRWSet();
-
-  for (auto &tile_group_entry : rw_set) {
-    oid_t tile_group_id = tile_group_entry.first;
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tile_group_id);
-    if (tile_group == nullptr) continue;
+void SsiTxnManager::RemoveSIReader(ReadList *reader) {
+  auto tile_group =
+      catalog::Manager::GetInstance().GetTileGroup(reader->tile_group_id);
+  // the reader lists went away with the tile group
+  if (tile_group == nullptr) return;
+
+  // Mark the entry, no entry can be linked behind it from now on
+  auto next = reader->next.load();
+  while (IsRemoved(next) == false &&
+         reader->next.compare_exchange_weak(next, MarkRemoved(next)) ==
+             false)
+    ;
+
+  // Unlink the entry
+  auto headp = GetReaderList(tile_group->GetHeader(), reader->tuple_id);
+  bool unlinked = false;
+  while (unlinked == false) {
+    auto prev = headp;
+    auto current = prev->load();
+
+    while (true) {
+      // the previous entry is being removed, start over
+      if (IsRemoved(current)) {
+        _mm_pause();
+        break;
+      }
 
-    auto tile_group_header = tile_group->GetHeader();
-    for (auto &tuple_entry : tile_group_entry.second) {
-      auto tuple_slot = tuple_entry.first;
+      // not in the list anymore, the tuple slot has been reused
+      if (current == nullptr) {
+        unlinked = true;
+        break;
+      }
 
-      // we don't have reader lock on insert
-      if (tuple_entry.second == RW_TYPE_INSERT ||
-          tuple_entry.second == RW_TYPE_INS_DEL) {
-        continue;
+      if (current == reader) {
+        auto expected = reader;
+        unlinked = prev->compare_exchange_strong(
+            expected, Unmarked(reader->next.load()));
+        break;
       }
-      RemoveSIReader(tile_group_header, tuple_slot, txn->GetTransactionId());
+
+      prev = &current->next;
+      current = prev->load();
     }
   }
-  LOG_TRACE("release SILock finish");
 }
 
-// Clean obsolete txn record
-// Current implementation might be very expensive, consider using dependency
-// count
-void SsiTxnManager::CleanUp() {
-  if(!stopped) {
-    stopped = true;
-    vacuum.join();
+void SsiTxnManager::RemoveReader(SsiTxnContext *txn_ctx) {
+  LOG_TRACE("release SILock");
+
+  if (txn_ctx->readers_removed_) return;
+
+  // Remove from the read list of accessed tuples
+  for (auto reader : txn_ctx->reads_) {
+    RemoveSIReader(reader);
   }
+  txn_ctx->readers_removed_ = true;
 
-  std::unordered_set <cid_t> gc_cids;
-  {
-    auto iter = end_txn_table_.lock_table();
+  LOG_TRACE("release SILock finish");
+}
 
-    for (auto &it : iter) {
-      auto ctx_ptr = it.second;
-      txn_table_.erase(ctx_ptr->transaction_->GetTransactionId());
-      gc_cids.insert(it.first);
+void SsiTxnManager::AddFinishedTxn(SsiTxnContext *txn_ctx) {
+  auto head = finished_txns_.load();
+  do {
+    txn_ctx->next_finished_ = head;
+  } while (finished_txns_.compare_exchange_weak(head, txn_ctx) == false);
+}
 
-      if (!ctx_ptr->is_abort()) {
-        RemoveReader(ctx_ptr->transaction_);
-      }
+void SsiTxnManager::ReclaimTxns(const cid_t max_cid) {
+  // Take the txns finished since the last round
+  auto txn_ctx = finished_txns_.exchange(nullptr);
+  while (txn_ctx != nullptr) {
+    ending_txns_.push_back(txn_ctx);
+    txn_ctx = txn_ctx->next_finished_;
+  }
+
+  // Free the txns unregistered before every running txn began, no running
+  // txn can still hold their entries or contexts
+  std::vector<SsiTxnContext *> retired_txns;
+  for (auto ctx_ptr : retired_txns_) {
+    if (ctx_ptr->retire_cid_ <= max_cid) {
       delete ctx_ptr->transaction_;
       delete ctx_ptr;
-      gc_cid = std::max(gc_cid, it.first);
+    } else {
+      retired_txns.push_back(ctx_ptr);
     }
   }
+  retired_txns_.swap(retired_txns);
 
-  for(auto cid : gc_cids) {
-    end_txn_table_.erase(cid);
+  // Unregister the txns that ended before every running txn began, they
+  // cannot be part of a conflict anymore
+  std::vector<SsiTxnContext *> ending_txns;
+  for (auto ctx_ptr : ending_txns_) {
+    if (ctx_ptr->transaction_->GetEndCommitId() < max_cid) {
+      txn_table_.erase(ctx_ptr->transaction_->GetTransactionId());
+      RemoveReader(ctx_ptr);
+      ctx_ptr->retire_cid_ = GetCurrentCommitId();
+      retired_txns_.push_back(ctx_ptr);
+    } else {
+      ending_txns.push_back(ctx_ptr);
+    }
   }
+  ending_txns_.swap(ending_txns);
 }
 
-void SsiTxnManager::CleanUpBg() {
-  while(!stopped) {
-    std::this_thread::sleep_for(std::chrono::milliseconds(EPOCH_LENGTH));
-    auto max_begin = GetMaxCommittedCid();
-    std::unordered_set<cid_t> gc_cids;
-    while (gc_cid < max_begin) {
-      SsiTxnContext *ctx_ptr = nullptr;
-      if (!end_txn_table_.find(gc_cid, ctx_ptr)) {
-        gc_cid++;
-        continue;
-      }
-
-      // find garbage
-      gc_cids.insert(gc_cid);
-      txn_table_.erase(ctx_ptr->transaction_->GetTransactionId());
-
-      gc_cids.insert(gc_cid);
+// Clean obsolete txn record
+void SsiTxnManager::CleanUp() {
+  if(!stopped) {
+    stopped = true;
+    vacuum.join();
+  }
 
-      if(!ctx_ptr->is_abort()) {
-        RemoveReader(ctx_ptr->transaction_);
-      }
-      delete ctx_ptr->transaction_;
-      delete ctx_ptr;
-      gc_cid++;
-    }
+  // No txn is running, unregister every finished txn, then free them
+  ReclaimTxns(MAX_CID);
+  ReclaimTxns(MAX_CID);
+}
 
-    for(auto cid : gc_cids) {
-      end_txn_table_.erase(cid);
-    }
+void SsiTxnManager::CleanUpBg() {
+  while(!stopped) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(
+        EpochManagerFactory::GetInstance().GetEpochLength()));
+    ReclaimTxns(GetMaxCommittedCid());
   }
 }
 
@@ -17,11 +17,31 @@
 #include "backend/catalog/manager.h"
 #include "libcuckoo/cuckoohash_map.hh"
 
-#include <map>
+#include <atomic>
+#include <vector>
 
 namespace peloton {
 namespace concurrency {
 
+struct SsiTxnContext;
+
+// Entry of the reader list (SIREAD locks) of a tuple.
+// Entries are only pushed at the head of a list. A reader removes its entry
+// by first marking the low bit of its next pointer, so that no entry gets
+// linked behind an entry being removed, and then unlinking it.
+struct ReadList {
+  SsiTxnContext *txn_ctx;
+  std::atomic<ReadList *> next;
+  // tuple whose list holds the entry
+  oid_t tile_group_id;
+  oid_t tuple_id;
+  ReadList(SsiTxnContext *t, const oid_t tile_group_id, const oid_t tuple_id)
+      : txn_ctx(t),
+        next(nullptr),
+        tile_group_id(tile_group_id),
+        tuple_id(tuple_id) {}
+};
+
 struct SsiTxnContext {
   SsiTxnContext(Transaction *t)
       : transaction_(t),
@@ -29,6 +49,14 @@ struct SsiTxnContext {
         out_conflict_(false),
         is_abort_(false),
         is_finish_(false) {}
+
+  // entries may only be freed once no running txn can traverse them
+  ~SsiTxnContext() {
+    for (auto reader : reads_) {
+      delete reader;
+    }
+  }
+
   Transaction *transaction_;
 
   // is_abort() could run without any locks
@@ -42,29 +70,37 @@ struct SsiTxnContext {
   bool is_abort_;
   bool is_finish_;  // is commit finished
   Spinlock lock_;
-};
 
-extern thread_local SsiTxnContext *current_ssi_txn_ctx;
+  // entries of the txn in the reader lists of the tuples it read
+  std::vector<ReadList *> reads_;
+  // have the entries been unlinked ?
+  bool readers_removed_ = false;
 
-struct ReadList {
-  SsiTxnContext *txn_ctx;
-  ReadList *next;
-  ReadList() : txn_ctx(nullptr), next(nullptr) {}
-  ReadList(SsiTxnContext *t) : txn_ctx(t), next(nullptr) {}
+  // next txn in the list of finished txns
+  SsiTxnContext *next_finished_ = nullptr;
+  // commit id when the txn was unregistered
+  cid_t retire_cid_ = INVALID_CID;
 };
 
-struct SIReadLock {
-  SIReadLock() : list(nullptr) {}
-  ReadList *list;
-  Spinlock lock;
-  void Lock() { lock.Lock(); }
-  void Unlock() { lock.Unlock(); }
-};
+extern thread_local SsiTxnContext *current_ssi_txn_ctx;
 
+/**
+ * Serializable snapshot isolation.
+ *
+ * SIREAD locks are kept in a lock-free reader list per tuple, whose head is
+ * in the reserved field of the tuple. Finished txns are pushed on a lock-free
+ * list and reclaimed by the vacuum thread in two epoch-based steps: once no
+ * running txn is concurrent with a txn, its entries are unlinked and it is
+ * unregistered; once the txns running at that point are over, its memory is
+ * freed.
+ */
 class SsiTxnManager : public TransactionManager {
  public:
-  SsiTxnManager() : stopped(false), cleaned(false){
-    gc_cid = 0;
+  SsiTxnManager()
+      : TransactionManager(CONCURRENCY_TYPE_SSI),
+        stopped(false),
+        cleaned(false) {
+    finished_txns_ = ATOMIC_VAR_INIT(nullptr);
     vacuum = std::thread(&SsiTxnManager::CleanUpBg, this);
   }
 
@@ -82,6 +118,14 @@ class SsiTxnManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void GetVisibleTuples(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t begin_tuple_id, const oid_t end_tuple_id,
+      std::vector<oid_t> &selection) {
+    GetSnapshotVisibleTuples(tile_group_header, begin_tuple_id, end_tuple_id,
+                             selection);
+  }
+
   virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
                        const oid_t &tuple_id);
 
@@ -107,14 +151,14 @@ class SsiTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *DBeginTransaction() {
     // txn_manager_mutex_.WriteLock();
 
     // protect beginTransaction with a global lock
     // to ensure that:
     //    txn_id_a > txn_id_b --> begin_cid_a > begin_cid_b
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
+    cid_t begin_cid = GetNextBeginCommitId();
     Transaction *txn = new Transaction(txn_id, begin_cid);
 
     current_ssi_txn_ctx = new SsiTxnContext(txn);
@@ -137,24 +181,21 @@ class SsiTxnManager : public TransactionManager {
 
   virtual void EndTransaction() { PL_ASSERT(false); }
 
-  virtual Result CommitTransaction();
+  virtual Result DCommitTransaction();
 
-  virtual Result AbortTransaction();
+  virtual Result DAbortTransaction();
 
  private:
-  // Mutex to protect txn_table_ and sireadlocks
-  // RWLock txn_manager_mutex_;
-  // mutex to avoid re-enter clean up
-  std::mutex clean_mutex_;
   // Transaction contexts
   cuckoohash_map<txn_id_t, SsiTxnContext *> txn_table_;
 
-  cuckoohash_map<cid_t, SsiTxnContext *> end_txn_table_;
+  // Txns finished since the last vacuum round
+  std::atomic<SsiTxnContext *> finished_txns_;
+  // Finished txns that are still registered (vacuum thread only)
+  std::vector<SsiTxnContext *> ending_txns_;
+  // Unregistered txns waiting to be freed (vacuum thread only)
+  std::vector<SsiTxnContext *> retired_txns_;
 
-  cid_t gc_cid;
-  // SIReadLocks
-  typedef std::map<oid_t, std::unique_ptr<SIReadLock>> TupleReadlocks;
-  std::map<std::pair<oid_t, oid_t>, std::unique_ptr<SIReadLock>> sireadlocks;
   // Used to make the vacuum thread stop
   bool stopped;
   bool cleaned;
@@ -162,7 +203,7 @@ class SsiTxnManager : public TransactionManager {
   std::thread vacuum;
 
   // init reserved area of a tuple
-  // creator txnid | lock (for read list) | read list head
+  // creator txnid | read list head
   // The txn_id could only be the cur_txn's txn id.
   void InitTupleReserved(const txn_id_t txn_id, const oid_t tile_group_id,
                          const oid_t tuple_id) {
@@ -178,8 +219,7 @@ class SsiTxnManager : public TransactionManager {
     auto reserved_area = tile_group_header->GetReservedFieldRef(tuple_id);
 
     *(txn_id_t *)(reserved_area + CREATOR_OFFSET) = txn_id;
-    new ((reserved_area + LOCK_OFFSET)) Spinlock();
-    *(ReadList **)(reserved_area + LIST_OFFSET) = nullptr;
+    new ((reserved_area + LIST_OFFSET)) std::atomic<ReadList *>(nullptr);
   }
 
   // Get creator of a tuple
@@ -189,74 +229,44 @@ class SsiTxnManager : public TransactionManager {
         tuple_id) + CREATOR_OFFSET);
   }
 
-  void GetReadLock(const storage::TileGroupHeader *const tile_group_header,
-                   const oid_t &tuple_id) {
-    auto lock = (Spinlock *)(tile_group_header->GetReservedFieldRef(tuple_id) +
-                             LOCK_OFFSET);
-    lock->Lock();
+  std::atomic<ReadList *> *GetReaderList(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t &tuple_id) {
+    return (std::atomic<ReadList *> *)(
+        tile_group_header->GetReservedFieldRef(tuple_id) + LIST_OFFSET);
   }
 
-  void ReleaseReadLock(const storage::TileGroupHeader *const tile_group_header,
-                       const oid_t tuple_id) {
-    auto lock = (Spinlock *)(tile_group_header->GetReservedFieldRef(tuple_id) +
-                             LOCK_OFFSET);
-    lock->Unlock();
+  // Is the entry owning this next pointer being removed ?
+  static inline bool IsRemoved(const ReadList *next) {
+    return (reinterpret_cast<uintptr_t>(next) & 1) != 0;
   }
 
-  // Add the current txn into the reader list of a tuple
-  void AddSIReader(storage::TileGroup *tile_group, const oid_t &tuple_id) {
-    ReadList *reader = new ReadList(current_ssi_txn_ctx);
-
-    GetReadLock(tile_group->GetHeader(), tuple_id);
-    ReadList **headp = (ReadList **)(
-        tile_group->GetHeader()->GetReservedFieldRef(tuple_id) + LIST_OFFSET);
-    reader->next = *headp;
-    *headp = reader;
-    ReleaseReadLock(tile_group->GetHeader(), tuple_id);
+  static inline ReadList *MarkRemoved(const ReadList *next) {
+    return reinterpret_cast<ReadList *>(reinterpret_cast<uintptr_t>(next) |
+                                        1);
   }
 
-  // Remove reader from the reader list of a tuple
-  void RemoveSIReader(storage::TileGroupHeader *tile_group_header,
-                      const oid_t &tuple_id, txn_id_t txn_id) {
-    LOG_TRACE("Acquire read lock");
-    GetReadLock(tile_group_header, tuple_id);
-    LOG_TRACE("Acquired");
-
-    ReadList **headp = (ReadList **)(
-        tile_group_header->GetReservedFieldRef(tuple_id) + LIST_OFFSET);
-
-    ReadList fake_header;
-    fake_header.next = *headp;
-    auto prev = &fake_header;
-    auto next = prev->next;
-    bool find = false;
-
-    while (next != nullptr) {
-      if (next->txn_ctx->transaction_->GetTransactionId() == txn_id) {
-        find = true;
-        prev->next = next->next;
-        delete next;
-        break;
-      }
-      prev = next;
-      next = next->next;
-    }
-
-    *headp = fake_header.next;
-
-    ReleaseReadLock(tile_group_header, tuple_id);
-    if (find == false) {
-      PL_ASSERT(false);
-    }
+  static inline ReadList *Unmarked(const ReadList *next) {
+    return reinterpret_cast<ReadList *>(reinterpret_cast<uintptr_t>(next) &
+                                        ~static_cast<uintptr_t>(1));
   }
 
-  ReadList *GetReaderList(
-      const storage::TileGroupHeader *const tile_group_header,
-      const oid_t &tuple_id) {
-    return *(ReadList **)(tile_group_header->GetReservedFieldRef(tuple_id) +
-                          LIST_OFFSET);
+  // Add the current txn into the reader list of a tuple
+  void AddSIReader(storage::TileGroup *tile_group, const oid_t &tuple_id) {
+    ReadList *reader = new ReadList(current_ssi_txn_ctx,
+                                    tile_group->GetTileGroupId(), tuple_id);
+    current_ssi_txn_ctx->reads_.push_back(reader);
+
+    auto headp = GetReaderList(tile_group->GetHeader(), tuple_id);
+    ReadList *head = headp->load();
+    do {
+      reader->next = head;
+    } while (headp->compare_exchange_weak(head, reader) == false);
   }
 
+  // Remove an entry from the reader list of its tuple
+  void RemoveSIReader(ReadList *reader);
+
   inline bool GetInConflict(SsiTxnContext *txn_ctx) {
     return txn_ctx->in_conflict_;
   }
@@ -275,15 +285,22 @@ class SsiTxnManager : public TransactionManager {
     txn_ctx->out_conflict_ = true;
   }
 
-  void RemoveReader(Transaction *txn);
+  // Remove the txn from the reader lists of the tuples it read
+  void RemoveReader(SsiTxnContext *txn_ctx);
+
+  // Hand a finished txn over to the vacuum thread
+  void AddFinishedTxn(SsiTxnContext *txn_ctx);
+
+  // Unregister the finished txns that ended before max_cid, and free the
+  // ones unregistered before max_cid
+  void ReclaimTxns(const cid_t max_cid);
 
   // Free contexts for SSI manager
   void CleanUpBg();
   void CleanUp();
 
   static const int CREATOR_OFFSET = 0;
-  static const int LOCK_OFFSET = (CREATOR_OFFSET + sizeof(txn_id_t));
-  static const int LIST_OFFSET = (LOCK_OFFSET + sizeof(txn_id_t));
+  static const int LIST_OFFSET = (CREATOR_OFFSET + sizeof(txn_id_t));
 };
 }
 }
@@ -38,6 +38,15 @@ enum RWType {
   RW_TYPE_INS_DEL  // delete after insert.
 };
 
+// Tuples [begin_tuple_id, end_tuple_id) of a tile group read by a scan while
+// the tile group was all-visible with the given generation
+struct ReadRange {
+  oid_t tile_group_id;
+  oid_t begin_tuple_id;
+  oid_t end_tuple_id;
+  uint64_t generation;
+};
+
 class Transaction : public Printable {
   Transaction(Transaction const &) = delete;
 
@@ -83,6 +92,10 @@ class Transaction : public Printable {
 
   void RecordRead(const ItemPointer &);
 
+  void RecordReadRange(const ReadRange &read_range) {
+    read_ranges_.push_back(read_range);
+  }
+
   void RecordUpdate(const ItemPointer &);
 
   void RecordInsert(const ItemPointer &);
@@ -92,6 +105,8 @@ class Transaction : public Printable {
 
   const std::map<oid_t, std::map<oid_t, RWType>> &GetRWSet();
 
+  const std::vector<ReadRange> &GetReadRanges() const { return read_ranges_; }
+
   // Get a string representation for debugging
   const std::string GetInfo() const;
 
@@ -124,6 +139,9 @@ class Transaction : public Printable {
 
   std::map<oid_t, std::map<oid_t, RWType>> rw_set_;
 
+  // scan reads, validated per tile group instead of per tuple
+  std::vector<ReadRange> read_ranges_;
+
   // result of the transaction
   Result result_ = peloton::RESULT_SUCCESS;
 
@@ -10,8 +10,18 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <chrono>
+#include <mutex>
+#include <string>
+
+#ifdef __AVX2__
+#include <immintrin.h>
+#endif
+
 #include "backend/concurrency/transaction_manager.h"
+#include "backend/common/exception.h"
 #include "backend/expression/container_tuple.h"
+#include "backend/logging/log_manager.h"
 
 namespace peloton {
 namespace concurrency {
@@ -19,6 +29,413 @@ namespace concurrency {
 // Current transaction for the backend thread
 thread_local Transaction *current_txn;
 
+//===--------------------------------------------------------------------===//
+// Metrics
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+// Set while the backend thread is committing, an abort then means that the
+// transaction failed its validation
+thread_local bool txn_committing = false;
+
+// Set once the abort of the committing transaction has been counted
+thread_local bool txn_commit_aborted = false;
+
+std::string GetProtocolName(const ConcurrencyType protocol) {
+  switch (protocol) {
+    case CONCURRENCY_TYPE_OPTIMISTIC:
+      return "optimistic";
+    case CONCURRENCY_TYPE_PESSIMISTIC:
+      return "pessimistic";
+    case CONCURRENCY_TYPE_SPECULATIVE_READ:
+      return "speculative_read";
+    case CONCURRENCY_TYPE_EAGER_WRITE:
+      return "eager_write";
+    case CONCURRENCY_TYPE_TO:
+      return "ts_order";
+    case CONCURRENCY_TYPE_SSI:
+      return "ssi";
+    case CONCURRENCY_TYPE_OCC_RB:
+      return "optimistic_rb";
+    default:
+      return "unknown";
+  }
+}
+
+}  // End anonymous namespace
+
+TransactionManager::TransactionManager(ConcurrencyType protocol) {
+  next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
+  next_cid_ = ATOMIC_VAR_INIT(START_CID);
+  maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
+  clock_offset_ = ATOMIC_VAR_INIT(0);
+  generation_ = ATOMIC_VAR_INIT(0);
+
+  auto &metrics = MetricsRegistry::GetInstance();
+  auto prefix = "txn." + GetProtocolName(protocol);
+
+  begin_counter_id_ = metrics.RegisterCounter(prefix + ".begin");
+  commit_counter_id_ = metrics.RegisterCounter(prefix + ".commit");
+  abort_counter_ids_[ABORT_REASON_USER] =
+      metrics.RegisterCounter(prefix + ".abort.user");
+  abort_counter_ids_[ABORT_REASON_CONFLICT] =
+      metrics.RegisterCounter(prefix + ".abort.conflict");
+  abort_counter_ids_[ABORT_REASON_VALIDATION] =
+      metrics.RegisterCounter(prefix + ".abort.validation");
+}
+
+Transaction *TransactionManager::BeginTransaction() {
+  MetricsRegistry::GetInstance().Increment(begin_counter_id_);
+
+  return DBeginTransaction();
+}
+
+Result TransactionManager::CommitTransaction() {
+  txn_committing = true;
+  txn_commit_aborted = false;
+
+  // the transaction is gone after the commit
+  cid_t read_cid = INVALID_CID;
+  bool read_only = true;
+  if (current_txn != nullptr) {
+    read_cid = current_txn->GetBeginCommitId();
+    read_only = current_txn->IsReadOnly();
+  }
+
+  auto result = DCommitTransaction();
+
+  txn_committing = false;
+
+  // In pipelined commit mode, the commit returns before its log record is
+  // durable. The reply to the client is held until it, and every commit it
+  // may depend on, is (see peloton_wait_for_commit). A read-only transaction
+  // wrote nothing that must be durable and is not held.
+  auto &log_manager = logging::LogManager::GetInstance();
+  if (result == RESULT_SUCCESS && read_only == false &&
+      log_manager.GetPipelinedCommit() == true) {
+    log_manager.DeferCommitAcknowledgement(read_cid);
+  }
+
+  auto &metrics = MetricsRegistry::GetInstance();
+  if (result == RESULT_SUCCESS) {
+    metrics.Increment(commit_counter_id_);
+  } else if (txn_commit_aborted == false) {
+    metrics.Increment(abort_counter_ids_[ABORT_REASON_VALIDATION]);
+  }
+
+  return result;
+}
+
+Result TransactionManager::AbortTransaction() {
+  // The transaction is gone once aborted
+  auto reason = ABORT_REASON_USER;
+  if (txn_committing == true) {
+    reason = ABORT_REASON_VALIDATION;
+    txn_commit_aborted = true;
+  } else if (current_txn != nullptr &&
+             current_txn->GetResult() == RESULT_FAILURE) {
+    reason = ABORT_REASON_CONFLICT;
+  }
+
+  MetricsRegistry::GetInstance().Increment(abort_counter_ids_[reason]);
+
+  return DAbortTransaction();
+}
+
+//===--------------------------------------------------------------------===//
+// Decentralized timestamps
+//===--------------------------------------------------------------------===//
+
+namespace {
+
+// Per-thread state of the decentralized allocation. It is only valid for the
+// manager and the generation it was set up with.
+struct TimestampContext {
+  const TransactionManager *owner = nullptr;
+  uint64_t generation = 0;
+  txn_id_t next_txn_id = INVALID_TXN_ID;
+  txn_id_t end_txn_id = INVALID_TXN_ID;
+  cid_t last_cid = INVALID_CID;
+};
+
+// Slots that are not held by any thread, with the state their last thread
+// left behind. A new thread taking over a slot also takes over that state, so
+// that its commit ids keep increasing past the ones of the previous thread.
+struct TimestampSlots {
+  std::mutex mutex;
+  std::vector<std::pair<oid_t, TimestampContext>> free_slots;
+  oid_t used_count = 0;
+};
+
+TimestampSlots timestamp_slots;
+
+// Slot of the thread in the low bits of its commit ids. It is taken on the
+// first clock commit id of the thread, and given back when the thread exits.
+struct TimestampThread {
+  oid_t slot = INVALID_OID;
+  TimestampContext context;
+
+  oid_t GetSlot() {
+    if (slot != INVALID_OID) return slot;
+
+    std::lock_guard<std::mutex> lock(timestamp_slots.mutex);
+    if (timestamp_slots.free_slots.empty() == false) {
+      slot = timestamp_slots.free_slots.back().first;
+      context = timestamp_slots.free_slots.back().second;
+      timestamp_slots.free_slots.pop_back();
+    } else if (timestamp_slots.used_count < (1 << TIMESTAMP_THREAD_BITS)) {
+      slot = timestamp_slots.used_count++;
+    } else {
+      throw TransactionException(
+          "All " + std::to_string(1 << TIMESTAMP_THREAD_BITS) +
+          " timestamp thread slots are in use");
+    }
+
+    return slot;
+  }
+
+  ~TimestampThread() {
+    if (slot == INVALID_OID) return;
+
+    std::lock_guard<std::mutex> lock(timestamp_slots.mutex);
+    timestamp_slots.free_slots.emplace_back(slot, context);
+  }
+};
+
+thread_local TimestampThread timestamp_thread;
+
+// Get the state of the thread, reset if it belongs to another manager or to
+// an older generation
+TimestampContext &GetTimestampContext(const TransactionManager *owner,
+                                      const uint64_t generation) {
+  auto &context = timestamp_thread.context;
+
+  if (context.owner != owner || context.generation != generation) {
+    context.owner = owner;
+    context.generation = generation;
+    context.next_txn_id = INVALID_TXN_ID;
+    context.end_txn_id = INVALID_TXN_ID;
+    context.last_cid = INVALID_CID;
+  }
+
+  return context;
+}
+
+int64_t GetSteadyClockNanoseconds() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+}  // End anonymous namespace
+
+void TransactionManager::SetTimestampType(
+    const TimestampType timestamp_type) {
+  std::lock_guard<std::mutex> lock(timestamp_type_mutex_);
+
+  if (timestamp_type == timestamp_type_) {
+    return;
+  }
+
+  if (SupportsTimestampType(timestamp_type) == false) {
+    throw Exception("Timestamp type " + std::to_string(timestamp_type) +
+                    " is not supported by the concurrency protocol");
+  }
+
+  if (timestamp_type == TIMESTAMP_TYPE_DECENTRALIZED) {
+    // the clock takes over from the shared counters
+    ResetClock(next_cid_.load());
+  } else {
+    // the shared counters take over from the clock
+    next_cid_ = GetCurrentCommitId() + (1 << TIMESTAMP_THREAD_BITS);
+    generation_++;
+  }
+
+  timestamp_type_ = timestamp_type;
+}
+
+void TransactionManager::SetNextCid(cid_t cid) {
+  next_cid_ = cid;
+
+  if (timestamp_type_ == TIMESTAMP_TYPE_DECENTRALIZED) {
+    ResetClock(cid);
+  }
+}
+
+uint64_t TransactionManager::GetClockTicks() const {
+  return GetSteadyClockNanoseconds() + clock_offset_.load();
+}
+
+void TransactionManager::ResetClock(const cid_t cid) {
+  // ticks are shifted left to make room for the thread slot
+  int64_t ticks = (cid >> TIMESTAMP_THREAD_BITS) + 1;
+  clock_offset_ = ticks - GetSteadyClockNanoseconds();
+  generation_++;
+}
+
+txn_id_t TransactionManager::GetNextLocalTransactionId() {
+  auto &context = GetTimestampContext(this, generation_.load());
+
+  if (context.next_txn_id == context.end_txn_id) {
+    // reserve a new block of transaction ids
+    context.next_txn_id = next_txn_id_.fetch_add(TXN_ID_BLOCK_SIZE);
+    context.end_txn_id = context.next_txn_id + TXN_ID_BLOCK_SIZE;
+  }
+
+  return context.next_txn_id++;
+}
+
+cid_t TransactionManager::GetNextClockCommitId() {
+  // may take over the slot, and the state, of a thread that exited
+  cid_t thread_slot = timestamp_thread.GetSlot();
+  auto &context = GetTimestampContext(this, generation_.load());
+
+  cid_t temp_cid = (GetClockTicks() << TIMESTAMP_THREAD_BITS) | thread_slot;
+
+  // two commit ids of the same thread can fall in the same clock tick
+  if (temp_cid <= context.last_cid) {
+    temp_cid = context.last_cid + (1 << TIMESTAMP_THREAD_BITS);
+  }
+  context.last_cid = temp_cid;
+
+  // wait if we do not yet have a grant for this commit id
+  while (temp_cid > maximum_grant_cid_.load());
+  return temp_cid;
+}
+
+//===--------------------------------------------------------------------===//
+// Batch visibility
+//===--------------------------------------------------------------------===//
+
+void TransactionManager::GetVisibleTuples(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t begin_tuple_id, const oid_t end_tuple_id,
+    std::vector<oid_t> &selection) {
+  for (oid_t tuple_id = begin_tuple_id; tuple_id < end_tuple_id; tuple_id++) {
+    if (IsVisible(tile_group_header, tuple_id)) {
+      selection.push_back(tuple_id);
+    }
+  }
+}
+
+/**
+ * @brief Visibility of a range of tuples, checked on the txn id and begin/end
+ * cid arrays of a column layout header.
+ *
+ * A tuple that is not owned by any transaction is visible iff
+ * begin cid <= snapshot < end cid, which is checked four tuples at a time
+ * with AVX2 (and in a branch-free loop otherwise). Tuples owned by a
+ * transaction are rare and fall back to IsVisible.
+ */
+void TransactionManager::GetSnapshotVisibleTuples(
+    const storage::TileGroupHeader *const tile_group_header,
+    const oid_t begin_tuple_id, const oid_t end_tuple_id,
+    std::vector<oid_t> &selection) {
+  // the row layout has no arrays, and the dirty range after recovery is not
+  // handled by the fast path
+  if (tile_group_header->IsColumnLayout() == false ||
+      dirty_range_.first < dirty_range_.second) {
+    TransactionManager::GetVisibleTuples(tile_group_header, begin_tuple_id,
+                                         end_tuple_id, selection);
+    return;
+  }
+
+  const txn_id_t *txn_ids = tile_group_header->GetTransactionIdArray();
+  const cid_t *begin_cids = tile_group_header->GetBeginCommitIdArray();
+  const cid_t *end_cids = tile_group_header->GetEndCommitIdArray();
+  const cid_t snapshot_cid = current_txn->GetBeginCommitId();
+
+  oid_t tuple_id = begin_tuple_id;
+
+#ifdef __AVX2__
+  // AVX2 only compares signed 64-bit integers : flip the sign bits
+  const __m256i sign_bit = _mm256_set1_epi64x(INT64_MIN);
+  const __m256i initial_txn_id = _mm256_set1_epi64x(INITIAL_TXN_ID);
+  const __m256i invalid_txn_id = _mm256_set1_epi64x(INVALID_TXN_ID);
+  const __m256i snapshot =
+      _mm256_xor_si256(_mm256_set1_epi64x(snapshot_cid), sign_bit);
+
+  for (; tuple_id + 4 <= end_tuple_id; tuple_id += 4) {
+    __m256i txn_id =
+        _mm256_loadu_si256((const __m256i *)(txn_ids + tuple_id));
+    __m256i begin_cid = _mm256_xor_si256(
+        _mm256_loadu_si256((const __m256i *)(begin_cids + tuple_id)),
+        sign_bit);
+    __m256i end_cid = _mm256_xor_si256(
+        _mm256_loadu_si256((const __m256i *)(end_cids + tuple_id)), sign_bit);
+
+    __m256i initial = _mm256_cmpeq_epi64(txn_id, initial_txn_id);
+    __m256i invalid = _mm256_cmpeq_epi64(txn_id, invalid_txn_id);
+    // begin cid > snapshot : not activated yet
+    __m256i not_activated = _mm256_cmpgt_epi64(begin_cid, snapshot);
+    // end cid > snapshot : not invalidated yet
+    __m256i not_invalidated = _mm256_cmpgt_epi64(end_cid, snapshot);
+
+    __m256i visible = _mm256_andnot_si256(
+        not_activated, _mm256_and_si256(initial, not_invalidated));
+    __m256i owned = _mm256_andnot_si256(_mm256_or_si256(initial, invalid),
+                                        _mm256_set1_epi64x(-1));
+
+    int visible_mask = _mm256_movemask_pd(_mm256_castsi256_pd(visible));
+    int owned_mask = _mm256_movemask_pd(_mm256_castsi256_pd(owned));
+    if (owned_mask == 0) {
+      while (visible_mask != 0) {
+        int lane = __builtin_ctz(visible_mask);
+        selection.push_back(tuple_id + lane);
+        visible_mask &= visible_mask - 1;
+      }
+      continue;
+    }
+
+    for (oid_t lane = 0; lane < 4; lane++) {
+      if (visible_mask & (1 << lane)) {
+        selection.push_back(tuple_id + lane);
+      } else if (owned_mask & (1 << lane)) {
+        if (IsVisible(tile_group_header, tuple_id + lane)) {
+          selection.push_back(tuple_id + lane);
+        }
+      }
+    }
+  }
+#endif
+
+  for (; tuple_id < end_tuple_id; tuple_id++) {
+    txn_id_t tuple_txn_id = txn_ids[tuple_id];
+    if (tuple_txn_id == INITIAL_TXN_ID) {
+      if ((begin_cids[tuple_id] <= snapshot_cid) &
+          (end_cids[tuple_id] > snapshot_cid)) {
+        selection.push_back(tuple_id);
+      }
+    } else if (tuple_txn_id != INVALID_TXN_ID) {
+      if (IsVisible(tile_group_header, tuple_id)) {
+        selection.push_back(tuple_id);
+      }
+    }
+  }
+}
+
+bool TransactionManager::IsAllVisible(
+    const storage::TileGroupHeader *const tile_group_header,
+    oid_t &tuple_count) {
+  // the dirty range after recovery needs per-tuple checks
+  if (dirty_range_.first < dirty_range_.second) {
+    return false;
+  }
+  return tile_group_header->IsAllVisible(current_txn->GetBeginCommitId(),
+                                         tuple_count);
+}
+
+bool TransactionManager::PerformReadRange(const oid_t tile_group_id,
+                                          const oid_t begin_tuple_id,
+                                          const oid_t end_tuple_id) {
+  for (oid_t tuple_id = begin_tuple_id; tuple_id < end_tuple_id; tuple_id++) {
+    if (PerformRead(ItemPointer(tile_group_id, tuple_id)) == false) {
+      return false;
+    }
+  }
+  return true;
+}
+
 bool TransactionManager::IsOccupied(const ItemPointer &position) {
   auto tile_group_header =
       catalog::Manager::GetInstance().GetTileGroup(position.block)->GetHeader();
@@ -15,13 +15,16 @@
 #include <atomic>
 #include <unordered_map>
 #include <list>
+#include <mutex>
 #include <utility>
+#include <vector>
 
 #include "backend/storage/tile_group_header.h"
 #include "backend/concurrency/transaction.h"
 #include "backend/concurrency/epoch_manager.h"
 #include "backend/catalog/manager.h"
 #include "backend/common/logger.h"
+#include "backend/common/metrics.h"
 
 #include "libcuckoo/cuckoohash_map.hh"
 
@@ -41,26 +44,69 @@ extern thread_local Transaction *current_txn;
 
 #define RUNNING_TXN_BUCKET_NUM 10
 
+// number of transaction ids reserved by a thread at a time
+#define TXN_ID_BLOCK_SIZE 1024
+
+// low bits of a decentralized commit id hold the slot of the thread
+#define TIMESTAMP_THREAD_BITS 8
+
+/**
+ * In the centralized mode, every transaction draws its transaction id and
+ * its commit ids from two shared counters.
+ *
+ * In the decentralized mode, a thread reserves a block of TXN_ID_BLOCK_SIZE
+ * transaction ids at a time, and commit ids are read off a clock shared by
+ * all the cores : the elapsed nanoseconds are shifted left and the slot of
+ * the thread is put in the low TIMESTAMP_THREAD_BITS bits. Commit ids are
+ * therefore unique, strictly increasing within a thread, and ordered by
+ * time across threads, without any shared write.
+ */
+
 class TransactionManager {
  public:
-  TransactionManager() {
-    next_txn_id_ = ATOMIC_VAR_INIT(START_TXN_ID);
-    next_cid_ = ATOMIC_VAR_INIT(START_CID);
-    maximum_grant_cid_ = ATOMIC_VAR_INIT(MAX_CID);
-  }
+  explicit TransactionManager(ConcurrencyType protocol);
 
   virtual ~TransactionManager() {}
 
-  txn_id_t GetNextTransactionId() { return next_txn_id_++; }
+  txn_id_t GetNextTransactionId() {
+    if (timestamp_type_ == TIMESTAMP_TYPE_DECENTRALIZED) {
+      return GetNextLocalTransactionId();
+    }
+    return next_txn_id_++;
+  }
 
   cid_t GetNextCommitId() {
+    if (timestamp_type_ == TIMESTAMP_TYPE_DECENTRALIZED) {
+      return GetNextClockCommitId();
+    }
 	  cid_t temp_cid = next_cid_++;
 	  // wait if we do not yet have a grant for this commit id
 	  while(temp_cid > maximum_grant_cid_.load());
 	  return temp_cid;
   }
 
-  cid_t GetCurrentCommitId() { return next_cid_.load(); }
+  // Draw the begin cid of a new transaction. In the slot epoch mode, a lower
+  // bound is published first, so the GC horizon can not pass it meanwhile.
+  cid_t GetNextBeginCommitId() {
+    auto &epoch_manager = EpochManagerFactory::GetInstance();
+    if (epoch_manager.GetEpochType() == EPOCH_TYPE_SLOT) {
+      epoch_manager.PublishBeginCidBound(GetCurrentCommitId());
+    }
+    return GetNextCommitId();
+  }
+
+  cid_t GetCurrentCommitId() {
+    if (timestamp_type_ == TIMESTAMP_TYPE_DECENTRALIZED) {
+      return GetClockTicks() << TIMESTAMP_THREAD_BITS;
+    }
+    return next_cid_.load();
+  }
+
+  // Switch between shared counters and per-thread allocation. Throws if the
+  // protocol can not run with these timestamps.
+  void SetTimestampType(const TimestampType timestamp_type);
+
+  TimestampType GetTimestampType() const { return timestamp_type_; }
 
   bool IsOccupied(const ItemPointer &position);
 
@@ -68,6 +114,20 @@ class TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id) = 0;
 
+  // Append the visible tuples among [begin_tuple_id, end_tuple_id) of a tile
+  // group to the selection vector, in order.
+  // By default, IsVisible is called on each tuple.
+  virtual void GetVisibleTuples(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t begin_tuple_id, const oid_t end_tuple_id,
+      std::vector<oid_t> &selection);
+
+  // If the tile group is all-visible to the current transaction, i.e. none
+  // of its tuples needs a visibility check, set tuple_count to its number of
+  // tuples and return true.
+  bool IsAllVisible(const storage::TileGroupHeader *const tile_group_header,
+                    oid_t &tuple_count);
+
   virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
                        const oid_t &tuple_id) = 0;
 
@@ -84,6 +144,16 @@ class TransactionManager {
 
   virtual bool PerformRead(const ItemPointer &location) = 0;
 
+  // Read of the tuples [begin_tuple_id, end_tuple_id) of a tile group.
+  // By default, PerformRead is called on each tuple.
+  virtual bool PerformReadRange(const oid_t tile_group_id,
+                                const oid_t begin_tuple_id,
+                                const oid_t end_tuple_id);
+
+  // Does PerformReadRange record ranges rather than tuples ? Scans then
+  // read whole all-visible tile groups, even under a predicate.
+  virtual bool IsReadRangeTracked() const { return false; }
+
   virtual void PerformUpdate(const ItemPointer &old_location,
                              const ItemPointer &new_location) = 0;
 
@@ -107,21 +177,25 @@ class TransactionManager {
   }
 
   //for use by recovery
-  void SetNextCid(cid_t cid) { next_cid_ = cid; }
+  void SetNextCid(cid_t cid);
 
   void SetMaxGrantCid(cid_t cid){ maximum_grant_cid_ = cid; }
 
-  virtual Transaction *BeginTransaction() = 0;
+  // Begin, commit and abort are counted per protocol before being handed to
+  // the protocol specific DBeginTransaction, DCommitTransaction and
+  // DAbortTransaction
+  Transaction *BeginTransaction();
 
   virtual void EndTransaction() = 0;
 
-  virtual Result CommitTransaction() = 0;
+  Result CommitTransaction();
 
-  virtual Result AbortTransaction() = 0;
+  Result AbortTransaction();
 
   void ResetStates() {
     next_txn_id_ = START_TXN_ID;
     next_cid_ = START_CID;
+    ResetClock(START_CID);
   }
 
   // this function generates the maximum commit id of committed transactions.
@@ -136,7 +210,25 @@ class TransactionManager {
   }
 
  protected:
+  virtual Transaction *DBeginTransaction() = 0;
+
+  virtual Result DCommitTransaction() = 0;
 
+  virtual Result DAbortTransaction() = 0;
+
+  // Whether the protocol, as configured, can run with the given timestamps
+  virtual bool SupportsTimestampType(
+      const TimestampType timestamp_type __attribute__((unused))) const {
+    return true;
+  }
+
+  // Batch visibility check for the protocols whose IsVisible makes a tuple
+  // not owned by any transaction visible iff it is activated and not
+  // invalidated. Only the tuples owned by a transaction go through IsVisible.
+  void GetSnapshotVisibleTuples(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t begin_tuple_id, const oid_t end_tuple_id,
+      std::vector<oid_t> &selection);
 
   inline bool CidIsInDirtyRange(cid_t cid){
 	  return ((cid > dirty_range_.first) & (cid <= dirty_range_.second));
@@ -147,10 +239,51 @@ class TransactionManager {
 
 
  private:
+  //===--------------------------------------------------------------------===//
+  // Decentralized timestamps
+  //===--------------------------------------------------------------------===//
+
+  txn_id_t GetNextLocalTransactionId();
+
+  cid_t GetNextClockCommitId();
+
+  // Clock reading from which commit ids are built
+  uint64_t GetClockTicks() const;
+
+  // Make the clock start at the given commit id, and drop the blocks
+  // reserved by the threads
+  void ResetClock(const cid_t cid);
+
   std::atomic<txn_id_t> next_txn_id_;
   std::atomic<cid_t> next_cid_;
   std::atomic<cid_t> maximum_grant_cid_;
 
+  // read without a lock on every timestamp
+  std::atomic<TimestampType> timestamp_type_{TIMESTAMP_TYPE_CENTRALIZED};
+
+  // serializes the switches
+  std::mutex timestamp_type_mutex_;
+
+  // added to the steady clock to get the clock ticks
+  std::atomic<int64_t> clock_offset_;
+
+  // bumped on every reset, so that threads reserve a new block
+  std::atomic<uint64_t> generation_;
+
+  //===--------------------------------------------------------------------===//
+  // Metrics
+  //===--------------------------------------------------------------------===//
+
+  enum AbortReason {
+    ABORT_REASON_USER = 0,        // aborted by the client
+    ABORT_REASON_CONFLICT = 1,    // an operation failed on a conflict
+    ABORT_REASON_VALIDATION = 2,  // failed to commit
+    ABORT_REASON_COUNT = 3
+  };
+
+  oid_t begin_counter_id_;
+  oid_t commit_counter_id_;
+  oid_t abort_counter_ids_[ABORT_REASON_COUNT];
 };
 }  // End storage namespace
 }  // End peloton namespace
@@ -18,5 +18,7 @@ ConcurrencyType TransactionManagerFactory::protocol_ =
     CONCURRENCY_TYPE_OPTIMISTIC;
 IsolationLevelType TransactionManagerFactory::isolation_level_ =
     ISOLATION_LEVEL_TYPE_FULL;
+TimestampType TransactionManagerFactory::timestamp_type_ =
+    TIMESTAMP_TYPE_CENTRALIZED;
 }
 }
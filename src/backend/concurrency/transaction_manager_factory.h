@@ -46,18 +46,25 @@ class TransactionManagerFactory {
   }
 
   static void Configure(ConcurrencyType protocol,
-                        IsolationLevelType level = ISOLATION_LEVEL_TYPE_FULL) {
+                        IsolationLevelType level = ISOLATION_LEVEL_TYPE_FULL,
+                        TimestampType timestamp_type =
+                            TIMESTAMP_TYPE_CENTRALIZED) {
     protocol_ = protocol;
     isolation_level_ = level;
+    GetInstance().SetTimestampType(timestamp_type);
+    timestamp_type_ = timestamp_type;
   }
 
   static ConcurrencyType GetProtocol() { return protocol_; }
 
   static IsolationLevelType GetIsolationLevel() { return isolation_level_; }
 
+  static TimestampType GetTimestampType() { return timestamp_type_; }
+
  private:
   static ConcurrencyType protocol_;
   static IsolationLevelType isolation_level_;
+  static TimestampType timestamp_type_;
 };
 }
 }
@@ -286,7 +286,7 @@ void TsOrderTxnManager::PerformDelete(const ItemPointer &location) {
   }
 }
 
-Result TsOrderTxnManager::CommitTransaction() {
+Result TsOrderTxnManager::DCommitTransaction() {
   LOG_TRACE("Committing peloton txn : %lu ", current_txn->GetTransactionId());
 
   if (current_txn->IsReadOnly() == true) {
@@ -386,7 +386,7 @@ Result TsOrderTxnManager::CommitTransaction() {
   return ret;
 }
 
-Result TsOrderTxnManager::AbortTransaction() {
+Result TsOrderTxnManager::DAbortTransaction() {
   LOG_TRACE("Aborting peloton txn : %lu ", current_txn->GetTransactionId());
   auto &manager = catalog::Manager::GetInstance();
 
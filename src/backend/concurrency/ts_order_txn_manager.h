@@ -24,7 +24,7 @@ namespace concurrency {
 
 class TsOrderTxnManager : public TransactionManager {
  public:
-  TsOrderTxnManager() {}
+  TsOrderTxnManager() : TransactionManager(CONCURRENCY_TYPE_TO) {}
 
   virtual ~TsOrderTxnManager() {}
 
@@ -34,6 +34,14 @@ class TsOrderTxnManager : public TransactionManager {
       const storage::TileGroupHeader *const tile_group_header,
       const oid_t &tuple_id);
 
+  virtual void GetVisibleTuples(
+      const storage::TileGroupHeader *const tile_group_header,
+      const oid_t begin_tuple_id, const oid_t end_tuple_id,
+      std::vector<oid_t> &selection) {
+    GetSnapshotVisibleTuples(tile_group_header, begin_tuple_id, end_tuple_id,
+                             selection);
+  }
+
   virtual bool IsOwner(const storage::TileGroupHeader *const tile_group_header,
                        const oid_t &tuple_id);
 
@@ -59,13 +67,13 @@ class TsOrderTxnManager : public TransactionManager {
 
   virtual void PerformDelete(const ItemPointer &location);
 
-  virtual Result CommitTransaction();
+  virtual Result DCommitTransaction();
 
-  virtual Result AbortTransaction();
+  virtual Result DAbortTransaction();
 
-  virtual Transaction *BeginTransaction() {
+  virtual Transaction *DBeginTransaction() {
     txn_id_t txn_id = GetNextTransactionId();
-    cid_t begin_cid = GetNextCommitId();
+    cid_t begin_cid = GetNextBeginCommitId();
     Transaction *txn = new Transaction(txn_id, begin_cid);
     current_txn = txn;
 
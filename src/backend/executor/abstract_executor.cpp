@@ -10,9 +10,12 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <ctime>
+
 #include "backend/executor/abstract_executor.h"
 #include "backend/planner/abstract_plan.h"
 #include "backend/common/logger.h"
+#include "backend/common/timer.h"
 
 namespace peloton {
 namespace executor {
@@ -45,6 +48,17 @@ const std::vector<AbstractExecutor *> &AbstractExecutor::GetChildren() const {
   return children_;
 }
 
+/**
+ * @brief Start collecting runtime statistics in the executor tree.
+ */
+void AbstractExecutor::EnableStats() {
+  stats_.reset(new ExecutorStats());
+
+  for (auto child : children_) {
+    child->EnableStats();
+  }
+}
+
 /**
  * @brief Initializes the executor.
  *
@@ -88,10 +102,51 @@ bool AbstractExecutor::Execute() {
   // TODO In the future, we might want to pass some kind of executor state to
   // GetNextTile. e.g. params for prepared plans.
 
+  // Only a branch when the statistics are not collected
+  if (stats_ != nullptr) {
+    return InstrumentedExecute();
+  }
+
   bool status = DExecute();
 
   return status;
 }
 
+static double GetThreadCpuTime() {
+  struct timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1000000.0;
+}
+
+static int64_t GetPoolAllocatedMemory(ExecutorContext *executor_context) {
+  if (executor_context == nullptr) return 0;
+  return executor_context->GetPoolAllocatedMemory();
+}
+
+/**
+ * @brief Execute the derived class and update the runtime statistics.
+ */
+bool AbstractExecutor::InstrumentedExecute() {
+  Timer<std::milli> timer;
+  auto cpu_start = GetThreadCpuTime();
+  auto pool_start = GetPoolAllocatedMemory(executor_context_);
+
+  timer.Start();
+  bool status = DExecute();
+  timer.Stop();
+
+  stats_->call_count++;
+  stats_->wall_time += timer.GetDuration();
+  stats_->cpu_time += GetThreadCpuTime() - cpu_start;
+  stats_->pool_bytes += GetPoolAllocatedMemory(executor_context_) - pool_start;
+
+  if (status == true && output != nullptr) {
+    stats_->tile_count++;
+    stats_->tuple_count += output->GetTupleCount();
+  }
+
+  return status;
+}
+
 }  // namespace executor
 }  // namespace peloton
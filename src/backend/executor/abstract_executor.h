@@ -17,6 +17,7 @@
 
 #include "backend/executor/logical_tile.h"
 #include "backend/executor/executor_context.h"
+#include "backend/executor/executor_stats.h"
 #include "backend/common/value.h"
 
 namespace peloton {
@@ -52,6 +53,17 @@ class AbstractExecutor {
 
   const std::vector<AbstractExecutor *> &GetChildren() const;
 
+  //===--------------------------------------------------------------------===//
+  // Instrumentation
+  //===--------------------------------------------------------------------===//
+
+  // Collect runtime statistics in this executor and all its children.
+  // Must be called once the executor tree is built.
+  void EnableStats();
+
+  // Runtime statistics, or nullptr if they are not collected
+  const ExecutorStats *GetStats() const { return stats_.get(); }
+
   //===--------------------------------------------------------------------===//
   // Accessors
   //===--------------------------------------------------------------------===//
@@ -86,6 +98,9 @@ class AbstractExecutor {
 
   void SetOutput(LogicalTile *val);
 
+  /** @brief Statistics to be updated by the derived class, if collected. */
+  ExecutorStats *GetMutableStats() { return stats_.get(); }
+
   /**
    * @brief Convenience method to return plan node corresponding to this
    *        executor, appropriately type-casted.
@@ -110,6 +125,11 @@ class AbstractExecutor {
   /** @brief Plan node corresponding to this executor. */
   const planner::AbstractPlan *node_ = nullptr;
 
+  bool InstrumentedExecute();
+
+  /** @brief Runtime statistics, only allocated when instrumented. */
+  std::unique_ptr<ExecutorStats> stats_;
+
  protected:
   // Executor context
   ExecutorContext *executor_context_ = nullptr;
@@ -16,13 +16,18 @@
 #include <utility>
 #include <vector>
 
+#include "backend/brain/layout_reorganizer.h"
+#include "backend/brain/sample.h"
 #include "backend/common/types.h"
 #include "backend/executor/logical_tile.h"
 #include "backend/executor/logical_tile_factory.h"
 #include "backend/expression/abstract_expression.h"
 #include "backend/expression/container_tuple.h"
+#include "backend/expression/expression_util.h"
+#include "backend/expression/tuple_value_expression.h"
 #include "backend/storage/data_table.h"
 #include "backend/storage/tile_group.h"
+#include "backend/storage/zone_map.h"
 
 #include "backend/common/logger.h"
 
@@ -56,5 +61,136 @@ bool AbstractScanExecutor::DInit() {
   return true;
 }
 
+void AbstractScanExecutor::RecordAccessSample(storage::DataTable *table) {
+  // Samples are only consumed by the layout reorganizer
+  if (brain::LayoutReorganizer::GetInstance().GetStatus() == false) return;
+
+  oid_t column_count = table->GetSchema()->GetColumnCount();
+  std::vector<double> columns_accessed(column_count, 0);
+
+  for (auto column_id : column_ids_) {
+    if (column_id < column_count) columns_accessed[column_id] = 1;
+  }
+
+  if (predicate_ != nullptr) {
+    std::vector<int> predicate_column_ids;
+    expression::ExpressionUtil::ExtractTupleValuesColumnIdx(
+        predicate_, predicate_column_ids);
+    for (auto column_id : predicate_column_ids) {
+      if (column_id >= 0 && (oid_t)column_id < column_count) {
+        columns_accessed[column_id] = 1;
+      }
+    }
+  }
+
+  brain::Sample sample(columns_accessed);
+  table->RecordSample(sample);
+}
+
+// Comparison obtained by swapping the operands
+static ExpressionType GetCommutedComparison(const ExpressionType type) {
+  switch (type) {
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHAN;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+      return EXPRESSION_TYPE_COMPARE_LESSTHAN;
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO;
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+      return EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO;
+    default:
+      return type;
+  }
+}
+
+static bool IsConstantExpression(const expression::AbstractExpression *expr) {
+  return (expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_CONSTANT ||
+          expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_PARAMETER);
+}
+
+static bool IsOuterColumnExpression(
+    const expression::AbstractExpression *expr) {
+  return (expr->GetExpressionType() == EXPRESSION_TYPE_VALUE_TUPLE &&
+          static_cast<const expression::TupleValueExpression *>(expr)
+                  ->GetTupleIdx() == 0);
+}
+
+/**
+ * @brief Conservatively check whether the expression can be true for any
+ * tuple summarized by the zone map.
+ */
+static bool ExpressionMayMatch(const expression::AbstractExpression *expr,
+                               storage::ZoneMap *zone_map,
+                               ExecutorContext *executor_context) {
+  auto left = expr->GetLeft();
+  auto right = expr->GetRight();
+
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+      return ExpressionMayMatch(left, zone_map, executor_context) &&
+             ExpressionMayMatch(right, zone_map, executor_context);
+
+    case EXPRESSION_TYPE_CONJUNCTION_OR:
+      return ExpressionMayMatch(left, zone_map, executor_context) ||
+             ExpressionMayMatch(right, zone_map, executor_context);
+
+    case EXPRESSION_TYPE_OPERATOR_IS_NULL:
+      if (left != nullptr && IsOuterColumnExpression(left)) {
+        auto column_id =
+            static_cast<const expression::TupleValueExpression *>(left)
+                ->GetColumnId();
+        return zone_map->IsNullMayMatch(column_id);
+      }
+      return true;
+
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO: {
+      if (left == nullptr || right == nullptr) return true;
+
+      // Only "column <op> constant" and "constant <op> column"
+      auto comparison_type = expr->GetExpressionType();
+      const expression::AbstractExpression *column_expr = nullptr;
+      const expression::AbstractExpression *constant_expr = nullptr;
+      if (IsOuterColumnExpression(left) && IsConstantExpression(right)) {
+        column_expr = left;
+        constant_expr = right;
+      } else if (IsConstantExpression(left) &&
+                 IsOuterColumnExpression(right)) {
+        column_expr = right;
+        constant_expr = left;
+        comparison_type = GetCommutedComparison(comparison_type);
+      } else {
+        return true;
+      }
+
+      auto column_id =
+          static_cast<const expression::TupleValueExpression *>(column_expr)
+              ->GetColumnId();
+      Value constant =
+          constant_expr->Evaluate(nullptr, nullptr, executor_context);
+      return zone_map->ComparisonMayMatch(column_id, comparison_type,
+                                          constant);
+    }
+
+    default:
+      return true;
+  }
+}
+
+bool AbstractScanExecutor::TileGroupMayMatch(storage::TileGroup *tile_group) {
+  if (predicate_ == nullptr) return true;
+
+  auto zone_map = tile_group->GetZoneMap();
+  if (zone_map == nullptr) return true;
+
+  // The synopses may be wider than necessary after in-place updates, they
+  // are tightened in the background (see TileGroupFreezer)
+  return ExpressionMayMatch(predicate_, zone_map, executor_context_);
+}
+
 }  // namespace executor
 }  // namespace peloton
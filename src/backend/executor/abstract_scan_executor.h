@@ -17,6 +17,13 @@
 #include "backend/executor/abstract_executor.h"
 
 namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroup;
+class ZoneMap;
+}
+
 namespace executor {
 
 /**
@@ -39,6 +46,13 @@ class AbstractScanExecutor : public AbstractExecutor {
 
   virtual bool DExecute() = 0;
 
+  // Record the columns accessed by this scan for layout reorganization
+  void RecordAccessSample(storage::DataTable *table);
+
+  // Check the predicate against the zone map of the tile group.
+  // Returns false only if no tuple in the tile group can satisfy it.
+  bool TileGroupMayMatch(storage::TileGroup *tile_group);
+
  protected:
   //===--------------------------------------------------------------------===//
   // Plan Info
@@ -19,6 +19,7 @@
 #include "backend/executor/aggregate_executor.h"
 #include "backend/executor/logical_tile_factory.h"
 #include "backend/executor/executor_context.h"
+#include "backend/executor/index_scan_executor.h"
 #include "backend/expression/container_tuple.h"
 #include "backend/planner/aggregate_plan.h"
 #include "backend/storage/table_factory.h"
@@ -73,6 +74,22 @@ bool AggregateExecutor::DInit() {
       INVALID_OID, INVALID_OID, output_table_schema, "aggregate_temp_table",
       DEFAULT_TUPLES_PER_TILEGROUP, own_schema, adapt_table);
 
+  // A plain aggregate whose terms have no expression (e.g. COUNT(*)) only
+  // counts the tuples of the child, so no column has to be read
+  bool reads_child_columns =
+      (node.GetAggregateStrategy() != AGGREGATE_TYPE_PLAIN);
+  for (auto &agg_term : node.GetUniqueAggTerms()) {
+    if (agg_term.expression != nullptr) {
+      reads_child_columns = true;
+    }
+  }
+
+  auto child_node = children_[0]->GetRawNode();
+  if (reads_child_columns == false && child_node != nullptr &&
+      child_node->GetPlanNodeType() == PLAN_NODE_TYPE_INDEXSCAN) {
+    static_cast<IndexScanExecutor *>(children_[0])->SkipOutputColumns();
+  }
+
   return true;
 }
 
@@ -98,6 +115,7 @@ bool AggregateExecutor::DExecute() {
 
   // Get an aggregator
   std::unique_ptr<AbstractAggregator> aggregator(nullptr);
+  HashAggregator *hash_aggregator = nullptr;
 
   // Get input tiles and aggregate them
   while (children_[0]->Execute() == true) {
@@ -108,8 +126,9 @@ bool AggregateExecutor::DExecute() {
       switch (node.GetAggregateStrategy()) {
         case AGGREGATE_TYPE_HASH:
           LOG_TRACE("Use HashAggregator");
-          aggregator.reset(new HashAggregator(
-              &node, output_table, executor_context_, tile->GetColumnCount()));
+          hash_aggregator = new HashAggregator(
+              &node, output_table, executor_context_, tile->GetColumnCount());
+          aggregator.reset(hash_aggregator);
           break;
         case AGGREGATE_TYPE_SORTED:
           LOG_TRACE("Use SortedAggregator");
@@ -140,6 +159,10 @@ bool AggregateExecutor::DExecute() {
     LOG_TRACE("Finished processing logical tile");
   }
 
+  if (hash_aggregator != nullptr && GetMutableStats() != nullptr) {
+    GetMutableStats()->hash_table_size = hash_aggregator->GetGroupCount();
+  }
+
   LOG_TRACE("Finalizing..");
   if (!aggregator.get() || !aggregator->Finalize()) {
     // If there's no tuples in the table and only if no group-by in the query,
@@ -278,6 +278,9 @@ class HashAggregator : public AbstractAggregator {
 
   bool Finalize() override;
 
+  // # of groups in the hash table
+  size_t GetGroupCount() const { return aggregates_map.size(); }
+
   ~HashAggregator();
 
  private:
@@ -12,6 +12,7 @@
 
 #include "backend/executor/delete_executor.h"
 #include "backend/executor/executor_context.h"
+#include "backend/executor/index_scan_executor.h"
 
 #include "backend/common/value.h"
 #include "backend/planner/delete_plan.h"
@@ -55,6 +56,13 @@ bool DeleteExecutor::DInit() {
   target_table_ = node.GetTable();
   PL_ASSERT(target_table_);
 
+  // The tuples are located through the base tiles of the child's output
+  auto child_node = children_[0]->GetRawNode();
+  if (child_node != nullptr &&
+      child_node->GetPlanNodeType() == PLAN_NODE_TYPE_INDEXSCAN) {
+    static_cast<IndexScanExecutor *>(children_[0])->DisableIndexOnly();
+  }
+
   return true;
 }
 
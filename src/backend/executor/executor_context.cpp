@@ -35,5 +35,11 @@ VarlenPool *ExecutorContext::GetExecutorContextPool() {
   return pool_.get();
 }
 
+int64_t ExecutorContext::GetPoolAllocatedMemory() const {
+  if (pool_.get() == nullptr) return 0;
+
+  return pool_->GetAllocatedMemory();
+}
+
 }  // namespace executor
 }  // namespace peloton
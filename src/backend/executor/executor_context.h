@@ -12,6 +12,9 @@
 
 #pragma once
 
+#include <memory>
+#include <unordered_map>
+
 #include "backend/concurrency/transaction.h"
 #include "backend/common/pool.h"
 #include "backend/common/value.h"
@@ -56,6 +59,15 @@ class ExecutorContext {
   // Get a varlen pool (will construct the pool only if needed)
   VarlenPool *GetExecutorContextPool();
 
+  // Bytes allocated by the varlen pool so far (0 if it was never used)
+  int64_t GetPoolAllocatedMemory() const;
+
+  // State an expression keeps across the rows of this execution, empty until
+  // the expression sets it (e.g. the function call of a UDFExpression)
+  std::shared_ptr<void> &GetExpressionState(const void *expression) {
+    return expression_states_[expression];
+  }
+
   // num of tuple processed
   uint32_t num_processed = 0;
 
@@ -73,6 +85,9 @@ class ExecutorContext {
   // pool
   std::unique_ptr<VarlenPool> pool_;
 
+  // expression -> state kept across rows
+  std::unordered_map<const void *, std::shared_ptr<void>> expression_states_;
+
   // PARAMS_EXEC_Flag
   ParamsExecFlag params_exec_flag_ ;
 };
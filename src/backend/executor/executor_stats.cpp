@@ -0,0 +1,107 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// executor_stats.cpp
+//
+// Identification: src/backend/executor/executor_stats.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <iomanip>
+#include <sstream>
+
+#include "backend/executor/executor_stats.h"
+#include "backend/executor/abstract_executor.h"
+#include "backend/planner/abstract_plan.h"
+
+namespace peloton {
+namespace executor {
+
+static std::string GetPlanTypeName(const AbstractExecutor *executor) {
+  auto node = executor->GetRawNode();
+  if (node == nullptr) return "UNKNOWN";
+
+  return PlanNodeTypeToString(node->GetPlanNodeType());
+}
+
+// Wall time spent in the operator itself, excluding its children
+static double GetSelfTime(const AbstractExecutor *executor) {
+  auto stats = executor->GetStats();
+  double self_time = stats->wall_time;
+
+  for (auto child : executor->GetChildren()) {
+    if (child->GetStats() != nullptr) {
+      self_time -= child->GetStats()->wall_time;
+    }
+  }
+
+  return std::max(self_time, 0.0);
+}
+
+static void GetExecutorStatsInfo(const AbstractExecutor *executor,
+                                 size_t depth, std::ostringstream &os) {
+  auto stats = executor->GetStats();
+  if (stats == nullptr) return;
+
+  os << std::string(depth * 6, ' ') << "->  " << GetPlanTypeName(executor)
+     << "  (actual time=" << stats->wall_time << " ms"
+     << " self=" << GetSelfTime(executor) << " ms"
+     << " cpu=" << stats->cpu_time << " ms"
+     << " calls=" << stats->call_count << " tiles=" << stats->tile_count
+     << " rows=" << stats->tuple_count;
+
+  if (stats->hash_table_size != 0) {
+    os << " hash entries=" << stats->hash_table_size;
+  }
+
+  if (stats->pool_bytes != 0) {
+    os << " pool=" << stats->pool_bytes << " bytes";
+  }
+
+  os << ")\n";
+
+  for (auto child : executor->GetChildren()) {
+    GetExecutorStatsInfo(child, depth + 1, os);
+  }
+}
+
+std::string GetExecutorStatsInfo(const AbstractExecutor *root) {
+  std::ostringstream os;
+  os << std::fixed << std::setprecision(3);
+
+  GetExecutorStatsInfo(root, 0, os);
+
+  return os.str();
+}
+
+static void DumpExecutorStats(const AbstractExecutor *executor, size_t depth,
+                              std::ostream &out) {
+  auto stats = executor->GetStats();
+  if (stats == nullptr) return;
+
+  out << depth << " ";
+  out << GetPlanTypeName(executor) << " ";
+  out << stats->call_count << " ";
+  out << stats->tile_count << " ";
+  out << stats->tuple_count << " ";
+  out << stats->wall_time << " ";
+  out << GetSelfTime(executor) << " ";
+  out << stats->cpu_time << " ";
+  out << stats->hash_table_size << " ";
+  out << stats->pool_bytes << "\n";
+
+  for (auto child : executor->GetChildren()) {
+    DumpExecutorStats(child, depth + 1, out);
+  }
+}
+
+void DumpExecutorStats(const AbstractExecutor *root, std::ostream &out) {
+  DumpExecutorStats(root, 0, out);
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -0,0 +1,66 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// executor_stats.h
+//
+// Identification: src/backend/executor/executor_stats.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+namespace peloton {
+namespace executor {
+
+class AbstractExecutor;
+
+//===--------------------------------------------------------------------===//
+// Executor Statistics
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Runtime statistics of an executor, collected by
+ * AbstractExecutor::Execute once AbstractExecutor::EnableStats is called.
+ *
+ * Times and pool allocations include the work done by the children, as the
+ * children are executed from within their parent. The exclusive cost of an
+ * operator is derived when the statistics are printed.
+ */
+struct ExecutorStats {
+  // # of calls to Execute
+  uint64_t call_count = 0;
+
+  // # of logical tiles and tuples produced
+  uint64_t tile_count = 0;
+
+  uint64_t tuple_count = 0;
+
+  // Wall clock and thread cpu time (ms)
+  double wall_time = 0;
+
+  double cpu_time = 0;
+
+  // # of entries in the hash table built by the operator, if any
+  uint64_t hash_table_size = 0;
+
+  // Bytes allocated from the executor context pool
+  int64_t pool_bytes = 0;
+};
+
+// Indented tree of the operator statistics, in the spirit of EXPLAIN ANALYZE
+std::string GetExecutorStatsInfo(const AbstractExecutor *root);
+
+// One line per operator, in pre-order, with space separated fields :
+// depth plan_type calls tiles tuples wall_ms self_ms cpu_ms hash_entries
+// pool_bytes
+void DumpExecutorStats(const AbstractExecutor *root, std::ostream &out);
+
+}  // namespace executor
+}  // namespace peloton
@@ -30,3 +30,4 @@
 #include "backend/executor/hash_set_op_executor.h"
 #include "backend/executor/append_executor.h"
 #include "backend/executor/projection_executor.h"
+#include "backend/executor/pipeline_executor.h"
@@ -92,6 +92,10 @@ bool HashExecutor::DExecute() {
       }
     }
 
+    if (GetMutableStats() != nullptr) {
+      GetMutableStats()->hash_table_size = hash_table_.size();
+    }
+
     done_ = true;
   }
 
@@ -16,6 +16,8 @@
 #include "backend/common/logger.h"
 #include "backend/executor/logical_tile_factory.h"
 #include "backend/executor/hash_join_executor.h"
+#include "backend/executor/join_filter.h"
+#include "backend/executor/seq_scan_executor.h"
 #include "backend/expression/abstract_expression.h"
 #include "backend/expression/container_tuple.h"
 
@@ -76,6 +78,8 @@ bool HashJoinExecutor::DExecute() {
         BufferRightTile(children_[1]->GetOutput());
       }
       right_child_done_ = true;
+
+      PushJoinFilter();
     }
 
     // Get next tile from LEFT child
@@ -176,5 +180,46 @@ bool HashJoinExecutor::DExecute() {
   }
 }
 
+void HashJoinExecutor::PushJoinFilter() {
+  // The unmatched left tuples are part of the output of these joins
+  if (join_type_ != JOIN_TYPE_INNER && join_type_ != JOIN_TYPE_RIGHT) return;
+
+  // Only a scan of a table can drop its tuples before building logical tiles
+  auto left_node = children_[0]->GetRawNode();
+  if (left_node == nullptr ||
+      left_node->GetPlanNodeType() != PLAN_NODE_TYPE_SEQSCAN) {
+    return;
+  }
+
+  // In push mode the scan may be wrapped by a pipeline executor
+  auto left_scan = dynamic_cast<SeqScanExecutor *>(children_[0]);
+  if (left_scan == nullptr) return;
+
+  auto &scan_column_ids = left_scan->GetColumnIds();
+  if (scan_column_ids.empty() == true) return;
+
+  auto &hash_table = hash_executor_->GetHashTable();
+  auto &hashed_col_ids = hash_executor_->GetHashKeyIds();
+  if (hash_table.size() > JOIN_FILTER_MAX_KEY_COUNT) return;
+
+  // The left tiles have the columns of the scan
+  std::vector<oid_t> table_column_ids;
+  for (auto column_id : hashed_col_ids) {
+    if (column_id >= scan_column_ids.size()) return;
+    table_column_ids.push_back(scan_column_ids[column_id]);
+  }
+
+  std::shared_ptr<JoinFilter> join_filter(
+      new JoinFilter(table_column_ids, hash_table.size()));
+  for (auto &entry : hash_table) {
+    join_filter->Insert(entry.first, hashed_col_ids);
+  }
+
+  LOG_TRACE("Pushed a join filter over %lu keys into the probe scan",
+            hash_table.size());
+
+  left_scan->SetJoinFilter(join_filter);
+}
+
 }  // namespace executor
 }  // namespace peloton
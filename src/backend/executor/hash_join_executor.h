@@ -36,6 +36,10 @@ class HashJoinExecutor : public AbstractJoinExecutor {
   bool DExecute();
 
  private:
+  // Once the hash table is built, summarize its keys into a join filter
+  // for the probe side scan
+  void PushJoinFilter();
+
   HashExecutor *hash_executor_ = nullptr;
 
   bool hashed_ = false;
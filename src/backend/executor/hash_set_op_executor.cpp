@@ -99,6 +99,10 @@ bool HashSetOpExecutor::ExecuteHelper() {
     }
   }
 
+  if (GetMutableStats() != nullptr) {
+    GetMutableStats()->hash_table_size = htable_.size();
+  }
+
   // Calculate the output number for each key
   switch (set_op_) {
     case SETOP_TYPE_INTERSECT:
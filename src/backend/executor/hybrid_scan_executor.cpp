@@ -151,6 +151,8 @@ bool HybridScanExecutor::DInit() {
     }
   }
 
+  if (table_ != nullptr) RecordAccessSample(table_);
+
   return true;
 }
 
@@ -168,6 +170,12 @@ bool HybridScanExecutor::SeqScanUtil() {
   while (current_tile_group_offset_ < table_tile_group_count_) {
     auto tile_group =
       table_->GetTileGroup(current_tile_group_offset_++);
+
+    // Skip tile groups that the predicate excludes
+    if (TileGroupMayMatch(tile_group.get()) == false) {
+      continue;
+    }
+
     auto tile_group_header = tile_group->GetHeader();
 
     oid_t active_tuple_count = tile_group->GetNextTupleSlot();
@@ -12,7 +12,11 @@
 
 #include "backend/executor/index_scan_executor.h"
 
+#include <algorithm>
 #include <memory>
+#include <numeric>
+#include <set>
+#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -24,6 +28,7 @@
 #include "backend/expression/container_tuple.h"
 #include "backend/index/index.h"
 #include "backend/storage/data_table.h"
+#include "backend/storage/tile.h"
 #include "backend/storage/tile_group.h"
 #include "backend/storage/tile_group_header.h"
 #include "backend/concurrency/transaction_manager_factory.h"
@@ -96,9 +101,41 @@ bool IndexScanExecutor::DInit() {
     std::iota(full_column_ids_.begin(), full_column_ids_.end(), 0);
   }
 
+  InitIndexOnly();
+
   return true;
 }
 
+void IndexScanExecutor::InitIndexOnly() {
+  // Without column ids, the scan outputs all the columns of the table
+  if (skip_output_columns_) {
+    index_only_column_ids_.clear();
+  } else if (column_ids_.empty()) {
+    index_only_column_ids_ = full_column_ids_;
+  } else {
+    index_only_column_ids_ = column_ids_;
+  }
+
+  // Without predicate, the columns may all be read from the index entries
+  index_only_ = false;
+  key_offsets_.clear();
+  if (index_only_allowed_ && table_ != nullptr && predicate_ == nullptr) {
+    auto indexed_columns = index_->GetKeySchema()->GetIndexedColumns();
+    index_only_ = true;
+
+    for (auto column_id : index_only_column_ids_) {
+      auto key_itr = std::find(indexed_columns.begin(), indexed_columns.end(),
+                               column_id);
+      if (key_itr == indexed_columns.end()) {
+        index_only_ = false;
+        key_offsets_.clear();
+        break;
+      }
+      key_offsets_.push_back(std::distance(indexed_columns.begin(), key_itr));
+    }
+  }
+}
+
 /**
  * @brief Creates logical tile(s) after scanning index.
  * @return true on success, false otherwise.
@@ -106,6 +143,11 @@ bool IndexScanExecutor::DInit() {
 bool IndexScanExecutor::DExecute() {
   LOG_TRACE("Index Scan executor :: 0 child");
 
+  if (!done_ && index_only_) {
+    auto status = ExecIndexOnlyLookup();
+    if (status == false) return false;
+  }
+
   if (!done_) {
     if (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
       auto status = ExecPrimaryIndexLookup();
@@ -153,15 +195,40 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  // Each entry is read once, as the garbage collection below may swap it
+  std::vector<ItemPointer> entry_locations;
+  entry_locations.reserve(tuple_location_ptrs.size());
+  for (auto tuple_location_ptr : tuple_location_ptrs) {
+    entry_locations.push_back(*tuple_location_ptr);
+  }
+
+  // Visit the entries tile group by tile group, in slot order
+  std::vector<size_t> entry_positions = GetSlotOrder(entry_locations);
+  std::vector<ItemPointer> tuple_locations;
+  tuple_locations.reserve(entry_positions.size());
+  for (auto entry_position : entry_positions) {
+    tuple_locations.push_back(entry_locations[entry_position]);
+  }
+
+  // the visible version reached through each entry, in index order
+  std::vector<ItemPointer> visible_locations(entry_positions.size());
   std::vector<ItemPointer> garbage_tuples;
+  std::shared_ptr<storage::TileGroup> batch_tile_group;
+  size_t batch_end = 0;
   // for every tuple that is found in the index.
-  for (auto tuple_location_ptr : tuple_location_ptrs) {
-    
-    ItemPointer tuple_location = *tuple_location_ptr;
-    
+  for (size_t entry_itr = 0; entry_itr < tuple_locations.size(); entry_itr++) {
+
+    ItemPointer tuple_location = tuple_locations[entry_itr];
+    ItemPointer *tuple_location_ptr =
+        tuple_location_ptrs[entry_positions[entry_itr]];
+
     auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
+    if (entry_itr == batch_end) {
+      batch_tile_group = manager.GetTileGroup(tuple_location.block);
+      batch_end = PrefetchBatch(tuple_locations, entry_itr,
+                                batch_tile_group.get());
+    }
+    auto tile_group = batch_tile_group;
     auto tile_group_header = tile_group.get()->GetHeader();
 
     size_t chain_length = 0;
@@ -179,7 +246,7 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
 
         // perform predicate evaluation.
         if (predicate_ == nullptr) {
-          visible_tuples[tuple_location.block].push_back(tuple_location.offset);
+          visible_locations[entry_positions[entry_itr]] = tuple_location;
 
           auto res = transaction_manager.PerformRead(tuple_location);
           if (!res) {
@@ -192,8 +259,7 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
           auto eval =
               predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
           if (eval == true) {
-            visible_tuples[tuple_location.block]
-                .push_back(tuple_location.offset);
+            visible_locations[entry_positions[entry_itr]] = tuple_location;
 
             auto res = transaction_manager.PerformRead(tuple_location);
             if (!res) {
@@ -272,6 +338,9 @@ bool IndexScanExecutor::ExecPrimaryIndexLookup() {
     }
   }
 
+  std::map<oid_t, std::vector<oid_t>> visible_tuples =
+      GroupByTileGroup(visible_locations);
+
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
@@ -316,41 +385,88 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
-  std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  // Visit the entries tile group by tile group, in slot order
+  std::vector<size_t> entry_positions = GetSlotOrder(tuple_locations);
+  std::vector<ItemPointer> entry_locations;
+  entry_locations.swap(tuple_locations);
+  tuple_locations.reserve(entry_positions.size());
+  for (auto entry_position : entry_positions) {
+    tuple_locations.push_back(entry_locations[entry_position]);
+  }
+
+  // the visible version reached through each entry, in index order
+  std::vector<ItemPointer> visible_locations(entry_positions.size());
+  // an entry also stands for the newer versions with the same key (heap-only
+  // updates), so several entries may lead to the same visible version.
+  std::set<ItemPointer> visited_tuples;
+  auto &manager = catalog::Manager::GetInstance();
+  std::shared_ptr<storage::TileGroup> batch_tile_group;
+  size_t batch_end = 0;
+
+  // the newer versions may be in other tile groups than the batch
+  auto get_tile_group = [&](const oid_t tile_group_id) {
+    return (tile_group_id == batch_tile_group->GetTileGroupId())
+               ? batch_tile_group
+               : manager.GetTileGroup(tile_group_id);
+  };
+
   // for every tuple that is found in the index.
-  for (auto tuple_location : tuple_locations) {
-    auto &manager = catalog::Manager::GetInstance();
-    auto tile_group = manager.GetTileGroup(tuple_location.block);
-    auto tile_group_header = tile_group.get()->GetHeader();
-    auto tile_group_id = tuple_location.block;
+  for (size_t entry_itr = 0; entry_itr < tuple_locations.size(); entry_itr++) {
+    ItemPointer tuple_location = tuple_locations[entry_itr];
+
+    if (entry_itr == batch_end) {
+      batch_tile_group = manager.GetTileGroup(tuple_location.block);
+      batch_end = PrefetchBatch(tuple_locations, entry_itr,
+                                batch_tile_group.get());
+    }
+
+    // find the visible version reached through this entry, if any.
+    while (tuple_location.IsNull() == false) {
+      auto tile_group_header =
+          get_tile_group(tuple_location.block)->GetHeader();
+      if (transaction_manager.IsVisible(tile_group_header,
+                                        tuple_location.offset)) {
+        break;
+      }
+      tuple_location = storage::DataTable::GetNextIndexedVersion(
+          index_, tuple_location);
+    }
+
+    if (tuple_location.IsNull() == true ||
+        visited_tuples.insert(tuple_location).second == false) {
+      continue;
+    }
+
+    auto tile_group = get_tile_group(tuple_location.block);
     auto tuple_id = tuple_location.offset;
 
-    // if the tuple is visible.
-    if (transaction_manager.IsVisible(tile_group_header, tuple_id)) {
-      // perform predicate evaluation.
-      if (predicate_ == nullptr) {
-        visible_tuples[tile_group_id].push_back(tuple_id);
+    // perform predicate evaluation.
+    if (predicate_ == nullptr) {
+      visible_locations[entry_positions[entry_itr]] = tuple_location;
+      auto res = transaction_manager.PerformRead(tuple_location);
+      if (!res) {
+        transaction_manager.SetTransactionResult(RESULT_FAILURE);
+        return res;
+      }
+    } else {
+      expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
+                                                           tuple_id);
+      auto eval =
+          predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
+      if (eval == true) {
+        visible_locations[entry_positions[entry_itr]] = tuple_location;
         auto res = transaction_manager.PerformRead(tuple_location);
         if (!res) {
           transaction_manager.SetTransactionResult(RESULT_FAILURE);
           return res;
         }
-      } else {
-        expression::ContainerTuple<storage::TileGroup> tuple(tile_group.get(),
-                                                             tuple_id);
-        auto eval =
-            predicate_->Evaluate(&tuple, nullptr, executor_context_).IsTrue();
-        if (eval == true) {
-          visible_tuples[tile_group_id].push_back(tuple_id);
-          auto res = transaction_manager.PerformRead(tuple_location);
-          if (!res) {
-            transaction_manager.SetTransactionResult(RESULT_FAILURE);
-            return res;
-          }
-        }
       }
     }
   }
+
+  std::map<oid_t, std::vector<oid_t>> visible_tuples =
+      GroupByTileGroup(visible_locations);
+
   // Construct a logical tile for each block
   for (auto tuples : visible_tuples) {
     auto &manager = catalog::Manager::GetInstance();
@@ -374,5 +490,211 @@ bool IndexScanExecutor::ExecSecondaryIndexLookup() {
   return true;
 }
 
+std::vector<size_t> IndexScanExecutor::GetSlotOrder(
+    const std::vector<ItemPointer> &tuple_locations) {
+  std::vector<size_t> entry_positions(tuple_locations.size());
+  std::iota(entry_positions.begin(), entry_positions.end(), 0);
+  std::sort(entry_positions.begin(), entry_positions.end(),
+            [&tuple_locations](const size_t lhs, const size_t rhs) {
+              return tuple_locations[lhs] < tuple_locations[rhs];
+            });
+
+  return entry_positions;
+}
+
+std::map<oid_t, std::vector<oid_t>> IndexScanExecutor::GroupByTileGroup(
+    const std::vector<ItemPointer> &visible_locations) {
+  std::map<oid_t, std::vector<oid_t>> visible_tuples;
+  for (auto &location : visible_locations) {
+    if (location.IsNull() == true) continue;
+    visible_tuples[location.block].push_back(location.offset);
+  }
+
+  return visible_tuples;
+}
+
+size_t IndexScanExecutor::PrefetchBatch(
+    const std::vector<ItemPointer> &tuple_locations, const size_t batch_begin,
+    const storage::TileGroup *tile_group) const {
+  auto tile_group_header = tile_group->GetHeader();
+  oid_t tile_group_id = tuple_locations[batch_begin].block;
+
+  // The batch ends with its tile group, the locations are sorted
+  size_t batch_end = batch_begin;
+  while (batch_end < tuple_locations.size() &&
+         batch_end - batch_begin < INDEX_SCAN_BATCH_SIZE &&
+         tuple_locations[batch_end].block == tile_group_id) {
+    tile_group_header->PrefetchTuple(tuple_locations[batch_end].offset);
+
+    // only the predicate reads the tuples here
+    if (predicate_ != nullptr) {
+      tile_group->PrefetchTuple(tuple_locations[batch_end].offset);
+    }
+    batch_end++;
+  }
+
+  return batch_end;
+}
+
+/**
+ * @brief Index-only scan, when all the columns are key columns.
+ *
+ * The key columns of the matching entries are copied into temp tiles, in
+ * index order. An entry pointing into an all-visible tile group is the latest
+ * version, visible to the transaction, so its key is used as is. Otherwise
+ * the visible version is looked up in the table, and its columns overwrite
+ * the key, which may be stale.
+ * @return true on success, false otherwise. If the index can not hand its
+ * keys, index_only_ is cleared and the regular lookup is left to run.
+ */
+bool IndexScanExecutor::ExecIndexOnlyLookup() {
+  PL_ASSERT(!done_);
+
+  std::unique_ptr<catalog::Schema> output_schema(catalog::Schema::CopySchema(
+      table_->GetSchema(), index_only_column_ids_));
+  const oid_t column_count = index_only_column_ids_.size();
+
+  // The temp tiles double in size, point lookups only get a small one
+  std::vector<std::shared_ptr<storage::Tile>> key_tiles;
+  std::vector<oid_t> tile_begins;
+  oid_t tile_end = 0;
+  std::vector<ItemPointer> tuple_locations;
+
+  // The keys are only valid under the lock of the index, copy them
+  auto supported = index_->ScanEntries(
+      values_, key_column_ids_, expr_types_, SCAN_DIRECTION_TYPE_FORWARD,
+      [&](const storage::Tuple *key, const ItemPointer &location) {
+        oid_t entry_itr = tuple_locations.size();
+        if (entry_itr == tile_end) {
+          oid_t row_count = std::min<oid_t>(
+              std::max<oid_t>(16, 2 * entry_itr), DEFAULT_TUPLES_PER_TILEGROUP);
+          // without columns, the logical tiles only carry the positions
+          key_tiles.emplace_back(
+              (column_count > 0)
+                  ? storage::TileFactory::GetTempTile(*output_schema,
+                                                      row_count)
+                  : nullptr);
+          tile_begins.push_back(entry_itr);
+          tile_end = entry_itr + row_count;
+        }
+
+        oid_t row = entry_itr - tile_begins.back();
+        for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+          key_tiles.back()->SetValue(key->GetValue(key_offsets_[column_itr]),
+                                     row, column_itr);
+        }
+        tuple_locations.push_back(location);
+      });
+
+  if (supported == false) {
+    index_only_ = false;
+    return true;
+  }
+
+  LOG_TRACE("Tuple_locations.size(): %lu", tuple_locations.size());
+
+  if (tuple_locations.size() == 0) return false;
+
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+  auto &manager = catalog::Manager::GetInstance();
+  bool is_primary =
+      (index_->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY);
+
+  // # of tuples of the tile groups found all-visible, 0 if they are not
+  std::unordered_map<oid_t, oid_t> all_visible_counts;
+  // only the lookups in the table may reach the same version twice
+  std::set<ItemPointer> visited_tuples;
+
+  for (oid_t tile_itr = 0; tile_itr < key_tiles.size(); tile_itr++) {
+    auto &key_tile = key_tiles[tile_itr];
+    oid_t entry_begin = tile_begins[tile_itr];
+    oid_t entry_end = (tile_itr + 1 < key_tiles.size())
+                          ? tile_begins[tile_itr + 1]
+                          : tuple_locations.size();
+    std::vector<oid_t> position_list;
+
+    for (oid_t entry_itr = entry_begin; entry_itr < entry_end; entry_itr++) {
+      ItemPointer tuple_location = tuple_locations[entry_itr];
+      oid_t tile_group_id = tuple_location.block;
+
+      auto all_visible_itr = all_visible_counts.find(tile_group_id);
+      if (all_visible_itr == all_visible_counts.end()) {
+        auto tile_group_header =
+            manager.GetTileGroup(tile_group_id)->GetHeader();
+        oid_t all_visible_count = 0;
+        if (transaction_manager.IsAllVisible(tile_group_header,
+                                             all_visible_count) == false) {
+          all_visible_count = 0;
+        }
+        all_visible_itr =
+            all_visible_counts.emplace(tile_group_id, all_visible_count).first;
+      }
+
+      if (tuple_location.offset >= all_visible_itr->second) {
+        // find the visible version reached through this entry, if any.
+        while (tuple_location.IsNull() == false) {
+          auto tile_group_header =
+              manager.GetTileGroup(tuple_location.block)->GetHeader();
+          if (transaction_manager.IsVisible(tile_group_header,
+                                            tuple_location.offset)) {
+            break;
+          }
+
+          if (is_primary == true) {
+            tuple_location =
+                tile_group_header->GetNextItemPointer(tuple_location.offset);
+            // there must exist a visible version.
+            if (tuple_location.IsNull()) {
+              transaction_manager.SetTransactionResult(RESULT_FAILURE);
+              return false;
+            }
+          } else {
+            tuple_location = storage::DataTable::GetNextIndexedVersion(
+                index_, tuple_location);
+          }
+        }
+
+        if (tuple_location.IsNull() == true ||
+            visited_tuples.insert(tuple_location).second == false) {
+          continue;
+        }
+
+        auto tile_group = manager.GetTileGroup(tuple_location.block);
+        for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+          key_tile->SetValue(
+              tile_group->GetValue(tuple_location.offset,
+                                   index_only_column_ids_[column_itr]),
+                             entry_itr - entry_begin, column_itr);
+        }
+      }
+
+      position_list.push_back(entry_itr - entry_begin);
+
+      auto res = transaction_manager.PerformRead(tuple_location);
+      if (!res) {
+        transaction_manager.SetTransactionResult(RESULT_FAILURE);
+        return res;
+      }
+    }
+
+    // Construct a logical tile for each temp tile
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+    auto position_list_idx =
+        logical_tile->AddPositionList(std::move(position_list));
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      logical_tile->AddColumn(key_tile, column_itr, position_list_idx);
+    }
+
+    result_.push_back(logical_tile.release());
+  }
+
+  done_ = true;
+
+  LOG_TRACE("Result tiles : %lu", result_.size());
+
+  return true;
+}
+
 }  // namespace executor
 }  // namespace peloton
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <map>
 #include <vector>
 
 #include "backend/executor/abstract_scan_executor.h"
@@ -21,10 +22,14 @@ namespace peloton {
 
 namespace storage {
 class AbstractTable;
+class TileGroup;
 }
 
 namespace executor {
 
+// Max # of entries whose slots are prefetched before being checked
+#define INDEX_SCAN_BATCH_SIZE 64
+
 class IndexScanExecutor : public AbstractScanExecutor {
   IndexScanExecutor(const IndexScanExecutor &) = delete;
   IndexScanExecutor &operator=(const IndexScanExecutor &) = delete;
@@ -35,6 +40,20 @@ class IndexScanExecutor : public AbstractScanExecutor {
 
   ~IndexScanExecutor();
 
+  // Always read the tuples from the table, for the parents that need the
+  // locations of the tuples in the base tiles of the output
+  void DisableIndexOnly() {
+    index_only_allowed_ = false;
+    index_only_ = false;
+  }
+
+  // Output none of the columns, for the parents that only count the tuples.
+  // Any index then covers the scan.
+  void SkipOutputColumns() {
+    skip_output_columns_ = true;
+    InitIndexOnly();
+  }
+
  protected:
   bool DInit();
 
@@ -46,6 +65,26 @@ class IndexScanExecutor : public AbstractScanExecutor {
   //===--------------------------------------------------------------------===//
   bool ExecPrimaryIndexLookup();
   bool ExecSecondaryIndexLookup();
+  bool ExecIndexOnlyLookup();
+
+  // Decide whether the output columns can be read from the index entries
+  void InitIndexOnly();
+
+  // Positions of the entries sorted by location, so that the lookups visit
+  // the tile groups one at a time
+  static std::vector<size_t> GetSlotOrder(
+      const std::vector<ItemPointer> &tuple_locations);
+
+  // Slots of the visible versions per tile group, in the order of the
+  // entries that reached them (index order)
+  static std::map<oid_t, std::vector<oid_t>> GroupByTileGroup(
+      const std::vector<ItemPointer> &visible_locations);
+
+  // Prefetch the slots of the batch of entries starting at batch_begin,
+  // which are in the given tile group. Returns the end of the batch.
+  size_t PrefetchBatch(const std::vector<ItemPointer> &tuple_locations,
+                       const size_t batch_begin,
+                       const storage::TileGroup *tile_group) const;
 
   //===--------------------------------------------------------------------===//
   // Executor State
@@ -82,6 +121,20 @@ class IndexScanExecutor : public AbstractScanExecutor {
   std::vector<oid_t> full_column_ids_;
 
   bool key_ready_ = false;
+
+  /** @brief Read the columns from the index entries (index-only scan) */
+  bool index_only_ = false;
+
+  bool index_only_allowed_ = true;
+
+  bool skip_output_columns_ = false;
+
+  /** @brief Columns read by an index-only scan, all of them if the plan has
+   * no column ids */
+  std::vector<oid_t> index_only_column_ids_;
+
+  /** @brief Offsets in the index key of the columns, for index-only scans */
+  std::vector<oid_t> key_offsets_;
 };
 
 }  // namespace executor
@@ -78,8 +78,8 @@ bool InsertExecutor::DExecute() {
     auto target_table_schema = target_table->GetSchema();
     auto column_count = target_table_schema->GetColumnCount();
 
-    std::unique_ptr<storage::Tuple> tuple(
-        new storage::Tuple(target_table_schema, true));
+    std::vector<std::unique_ptr<storage::Tuple>> tuples;
+    std::vector<const storage::Tuple *> insert_tuples;
 
     // Go over the logical tile
     for (oid_t tuple_id : *logical_tile) {
@@ -87,16 +87,22 @@ bool InsertExecutor::DExecute() {
                                                         tuple_id);
 
       // Materialize the logical tile tuple
+      tuples.emplace_back(new storage::Tuple(target_table_schema, true));
       for (oid_t column_itr = 0; column_itr < column_count; column_itr++)
-        tuple->SetValue(column_itr, cur_tuple.GetValue(column_itr),
-                        executor_pool);
+        tuples.back()->SetValue(column_itr, cur_tuple.GetValue(column_itr),
+                                executor_pool);
+      insert_tuples.push_back(tuples.back().get());
+    }
 
-      peloton::ItemPointer location = target_table->InsertTuple(tuple.get());
-      if (location.block == INVALID_OID) {
-        transaction_manager.SetTransactionResult(
-            peloton::Result::RESULT_FAILURE);
-        return false;
-      }
+    // Insert the whole tile at once
+    std::vector<ItemPointer> locations;
+    if (target_table->InsertTuples(insert_tuples, locations) == false) {
+      transaction_manager.SetTransactionResult(
+          peloton::Result::RESULT_FAILURE);
+      return false;
+    }
+
+    for (auto &location : locations) {
       auto res =
           transaction_manager.PerformInsert(location);
       if (!res) {
@@ -140,6 +146,33 @@ bool InsertExecutor::DExecute() {
     }
 
     // Bulk Insert Mode
+    if (bulk_insert_count > 1) {
+      std::vector<const storage::Tuple *> insert_tuples(bulk_insert_count,
+                                                        tuple);
+      std::vector<ItemPointer> locations;
+
+      // Carry out insertion
+      if (target_table->InsertTuples(insert_tuples, locations) == false) {
+        LOG_TRACE("Failed to Insert. Set txn failure.");
+        transaction_manager.SetTransactionResult(Result::RESULT_FAILURE);
+        return false;
+      }
+
+      for (auto &location : locations) {
+        auto res =
+            transaction_manager.PerformInsert(location);
+        if (!res) {
+          transaction_manager.SetTransactionResult(RESULT_FAILURE);
+          return res;
+        }
+
+        executor_context_->num_processed += 1;  // insert one
+      }
+
+      done_ = true;
+      return true;
+    }
+
     for (oid_t insert_itr = 0; insert_itr < bulk_insert_count; insert_itr++) {
 
       // Carry out insertion
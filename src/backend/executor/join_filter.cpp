@@ -0,0 +1,76 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_filter.cpp
+//
+// Identification: src/backend/executor/join_filter.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "backend/executor/join_filter.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/zone_map.h"
+
+namespace peloton {
+namespace executor {
+
+JoinFilter::JoinFilter(const std::vector<oid_t> &column_ids,
+                       const size_t key_count)
+    : column_ids_(column_ids),
+      bloom_filter_(key_count),
+      has_range_(column_ids.size() == 1) {}
+
+void JoinFilter::Insert(const expression::ContainerTuple<LogicalTile> &key,
+                        const std::vector<oid_t> &key_column_ids) {
+  bloom_filter_.Insert(key.HashCode());
+
+  if (has_range_ == true) {
+    Value value = key.GetValue(key_column_ids[0]);
+    if (value.IsNull() == true) {
+      has_range_ = false;
+    } else if (is_empty_ == true) {
+      min_key_ = value;
+      max_key_ = value;
+    } else if (value.Compare(min_key_) < 0) {
+      min_key_ = value;
+    } else if (value.Compare(max_key_) > 0) {
+      max_key_ = value;
+    }
+  }
+
+  is_empty_ = false;
+}
+
+bool JoinFilter::TileGroupMayMatch(storage::TileGroup *tile_group) const {
+  // No key, no match
+  if (is_empty_ == true) return false;
+
+  if (has_range_ == false) return true;
+
+  auto zone_map = tile_group->GetZoneMap();
+  if (zone_map == nullptr) return true;
+
+  return zone_map->ComparisonMayMatch(
+             column_ids_[0], EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+             min_key_) &&
+         zone_map->ComparisonMayMatch(
+             column_ids_[0], EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO,
+             max_key_);
+}
+
+bool JoinFilter::TupleMayMatch(storage::TileGroup *tile_group,
+                               const oid_t tuple_id) const {
+  // Same hash as ContainerTuple::HashCode on the key columns
+  size_t hash = 0;
+  for (auto column_id : column_ids_) {
+    tile_group->GetValue(tuple_id, column_id).HashCombine(hash);
+  }
+
+  return bloom_filter_.MayContain(hash);
+}
+
+}  // namespace executor
+}  // namespace peloton
@@ -0,0 +1,85 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// join_filter.h
+//
+// Identification: src/backend/executor/join_filter.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <vector>
+
+#include "backend/common/bloom_filter.h"
+#include "backend/common/types.h"
+#include "backend/common/value.h"
+#include "backend/executor/logical_tile.h"
+#include "backend/expression/container_tuple.h"
+
+namespace peloton {
+
+namespace storage {
+class TileGroup;
+}
+
+namespace executor {
+
+// Joins with more build keys do not get a filter
+#define JOIN_FILTER_MAX_KEY_COUNT (1 << 24)
+
+//===--------------------------------------------------------------------===//
+// Join Filter
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Summary of the build side keys of a hash join, pushed into the
+ * probe side scan.
+ *
+ * The scan drops the tuples whose key hash is not in the Bloom filter
+ * before building its logical tiles, and, for single column keys, skips the
+ * tile groups whose zone map is outside the range of the keys. The key
+ * hashes are the ones of the hash table, so every tuple with a match in
+ * the hash table passes.
+ */
+class JoinFilter {
+ public:
+  JoinFilter(const JoinFilter &) = delete;
+  JoinFilter &operator=(const JoinFilter &) = delete;
+  JoinFilter(JoinFilter &&) = delete;
+  JoinFilter &operator=(JoinFilter &&) = delete;
+
+  // column_ids are the key columns in the tile groups of the probe side
+  JoinFilter(const std::vector<oid_t> &column_ids, const size_t key_count);
+
+  // Add a key of the hash table, made of the key_column_ids of its tile
+  void Insert(const expression::ContainerTuple<LogicalTile> &key,
+              const std::vector<oid_t> &key_column_ids);
+
+  // Could any tuple of the tile group have a match ?
+  bool TileGroupMayMatch(storage::TileGroup *tile_group) const;
+
+  // Could the tuple have a match ?
+  bool TupleMayMatch(storage::TileGroup *tile_group,
+                     const oid_t tuple_id) const;
+
+ private:
+  std::vector<oid_t> column_ids_;
+
+  BloomFilter bloom_filter_;
+
+  bool is_empty_ = true;
+
+  // Range of the keys, if they are made of a single non-null column
+  bool has_range_;
+
+  Value min_key_;
+
+  Value max_key_;
+};
+
+}  // namespace executor
+}  // namespace peloton
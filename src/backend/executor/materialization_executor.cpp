@@ -23,6 +23,7 @@
 #include "backend/storage/tuple.h"
 #include "backend/storage/data_table.h"
 #include "backend/storage/tile.h"
+#include "backend/storage/compressed_tile.h"
 
 namespace peloton {
 namespace executor {
@@ -142,6 +143,7 @@ void MaterializeRowAtAtATime(
     std::vector<ValueType> old_column_types;
     std::vector<bool> old_is_inlineds;
     std::vector<storage::Tile *> old_tiles;
+    std::vector<storage::CompressedTile *> old_compressed_tiles;
 
     // Get new column information
     std::vector<size_t> new_column_offsets;
@@ -158,6 +160,10 @@ void MaterializeRowAtAtATime(
       // Get old column information
       storage::Tile *old_tile = column_info.base_tile.get();
       old_tiles.push_back(old_tile);
+      old_compressed_tiles.push_back(
+          old_tile->IsCompressed()
+              ? static_cast<storage::CompressedTile *>(old_tile)
+              : nullptr);
       auto old_schema = old_tile->GetSchema();
       oid_t old_column_id = column_info.origin_column_id;
       const size_t old_column_offset = old_schema->GetOffset(old_column_id);
@@ -202,9 +208,14 @@ void MaterializeRowAtAtATime(
 
         oid_t base_tuple_id = column_position_list[old_tuple_id];
 
-        auto value = old_tiles[col_itr]->GetValueFast(
-            base_tuple_id, old_column_offsets[col_itr],
-            old_column_types[col_itr], old_is_inlineds[col_itr]);
+        auto value =
+            (old_compressed_tiles[col_itr] == nullptr)
+                ? old_tiles[col_itr]->GetValueFast(
+                      base_tuple_id, old_column_offsets[col_itr],
+                      old_column_types[col_itr], old_is_inlineds[col_itr])
+                : old_compressed_tiles[col_itr]->GetValueFast(
+                      base_tuple_id, old_column_offsets[col_itr],
+                      old_column_types[col_itr], old_is_inlineds[col_itr]);
 
         LOG_TRACE("Old Tuple : %u Column : %u ", old_tuple_id, old_col_id);
         LOG_TRACE("New Tuple : %u Column : %lu ", new_tuple_id,
@@ -270,6 +281,21 @@ void MaterializeColumnAtATime(
           source_tile->GetPositionList(column_info.position_list_idx);
       oid_t new_tuple_id = 0;
 
+      // Compressed tiles are decoded through their own getter
+      if (old_tile->IsCompressed()) {
+        auto compressed_tile = static_cast<storage::CompressedTile *>(old_tile);
+        for (oid_t old_tuple_id : *source_tile) {
+          oid_t base_tuple_id = column_position_list[old_tuple_id];
+          auto value = compressed_tile->GetValueFast(
+              base_tuple_id, old_column_offset, old_column_type,
+              old_is_inlined);
+          dest_tile->SetValueFast(value, new_tuple_id, new_column_offset,
+                                  new_is_inlined, new_column_length);
+          new_tuple_id++;
+        }
+        continue;
+      }
+
       // Copy all values in the column to the physical tile
       // This uses fast getter and setter functions
       ///////////////////////////
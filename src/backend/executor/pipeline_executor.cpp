@@ -0,0 +1,790 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pipeline_executor.cpp
+//
+// Identification: src/backend/executor/pipeline_executor.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "backend/executor/pipeline_executor.h"
+
+#include <numeric>
+#include <unordered_map>
+#include <utility>
+
+#include "backend/catalog/manager.h"
+#include "backend/catalog/schema.h"
+#include "backend/common/exception.h"
+#include "backend/common/logger.h"
+#include "backend/common/value_factory.h"
+#include "backend/executor/aggregator.h"
+#include "backend/executor/executor_context.h"
+#include "backend/executor/logical_tile.h"
+#include "backend/executor/logical_tile_factory.h"
+#include "backend/executor/seq_scan_executor.h"
+#include "backend/expression/abstract_expression.h"
+#include "backend/expression/container_tuple.h"
+#include "backend/expression/tuple_value_expression.h"
+#include "backend/planner/aggregate_plan.h"
+#include "backend/planner/hash_join_plan.h"
+#include "backend/planner/hash_plan.h"
+#include "backend/planner/materialization_plan.h"
+#include "backend/planner/projection_plan.h"
+#include "backend/planner/seq_scan_plan.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/table_factory.h"
+#include "backend/storage/tile.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_header.h"
+#include "backend/storage/tuple.h"
+
+namespace peloton {
+namespace executor {
+
+//===--------------------------------------------------------------------===//
+// Pipeline
+//===--------------------------------------------------------------------===//
+
+enum PipelineStageType {
+  PIPELINE_STAGE_TYPE_PROJECT = 0,
+  PIPELINE_STAGE_TYPE_MATERIALIZE = 1,
+  PIPELINE_STAGE_TYPE_PROBE = 2
+};
+
+enum PipelineSinkType {
+  PIPELINE_SINK_TYPE_OUTPUT = 0,
+  PIPELINE_SINK_TYPE_BUILD = 1,
+  PIPELINE_SINK_TYPE_AGGREGATE = 2
+};
+
+struct JoinKeyHasher {
+  size_t operator()(const std::vector<Value> &key) const {
+    size_t seed = 0;
+    for (auto &value : key) value.HashCombine(seed);
+    return seed;
+  }
+};
+
+struct JoinKeyComparator {
+  bool operator()(const std::vector<Value> &lhs,
+                  const std::vector<Value> &rhs) const {
+    for (size_t key_itr = 0; key_itr < lhs.size(); key_itr++) {
+      if (lhs[key_itr].Compare(rhs[key_itr]) != 0) return false;
+    }
+    return true;
+  }
+};
+
+/** @brief Rows of the build side of a hash join, by join key. */
+struct JoinHashTable {
+  std::vector<std::vector<Value>> rows;
+
+  std::unordered_map<std::vector<Value>, std::vector<oid_t>, JoinKeyHasher,
+                     JoinKeyComparator> row_offsets;
+};
+
+struct PipelineStage {
+  PipelineStageType type;
+
+  // PROJECT, and PROBE when the join has a projection
+  const planner::ProjectInfo *project_info = nullptr;
+
+  // MATERIALIZE
+  const std::unordered_map<oid_t, oid_t> *old_to_new_cols = nullptr;
+
+  // PROBE
+  const expression::AbstractExpression *predicate = nullptr;
+
+  const JoinHashTable *hash_table = nullptr;
+
+  std::vector<oid_t> key_column_ids;
+
+  std::vector<Value> key;
+
+  // Output of the stage, reused for every tuple
+  std::vector<Value> row;
+};
+
+struct Pipeline {
+  // Source : either a sequential scan ...
+  std::unique_ptr<SeqScanExecutor> scan;
+
+  // ... or the result of the aggregation in another pipeline
+  Pipeline *aggregate_source = nullptr;
+
+  oid_t source_tile_group_offset = 0;
+
+  // Columns of the source tile groups seen by the first stage
+  std::vector<oid_t> column_ids;
+
+  // Current source tile group and its selected tuples
+  std::shared_ptr<storage::TileGroup> tile_group;
+
+  std::vector<oid_t> selection;
+
+  std::vector<PipelineStage> stages;
+
+  // Number of columns of the tuples reaching the sink
+  oid_t column_count = 0;
+
+  PipelineSinkType sink_type = PIPELINE_SINK_TYPE_OUTPUT;
+
+  // BUILD
+  JoinHashTable hash_table;
+
+  std::vector<oid_t> key_column_ids;
+
+  // AGGREGATE
+  const planner::AggregatePlan *aggregate_node = nullptr;
+
+  std::unique_ptr<storage::DataTable> aggregate_table;
+
+  std::unique_ptr<AbstractAggregator> aggregator;
+};
+
+/**
+ * @brief Tuple of a source tile group, seen through the column ids of the
+ * pipeline. Only the columns used by the stages are read.
+ */
+class SourceTuple : public AbstractTuple {
+ public:
+  SourceTuple(storage::TileGroup *tile_group,
+              const std::vector<oid_t> *column_ids)
+      : tile_group_(tile_group), column_ids_(column_ids) {}
+
+  void SetTupleId(oid_t tuple_id) { tuple_id_ = tuple_id; }
+
+  Value GetValue(oid_t column_id) const override {
+    return tile_group_->GetValue(tuple_id_, (*column_ids_)[column_id]);
+  }
+
+  char *GetData() const override {
+    throw NotImplementedException(
+        "GetData() not supported for pipeline tuples.");
+    return nullptr;
+  }
+
+ private:
+  storage::TileGroup *tile_group_;
+
+  const std::vector<oid_t> *column_ids_;
+
+  oid_t tuple_id_ = INVALID_OID;
+};
+
+//===--------------------------------------------------------------------===//
+// Plan Helpers
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Columns produced by a supported plan node.
+ */
+static std::vector<catalog::Column> GetOutputColumns(
+    const planner::AbstractPlan *plan) {
+  auto &children = plan->GetChildren();
+
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN: {
+      auto node = static_cast<const planner::SeqScanPlan *>(plan);
+      auto schema = node->GetTable()->GetSchema();
+      auto &column_ids = node->GetColumnIds();
+      if (column_ids.empty()) return schema->GetColumns();
+
+      std::vector<catalog::Column> columns;
+      for (auto column_id : column_ids) {
+        columns.push_back(schema->GetColumn(column_id));
+      }
+      return columns;
+    }
+
+    case PLAN_NODE_TYPE_PROJECTION:
+      return static_cast<const planner::ProjectionPlan *>(plan)
+          ->GetSchema()
+          ->GetColumns();
+
+    case PLAN_NODE_TYPE_MATERIALIZE: {
+      auto schema =
+          static_cast<const planner::MaterializationPlan *>(plan)->GetSchema();
+      if (schema == nullptr) return GetOutputColumns(children[0].get());
+      return schema->GetColumns();
+    }
+
+    case PLAN_NODE_TYPE_AGGREGATE_V2:
+      return static_cast<const planner::AggregatePlan *>(plan)
+          ->GetOutputSchema()
+          ->GetColumns();
+
+    case PLAN_NODE_TYPE_HASH:
+      return GetOutputColumns(children[0].get());
+
+    case PLAN_NODE_TYPE_HASHJOIN: {
+      auto node = static_cast<const planner::HashJoinPlan *>(plan);
+      if (node->GetProjInfo() != nullptr) {
+        return node->GetSchema()->GetColumns();
+      }
+
+      // Left columns followed by right columns
+      auto columns = GetOutputColumns(children[0].get());
+      auto right_columns = GetOutputColumns(children[1].get());
+      columns.insert(columns.end(), right_columns.begin(),
+                     right_columns.end());
+      return columns;
+    }
+
+    default:
+      throw NotImplementedException("Plan node not supported by pipelines");
+  }
+}
+
+/**
+ * @brief Evaluate a projection into a row of values.
+ */
+static void ProjectRow(const planner::ProjectInfo *project_info,
+                       const AbstractTuple *tuple1, const AbstractTuple *tuple2,
+                       ExecutorContext *executor_context,
+                       std::vector<Value> &row) {
+  for (auto &target : project_info->GetTargetList()) {
+    row[target.first] =
+        target.second->Evaluate(tuple1, tuple2, executor_context);
+  }
+
+  for (auto &direct_map : project_info->GetDirectMapList()) {
+    auto tuple = (direct_map.second.first == 0) ? tuple1 : tuple2;
+    row[direct_map.first] = tuple->GetValue(direct_map.second.second);
+  }
+}
+
+/**
+ * @brief Get the join key of a tuple.
+ * @return false if a key column is null, as null never joins.
+ */
+static bool GetJoinKey(const AbstractTuple *tuple,
+                       const std::vector<oid_t> &key_column_ids,
+                       std::vector<Value> &key) {
+  key.resize(key_column_ids.size());
+  for (size_t key_itr = 0; key_itr < key_column_ids.size(); key_itr++) {
+    key[key_itr] = tuple->GetValue(key_column_ids[key_itr]);
+    if (key[key_itr].IsNull()) return false;
+  }
+  return true;
+}
+
+//===--------------------------------------------------------------------===//
+// Pipeline Executor
+//===--------------------------------------------------------------------===//
+
+PipelineExecutor::PipelineExecutor(const planner::AbstractPlan *node,
+                                   ExecutorContext *executor_context)
+    : AbstractExecutor(node, executor_context) {}
+
+PipelineExecutor::~PipelineExecutor() {
+  for (auto output_tile : output_tiles_) delete output_tile;
+}
+
+/**
+ * @brief Check if every node in the plan tree has a pipelined implementation.
+ * Supported nodes are sequential scans over tables, projections,
+ * materializations, hash and plain aggregations and inner hash joins.
+ */
+bool PipelineExecutor::IsSupported(const planner::AbstractPlan *plan) {
+  if (plan == nullptr) return false;
+
+  auto &children = plan->GetChildren();
+
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN:
+      return children.empty() &&
+             static_cast<const planner::SeqScanPlan *>(plan)->GetTable() !=
+                 nullptr;
+
+    case PLAN_NODE_TYPE_PROJECTION:
+    case PLAN_NODE_TYPE_MATERIALIZE:
+      return children.size() == 1 && IsSupported(children[0].get());
+
+    case PLAN_NODE_TYPE_AGGREGATE_V2: {
+      auto strategy = static_cast<const planner::AggregatePlan *>(plan)
+                          ->GetAggregateStrategy();
+      return (strategy == AGGREGATE_TYPE_HASH ||
+              strategy == AGGREGATE_TYPE_PLAIN) &&
+             children.size() == 1 && IsSupported(children[0].get());
+    }
+
+    case PLAN_NODE_TYPE_HASHJOIN: {
+      auto node = static_cast<const planner::HashJoinPlan *>(plan);
+      if (node->GetJoinType() != JOIN_TYPE_INNER || children.size() != 2 ||
+          children[1]->GetPlanNodeType() != PLAN_NODE_TYPE_HASH) {
+        return false;
+      }
+      if (node->GetProjInfo() != nullptr && node->GetSchema() == nullptr) {
+        return false;
+      }
+
+      // The hash keys must be plain columns of the build side
+      auto hash_node =
+          static_cast<const planner::HashPlan *>(children[1].get());
+      for (auto &hash_key : hash_node->GetHashKeys()) {
+        if (hash_key->GetExpressionType() != EXPRESSION_TYPE_VALUE_TUPLE) {
+          return false;
+        }
+      }
+
+      auto &hash_children = hash_node->GetChildren();
+      return hash_children.size() == 1 &&
+             IsSupported(hash_children[0].get()) &&
+             IsSupported(children[0].get());
+    }
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Split the plan tree into pipelines.
+ * @return true on success, false otherwise.
+ */
+bool PipelineExecutor::DInit() {
+  PL_ASSERT(children_.size() == 0);
+
+  for (auto output_tile : output_tiles_) delete output_tile;
+  output_tiles_.clear();
+  output_tile_.reset();
+  output_tile_offset_ = 0;
+  breakers_done_ = false;
+  pipelines_.clear();
+
+  auto plan = GetRawNode();
+  if (IsSupported(plan) == false) {
+    LOG_ERROR("Plan can not be run in pipelined mode");
+    return false;
+  }
+
+  auto pipeline = BuildPipeline(plan);
+  if (pipeline == nullptr) return false;
+
+  // The pipeline producing the output of the plan is always the last one
+  PL_ASSERT(pipeline == pipelines_.back().get());
+  pipeline->sink_type = PIPELINE_SINK_TYPE_OUTPUT;
+
+  output_schema_.reset(new catalog::Schema(GetOutputColumns(plan)));
+
+  return true;
+}
+
+/**
+ * @brief Build the pipelines for the given plan, in the order in which they
+ * have to run.
+ * @return the pipeline producing the output of the plan, or nullptr.
+ */
+Pipeline *PipelineExecutor::BuildPipeline(const planner::AbstractPlan *plan) {
+  auto &children = plan->GetChildren();
+
+  switch (plan->GetPlanNodeType()) {
+    case PLAN_NODE_TYPE_SEQSCAN: {
+      std::unique_ptr<Pipeline> pipeline(new Pipeline());
+      pipeline->scan.reset(new SeqScanExecutor(plan, executor_context_));
+      if (pipeline->scan->Init() == false) return nullptr;
+
+      pipeline->column_ids = pipeline->scan->GetColumnIds();
+      pipeline->column_count = pipeline->column_ids.size();
+
+      pipelines_.push_back(std::move(pipeline));
+      return pipelines_.back().get();
+    }
+
+    case PLAN_NODE_TYPE_PROJECTION: {
+      auto node = static_cast<const planner::ProjectionPlan *>(plan);
+      auto pipeline = BuildPipeline(children[0].get());
+      if (pipeline == nullptr) return nullptr;
+
+      PipelineStage stage;
+      stage.type = PIPELINE_STAGE_TYPE_PROJECT;
+      stage.project_info = node->GetProjectInfo();
+      stage.row.resize(node->GetSchema()->GetColumnCount());
+
+      pipeline->column_count = stage.row.size();
+      pipeline->stages.push_back(std::move(stage));
+      return pipeline;
+    }
+
+    case PLAN_NODE_TYPE_MATERIALIZE: {
+      auto node = static_cast<const planner::MaterializationPlan *>(plan);
+      auto pipeline = BuildPipeline(children[0].get());
+      if (pipeline == nullptr) return nullptr;
+
+      // Pass-through materialization
+      if (node->GetSchema() == nullptr) return pipeline;
+
+      PipelineStage stage;
+      stage.type = PIPELINE_STAGE_TYPE_MATERIALIZE;
+      stage.old_to_new_cols = &node->old_to_new_cols();
+      stage.row.resize(node->GetSchema()->GetColumnCount());
+
+      pipeline->column_count = stage.row.size();
+      pipeline->stages.push_back(std::move(stage));
+      return pipeline;
+    }
+
+    case PLAN_NODE_TYPE_AGGREGATE_V2: {
+      auto node = static_cast<const planner::AggregatePlan *>(plan);
+
+      // Breaker : the child pipeline aggregates into a temp table
+      auto child_pipeline = BuildPipeline(children[0].get());
+      if (child_pipeline == nullptr) return nullptr;
+
+      child_pipeline->sink_type = PIPELINE_SINK_TYPE_AGGREGATE;
+      child_pipeline->aggregate_node = node;
+
+      bool own_schema = false;
+      bool adapt_table = false;
+      child_pipeline->aggregate_table.reset(storage::TableFactory::GetDataTable(
+          INVALID_OID, INVALID_OID,
+          const_cast<catalog::Schema *>(node->GetOutputSchema()),
+          "aggregate_temp_table", DEFAULT_TUPLES_PER_TILEGROUP, own_schema,
+          adapt_table));
+
+      std::unique_ptr<Pipeline> pipeline(new Pipeline());
+      pipeline->aggregate_source = child_pipeline;
+      pipeline->column_count = node->GetOutputSchema()->GetColumnCount();
+      pipeline->column_ids.resize(pipeline->column_count);
+      std::iota(pipeline->column_ids.begin(), pipeline->column_ids.end(), 0);
+
+      pipelines_.push_back(std::move(pipeline));
+      return pipelines_.back().get();
+    }
+
+    case PLAN_NODE_TYPE_HASHJOIN: {
+      auto node = static_cast<const planner::HashJoinPlan *>(plan);
+      auto hash_node =
+          static_cast<const planner::HashPlan *>(children[1].get());
+
+      // Breaker : the right pipeline builds the hash table
+      auto build_pipeline = BuildPipeline(hash_node->GetChildren()[0].get());
+      if (build_pipeline == nullptr) return nullptr;
+
+      build_pipeline->sink_type = PIPELINE_SINK_TYPE_BUILD;
+      for (auto &hash_key : hash_node->GetHashKeys()) {
+        auto tuple_value =
+            static_cast<const expression::TupleValueExpression *>(
+                hash_key.get());
+        build_pipeline->key_column_ids.push_back(tuple_value->GetColumnId());
+      }
+
+      // The left pipeline probes it
+      auto pipeline = BuildPipeline(children[0].get());
+      if (pipeline == nullptr) return nullptr;
+
+      PipelineStage stage;
+      stage.type = PIPELINE_STAGE_TYPE_PROBE;
+      stage.predicate = node->GetPredicate();
+      stage.project_info = node->GetProjInfo();
+      stage.hash_table = &build_pipeline->hash_table;
+
+      // Like the hash join executor, probe on the build key columns unless
+      // the outer keys are given
+      stage.key_column_ids = node->GetOuterHashIds();
+      if (stage.key_column_ids.empty()) {
+        stage.key_column_ids = build_pipeline->key_column_ids;
+      }
+
+      if (stage.project_info != nullptr) {
+        stage.row.resize(node->GetSchema()->GetColumnCount());
+      } else {
+        stage.row.resize(pipeline->column_count + build_pipeline->column_count);
+      }
+
+      pipeline->column_count = stage.row.size();
+      pipeline->stages.push_back(std::move(stage));
+      return pipeline;
+    }
+
+    default:
+      return nullptr;
+  }
+}
+
+/**
+ * @brief Run the pipelines that feed the last one, then the last one a tile
+ * group at a time until there is some output.
+ * @return true on success, false when there is no more output.
+ */
+bool PipelineExecutor::DExecute() {
+  if (breakers_done_ == false) {
+    for (size_t pipeline_itr = 0; pipeline_itr + 1 < pipelines_.size();
+         pipeline_itr++) {
+      if (RunPipeline(pipelines_[pipeline_itr].get()) == false) return false;
+    }
+    breakers_done_ = true;
+  }
+
+  auto pipeline = pipelines_.back().get();
+  while (output_tiles_.empty()) {
+    if (ProcessNextTileGroup(pipeline) == false) break;
+  }
+
+  if (output_tiles_.empty()) return false;
+
+  SetOutput(output_tiles_.front());
+  output_tiles_.pop_front();
+  return true;
+}
+
+/**
+ * @brief Run a pipeline over all of its source.
+ * @return false if the transaction failed.
+ */
+bool PipelineExecutor::RunPipeline(Pipeline *pipeline) {
+  while (ProcessNextTileGroup(pipeline) == true)
+    ;
+
+  if (executor_context_->GetTransaction()->GetResult() == RESULT_FAILURE) {
+    return false;
+  }
+
+  if (pipeline->sink_type == PIPELINE_SINK_TYPE_AGGREGATE) {
+    return FinishAggregate(pipeline);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Push the selected tuples of the next source tile group through the
+ * pipeline.
+ * @return false when the source is exhausted or on failure.
+ */
+bool PipelineExecutor::ProcessNextTileGroup(Pipeline *pipeline) {
+  if (pipeline->scan != nullptr) {
+    if (pipeline->scan->ScanNextTileGroup(pipeline->tile_group,
+                                          pipeline->selection) == false) {
+      return false;
+    }
+  } else {
+    auto table = pipeline->aggregate_source->aggregate_table.get();
+    if (pipeline->source_tile_group_offset >= table->GetTileGroupCount()) {
+      return false;
+    }
+
+    pipeline->tile_group =
+        table->GetTileGroup(pipeline->source_tile_group_offset++);
+    pipeline->selection.resize(pipeline->tile_group->GetNextTupleSlot());
+    std::iota(pipeline->selection.begin(), pipeline->selection.end(), 0);
+    if (pipeline->selection.empty()) return true;
+  }
+
+  // Without stages, the output just refers to the selected tuples
+  if (pipeline->sink_type == PIPELINE_SINK_TYPE_OUTPUT &&
+      pipeline->stages.empty()) {
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+    logical_tile->AddColumns(pipeline->tile_group, pipeline->column_ids);
+    logical_tile->AddPositionList(
+        LogicalTile::PositionList(pipeline->selection));
+    output_tiles_.push_back(logical_tile.release());
+    return true;
+  }
+
+  output_tile_capacity_ = pipeline->selection.size();
+
+  SourceTuple tuple(pipeline->tile_group.get(), &pipeline->column_ids);
+  for (auto tuple_id : pipeline->selection) {
+    tuple.SetTupleId(tuple_id);
+    if (PushTuple(pipeline, 0, &tuple) == false) return false;
+  }
+
+  if (pipeline->sink_type == PIPELINE_SINK_TYPE_OUTPUT) FlushOutputTile();
+
+  return true;
+}
+
+/**
+ * @brief Run the given stage and the following ones on a tuple.
+ * @return true on success, false otherwise.
+ */
+bool PipelineExecutor::PushTuple(Pipeline *pipeline, size_t stage_offset,
+                                 AbstractTuple *tuple) {
+  if (stage_offset == pipeline->stages.size()) {
+    return ConsumeTuple(pipeline, tuple);
+  }
+
+  auto &stage = pipeline->stages[stage_offset];
+  expression::ContainerTuple<std::vector<Value>> row_tuple(&stage.row);
+
+  switch (stage.type) {
+    case PIPELINE_STAGE_TYPE_PROJECT:
+      ProjectRow(stage.project_info, tuple, nullptr, executor_context_,
+                 stage.row);
+      return PushTuple(pipeline, stage_offset + 1, &row_tuple);
+
+    case PIPELINE_STAGE_TYPE_MATERIALIZE:
+      for (auto &entry : *stage.old_to_new_cols) {
+        stage.row[entry.second] = tuple->GetValue(entry.first);
+      }
+      return PushTuple(pipeline, stage_offset + 1, &row_tuple);
+
+    case PIPELINE_STAGE_TYPE_PROBE: {
+      if (GetJoinKey(tuple, stage.key_column_ids, stage.key) == false) {
+        return true;
+      }
+
+      auto &hash_table = *stage.hash_table;
+      auto location = hash_table.row_offsets.find(stage.key);
+      if (location == hash_table.row_offsets.end()) return true;
+
+      for (auto row_offset : location->second) {
+        auto &right_row = hash_table.rows[row_offset];
+        expression::ContainerTuple<std::vector<Value>> right_tuple(
+            const_cast<std::vector<Value> *>(&right_row));
+
+        if (stage.predicate != nullptr &&
+            stage.predicate->Evaluate(tuple, &right_tuple, executor_context_)
+                    .IsTrue() == false) {
+          continue;
+        }
+
+        if (stage.project_info != nullptr) {
+          ProjectRow(stage.project_info, tuple, &right_tuple,
+                     executor_context_, stage.row);
+        } else {
+          oid_t left_column_count = stage.row.size() - right_row.size();
+          for (oid_t column_itr = 0; column_itr < left_column_count;
+               column_itr++) {
+            stage.row[column_itr] = tuple->GetValue(column_itr);
+          }
+          std::copy(right_row.begin(), right_row.end(),
+                    stage.row.begin() + left_column_count);
+        }
+
+        if (PushTuple(pipeline, stage_offset + 1, &row_tuple) == false) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Hand a tuple that went through all the stages to the sink.
+ * @return true on success, false otherwise.
+ */
+bool PipelineExecutor::ConsumeTuple(Pipeline *pipeline, AbstractTuple *tuple) {
+  switch (pipeline->sink_type) {
+    case PIPELINE_SINK_TYPE_OUTPUT: {
+      if (output_tile_.get() == nullptr) {
+        output_tile_.reset(storage::TileFactory::GetTempTile(
+            *output_schema_, output_tile_capacity_));
+        output_tile_offset_ = 0;
+      }
+
+      for (oid_t column_itr = 0; column_itr < pipeline->column_count;
+           column_itr++) {
+        output_tile_->SetValue(tuple->GetValue(column_itr),
+                               output_tile_offset_, column_itr);
+      }
+
+      if (++output_tile_offset_ == output_tile_capacity_) FlushOutputTile();
+      return true;
+    }
+
+    case PIPELINE_SINK_TYPE_BUILD: {
+      std::vector<Value> key;
+      if (GetJoinKey(tuple, pipeline->key_column_ids, key) == false) {
+        return true;
+      }
+
+      // The row outlives the source tile group, so copy out its values
+      auto pool = executor_context_->GetExecutorContextPool();
+      std::vector<Value> row;
+      row.reserve(pipeline->column_count);
+      for (oid_t column_itr = 0; column_itr < pipeline->column_count;
+           column_itr++) {
+        row.push_back(ValueFactory::Clone(tuple->GetValue(column_itr), pool));
+      }
+
+      auto &hash_table = pipeline->hash_table;
+      hash_table.row_offsets[key].push_back(hash_table.rows.size());
+      hash_table.rows.push_back(std::move(row));
+      return true;
+    }
+
+    case PIPELINE_SINK_TYPE_AGGREGATE: {
+      if (pipeline->aggregator.get() == nullptr) {
+        auto node = pipeline->aggregate_node;
+        auto output_table = pipeline->aggregate_table.get();
+
+        if (node->GetAggregateStrategy() == AGGREGATE_TYPE_HASH) {
+          pipeline->aggregator.reset(new HashAggregator(
+              node, output_table, executor_context_, pipeline->column_count));
+        } else {
+          pipeline->aggregator.reset(
+              new PlainAggregator(node, output_table, executor_context_));
+        }
+      }
+
+      return pipeline->aggregator->Advance(tuple);
+    }
+
+    default:
+      return false;
+  }
+}
+
+/**
+ * @brief Write the result of the aggregation into the temp table.
+ * @return true on success, false otherwise.
+ */
+bool PipelineExecutor::FinishAggregate(Pipeline *pipeline) {
+  if (pipeline->aggregator.get() != nullptr) {
+    pipeline->aggregator->Finalize();
+    return true;
+  }
+
+  // Without input tuples and group-by, SQL requires a NULL tuple
+  if (pipeline->aggregate_node->GetGroupbyColIds().empty()) {
+    auto output_table = pipeline->aggregate_table.get();
+    std::unique_ptr<storage::Tuple> tuple(
+        new storage::Tuple(output_table->GetSchema(), true));
+    tuple->SetAllNulls();
+    auto location = output_table->InsertTuple(tuple.get());
+    if (location.block == INVALID_OID) return false;
+
+    auto &manager = catalog::Manager::GetInstance();
+    auto tile_group_header = manager.GetTileGroup(location.block)->GetHeader();
+    tile_group_header->SetTransactionId(location.offset, INITIAL_TXN_ID);
+  }
+
+  return true;
+}
+
+/**
+ * @brief Wrap the tuples written into the output tile into a logical tile.
+ */
+void PipelineExecutor::FlushOutputTile() {
+  if (output_tile_.get() == nullptr) return;
+
+  if (output_tile_offset_ > 0) {
+    LogicalTile::PositionList position_list(output_tile_offset_);
+    std::iota(position_list.begin(), position_list.end(), 0);
+
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+    logical_tile->AddPositionList(std::move(position_list));
+    for (oid_t column_itr = 0; column_itr < output_schema_->GetColumnCount();
+         column_itr++) {
+      logical_tile->AddColumn(output_tile_, column_itr, 0);
+    }
+    output_tiles_.push_back(logical_tile.release());
+  }
+
+  output_tile_.reset();
+  output_tile_offset_ = 0;
+}
+
+}  // namespace executor
+}  // namespace peloton
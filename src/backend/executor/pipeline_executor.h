@@ -0,0 +1,116 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pipeline_executor.h
+//
+// Identification: src/backend/executor/pipeline_executor.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include "backend/executor/abstract_executor.h"
+
+namespace peloton {
+
+class AbstractTuple;
+
+namespace catalog {
+class Schema;
+}
+
+namespace storage {
+class Tile;
+}
+
+namespace executor {
+
+struct Pipeline;
+
+/**
+ * @brief Push-based execution of a plan tree.
+ *
+ * The plan is split into pipelines at the pipeline breakers, i.e. the build
+ * side of a hash join and aggregations. Each pipeline has a source (a
+ * sequential scan, or the result of an aggregation), a chain of stages
+ * (projection, materialization, hash join probe) and a sink (the output of
+ * the plan, a hash join build or an aggregation).
+ *
+ * A pipeline runs one tile group at a time : the source fills a selection
+ * vector that is reused across tile groups, and every selected tuple is
+ * pushed through the stages into the sink in a single loop, without building
+ * intermediate logical tiles. The output is returned as logical tiles, like
+ * any other executor, so a pipeline executor can replace a subtree of the
+ * pull-based executor tree.
+ *
+ * Only a subset of the plan nodes is supported (see IsSupported).
+ */
+class PipelineExecutor : public AbstractExecutor {
+ public:
+  PipelineExecutor(const PipelineExecutor &) = delete;
+  PipelineExecutor &operator=(const PipelineExecutor &) = delete;
+  PipelineExecutor(PipelineExecutor &&) = delete;
+  PipelineExecutor &operator=(PipelineExecutor &&) = delete;
+
+  explicit PipelineExecutor(const planner::AbstractPlan *node,
+                            ExecutorContext *executor_context);
+
+  ~PipelineExecutor();
+
+  // Can the plan tree be run in push-based mode ?
+  static bool IsSupported(const planner::AbstractPlan *plan);
+
+ protected:
+  bool DInit();
+
+  bool DExecute();
+
+ private:
+  Pipeline *BuildPipeline(const planner::AbstractPlan *plan);
+
+  bool RunPipeline(Pipeline *pipeline);
+
+  bool ProcessNextTileGroup(Pipeline *pipeline);
+
+  bool PushTuple(Pipeline *pipeline, size_t stage_offset,
+                 AbstractTuple *tuple);
+
+  bool ConsumeTuple(Pipeline *pipeline, AbstractTuple *tuple);
+
+  bool FinishAggregate(Pipeline *pipeline);
+
+  void FlushOutputTile();
+
+  //===--------------------------------------------------------------------===//
+  // Executor State
+  //===--------------------------------------------------------------------===//
+
+  /** @brief Pipelines in the order in which they must be run. */
+  std::vector<std::unique_ptr<Pipeline>> pipelines_;
+
+  /** @brief Have the pipelines feeding the last one been run ? */
+  bool breakers_done_ = false;
+
+  /** @brief Schema of the output tiles. */
+  std::unique_ptr<catalog::Schema> output_schema_;
+
+  /** @brief Physical tile being filled by the output sink. */
+  std::shared_ptr<storage::Tile> output_tile_;
+
+  oid_t output_tile_offset_ = 0;
+
+  oid_t output_tile_capacity_ = 0;
+
+  /** @brief Output tiles not yet returned. */
+  std::deque<LogicalTile *> output_tiles_;
+};
+
+}  // namespace executor
+}  // namespace peloton
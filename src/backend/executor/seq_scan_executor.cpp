@@ -13,6 +13,7 @@
 #include "backend/executor/seq_scan_executor.h"
 
 #include <memory>
+#include <numeric>
 #include <utility>
 #include <vector>
 
@@ -22,6 +23,8 @@
 #include "backend/executor/executor_context.h"
 #include "backend/expression/abstract_expression.h"
 #include "backend/expression/container_tuple.h"
+#include "backend/expression/tuple_value_expression.h"
+#include "backend/storage/compressed_tile.h"
 #include "backend/storage/data_table.h"
 #include "backend/storage/tile_group_header.h"
 #include "backend/storage/tile.h"
@@ -32,6 +35,60 @@
 namespace peloton {
 namespace executor {
 
+/**
+ * @brief Find the only column of the outer tuple that the expression depends
+ * on. The expression must be a deterministic function of that column.
+ * @return false if the expression depends on anything else.
+ */
+static bool GetSingleColumn(const expression::AbstractExpression *expr,
+                            oid_t &column_id) {
+  if (expr == nullptr) return true;
+
+  switch (expr->GetExpressionType()) {
+    case EXPRESSION_TYPE_VALUE_TUPLE: {
+      auto tuple_value_expr =
+          static_cast<const expression::TupleValueExpression *>(expr);
+      if (tuple_value_expr->GetTupleIdx() != 0) return false;
+
+      oid_t expr_column_id = tuple_value_expr->GetColumnId();
+      if (column_id != INVALID_OID && column_id != expr_column_id) {
+        return false;
+      }
+      column_id = expr_column_id;
+      return true;
+    }
+
+    case EXPRESSION_TYPE_VALUE_CONSTANT:
+    case EXPRESSION_TYPE_VALUE_PARAMETER:
+    case EXPRESSION_TYPE_VALUE_NULL:
+      return true;
+
+    case EXPRESSION_TYPE_COMPARE_EQUAL:
+    case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+    case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+    case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+    case EXPRESSION_TYPE_COMPARE_LIKE:
+    case EXPRESSION_TYPE_COMPARE_NOTLIKE:
+    case EXPRESSION_TYPE_CONJUNCTION_AND:
+    case EXPRESSION_TYPE_CONJUNCTION_OR:
+    case EXPRESSION_TYPE_OPERATOR_NOT:
+    case EXPRESSION_TYPE_OPERATOR_IS_NULL:
+    case EXPRESSION_TYPE_OPERATOR_PLUS:
+    case EXPRESSION_TYPE_OPERATOR_MINUS:
+    case EXPRESSION_TYPE_OPERATOR_MULTIPLY:
+    case EXPRESSION_TYPE_OPERATOR_DIVIDE:
+    case EXPRESSION_TYPE_OPERATOR_MOD:
+    case EXPRESSION_TYPE_OPERATOR_UNARY_MINUS:
+      return GetSingleColumn(expr->GetLeft(), column_id) &&
+             GetSingleColumn(expr->GetRight(), column_id);
+
+    default:
+      return false;
+  }
+}
+
 /**
  * @brief Constructor for seqscan executor.
  * @param node Seqscan node corresponding to this executor.
@@ -56,6 +113,9 @@ bool SeqScanExecutor::DInit() {
 
   current_tile_group_offset_ = START_OID;
 
+  // The hash join pushes the filter of its current build again, if any
+  join_filter_.reset();
+
   if (target_table_ != nullptr) {
     table_tile_group_count_ = target_table_->GetTileGroupCount();
 
@@ -63,6 +123,15 @@ bool SeqScanExecutor::DInit() {
       column_ids_.resize(target_table_->GetSchema()->GetColumnCount());
       std::iota(column_ids_.begin(), column_ids_.end(), 0);
     }
+
+    RecordAccessSample(target_table_);
+  }
+
+  // Check if the predicate can be evaluated on compressed codes
+  predicate_column_id_ = INVALID_OID;
+  if (predicate_ != nullptr &&
+      GetSingleColumn(predicate_, predicate_column_id_) == false) {
+    predicate_column_id_ = INVALID_OID;
   }
 
   return true;
@@ -110,72 +179,175 @@ bool SeqScanExecutor::DExecute() {
   else if (children_.size() == 0) {
     LOG_TRACE("Seq Scan executor :: 0 child ");
 
-    PL_ASSERT(target_table_ != nullptr);
-    PL_ASSERT(column_ids_.size() > 0);
+    std::shared_ptr<storage::TileGroup> tile_group;
+    std::vector<oid_t> position_list;
+    if (ScanNextTileGroup(tile_group, position_list) == false) {
+      return false;
+    }
 
-    // Force to use occ txn manager if dirty read is forbidden
-    concurrency::TransactionManager &transaction_manager =
-        concurrency::TransactionManagerFactory::GetInstance();
+    // Construct logical tile.
+    std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
+    logical_tile->AddColumns(tile_group, column_ids_);
+    logical_tile->AddPositionList(std::move(position_list));
 
-    // LOG_TRACE("Number of tuples: %f",
-    // target_table_->GetIndex(0)->GetNumberOfTuples());
+    SetOutput(logical_tile.release());
+    return true;
+  }
 
-    // Retrieve next tile group.
-    while (current_tile_group_offset_ < table_tile_group_count_) {
-      auto tile_group =
-          target_table_->GetTileGroup(current_tile_group_offset_++);
-      auto tile_group_header = tile_group->GetHeader();
+  return false;
+}
 
-      oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+/**
+ * @brief Selects the visible tuples of the next tile group that satisfy the
+ * predicate. Empty tile groups are skipped.
+ * @return false when the table is exhausted or a read failed.
+ */
+bool SeqScanExecutor::ScanNextTileGroup(
+    std::shared_ptr<storage::TileGroup> &tile_group,
+    std::vector<oid_t> &position_list) {
+  PL_ASSERT(target_table_ != nullptr);
+  PL_ASSERT(column_ids_.size() > 0);
+
+  // Force to use occ txn manager if dirty read is forbidden
+  concurrency::TransactionManager &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  // LOG_TRACE("Number of tuples: %f",
+  // target_table_->GetIndex(0)->GetNumberOfTuples());
+
+  // Retrieve next tile group.
+  while (current_tile_group_offset_ < table_tile_group_count_) {
+    tile_group = target_table_->GetTileGroup(current_tile_group_offset_++);
+
+    // Skip tile groups that the predicate or the join filter excludes
+    if (TileGroupMayMatch(tile_group.get()) == false ||
+        (join_filter_ != nullptr &&
+         join_filter_->TileGroupMayMatch(tile_group.get()) == false)) {
+      continue;
+    }
 
+    auto tile_group_header = tile_group->GetHeader();
+
+    oid_t active_tuple_count = tile_group->GetNextTupleSlot();
+
+    // On a dictionary or run-length encoded predicate column, the
+    // predicate only has to be evaluated once per code
+    storage::CompressedTile *predicate_tile = nullptr;
+    oid_t predicate_tile_column_id = INVALID_OID;
+    std::vector<int8_t> code_results;
+    if (predicate_column_id_ != INVALID_OID && tile_group->IsCompressed()) {
+      oid_t tile_offset;
+      tile_group->LocateTileAndColumn(predicate_column_id_, tile_offset,
+                                      predicate_tile_column_id);
+      predicate_tile = static_cast<storage::CompressedTile *>(
+          tile_group->GetTile(tile_offset));
+
+      auto code_count =
+          predicate_tile->GetCodeCount(predicate_tile_column_id);
+      if (code_count == 0) {
+        predicate_tile = nullptr;
+      } else {
+        code_results.resize(code_count, -1);
+      }
+    }
 
-      // Construct position list by looping through tile group
-      // and applying the predicate.
-      std::vector<oid_t> position_list;
-      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+    // check transaction visibility of the whole tile group at once
+    visible_tuples_.clear();
+    oid_t all_visible_count = 0;
+    bool all_visible =
+        transaction_manager.IsAllVisible(tile_group_header, all_visible_count);
+    if (all_visible == true) {
+      // no write since the tile group was marked all-visible
+      visible_tuples_.resize(all_visible_count);
+      std::iota(visible_tuples_.begin(), visible_tuples_.end(), 0);
+    } else {
+      transaction_manager.GetVisibleTuples(tile_group_header, 0,
+                                           active_tuple_count,
+                                           visible_tuples_);
+      if (active_tuple_count > 0 &&
+          visible_tuples_.size() == active_tuple_count) {
+        // maybe frozen, spare the next scans the checks
+        tile_group_header->TryMarkAllVisible();
+      }
+    }
+
+    // Construct position list by looping through the visible tuples
+    // and applying the predicate.
+    position_list.clear();
+    bool is_filtered = (predicate_ != nullptr || join_filter_ != nullptr);
+    bool read_range = all_visible == true &&
+                      (is_filtered == false ||
+                       transaction_manager.IsReadRangeTracked() == true);
+    if (read_range == true) {
+      // the whole tile group is read
+      auto res = transaction_manager.PerformReadRange(
+          tile_group->GetTileGroupId(), 0, all_visible_count);
+      if (!res) {
+        transaction_manager.SetTransactionResult(RESULT_FAILURE);
+        return res;
+      }
+    }
+
+    if (all_visible == true && is_filtered == false) {
+      position_list = visible_tuples_;
+    } else {
+      for (auto tuple_id : visible_tuples_) {
 
         ItemPointer location(tile_group->GetTileGroupId(), tuple_id);
 
-        // check transaction visibility
-        if (transaction_manager.IsVisible(tile_group_header, tuple_id)) {
-          // if the tuple is visible, then perform predicate evaluation.
-          if (predicate_ == nullptr) {
+        // the tuple is visible, drop it early if it can not join
+        if (join_filter_ != nullptr &&
+            join_filter_->TupleMayMatch(tile_group.get(), tuple_id) == false) {
+          continue;
+        }
+
+        // perform predicate evaluation.
+        if (predicate_ == nullptr) {
+          position_list.push_back(tuple_id);
+          if (read_range == true) continue;
+          auto res = transaction_manager.PerformRead(location);
+          if (!res) {
+            transaction_manager.SetTransactionResult(RESULT_FAILURE);
+            return res;
+          }
+        } else {
+          bool eval;
+          if (predicate_tile != nullptr) {
+            auto code =
+                predicate_tile->GetCode(tuple_id, predicate_tile_column_id);
+            if (code_results[code] == -1) {
+              expression::ContainerTuple<storage::TileGroup> tuple(
+                  tile_group.get(), tuple_id);
+              code_results[code] =
+                  predicate_->Evaluate(&tuple, nullptr, executor_context_)
+                      .IsTrue();
+            }
+            eval = (code_results[code] == 1);
+          } else {
+            expression::ContainerTuple<storage::TileGroup> tuple(
+                tile_group.get(), tuple_id);
+            eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
+                       .IsTrue();
+          }
+          if (eval == true) {
             position_list.push_back(tuple_id);
+            if (read_range == true) continue;
             auto res = transaction_manager.PerformRead(location);
             if (!res) {
               transaction_manager.SetTransactionResult(RESULT_FAILURE);
               return res;
             }
-          } else {
-            expression::ContainerTuple<storage::TileGroup> tuple(
-                tile_group.get(), tuple_id);
-            auto eval = predicate_->Evaluate(&tuple, nullptr, executor_context_)
-                            .IsTrue();
-            if (eval == true) {
-              position_list.push_back(tuple_id);
-              auto res = transaction_manager.PerformRead(location);
-              if (!res) {
-                transaction_manager.SetTransactionResult(RESULT_FAILURE);
-                return res;
-              }
-            }
           }
         }
       }
+    }
 
-      // Don't return empty tiles
-      if (position_list.size() == 0) {
-        continue;
-      }
-
-      // Construct logical tile.
-      std::unique_ptr<LogicalTile> logical_tile(LogicalTileFactory::GetTile());
-      logical_tile->AddColumns(tile_group, column_ids_);
-      logical_tile->AddPositionList(std::move(position_list));
-
-      SetOutput(logical_tile.release());
-      return true;
+    // Skip empty tile groups
+    if (position_list.size() == 0) {
+      continue;
     }
+
+    return true;
   }
 
   return false;
@@ -12,8 +12,11 @@
 
 #pragma once
 
+#include <memory>
+
 #include "backend/planner/seq_scan_plan.h"
 #include "backend/executor/abstract_scan_executor.h"
+#include "backend/executor/join_filter.h"
 
 namespace peloton {
 namespace executor {
@@ -28,6 +31,19 @@ class SeqScanExecutor : public AbstractScanExecutor {
   explicit SeqScanExecutor(const planner::AbstractPlan *node,
                            ExecutorContext *executor_context);
 
+  // Select the tuples of the next tile group without building a logical
+  // tile (used by the pipeline executor)
+  bool ScanNextTileGroup(std::shared_ptr<storage::TileGroup> &tile_group,
+                         std::vector<oid_t> &position_list);
+
+  const std::vector<oid_t> &GetColumnIds() const { return column_ids_; }
+
+  // Drop the tuples that the join filter excludes (set by a hash join on
+  // its probe side scan)
+  void SetJoinFilter(std::shared_ptr<const JoinFilter> join_filter) {
+    join_filter_ = join_filter;
+  }
+
  protected:
   bool DInit();
 
@@ -44,6 +60,19 @@ class SeqScanExecutor : public AbstractScanExecutor {
   /** @brief Keeps track of the number of tile groups to scan. */
   oid_t table_tile_group_count_ = INVALID_OID;
 
+  /**
+   * @brief The only column the predicate depends on, if any.
+   * On compressed tile groups, tuples with the same code in this column
+   * share the predicate result.
+   */
+  oid_t predicate_column_id_ = INVALID_OID;
+
+  /** @brief Visible tuples of the current tile group, reused across them. */
+  std::vector<oid_t> visible_tuples_;
+
+  /** @brief Filter on the keys of the join this scan is probing, if any. */
+  std::shared_ptr<const JoinFilter> join_filter_;
+
   //===--------------------------------------------------------------------===//
   // Plan Info
   //===--------------------------------------------------------------------===//
@@ -16,6 +16,7 @@
 #include "backend/catalog/manager.h"
 #include "backend/executor/logical_tile.h"
 #include "backend/executor/executor_context.h"
+#include "backend/executor/index_scan_executor.h"
 #include "backend/expression/container_tuple.h"
 #include "backend/concurrency/transaction.h"
 #include "backend/concurrency/transaction_manager_factory.h"
@@ -52,6 +53,24 @@ bool UpdateExecutor::DInit() {
   PL_ASSERT(target_table_);
   PL_ASSERT(project_info_);
 
+  // Only the indexes on these columns need a new entry for a new version
+  updated_columns_.clear();
+  for (auto &target : project_info_->GetTargetList()) {
+    updated_columns_.push_back(target.first);
+  }
+  for (auto &direct_map : project_info_->GetDirectMapList()) {
+    if (direct_map.first != direct_map.second.second) {
+      updated_columns_.push_back(direct_map.first);
+    }
+  }
+
+  // The tuples are located through the base tiles of the child's output
+  auto child_node = children_[0]->GetRawNode();
+  if (child_node != nullptr &&
+      child_node->GetPlanNodeType() == PLAN_NODE_TYPE_INDEXSCAN) {
+    static_cast<IndexScanExecutor *>(children_[0])->DisableIndexOnly();
+  }
+
   return true;
 }
 
@@ -170,7 +189,8 @@ bool UpdateExecutor::DExecute() {
         tile_group->CopyTuple(new_tuple.get(), old_location.offset);
       } else {
         // finally insert updated tuple into the table
-        ItemPointer new_location = target_table_->InsertVersion(new_tuple.get());
+        ItemPointer new_location =
+            target_table_->InsertVersion(new_tuple.get(), &updated_columns_);
 
         // FIXME: PerformUpdate() will not be executed if the insertion failed,
         // There is a write lock acquired, but since it is not in the write set,
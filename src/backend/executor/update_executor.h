@@ -37,6 +37,9 @@ class UpdateExecutor : public AbstractExecutor {
  private:
   storage::DataTable *target_table_ = nullptr;
   const planner::ProjectInfo *project_info_ = nullptr;
+
+  // Columns whose value may be modified by the update
+  std::vector<oid_t> updated_columns_;
 };
 
 }  // namespace executor
@@ -0,0 +1,112 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// udf_expression.cpp
+//
+// Identification: src/backend/expression/udf_expression.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "backend/expression/udf_expression.h"
+#include "backend/common/exception.h"
+#include "backend/common/value_factory.h"
+#include "backend/executor/executor_context.h"
+
+namespace peloton {
+namespace expression {
+
+void UDFExpression::Prepare() const {
+  if (args_.size() > FUNC_MAX_ARGS) {
+    throw Exception("UDF called with too many arguments : " +
+                    std::to_string(args_.size()));
+  }
+
+  // Resolve the function once instead of on every OidFunctionCall.
+  // fmgr_info reports errors by longjmp, which must not cross call_once:
+  // turn them into an exception.
+  volatile bool resolved = true;
+  PG_TRY();
+  { fmgr_info(func_id, &flinfo_); }
+  PG_CATCH();
+  {
+    FlushErrorState();
+    resolved = false;
+  }
+  PG_END_TRY();
+
+  if (resolved == false) {
+    throw Exception("Could not look up UDF : " + std::to_string(func_id));
+  }
+}
+
+void UDFExpression::InitCallInfo(CallInfo &call_info) const {
+  std::call_once(prepare_flag_, &UDFExpression::Prepare, this);
+  fmgr_info_copy(&call_info.flinfo, &flinfo_, CurrentMemoryContext);
+  InitFunctionCallInfoData(call_info.fcinfo, &call_info.flinfo, args_.size(),
+                           collation, NULL, NULL);
+}
+
+Value UDFExpression::Invoke(FunctionCallInfoData &fcinfo,
+                            const AbstractTuple *tuple1,
+                            const AbstractTuple *tuple2,
+                            executor::ExecutorContext *context) const {
+  bool has_null_arg = false;
+
+  // Evaluate the argument expressions into Value, and convert them into
+  // Datum directly in the argument buffer
+  for (size_t i = 0; i < args_.size(); i++) {
+    Value value = args_[i]->Evaluate(tuple1, tuple2, context);
+    if (value.IsNull()) {
+      fcinfo.arg[i] = PointerGetDatum(nullptr);
+      fcinfo.argnull[i] = true;
+      has_null_arg = true;
+    } else {
+      fcinfo.arg[i] = bridge::TupleTransformer::GetDatum(value);
+      fcinfo.argnull[i] = false;
+    }
+  }
+
+  // A strict function returns null on any null input without being called
+  if (has_null_arg && flinfo_.fn_strict) {
+    return ValueFactory::GetNullValue();
+  }
+
+  // Invoking the udf function call
+  fcinfo.isnull = false;
+  Datum result = FunctionCallInvoke(&fcinfo);
+  if (fcinfo.isnull) {
+    return ValueFactory::GetNullValue();
+  }
+
+  // Convert returned Datum into peloton's Value
+  return bridge::TupleTransformer::GetValue(result, return_type);
+}
+
+Value UDFExpression::Evaluate(const AbstractTuple *tuple1,
+                              const AbstractTuple *tuple2,
+                              executor::ExecutorContext *context) const {
+  // Without an executor context, nothing outlives the call
+  if (context == nullptr) {
+    CallInfo call_info;
+    InitCallInfo(call_info);
+    return Invoke(call_info.fcinfo, tuple1, tuple2, context);
+  }
+
+  // The first row of the execution sets up the call, the next ones reuse it
+  // along with whatever the function cached in fn_extra
+  auto &state = context->GetExpressionState(this);
+  if (state == nullptr) {
+    auto call_info = std::make_shared<CallInfo>();
+    InitCallInfo(*call_info);
+    state = call_info;
+  }
+
+  auto call_info = static_cast<CallInfo *>(state.get());
+  return Invoke(call_info->fcinfo, tuple1, tuple2, context);
+}
+
+}  // End expression namespace
+}  // End peloton namespace
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <mutex>
+
 #include "backend/expression/abstract_expression.h"
 #include "nodes/execnodes.h"
 #include "backend/bridge/dml/tuple/tuple_transformer.h"
@@ -20,6 +22,16 @@
 namespace peloton {
 namespace expression {
 
+/**
+ * Invokes a Postgres UDF (C, SQL or PL/pgSQL) through fmgr.
+ *
+ * The function is resolved into an FmgrInfo once per expression instance on
+ * first use, so per-row evaluation only converts the arguments and invokes
+ * the function pointer. The function may cache its own state in fn_extra
+ * (PL/pgSQL and SQL functions do), so each execution calls its own copy of
+ * the resolved FmgrInfo, kept in the executor context and reused across
+ * rows.
+ */
 class UDFExpression : public AbstractExpression {
  public:
   UDFExpression(
@@ -33,43 +45,7 @@ class UDFExpression : public AbstractExpression {
   };
 
   Value Evaluate(const AbstractTuple *tuple1, const AbstractTuple *tuple2,
-                 executor::ExecutorContext *context) const {
-    Datum result = 0;
-
-    // Evaluate the argument expression into Value, and convert it into Datum
-    // for invoking OidFunctionCall
-    std::vector<Datum> args_eval(args_.size());
-    for (size_t i = 0; i < args_.size(); i++) {
-      Value value = args_[i]->Evaluate(tuple1, tuple2, context);
-      args_eval[i] = bridge::TupleTransformer::GetDatum(value);
-    }
-
-    // Invoking the udf function call
-    switch (args_.size()) {
-      case 0:
-        result = OidFunctionCall0Coll(func_id, collation);
-        break;
-      case 1:
-        result = OidFunctionCall1Coll(func_id, collation, args_eval[0]);
-        break;
-      case 2:
-        result = OidFunctionCall2Coll(func_id, collation, args_eval[0],
-                                      args_eval[1]);
-        break;
-      case 3:
-        result = OidFunctionCall3Coll(func_id, collation, args_eval[0],
-                                      args_eval[1], args_eval[2]);
-      case 4:
-        result = OidFunctionCall4Coll(func_id, collation, args_eval[0],
-                                      args_eval[1], args_eval[2], args_eval[3]);
-      default:
-        // This part should not be reached.
-        break;
-    }
-
-    // Convert returned Datum into peloton's Value
-    return bridge::TupleTransformer::GetValue(result, return_type);
-  }
+                 executor::ExecutorContext *context) const;
 
   std::string DebugInfo(const std::string &spacer) const {
     return (spacer + "UDFExpression");
@@ -84,10 +60,30 @@ class UDFExpression : public AbstractExpression {
   }
 
  private:
+  // Look up the function (done once per expression instance)
+  void Prepare() const;
+
+  // Copy of the resolved function and its call arguments, for one execution
+  struct CallInfo {
+    FmgrInfo flinfo;
+    FunctionCallInfoData fcinfo;
+  };
+
+  void InitCallInfo(CallInfo &call_info) const;
+
+  // Invoke the prepared function on the arguments of a single row
+  Value Invoke(FunctionCallInfoData &fcinfo, const AbstractTuple *tuple1,
+               const AbstractTuple *tuple2,
+               executor::ExecutorContext *context) const;
+
   Oid func_id;
   Oid collation;
   Oid return_type;
   std::vector<std::unique_ptr<expression::AbstractExpression>> args_;
+
+  // Cached function lookup, only copied once resolved
+  mutable std::once_flag prepare_flag_;
+  mutable FmgrInfo flinfo_;
 };
 
 }  // End expression namespace
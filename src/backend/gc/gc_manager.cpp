@@ -11,10 +11,12 @@
 //===----------------------------------------------------------------------===//
 
 #include "backend/common/types.h"
+#include "backend/common/metrics.h"
 #include "backend/gc/gc_manager.h"
 #include "backend/gc/gc_manager_factory.h"
 #include "backend/index/index.h"
 #include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/data_table.h"
 
 #include <list>
 
@@ -58,6 +60,8 @@ void GCManager::StopGC() {
 // Since no one will use it any more, keeping track of it is useless.
 // Note that, if we drop a single tile group without dropping the whole table,
 // such assumption is problematic.
+// A compressed tile group is decompressed first, so that its slots can
+// be reused like any other (the freezer may compress it again later).
 bool GCManager::ResetTuple(const TupleMetadata &tuple_metadata) {
   auto &manager = catalog::Manager::GetInstance();
   auto tile_group = manager.GetTileGroup(tuple_metadata.tile_group_id);
@@ -75,6 +79,25 @@ bool GCManager::ResetTuple(const TupleMetadata &tuple_metadata) {
 
   auto tile_group_header = tile_group->GetHeader();
 
+  auto table =
+      dynamic_cast<storage::DataTable *>(tile_group->GetAbstractTable());
+
+  // Compressed tile groups are immutable, so the slot can only be recycled
+  // into an uncompressed copy. The header is shared between the two.
+  if (tile_group->IsCompressed() == true) {
+    if (table == nullptr ||
+        table->DecompressTileGroup(tuple_metadata.tile_group_id) == nullptr) {
+      return false;
+    }
+  }
+
+  // Secondary index entries must not outlive the version. This is done
+  // before the reset, while the version chain is still intact.
+  if (table != nullptr) {
+    table->PruneSecondaryIndexEntries(ItemPointer(
+        tuple_metadata.tile_group_id, tuple_metadata.tuple_slot_id));
+  }
+
   // Reset the header
   tile_group_header->SetTransactionId(tuple_metadata.tuple_slot_id,
                                       INVALID_TXN_ID);
@@ -91,6 +114,7 @@ bool GCManager::ResetTuple(const TupleMetadata &tuple_metadata) {
   LOG_TRACE("Garbage tuple(%u, %u) in table %u is reset",
            tuple_metadata.tile_group_id, tuple_metadata.tuple_slot_id,
            tuple_metadata.table_id);
+
   return true;
 }
 
@@ -126,6 +150,10 @@ void GCManager::Running() {
   // We use a local buffer to store all possible garbage handled by this gc worker
   std::list<TupleMetadata> local_reclaim_queue;
 
+  auto &metrics = MetricsRegistry::GetInstance();
+  auto reclaimed_counter_id = metrics.RegisterCounter("gc.reclaimed");
+  auto backlog_gauge_id = metrics.RegisterGauge("gc.backlog");
+
   while (true) {
     std::this_thread::sleep_for(
         std::chrono::milliseconds(GC_PERIOD_MILLISECONDS));
@@ -169,6 +197,9 @@ void GCManager::Running() {
     }
 
     LOG_TRACE("Marked %d tuples as garbage", tuple_counter);
+    metrics.Increment(reclaimed_counter_id, tuple_counter);
+    metrics.SetGauge(backlog_gauge_id, local_reclaim_queue.size());
+
     if (is_running_ == false) {
       // Clear all pending garbage
       tuple_counter = 0;
@@ -183,6 +214,8 @@ void GCManager::Running() {
       }
 
       LOG_TRACE("GCThread recycle last %d tuples before exits", tuple_counter);
+      metrics.Increment(reclaimed_counter_id, tuple_counter);
+      metrics.SetGauge(backlog_gauge_id, 0);
       return;
     }
   }
@@ -205,13 +238,18 @@ void GCManager::RecycleTupleSlot(const oid_t &table_id,
 
   reclaim_queue_.Enqueue(tuple_metadata);
 
+  static oid_t queued_counter_id =
+      MetricsRegistry::GetInstance().RegisterCounter("gc.queued");
+  MetricsRegistry::GetInstance().Increment(queued_counter_id);
+
   LOG_TRACE("Marked tuple(%u, %u) in table %u as possible garbage",
            tuple_metadata.tile_group_id, tuple_metadata.tuple_slot_id,
            tuple_metadata.table_id);
 }
 
 // this function returns a free tuple slot, if one exists
-// called by data_table.
+// called by data_table, which must release the claim on the slot once the
+// tuple is written (see TileGroupHeader::ClaimRecycledSlot).
 ItemPointer GCManager::ReturnFreeSlot(const oid_t &table_id) {
   if (this->gc_type_ == GC_TYPE_OFF) {
     return INVALID_ITEMPOINTER;
@@ -222,6 +260,22 @@ ItemPointer GCManager::ReturnFreeSlot(const oid_t &table_id) {
   if (recycle_queue_map_.find(table_id, recycle_queue) == true) {
     TupleMetadata tuple_metadata;
     if (recycle_queue->Dequeue(tuple_metadata) == true) {
+      auto &manager = catalog::Manager::GetInstance();
+      auto tile_group = manager.GetTileGroup(tuple_metadata.tile_group_id);
+      if (tile_group == nullptr) {
+        return ItemPointer();
+      }
+
+      // The tile group is being copied, keep the slot for later
+      if (tile_group->GetHeader()->ClaimRecycledSlot() == false) {
+        recycle_queue->Enqueue(tuple_metadata);
+        return ItemPointer();
+      }
+
+      static oid_t reused_counter_id =
+          MetricsRegistry::GetInstance().RegisterCounter("gc.reused");
+      MetricsRegistry::GetInstance().Increment(reused_counter_id);
+
       LOG_TRACE("Reuse tuple(%u, %u) in table %u", tuple_metadata.tile_group_id,
                tuple_metadata.tuple_slot_id, table_id);
       return ItemPointer(tuple_metadata.tile_group_id,
@@ -69,6 +69,7 @@ class GCManager {
   void RecycleTupleSlot(const oid_t &table_id, const oid_t &tile_group_id,
                         const oid_t &tuple_id, const cid_t &tuple_end_cid);
 
+  // Returns a recycled slot claimed for writing, or an empty item pointer
   ItemPointer ReturnFreeSlot(const oid_t &table_id);
 
  private:
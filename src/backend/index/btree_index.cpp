@@ -10,8 +10,13 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <thread>
+#include <type_traits>
+
 #include "backend/index/btree_index.h"
 #include "backend/index/index_key.h"
+#include "backend/common/exception.h"
 #include "backend/common/logger.h"
 #include "backend/storage/tuple.h"
 
@@ -48,6 +53,8 @@ template <typename KeyType, typename ValueType, class KeyComparator,
 bool BTreeIndex<KeyType, ValueType, KeyComparator,
                 KeyEqualityChecker>::InsertEntry(const storage::Tuple *key,
                                                  const ItemPointer &location) {
+  IncrementInsertCount();
+
   KeyType index_key;
 
   index_key.SetFromKey(key);
@@ -70,8 +77,11 @@ template <typename KeyType, typename ValueType, class KeyComparator,
 bool BTreeIndex<KeyType, ValueType, KeyComparator,
                 KeyEqualityChecker>::DeleteEntry(const storage::Tuple *key,
                                                  const ItemPointer &location) {
+  IncrementDeleteCount();
+
   KeyType index_key;
   index_key.SetFromKey(key);
+  bool deleted = false;
 
   {
     index_lock.WriteLock();
@@ -93,6 +103,7 @@ bool BTreeIndex<KeyType, ValueType, KeyComparator,
           delete iterator->second;
           iterator->second = nullptr;
           container.erase(iterator);
+          deleted = true;
           // Set try again
           try_again = true;
           break;
@@ -103,7 +114,7 @@ bool BTreeIndex<KeyType, ValueType, KeyComparator,
     index_lock.Unlock();
   }
 
-  return true;
+  return deleted;
 }
 
 template <typename KeyType, typename ValueType, class KeyComparator,
@@ -111,6 +122,8 @@ template <typename KeyType, typename ValueType, class KeyComparator,
 bool BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::
     CondInsertEntry(const storage::Tuple *key, const ItemPointer &location,
                     std::function<bool(const ItemPointer &)> predicate) {
+  IncrementInsertCount();
+
   KeyType index_key;
   index_key.SetFromKey(key);
 
@@ -139,12 +152,177 @@ bool BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::
   return true;
 }
 
+/**
+ * @brief Insert a batch of entries in key order, under a single acquisition
+ * of the index lock. Consecutive inserts then mostly hit the same leaves.
+ */
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
-void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
-    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
-    const std::vector<ExpressionType> &expr_types,
-    const ScanDirectionType &scan_direction, std::vector<ItemPointer> &result) {
+void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::
+    InsertEntries(const std::vector<const storage::Tuple *> &keys,
+                  const std::vector<ItemPointer> &locations) {
+  PL_ASSERT(keys.size() == locations.size());
+  IncrementInsertCount(keys.size());
+
+  std::vector<std::pair<KeyType, ValueType>> entries(keys.size());
+  for (size_t entry_itr = 0; entry_itr < keys.size(); entry_itr++) {
+    entries[entry_itr].first.SetFromKey(keys[entry_itr]);
+    entries[entry_itr].second = new ItemPointer(locations[entry_itr]);
+  }
+
+  std::stable_sort(entries.begin(), entries.end(),
+                   [this](const std::pair<KeyType, ValueType> &lhs,
+                          const std::pair<KeyType, ValueType> &rhs) {
+                     return comparator(lhs.first, rhs.first);
+                   });
+
+  {
+    index_lock.WriteLock();
+
+    for (auto &entry : entries) {
+      container.insert(entry);
+    }
+
+    index_lock.Unlock();
+  }
+}
+
+/**
+ * @brief Sort-based bulk load. Each partition is scanned by its own thread,
+ * which copies the keys of its entries and sorts them. The sorted runs are
+ * then merged pairwise in parallel, and the tree is built bottom-up from the
+ * merged run.
+ */
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+size_t
+BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::BulkLoad(
+    const size_t partition_count, const BulkLoadScanner &scanner,
+    const double fill_factor,
+    std::function<bool(const ItemPointer &)> predicate) {
+  // Tuple keys point to the key tuple, which does not outlive the callback
+  if (std::is_same<KeyType, TupleKey>::value == true ||
+      container.empty() == false) {
+    return Index::BulkLoad(partition_count, scanner, fill_factor, predicate);
+  }
+
+  typedef std::pair<KeyType, ItemPointer> EntryType;
+  typedef std::vector<EntryType> RunType;
+
+  auto entry_comparator = [this](const EntryType &lhs, const EntryType &rhs) {
+    return comparator(lhs.first, rhs.first);
+  };
+
+  // Scan and sort the partitions
+  std::vector<RunType> runs(partition_count);
+  std::vector<std::thread> threads;
+
+  for (size_t partition = 0; partition < partition_count; partition++) {
+    threads.emplace_back([&, partition] {
+      auto &run = runs[partition];
+      scanner(partition, [&run](const storage::Tuple *key,
+                                const ItemPointer &location) {
+        KeyType index_key;
+        index_key.SetFromKey(key);
+        run.emplace_back(index_key, location);
+      });
+
+      std::sort(run.begin(), run.end(), entry_comparator);
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  // Merge the runs
+  while (runs.size() > 1) {
+    std::vector<RunType> merged_runs((runs.size() + 1) / 2);
+    threads.clear();
+
+    for (size_t run_itr = 0; run_itr + 1 < runs.size(); run_itr += 2) {
+      threads.emplace_back([&, run_itr] {
+        auto &left = runs[run_itr];
+        auto &right = runs[run_itr + 1];
+        auto &merged_run = merged_runs[run_itr / 2];
+
+        merged_run.reserve(left.size() + right.size());
+        std::merge(left.begin(), left.end(), right.begin(), right.end(),
+                   std::back_inserter(merged_run), entry_comparator);
+
+        RunType().swap(left);
+        RunType().swap(right);
+      });
+    }
+
+    if (runs.size() % 2 == 1) {
+      merged_runs.back() = std::move(runs.back());
+    }
+
+    for (auto &thread : threads) {
+      thread.join();
+    }
+
+    runs = std::move(merged_runs);
+  }
+
+  if (runs.empty() == true || runs[0].empty() == true) return 0;
+
+  auto &run = runs[0];
+
+  // Equal keys are neighbours in the merged run
+  if (HasUniqueKeys() == true) {
+    size_t group_begin = 0;
+    while (group_begin < run.size()) {
+      size_t group_end = group_begin + 1;
+      while (group_end < run.size() &&
+             equals(run[group_begin].first, run[group_end].first) == true) {
+        group_end++;
+      }
+
+      if (group_end - group_begin > 1) {
+        size_t occupied_count = 0;
+        for (size_t entry_itr = group_begin; entry_itr < group_end;
+             entry_itr++) {
+          if (predicate(run[entry_itr].second) == true) occupied_count++;
+        }
+        if (occupied_count > 1) {
+          throw IndexException("Duplicate key in unique index " + GetName());
+        }
+      }
+
+      group_begin = group_end;
+    }
+  }
+  std::vector<std::pair<KeyType, ValueType>> entries;
+  entries.reserve(run.size());
+  for (auto &entry : run) {
+    entries.emplace_back(entry.first, new ItemPointer(entry.second));
+  }
+  RunType().swap(run);
+
+  {
+    index_lock.WriteLock();
+
+    container.bulk_load(entries.begin(), entries.end(), fill_factor);
+
+    index_lock.Unlock();
+  }
+
+  return entries.size();
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+template <typename EntryCallback>
+void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::
+    ScanMatchingEntries(const std::vector<Value> &values,
+                        const std::vector<oid_t> &key_column_ids,
+                        const std::vector<ExpressionType> &expr_types,
+                        const ScanDirectionType &scan_direction,
+                        const EntryCallback &callback) {
+  IncrementScanCount();
+
   // Check if we have leading (leftmost) column equality
   // refer : http://www.postgresql.org/docs/8.2/static/indexes-multicolumn.html
   //  oid_t leading_column_id = 0;
@@ -159,7 +337,7 @@ void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
   // Aligned example: A > 0, B >= 15, c > 4
   // Not Aligned example: A >= 15, B < 30
 
-  bool special_case = true;
+  bool special_case = (key_column_ids.empty() == false);
   for (auto key_column_ids_itr = key_column_ids.begin();
        key_column_ids_itr != key_column_ids.end(); key_column_ids_itr++) {
     auto offset = std::distance(key_column_ids.begin(), key_column_ids_itr);
@@ -188,13 +366,17 @@ void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
 
       ConstructIntervals(leading_column_id, values, key_column_ids, expr_types,
                          intervals);
+      assert(intervals.size() != 0);
 
       // For non-leading columns, find the max and min
       std::map<oid_t, std::pair<Value, Value>> non_leading_columns;
       FindMaxMinInColumns(leading_column_id, values, key_column_ids, expr_types,
                           non_leading_columns);
 
-      for (auto key_column_id : metadata->GetKeySchema()->GetIndexedColumns()) {
+      // The scan keys are offsets in the key schema, not table column ids
+      oid_t key_column_count = metadata->GetKeySchema()->GetColumnCount();
+      for (oid_t key_column_id = 0; key_column_id < key_column_count;
+           key_column_id++) {
         if (non_leading_columns.find(key_column_id) ==
             non_leading_columns.end()) {
           auto type =
@@ -253,8 +435,7 @@ void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
               // "expression types"
               // For instance, "5" EXPR_GREATER_THAN "2" is true
               if (Compare(tuple, key_column_ids, expr_types, values) == true) {
-                ItemPointer location_header = *(scan_itr->second);
-                result.push_back(location_header);
+                callback(tuple, scan_itr->second);
               }
             }
           } break;
@@ -283,8 +464,7 @@ void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
             // "expression types"
             // For instance, "5" EXPR_GREATER_THAN "2" is true
             if (Compare(tuple, key_column_ids, expr_types, values) == true) {
-              ItemPointer location_header = *(scan_itr->second);
-              result.push_back(location_header);
+              callback(tuple, scan_itr->second);
             }
           }
         } break;
@@ -300,11 +480,41 @@ void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
   }
 }
 
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
+    const std::vector<Value> &values, const std::vector<oid_t> &key_column_ids,
+    const std::vector<ExpressionType> &expr_types,
+    const ScanDirectionType &scan_direction, std::vector<ItemPointer> &result) {
+  ScanMatchingEntries(values, key_column_ids, expr_types, scan_direction,
+                      [&result](const storage::Tuple &, ItemPointer *location) {
+                        result.push_back(*location);
+                      });
+}
+
+template <typename KeyType, typename ValueType, class KeyComparator,
+          class KeyEqualityChecker>
+bool BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::
+    ScanEntries(const std::vector<Value> &values,
+                const std::vector<oid_t> &key_column_ids,
+                const std::vector<ExpressionType> &expr_types,
+                const ScanDirectionType &scan_direction,
+                const ScanEntryCallback &callback) {
+  ScanMatchingEntries(values, key_column_ids, expr_types, scan_direction,
+                      [&callback](const storage::Tuple &key,
+                                  ItemPointer *location) {
+                        callback(&key, *location);
+                      });
+  return true;
+}
+
 template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void BTreeIndex<KeyType, ValueType, KeyComparator,
                 KeyEqualityChecker>::ScanAllKeys(std::vector<ItemPointer> &
                                                      result) {
+  IncrementScanCount();
+
   {
     index_lock.ReadLock();
 
@@ -326,6 +536,8 @@ template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanKey(
     const storage::Tuple *key, std::vector<ItemPointer> &result) {
+  IncrementLookupCount();
+
   KeyType index_key;
   index_key.SetFromKey(key);
 
@@ -490,160 +702,10 @@ void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::Scan(
     const std::vector<ExpressionType> &expr_types,
     const ScanDirectionType &scan_direction,
     std::vector<ItemPointer *> &result) {
-  // Check if we have leading (leftmost) column equality
-  // refer : http://www.postgresql.org/docs/8.2/static/indexes-multicolumn.html
-  //  oid_t leading_column_id = 0;
-  //  auto key_column_ids_itr = std::find(key_column_ids.begin(),
-  //                                      key_column_ids.end(),
-  //                                      leading_column_id);
-
-  // SPECIAL CASE : leading column id is one of the key column ids
-  // and is involved in a equality constraint
-  // Currently special case only includes EXPRESSION_TYPE_COMPARE_EQUAL
-  // There are two more types, one is aligned, another is not aligned.
-  // Aligned example: A > 0, B >= 15, c > 4
-  // Not Aligned example: A >= 15, B < 30
-
-  bool special_case = true;
-  for (auto key_column_ids_itr = key_column_ids.begin();
-       key_column_ids_itr != key_column_ids.end(); key_column_ids_itr++) {
-    auto offset = std::distance(key_column_ids.begin(), key_column_ids_itr);
-
-    if (expr_types[offset] == EXPRESSION_TYPE_COMPARE_NOTEQUAL ||
-        expr_types[offset] == EXPRESSION_TYPE_COMPARE_IN ||
-        expr_types[offset] == EXPRESSION_TYPE_COMPARE_LIKE ||
-        expr_types[offset] == EXPRESSION_TYPE_COMPARE_NOTLIKE) {
-      special_case = false;
-      break;
-    }
-  }
-
-  LOG_TRACE("Special case : %d ", special_case);
-
-  {
-    index_lock.ReadLock();
-
-    // If it is a special case, we can figure out the range to scan in the index
-    if (special_case == true) {
-      // Assumption: must have leading column, assume it's first one in
-      // key_column_ids.
-      assert(key_column_ids.size() > 0);
-      oid_t leading_column_id = key_column_ids[0];
-      std::vector<std::pair<Value, Value>> intervals;
-
-      ConstructIntervals(leading_column_id, values, key_column_ids, expr_types,
-                         intervals);
-
-      // For non-leading columns, find the max and min
-      std::map<oid_t, std::pair<Value, Value>> non_leading_columns;
-      FindMaxMinInColumns(leading_column_id, values, key_column_ids, expr_types,
-                          non_leading_columns);
-
-      for (auto key_column_id : metadata->GetKeySchema()->GetIndexedColumns()) {
-        if (non_leading_columns.find(key_column_id) ==
-            non_leading_columns.end()) {
-          auto type =
-              metadata->GetKeySchema()->GetColumn(key_column_id).column_type;
-          std::pair<Value, Value> range(Value::GetMinValue(type),
-                                        Value::GetMaxValue(type));
-          std::pair<oid_t, std::pair<Value, Value>> key_value(key_column_id,
-                                                              range);
-          non_leading_columns.insert(key_value);
-        }
-      }
-
-      assert(intervals.size() != 0);
-      // Search each interval of leading_column.
-      for (const auto &interval : intervals) {
-        auto scan_begin_itr = container.begin();
-        auto scan_end_itr = container.end();
-        std::unique_ptr<storage::Tuple> start_key;
-        std::unique_ptr<storage::Tuple> end_key;
-        start_key.reset(new storage::Tuple(metadata->GetKeySchema(), true));
-        end_key.reset(new storage::Tuple(metadata->GetKeySchema(), true));
-
-        LOG_TRACE("%s", "Constructing start/end keys\n");
-
-        LOG_TRACE("left bound %s\t\t right bound %s\n", interval.first.GetInfo().c_str(),
-                  interval.second.GetInfo().c_str());
-
-        start_key->SetValue(leading_column_id, interval.first, GetPool());
-        end_key->SetValue(leading_column_id, interval.second, GetPool());
-
-        for (const auto &k_v : non_leading_columns) {
-          start_key->SetValue(k_v.first, k_v.second.first, GetPool());
-          end_key->SetValue(k_v.first, k_v.second.second, GetPool());
-          LOG_TRACE("left bound %s\t\t right bound %s\n",
-                    k_v.second.first.GetInfo().c_str(), k_v.second.second.GetInfo().c_str());
-        }
-
-        KeyType start_index_key;
-        KeyType end_index_key;
-        start_index_key.SetFromKey(start_key.get());
-        end_index_key.SetFromKey(end_key.get());
-
-        scan_begin_itr = container.equal_range(start_index_key).first;
-        scan_end_itr = container.equal_range(end_index_key).second;
-
-        switch (scan_direction) {
-          case SCAN_DIRECTION_TYPE_FORWARD:
-          case SCAN_DIRECTION_TYPE_BACKWARD: {
-            // Scan the index entries in forward direction
-            for (auto scan_itr = scan_begin_itr; scan_itr != scan_end_itr;
-                 scan_itr++) {
-              auto scan_current_key = scan_itr->first;
-              auto tuple = scan_current_key.GetTupleForComparison(
-                  metadata->GetKeySchema());
-
-              // Compare the current key in the scan with "values" based on
-              // "expression types"
-              // For instance, "5" EXPR_GREATER_THAN "2" is true
-              if (Compare(tuple, key_column_ids, expr_types, values) == true) {
-                ItemPointer *location_header = scan_itr->second;
-                result.push_back(location_header);
-              }
-            }
-          } break;
-
-          case SCAN_DIRECTION_TYPE_INVALID:
-          default:
-            throw Exception("Invalid scan direction \n");
-            break;
-        }
-      }
-
-    } else {
-      auto scan_begin_itr = container.begin();
-
-      switch (scan_direction) {
-        case SCAN_DIRECTION_TYPE_FORWARD:
-        case SCAN_DIRECTION_TYPE_BACKWARD: {
-          // Scan the index entries in forward direction
-          for (auto scan_itr = scan_begin_itr; scan_itr != container.end();
-               scan_itr++) {
-            auto scan_current_key = scan_itr->first;
-            auto tuple = scan_current_key.GetTupleForComparison(
-                metadata->GetKeySchema());
-
-            // Compare the current key in the scan with "values" based on
-            // "expression types"
-            // For instance, "5" EXPR_GREATER_THAN "2" is true
-            if (Compare(tuple, key_column_ids, expr_types, values) == true) {
-              ItemPointer *location_header = scan_itr->second;
-              result.push_back(location_header);
-            }
-          }
-        } break;
-
-        case SCAN_DIRECTION_TYPE_INVALID:
-        default:
-          throw Exception("Invalid scan direction \n");
-          break;
-      }
-    }
-
-    index_lock.Unlock();
-  }
+  ScanMatchingEntries(values, key_column_ids, expr_types, scan_direction,
+                      [&result](const storage::Tuple &, ItemPointer *location) {
+                        result.push_back(location);
+                      });
 }
 
 template <typename KeyType, typename ValueType, class KeyComparator,
@@ -651,6 +713,8 @@ template <typename KeyType, typename ValueType, class KeyComparator,
 void BTreeIndex<KeyType, ValueType, KeyComparator,
                 KeyEqualityChecker>::ScanAllKeys(std::vector<ItemPointer *> &
                                                      result) {
+  IncrementScanCount();
+
   {
     index_lock.ReadLock();
 
@@ -674,6 +738,8 @@ template <typename KeyType, typename ValueType, class KeyComparator,
           class KeyEqualityChecker>
 void BTreeIndex<KeyType, ValueType, KeyComparator, KeyEqualityChecker>::ScanKey(
     const storage::Tuple *key, std::vector<ItemPointer *> &result) {
+  IncrementLookupCount();
+
   KeyType index_key;
   index_key.SetFromKey(key);
 
@@ -709,30 +775,30 @@ template class BTreeIndex<IntsKey<3>, ItemPointer *, IntsComparator<3>,
 template class BTreeIndex<IntsKey<4>, ItemPointer *, IntsComparator<4>,
                           IntsEqualityChecker<4>>;
 
-template class BTreeIndex<GenericKey<4>, ItemPointer *, GenericComparator<4>,
-                          GenericEqualityChecker<4>>;
-template class BTreeIndex<GenericKey<8>, ItemPointer *, GenericComparator<8>,
-                          GenericEqualityChecker<8>>;
-template class BTreeIndex<GenericKey<12>, ItemPointer *, GenericComparator<12>,
-                          GenericEqualityChecker<12>>;
-template class BTreeIndex<GenericKey<16>, ItemPointer *, GenericComparator<16>,
-                          GenericEqualityChecker<16>>;
-template class BTreeIndex<GenericKey<24>, ItemPointer *, GenericComparator<24>,
-                          GenericEqualityChecker<24>>;
-template class BTreeIndex<GenericKey<32>, ItemPointer *, GenericComparator<32>,
-                          GenericEqualityChecker<32>>;
-template class BTreeIndex<GenericKey<48>, ItemPointer *, GenericComparator<48>,
-                          GenericEqualityChecker<48>>;
-template class BTreeIndex<GenericKey<64>, ItemPointer *, GenericComparator<64>,
-                          GenericEqualityChecker<64>>;
-template class BTreeIndex<GenericKey<96>, ItemPointer *, GenericComparator<96>,
-                          GenericEqualityChecker<96>>;
-template class BTreeIndex<GenericKey<128>, ItemPointer *,
-                          GenericComparator<128>, GenericEqualityChecker<128>>;
-template class BTreeIndex<GenericKey<256>, ItemPointer *,
-                          GenericComparator<256>, GenericEqualityChecker<256>>;
-template class BTreeIndex<GenericKey<512>, ItemPointer *,
-                          GenericComparator<512>, GenericEqualityChecker<512>>;
+template class BTreeIndex<BinaryKey<4>, ItemPointer *, BinaryComparator<4>,
+                          BinaryEqualityChecker<4>>;
+template class BTreeIndex<BinaryKey<8>, ItemPointer *, BinaryComparator<8>,
+                          BinaryEqualityChecker<8>>;
+template class BTreeIndex<BinaryKey<12>, ItemPointer *, BinaryComparator<12>,
+                          BinaryEqualityChecker<12>>;
+template class BTreeIndex<BinaryKey<16>, ItemPointer *, BinaryComparator<16>,
+                          BinaryEqualityChecker<16>>;
+template class BTreeIndex<BinaryKey<24>, ItemPointer *, BinaryComparator<24>,
+                          BinaryEqualityChecker<24>>;
+template class BTreeIndex<BinaryKey<32>, ItemPointer *, BinaryComparator<32>,
+                          BinaryEqualityChecker<32>>;
+template class BTreeIndex<BinaryKey<48>, ItemPointer *, BinaryComparator<48>,
+                          BinaryEqualityChecker<48>>;
+template class BTreeIndex<BinaryKey<64>, ItemPointer *, BinaryComparator<64>,
+                          BinaryEqualityChecker<64>>;
+template class BTreeIndex<BinaryKey<96>, ItemPointer *, BinaryComparator<96>,
+                          BinaryEqualityChecker<96>>;
+template class BTreeIndex<BinaryKey<128>, ItemPointer *,
+                          BinaryComparator<128>, BinaryEqualityChecker<128>>;
+template class BTreeIndex<BinaryKey<256>, ItemPointer *,
+                          BinaryComparator<256>, BinaryEqualityChecker<256>>;
+template class BTreeIndex<BinaryKey<512>, ItemPointer *,
+                          BinaryComparator<512>, BinaryEqualityChecker<512>>;
 
 template class BTreeIndex<TupleKey, ItemPointer *, TupleKeyComparator,
                           TupleKeyEqualityChecker>;
@@ -51,6 +51,13 @@ class BTreeIndex : public Index {
   bool CondInsertEntry(const storage::Tuple *key, const ItemPointer &location,
                        std::function<bool(const ItemPointer &)> predicate);
 
+  void InsertEntries(const std::vector<const storage::Tuple *> &keys,
+                     const std::vector<ItemPointer> &locations);
+
+  size_t BulkLoad(const size_t partition_count, const BulkLoadScanner &scanner,
+                  const double fill_factor,
+                  std::function<bool(const ItemPointer &)> predicate);
+
   void Scan(const std::vector<Value> &values,
             const std::vector<oid_t> &key_column_ids,
             const std::vector<ExpressionType> &expr_types,
@@ -71,6 +78,12 @@ class BTreeIndex : public Index {
 
   void ScanKey(const storage::Tuple *key, std::vector<ItemPointer *> &result);
 
+  bool ScanEntries(const std::vector<Value> &values,
+                   const std::vector<oid_t> &key_column_ids,
+                   const std::vector<ExpressionType> &exprs,
+                   const ScanDirectionType &scan_direction,
+                   const ScanEntryCallback &callback);
+
   std::string GetTypeName() const;
 
   bool Cleanup() { return true; }
@@ -101,6 +114,15 @@ class BTreeIndex : public Index {
 
   std::atomic<int> indexed_tile_group_offset_;
 
+ private:
+  // Hand the key and the value of each entry matching the predicate to the
+  // callback, under the read lock of the index
+  template <typename EntryCallback>
+  void ScanMatchingEntries(const std::vector<Value> &values,
+                           const std::vector<oid_t> &key_column_ids,
+                           const std::vector<ExpressionType> &expr_types,
+                           const ScanDirectionType &scan_direction,
+                           const EntryCallback &callback);
 };
 
 }  // End index namespace
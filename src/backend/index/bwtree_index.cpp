@@ -126,30 +126,30 @@ template class BWTreeIndex<IntsKey<3>, ItemPointer *,
 template class BWTreeIndex<IntsKey<4>, ItemPointer *,
                            IntsComparator<4>, IntsEqualityChecker<4>>;
 
-template class BWTreeIndex<GenericKey<4>, ItemPointer *,
-                           GenericComparator<4>, GenericEqualityChecker<4>>;
-template class BWTreeIndex<GenericKey<8>, ItemPointer *,
-                           GenericComparator<8>, GenericEqualityChecker<8>>;
-template class BWTreeIndex<GenericKey<12>, ItemPointer *,
-                           GenericComparator<12>, GenericEqualityChecker<12>>;
-template class BWTreeIndex<GenericKey<16>, ItemPointer *,
-                           GenericComparator<16>, GenericEqualityChecker<16>>;
-template class BWTreeIndex<GenericKey<24>, ItemPointer *,
-                           GenericComparator<24>, GenericEqualityChecker<24>>;
-template class BWTreeIndex<GenericKey<32>, ItemPointer *,
-                           GenericComparator<32>, GenericEqualityChecker<32>>;
-template class BWTreeIndex<GenericKey<48>, ItemPointer *,
-                           GenericComparator<48>, GenericEqualityChecker<48>>;
-template class BWTreeIndex<GenericKey<64>, ItemPointer *,
-                           GenericComparator<64>, GenericEqualityChecker<64>>;
-template class BWTreeIndex<GenericKey<96>, ItemPointer *,
-                           GenericComparator<96>, GenericEqualityChecker<96>>;
-template class BWTreeIndex<GenericKey<128>, ItemPointer *,
-                           GenericComparator<128>, GenericEqualityChecker<128>>;
-template class BWTreeIndex<GenericKey<256>, ItemPointer *,
-                           GenericComparator<256>, GenericEqualityChecker<256>>;
-template class BWTreeIndex<GenericKey<512>, ItemPointer *,
-                           GenericComparator<512>, GenericEqualityChecker<512>>;
+template class BWTreeIndex<BinaryKey<4>, ItemPointer *,
+                           BinaryComparator<4>, BinaryEqualityChecker<4>>;
+template class BWTreeIndex<BinaryKey<8>, ItemPointer *,
+                           BinaryComparator<8>, BinaryEqualityChecker<8>>;
+template class BWTreeIndex<BinaryKey<12>, ItemPointer *,
+                           BinaryComparator<12>, BinaryEqualityChecker<12>>;
+template class BWTreeIndex<BinaryKey<16>, ItemPointer *,
+                           BinaryComparator<16>, BinaryEqualityChecker<16>>;
+template class BWTreeIndex<BinaryKey<24>, ItemPointer *,
+                           BinaryComparator<24>, BinaryEqualityChecker<24>>;
+template class BWTreeIndex<BinaryKey<32>, ItemPointer *,
+                           BinaryComparator<32>, BinaryEqualityChecker<32>>;
+template class BWTreeIndex<BinaryKey<48>, ItemPointer *,
+                           BinaryComparator<48>, BinaryEqualityChecker<48>>;
+template class BWTreeIndex<BinaryKey<64>, ItemPointer *,
+                           BinaryComparator<64>, BinaryEqualityChecker<64>>;
+template class BWTreeIndex<BinaryKey<96>, ItemPointer *,
+                           BinaryComparator<96>, BinaryEqualityChecker<96>>;
+template class BWTreeIndex<BinaryKey<128>, ItemPointer *,
+                           BinaryComparator<128>, BinaryEqualityChecker<128>>;
+template class BWTreeIndex<BinaryKey<256>, ItemPointer *,
+                           BinaryComparator<256>, BinaryEqualityChecker<256>>;
+template class BWTreeIndex<BinaryKey<512>, ItemPointer *,
+                           BinaryComparator<512>, BinaryEqualityChecker<512>>;
 
 template class BWTreeIndex<TupleKey, ItemPointer *, TupleKeyComparator,
                            TupleKeyEqualityChecker>;
@@ -13,6 +13,7 @@
 #include "backend/index/index.h"
 #include "backend/common/exception.h"
 #include "backend/common/logger.h"
+#include "backend/common/metrics.h"
 #include "backend/common/pool.h"
 #include "backend/catalog/schema.h"
 #include "backend/catalog/manager.h"
@@ -223,13 +224,78 @@ bool Index::ConstructLowerBoundTuple(
 
 Index::Index(IndexMetadata *metadata) : metadata(metadata) {
   index_oid = metadata->GetOid();
-  // initialize counters
-  lookup_counter = insert_counter = delete_counter = update_counter = 0;
 
   // initialize pool
   pool = new VarlenPool(BACKEND_TYPE_MM);
 }
 
+void Index::InsertEntries(const std::vector<const storage::Tuple *> &keys,
+                          const std::vector<ItemPointer> &locations) {
+  PL_ASSERT(keys.size() == locations.size());
+
+  for (size_t entry_itr = 0; entry_itr < keys.size(); entry_itr++) {
+    InsertEntry(keys[entry_itr], locations[entry_itr]);
+  }
+}
+
+size_t Index::BulkLoad(const size_t partition_count,
+                       const BulkLoadScanner &scanner,
+                       UNUSED_ATTRIBUTE const double fill_factor,
+                       std::function<bool(const ItemPointer &)> predicate) {
+  size_t entry_count = 0;
+  bool unique_keys = HasUniqueKeys();
+
+  for (size_t partition = 0; partition < partition_count; partition++) {
+    scanner(partition, [&](const storage::Tuple *key,
+                           const ItemPointer &location) {
+      // Entries that do not satisfy the predicate never conflict
+      if (unique_keys == false ||
+          CondInsertEntry(key, location, predicate) == false) {
+        if (unique_keys == true && predicate(location) == true) {
+          throw IndexException("Duplicate key in unique index " + GetName());
+        }
+        InsertEntry(key, location);
+      }
+      entry_count++;
+    });
+  }
+
+  return entry_count;
+}
+
+bool Index::ScanEntries(
+    UNUSED_ATTRIBUTE const std::vector<Value> &values,
+    UNUSED_ATTRIBUTE const std::vector<oid_t> &key_column_ids,
+    UNUSED_ATTRIBUTE const std::vector<ExpressionType> &exprs,
+    UNUSED_ATTRIBUTE const ScanDirectionType &scan_direction,
+    UNUSED_ATTRIBUTE const ScanEntryCallback &callback) {
+  return false;
+}
+
+void Index::IncrementInsertCount(const uint64_t count) {
+  static oid_t counter_id =
+      MetricsRegistry::GetInstance().RegisterCounter("index.insert");
+  MetricsRegistry::GetInstance().Increment(counter_id, count);
+}
+
+void Index::IncrementDeleteCount() {
+  static oid_t counter_id =
+      MetricsRegistry::GetInstance().RegisterCounter("index.delete");
+  MetricsRegistry::GetInstance().Increment(counter_id);
+}
+
+void Index::IncrementLookupCount() {
+  static oid_t counter_id =
+      MetricsRegistry::GetInstance().RegisterCounter("index.lookup");
+  MetricsRegistry::GetInstance().Increment(counter_id);
+}
+
+void Index::IncrementScanCount() {
+  static oid_t counter_id =
+      MetricsRegistry::GetInstance().RegisterCounter("index.scan");
+  MetricsRegistry::GetInstance().Increment(counter_id);
+}
+
 const std::string Index::GetInfo() const {
   std::stringstream os;
 
@@ -116,6 +116,7 @@ class Index : public Printable {
                            const ItemPointer &location) = 0;
 
   // delete the index entry linked to given tuple and location
+  // Return false if there was no such entry
   virtual bool DeleteEntry(const storage::Tuple *key,
                            const ItemPointer &location) = 0;
 
@@ -128,6 +129,30 @@ class Index : public Printable {
       const storage::Tuple *key, const ItemPointer &location,
       std::function<bool(const ItemPointer &)> predicate) = 0;
 
+  // insert a batch of entries (bulk inserts), the i-th key being linked to
+  // the i-th location. The default implementation inserts them one at a time.
+  virtual void InsertEntries(const std::vector<const storage::Tuple *> &keys,
+                             const std::vector<ItemPointer> &locations);
+
+  // Handed the key and location of each entry by a bulk load
+  typedef std::function<void(const storage::Tuple *, const ItemPointer &)>
+      BulkLoadCallback;
+
+  // Produces the entries of a partition of a bulk load
+  typedef std::function<void(const size_t, const BulkLoadCallback &)>
+      BulkLoadScanner;
+
+  // Fill an empty index with the entries produced by the partitions of the
+  // scanner, leaving its leaves filled up to the fill factor (in (0, 1]).
+  // Returns the # of entries loaded. If the index has unique keys, two
+  // entries with the same key whose locations both satisfy the predicate
+  // (as in CondInsertEntry) fail the load with an IndexException. The
+  // default implementation inserts the entries one at a time.
+  virtual size_t BulkLoad(const size_t partition_count,
+                          const BulkLoadScanner &scanner,
+                          const double fill_factor,
+                          std::function<bool(const ItemPointer &)> predicate);
+
   //===--------------------------------------------------------------------===//
   // Accessors
   //===--------------------------------------------------------------------===//
@@ -157,6 +182,20 @@ class Index : public Printable {
   virtual void ScanKey(const storage::Tuple *key,
                        std::vector<ItemPointer *> &result) = 0;
 
+  // Handed the key and location of each entry matched by an entry scan
+  typedef std::function<void(const storage::Tuple *, const ItemPointer &)>
+      ScanEntryCallback;
+
+  // Scan the entries matching the predicate like Scan does, handing their
+  // keys to the callback as well, so that the columns of the key can be read
+  // without going to the table. The key is only valid during the callback.
+  // Returns false if the index does not support it, without scanning.
+  virtual bool ScanEntries(const std::vector<Value> &values,
+                           const std::vector<oid_t> &key_column_ids,
+                           const std::vector<ExpressionType> &exprs,
+                           const ScanDirectionType &scan_direction,
+                           const ScanEntryCallback &callback);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -241,6 +280,15 @@ class Index : public Printable {
 
   bool IfBackwardExpression(ExpressionType e);
 
+  // Access counters, kept in the metrics registry
+  static void IncrementInsertCount(const uint64_t count = 1);
+
+  static void IncrementDeleteCount();
+
+  static void IncrementLookupCount();
+
+  static void IncrementScanCount();
+
   //  Data members
   //===--------------------------------------------------------------------===//
 
@@ -248,12 +296,6 @@ class Index : public Printable {
 
   oid_t index_oid = INVALID_OID;
 
-  // access counters
-  int lookup_counter;
-  int insert_counter;
-  int delete_counter;
-  int update_counter;
-
   // number of tuples
   float number_of_tuples = 0.0;
 
@@ -0,0 +1,210 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_builder.cpp
+//
+// Identification: src/backend/index/index_builder.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <memory>
+#include <thread>
+
+#include "backend/index/index_builder.h"
+#include "backend/catalog/manager.h"
+#include "backend/catalog/schema.h"
+#include "backend/common/exception.h"
+#include "backend/common/logger.h"
+#include "backend/common/pool.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_header.h"
+#include "backend/storage/tuple.h"
+
+namespace peloton {
+namespace index {
+
+size_t IndexBuilder::BuildIndex(storage::DataTable *table, Index *index,
+                                const int fill_factor) {
+  // Inserts from now on are logged
+  table->StartIndexBuild();
+
+  size_t tile_group_count = table->GetTileGroupCount();
+  size_t partition_count = std::max<size_t>(
+      1, std::min<size_t>(std::thread::hardware_concurrency(),
+                          tile_group_count));
+
+  // Slots claimed by an insert that did not set up their version yet
+  std::vector<std::vector<ItemPointer>> skipped_locations(partition_count);
+
+  // Locations handed to the index by each partition
+  std::vector<std::vector<ItemPointer>> loaded_locations(partition_count);
+
+  // Each partition scans every partition_count-th tile group
+  auto scanner = [&](const size_t partition,
+                     const Index::BulkLoadCallback &callback) {
+    std::unique_ptr<storage::Tuple> key(
+        new storage::Tuple(index->GetKeySchema(), true));
+    VarlenPool pool(BACKEND_TYPE_MM);
+
+    for (size_t tile_group_offset = partition;
+         tile_group_offset < tile_group_count;
+         tile_group_offset += partition_count) {
+      auto tile_group = table->GetTileGroup(tile_group_offset);
+      auto tile_group_header = tile_group->GetHeader();
+      auto tile_group_id = tile_group->GetTileGroupId();
+      oid_t active_tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+      for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+        ItemPointer location(tile_group_id, tuple_id);
+
+        if (tile_group_header->GetTransactionId(tuple_id) == INVALID_TXN_ID) {
+          skipped_locations[partition].push_back(location);
+          continue;
+        }
+
+        if (HasOwnEntry(index, tile_group.get(), location) == false) continue;
+
+        SetKey(index, tile_group.get(), tuple_id, key.get(), &pool);
+        callback(key.get(), location);
+        loaded_locations[partition].push_back(location);
+      }
+    }
+  };
+
+  std::function<bool(const ItemPointer &)> predicate =
+      std::bind(&IndexBuilder::IsLive, index, std::placeholders::_1);
+
+  size_t entry_count;
+  try {
+    entry_count = index->BulkLoad(partition_count, scanner,
+                                  fill_factor / 100.0, predicate);
+  } catch (IndexException &e) {
+    table->AbortIndexBuild();
+    throw;
+  }
+
+  LOG_TRACE("Bulk loaded %lu entries into index %s", entry_count,
+            index->GetName().c_str());
+
+  std::set<ItemPointer> indexed_locations;
+  for (auto &locations : loaded_locations) {
+    indexed_locations.insert(locations.begin(), locations.end());
+    locations.clear();
+  }
+
+  // Catch up with the inserts that happened during the build
+  auto logged_locations = table->FinishIndexBuild(index);
+
+  for (auto &logged_location : logged_locations) {
+    if (CatchUp(index, logged_location.first, logged_location.second, true,
+                indexed_locations) == true) {
+      entry_count++;
+    }
+  }
+
+  for (auto &locations : skipped_locations) {
+    for (auto &location : locations) {
+      if (CatchUp(index, location, false, false, indexed_locations) == true) {
+        entry_count++;
+      }
+    }
+  }
+
+  index->SetNumberOfTuples(entry_count);
+
+  return entry_count;
+}
+
+bool IndexBuilder::HasOwnEntry(Index *index, storage::TileGroup *tile_group,
+                               const ItemPointer &location) {
+  auto prev_location =
+      tile_group->GetHeader()->GetPrevItemPointer(location.offset);
+  if (prev_location.IsNull() == true) return true;
+
+  // Only the first version of a tuple is in the primary index
+  if (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+    return false;
+  }
+
+  // A version with the same key as the previous one is reached through the
+  // entry of the previous version (heap-only update)
+  auto indexed_location =
+      storage::DataTable::GetNextIndexedVersion(index, prev_location);
+  return (indexed_location.block != location.block ||
+          indexed_location.offset != location.offset);
+}
+
+void IndexBuilder::SetKey(Index *index, storage::TileGroup *tile_group,
+                          const oid_t tuple_id, storage::Tuple *key,
+                          VarlenPool *pool) {
+  auto indexed_columns = index->GetKeySchema()->GetIndexedColumns();
+
+  for (oid_t key_itr = 0; key_itr < indexed_columns.size(); key_itr++) {
+    key->SetValue(key_itr,
+                  tile_group->GetValue(tuple_id, indexed_columns[key_itr]),
+                  pool);
+  }
+}
+
+bool IndexBuilder::IsLive(Index *index, ItemPointer location) {
+  auto &manager = catalog::Manager::GetInstance();
+
+  while (location.IsNull() == false) {
+    auto tile_group_header = manager.GetTileGroup(location.block)->GetHeader();
+
+    if (tile_group_header->GetTransactionId(location.offset) !=
+            INVALID_TXN_ID &&
+        tile_group_header->GetEndCommitId(location.offset) == MAX_CID) {
+      return true;
+    }
+
+    // The primary index has an entry for the first version of a tuple only
+    if (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+      location = tile_group_header->GetNextItemPointer(location.offset);
+    } else {
+      location = storage::DataTable::GetNextIndexedVersion(index, location);
+    }
+  }
+
+  return false;
+}
+
+bool IndexBuilder::CatchUp(Index *index, const ItemPointer &location,
+                           const bool is_version, const bool is_claimed,
+                           std::set<ItemPointer> &indexed_locations) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(location.block);
+  if (tile_group == nullptr) return false;
+
+  if (is_claimed == false &&
+      tile_group->GetHeader()->GetTransactionId(location.offset) ==
+          INVALID_TXN_ID) {
+    return false;
+  }
+
+  if (is_version == true &&
+      index->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) {
+    return false;
+  }
+
+  if (HasOwnEntry(index, tile_group.get(), location) == false) return false;
+
+  // The location may have been scanned, or logged more than once
+  if (indexed_locations.insert(location).second == false) return false;
+
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index->GetKeySchema(), true));
+  SetKey(index, tile_group.get(), location.offset, key.get(), index->GetPool());
+
+  index->InsertEntry(key.get(), location);
+
+  return true;
+}
+
+}  // End index namespace
+}  // End peloton namespace
@@ -0,0 +1,87 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_builder.h
+//
+// Identification: src/backend/index/index_builder.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <set>
+#include <vector>
+
+#include "backend/common/types.h"
+#include "backend/index/index.h"
+
+namespace peloton {
+
+namespace storage {
+class DataTable;
+class TileGroup;
+class Tuple;
+}
+
+namespace index {
+
+// % of the leaf slots filled by a build, as in postgres
+#define INDEX_BUILD_DEFAULT_FILL_FACTOR 90
+
+//===--------------------------------------------------------------------===//
+// Index Builder
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Builds an index over the tuples already in a table.
+ *
+ * The tile groups of the table are scanned in parallel, and the keys of the
+ * versions are handed to Index::BulkLoad, which sorts them and builds the
+ * index bottom-up. As the index scans check the visibility of every entry,
+ * all the versions are indexed, the same way they are when inserted.
+ *
+ * The table logs the locations inserted into its indexes while the build
+ * runs. Once loaded, the index is added to the table and catches up with the
+ * logged locations, and with the slots that were claimed but not yet
+ * inserted when they were scanned.
+ */
+class IndexBuilder {
+ public:
+  IndexBuilder(const IndexBuilder &) = delete;
+  IndexBuilder &operator=(const IndexBuilder &) = delete;
+  IndexBuilder(IndexBuilder &&) = delete;
+  IndexBuilder &operator=(IndexBuilder &&) = delete;
+
+  // Fill the empty index from the table, then add it to the table.
+  // Returns the # of entries of the index. Throws an IndexException, and
+  // leaves the table without the index, if the index has unique keys and
+  // two live tuples of the table have the same key.
+  static size_t BuildIndex(storage::DataTable *table, Index *index,
+                           const int fill_factor =
+                               INDEX_BUILD_DEFAULT_FILL_FACTOR);
+
+ private:
+  // Does the version have an entry of its own in the index ?
+  static bool HasOwnEntry(Index *index, storage::TileGroup *tile_group,
+                          const ItemPointer &location);
+
+  static void SetKey(Index *index, storage::TileGroup *tile_group,
+                     const oid_t tuple_id, storage::Tuple *key,
+                     VarlenPool *pool);
+
+  // Is the latest version reached through the entry of the version neither
+  // deleted nor aborted ? Duplicate keys of a unique index are only allowed
+  // between entries that are not live.
+  static bool IsLive(Index *index, ItemPointer location);
+
+  // Insert an entry for the version, unless it is in the indexed locations
+  static bool CatchUp(Index *index, const ItemPointer &location,
+                      const bool is_version, const bool is_claimed,
+                      std::set<ItemPointer> &indexed_locations);
+};
+
+}  // End index namespace
+}  // End peloton namespace
@@ -60,55 +60,56 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
     }
   }
 
+  // Other keys are compared on their order-preserving binary encoding
   if (index_type == INDEX_TYPE_BTREE) {
     if (key_size <= 4) {
-      return new BTreeIndex<GenericKey<4>, ItemPointer *,
-                            GenericComparator<4>, GenericEqualityChecker<4>>(
+      return new BTreeIndex<BinaryKey<4>, ItemPointer *,
+                            BinaryComparator<4>, BinaryEqualityChecker<4>>(
           metadata);
     } else if (key_size <= 8) {
-      return new BTreeIndex<GenericKey<8>, ItemPointer *,
-                            GenericComparator<8>, GenericEqualityChecker<8>>(
+      return new BTreeIndex<BinaryKey<8>, ItemPointer *,
+                            BinaryComparator<8>, BinaryEqualityChecker<8>>(
           metadata);
     } else if (key_size <= 12) {
-      return new BTreeIndex<GenericKey<12>, ItemPointer *,
-                            GenericComparator<12>, GenericEqualityChecker<12>>(
+      return new BTreeIndex<BinaryKey<12>, ItemPointer *,
+                            BinaryComparator<12>, BinaryEqualityChecker<12>>(
           metadata);
     } else if (key_size <= 16) {
-      return new BTreeIndex<GenericKey<16>, ItemPointer *,
-                            GenericComparator<16>, GenericEqualityChecker<16>>(
+      return new BTreeIndex<BinaryKey<16>, ItemPointer *,
+                            BinaryComparator<16>, BinaryEqualityChecker<16>>(
           metadata);
     } else if (key_size <= 24) {
-      return new BTreeIndex<GenericKey<24>, ItemPointer *,
-                            GenericComparator<24>, GenericEqualityChecker<24>>(
+      return new BTreeIndex<BinaryKey<24>, ItemPointer *,
+                            BinaryComparator<24>, BinaryEqualityChecker<24>>(
           metadata);
     } else if (key_size <= 32) {
-      return new BTreeIndex<GenericKey<32>, ItemPointer *,
-                            GenericComparator<32>, GenericEqualityChecker<32>>(
+      return new BTreeIndex<BinaryKey<32>, ItemPointer *,
+                            BinaryComparator<32>, BinaryEqualityChecker<32>>(
           metadata);
     } else if (key_size <= 48) {
-      return new BTreeIndex<GenericKey<48>, ItemPointer *,
-                            GenericComparator<48>, GenericEqualityChecker<48>>(
+      return new BTreeIndex<BinaryKey<48>, ItemPointer *,
+                            BinaryComparator<48>, BinaryEqualityChecker<48>>(
           metadata);
     } else if (key_size <= 64) {
-      return new BTreeIndex<GenericKey<64>, ItemPointer *,
-                            GenericComparator<64>, GenericEqualityChecker<64>>(
+      return new BTreeIndex<BinaryKey<64>, ItemPointer *,
+                            BinaryComparator<64>, BinaryEqualityChecker<64>>(
           metadata);
     } else if (key_size <= 96) {
-      return new BTreeIndex<GenericKey<96>, ItemPointer *,
-                            GenericComparator<96>, GenericEqualityChecker<96>>(
+      return new BTreeIndex<BinaryKey<96>, ItemPointer *,
+                            BinaryComparator<96>, BinaryEqualityChecker<96>>(
           metadata);
     } else if (key_size <= 128) {
-      return new BTreeIndex<GenericKey<128>, ItemPointer *,
-                            GenericComparator<128>,
-                            GenericEqualityChecker<128>>(metadata);
+      return new BTreeIndex<BinaryKey<128>, ItemPointer *,
+                            BinaryComparator<128>,
+                            BinaryEqualityChecker<128>>(metadata);
     } else if (key_size <= 256) {
-      return new BTreeIndex<GenericKey<256>, ItemPointer *,
-                            GenericComparator<256>,
-                            GenericEqualityChecker<256>>(metadata);
+      return new BTreeIndex<BinaryKey<256>, ItemPointer *,
+                            BinaryComparator<256>,
+                            BinaryEqualityChecker<256>>(metadata);
     } else if (key_size <= 512) {
-      return new BTreeIndex<GenericKey<512>, ItemPointer *,
-                            GenericComparator<512>,
-                            GenericEqualityChecker<512>>(metadata);
+      return new BTreeIndex<BinaryKey<512>, ItemPointer *,
+                            BinaryComparator<512>,
+                            BinaryEqualityChecker<512>>(metadata);
     } else {
       return new BTreeIndex<TupleKey, ItemPointer *,
                             TupleKeyComparator, TupleKeyEqualityChecker>(
@@ -141,53 +142,53 @@ Index *IndexFactory::GetInstance(IndexMetadata *metadata) {
 
   if (index_type == INDEX_TYPE_BWTREE) {
     if (key_size <= 4) {
-      return new BWTreeIndex<GenericKey<4>, ItemPointer *,
-                             GenericComparator<4>, GenericEqualityChecker<4>>(
+      return new BWTreeIndex<BinaryKey<4>, ItemPointer *,
+                             BinaryComparator<4>, BinaryEqualityChecker<4>>(
           metadata);
     } else if (key_size <= 8) {
-      return new BWTreeIndex<GenericKey<8>, ItemPointer *,
-                             GenericComparator<8>, GenericEqualityChecker<8>>(
+      return new BWTreeIndex<BinaryKey<8>, ItemPointer *,
+                             BinaryComparator<8>, BinaryEqualityChecker<8>>(
           metadata);
     } else if (key_size <= 12) {
-      return new BWTreeIndex<GenericKey<12>, ItemPointer *,
-                             GenericComparator<12>, GenericEqualityChecker<12>>(
+      return new BWTreeIndex<BinaryKey<12>, ItemPointer *,
+                             BinaryComparator<12>, BinaryEqualityChecker<12>>(
           metadata);
     } else if (key_size <= 16) {
-      return new BWTreeIndex<GenericKey<16>, ItemPointer *,
-                             GenericComparator<16>, GenericEqualityChecker<16>>(
+      return new BWTreeIndex<BinaryKey<16>, ItemPointer *,
+                             BinaryComparator<16>, BinaryEqualityChecker<16>>(
           metadata);
     } else if (key_size <= 24) {
-      return new BWTreeIndex<GenericKey<24>, ItemPointer *,
-                             GenericComparator<24>, GenericEqualityChecker<24>>(
+      return new BWTreeIndex<BinaryKey<24>, ItemPointer *,
+                             BinaryComparator<24>, BinaryEqualityChecker<24>>(
           metadata);
     } else if (key_size <= 32) {
-      return new BWTreeIndex<GenericKey<32>, ItemPointer *,
-                             GenericComparator<32>, GenericEqualityChecker<32>>(
+      return new BWTreeIndex<BinaryKey<32>, ItemPointer *,
+                             BinaryComparator<32>, BinaryEqualityChecker<32>>(
           metadata);
     } else if (key_size <= 48) {
-      return new BWTreeIndex<GenericKey<48>, ItemPointer *,
-                             GenericComparator<48>, GenericEqualityChecker<48>>(
+      return new BWTreeIndex<BinaryKey<48>, ItemPointer *,
+                             BinaryComparator<48>, BinaryEqualityChecker<48>>(
           metadata);
     } else if (key_size <= 64) {
-      return new BWTreeIndex<GenericKey<64>, ItemPointer *,
-                             GenericComparator<64>, GenericEqualityChecker<64>>(
+      return new BWTreeIndex<BinaryKey<64>, ItemPointer *,
+                             BinaryComparator<64>, BinaryEqualityChecker<64>>(
           metadata);
     } else if (key_size <= 96) {
-      return new BWTreeIndex<GenericKey<96>, ItemPointer *,
-                             GenericComparator<96>, GenericEqualityChecker<96>>(
+      return new BWTreeIndex<BinaryKey<96>, ItemPointer *,
+                             BinaryComparator<96>, BinaryEqualityChecker<96>>(
           metadata);
     } else if (key_size <= 128) {
-      return new BWTreeIndex<GenericKey<128>, ItemPointer *,
-                             GenericComparator<128>,
-                             GenericEqualityChecker<128>>(metadata);
+      return new BWTreeIndex<BinaryKey<128>, ItemPointer *,
+                             BinaryComparator<128>,
+                             BinaryEqualityChecker<128>>(metadata);
     } else if (key_size <= 256) {
-      return new BWTreeIndex<GenericKey<256>, ItemPointer *,
-                             GenericComparator<256>,
-                             GenericEqualityChecker<256>>(metadata);
+      return new BWTreeIndex<BinaryKey<256>, ItemPointer *,
+                             BinaryComparator<256>,
+                             BinaryEqualityChecker<256>>(metadata);
     } else if (key_size <= 512) {
-      return new BWTreeIndex<GenericKey<512>, ItemPointer *,
-                             GenericComparator<512>,
-                             GenericEqualityChecker<512>>(metadata);
+      return new BWTreeIndex<BinaryKey<512>, ItemPointer *,
+                             BinaryComparator<512>,
+                             BinaryEqualityChecker<512>>(metadata);
     } else {
       return new BWTreeIndex<TupleKey, ItemPointer *,
                              TupleKeyComparator, TupleKeyEqualityChecker>(
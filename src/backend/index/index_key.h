@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <cstring>
 #include <iostream>
 #include <sstream>
 
@@ -501,6 +502,253 @@ struct GenericHasher : std::unary_function<GenericKey<KeySize>, std::size_t> {
   const catalog::Schema *schema;
 };
 
+/**
+ * Order-preserving binary encoding of the columns of a key, so that two keys
+ * can be ordered by comparing their encodings with memcmp.
+ *
+ *  integers / timestamps : big-endian, with the sign bit flipped
+ *  booleans              : one byte
+ *  doubles               : big-endian IEEE 754, with the sign bit flipped for
+ *                          positive values and all bits flipped for negative
+ *                          values (-0.0 is normalized to 0.0)
+ *  varchars              : big-endian length (ordered before the contents,
+ *                          like Value::Compare), then the leading bytes
+ *
+ * NULLs are encoded as all zero bytes, which sorts them first. The encoding
+ * stops after the first varchar, at the first column of another type, or
+ * when the buffer is full. Keys with equal encodings have then to be compared
+ * on their values (see IsComplete).
+ */
+class BinaryKeyEncoder {
+ public:
+  static void Encode(const storage::Tuple *key, unsigned char *buffer,
+                     const size_t buffer_size) {
+    PL_MEMSET(buffer, 0, buffer_size);
+
+    const catalog::Schema *key_schema = key->GetSchema();
+    size_t offset = 0;
+    for (oid_t column_itr = 0; column_itr < key_schema->GetColumnCount();
+         column_itr++) {
+      const ValueType column_type = key_schema->GetType(column_itr);
+      const Value value = key->GetValue(column_itr);
+
+      const size_t width = GetFixedWidth(column_type);
+      if (width != 0) {
+        if (offset + width > buffer_size) return;
+        if (value.IsNull() == false) {
+          WriteBigEndian(buffer + offset, EncodeFixed(column_type, value),
+                         width);
+        }
+        offset += width;
+        continue;
+      }
+
+      if (column_type != VALUE_TYPE_VARCHAR ||
+          offset + sizeof(uint32_t) > buffer_size) {
+        return;
+      }
+
+      // NULL < any string, then shorter strings < longer strings
+      if (value.IsNull() == true) return;
+      const int32_t length = ValuePeeker::PeekObjectLengthWithoutNull(value);
+      WriteBigEndian(buffer + offset, static_cast<uint64_t>(length) + 1,
+                     sizeof(uint32_t));
+      offset += sizeof(uint32_t);
+
+      // Same as strncmp : nothing after a NUL byte matters
+      const char *data = reinterpret_cast<const char *>(
+          ValuePeeker::PeekObjectValueWithoutNull(value));
+      for (int32_t byte_itr = 0;
+           byte_itr < length && offset < buffer_size && data[byte_itr] != 0;
+           byte_itr++) {
+        buffer[offset++] = static_cast<unsigned char>(data[byte_itr]);
+      }
+      return;
+    }
+  }
+
+  // Do equal encodings imply equal keys ?
+  static bool IsComplete(const catalog::Schema *key_schema,
+                         const size_t buffer_size) {
+    size_t offset = 0;
+    for (oid_t column_itr = 0; column_itr < key_schema->GetColumnCount();
+         column_itr++) {
+      const size_t width = GetFixedWidth(key_schema->GetType(column_itr));
+      if (width == 0) return false;
+      offset += width;
+    }
+    return offset <= buffer_size;
+  }
+
+ private:
+  // Size of the encoding of a fixed-length type, 0 for the other types
+  static size_t GetFixedWidth(const ValueType type) {
+    switch (type) {
+      case VALUE_TYPE_BOOLEAN:
+      case VALUE_TYPE_TINYINT:
+        return sizeof(int8_t);
+      case VALUE_TYPE_SMALLINT:
+        return sizeof(int16_t);
+      case VALUE_TYPE_INTEGER:
+        return sizeof(int32_t);
+      case VALUE_TYPE_BIGINT:
+      case VALUE_TYPE_TIMESTAMP:
+      case VALUE_TYPE_DOUBLE:
+        return sizeof(int64_t);
+      default:
+        return 0;
+    }
+  }
+
+  static uint64_t EncodeSigned(const int64_t value, const size_t width) {
+    return static_cast<uint64_t>(value) ^ (1ULL << (width * 8 - 1));
+  }
+
+  static uint64_t EncodeFixed(const ValueType type, const Value &value) {
+    switch (type) {
+      case VALUE_TYPE_BOOLEAN:
+        return ValuePeeker::PeekBoolean(value) ? 2 : 1;
+      case VALUE_TYPE_TINYINT:
+        return EncodeSigned(ValuePeeker::PeekTinyInt(value), sizeof(int8_t));
+      case VALUE_TYPE_SMALLINT:
+        return EncodeSigned(ValuePeeker::PeekSmallInt(value),
+                            sizeof(int16_t));
+      case VALUE_TYPE_INTEGER:
+        return EncodeSigned(ValuePeeker::PeekInteger(value), sizeof(int32_t));
+      case VALUE_TYPE_BIGINT:
+        return EncodeSigned(ValuePeeker::PeekBigInt(value), sizeof(int64_t));
+      case VALUE_TYPE_TIMESTAMP:
+        return EncodeSigned(ValuePeeker::PeekTimestamp(value),
+                            sizeof(int64_t));
+      case VALUE_TYPE_DOUBLE: {
+        double number = ValuePeeker::PeekDouble(value);
+        if (number == 0.0) number = 0.0;
+        uint64_t bits;
+        PL_MEMCPY(&bits, &number, sizeof(bits));
+        return (bits >> 63) ? ~bits : (bits | (1ULL << 63));
+      }
+      default:
+        return 0;
+    }
+  }
+
+  // Write the low width bytes of value, most significant byte first
+  static void WriteBigEndian(unsigned char *buffer, const uint64_t value,
+                             const size_t width) {
+    for (size_t byte_itr = 0; byte_itr < width; byte_itr++) {
+      buffer[byte_itr] =
+          static_cast<unsigned char>(value >> ((width - 1 - byte_itr) * 8));
+    }
+  }
+};
+
+/**
+ * Key object for indexes of mixed types, compared on its binary encoding.
+ * The key tuple is kept next to the encoding, to break ties between
+ * truncated encodings and to evaluate scan predicates.
+ */
+template <std::size_t KeySize> class BinaryKey {
+ public:
+  // Room for the encoding, with a few bytes of prefix for short varchar keys
+  static const std::size_t EncodedSize = (KeySize < 16) ? 16 : KeySize;
+
+  inline void SetFromKey(const storage::Tuple *tuple) {
+    PL_ASSERT(tuple);
+    PL_MEMCPY(data, tuple->GetData(), KeySize);
+    BinaryKeyEncoder::Encode(tuple, encoded, EncodedSize);
+  }
+
+  const storage::Tuple GetTupleForComparison(
+      const catalog::Schema *key_schema) {
+    return storage::Tuple(key_schema, data);
+  }
+
+  inline const Value ToValueFast(const catalog::Schema *schema,
+                                 int column_id) const {
+    const ValueType column_type = schema->GetType(column_id);
+    const char *data_ptr = &data[schema->GetOffset(column_id)];
+    const bool is_inlined = schema->IsInlined(column_id);
+
+    return Value::InitFromTupleStorage(data_ptr, column_type, is_inlined);
+  }
+
+  // order-preserving encoding of the key
+  unsigned char encoded[EncodedSize];
+
+  // actual location of data, extends past the end.
+  char data[KeySize];
+};
+
+/**
+ * Function object returns true if lhs < rhs, used for trees
+ */
+template <std::size_t KeySize> class BinaryComparator {
+ public:
+  BinaryComparator(index::IndexMetadata *metadata)
+      : schema(metadata->GetKeySchema()),
+        complete(BinaryKeyEncoder::IsComplete(
+            schema, BinaryKey<KeySize>::EncodedSize)) {}
+
+  inline bool operator()(const BinaryKey<KeySize> &lhs,
+                         const BinaryKey<KeySize> &rhs) const {
+    int diff =
+        memcmp(lhs.encoded, rhs.encoded, BinaryKey<KeySize>::EncodedSize);
+    if (diff != 0 || complete == true) {
+      return diff < 0;
+    }
+
+    // Tie-break on the values
+    for (oid_t column_itr = 0; column_itr < schema->GetColumnCount();
+         column_itr++) {
+      const Value lhs_value = lhs.ToValueFast(schema, column_itr);
+      const Value rhs_value = rhs.ToValueFast(schema, column_itr);
+
+      diff = lhs_value.Compare(rhs_value);
+
+      if (diff) {
+        return diff < 0;
+      }
+    }
+
+    /* equal */
+    return false;
+  }
+
+  const catalog::Schema *schema;
+
+  // equal encodings mean equal keys
+  bool complete;
+};
+
+/**
+ * Equality-checking function object
+ */
+template <std::size_t KeySize> class BinaryEqualityChecker {
+ public:
+  BinaryEqualityChecker(index::IndexMetadata *metadata)
+      : schema(metadata->GetKeySchema()),
+        complete(BinaryKeyEncoder::IsComplete(
+            schema, BinaryKey<KeySize>::EncodedSize)) {}
+
+  inline bool operator()(const BinaryKey<KeySize> &lhs,
+                         const BinaryKey<KeySize> &rhs) const {
+    if (memcmp(lhs.encoded, rhs.encoded, BinaryKey<KeySize>::EncodedSize)) {
+      return false;
+    }
+    if (complete == true) return true;
+
+    storage::Tuple lhTuple(schema);
+    lhTuple.MoveToTuple(reinterpret_cast<const void *>(lhs.data));
+    storage::Tuple rhTuple(schema);
+    rhTuple.MoveToTuple(reinterpret_cast<const void *>(rhs.data));
+    return lhTuple.EqualsNoSchemaCheck(rhTuple);
+  }
+
+  const catalog::Schema *schema;
+
+  bool complete;
+};
+
 /*
  * TupleKey is the all-purpose fallback key for indexes that can't be
  * better specialized. Each TupleKey wraps a pointer to a *persistent
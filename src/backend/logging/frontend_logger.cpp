@@ -33,6 +33,11 @@ FrontendLogger::FrontendLogger() {
   // Set wait timeout
   wait_timeout = peloton_wait_timeout;
   LOG_TRACE("Init frontend logger with wait_time: %d ", (int)wait_timeout);
+
+  auto &metrics = MetricsRegistry::GetInstance();
+  log_bytes_counter_id = metrics.RegisterCounter("log.bytes");
+  flush_latency_histogram_id =
+      metrics.RegisterHistogram("log.flush_latency_us");
 }
 
 FrontendLogger::~FrontendLogger() {
@@ -21,6 +21,7 @@
 #include <thread>
 
 #include "backend/common/types.h"
+#include "backend/common/metrics.h"
 #include "backend/logging/logger.h"
 #include "backend/logging/log_buffer.h"
 #include "backend/logging/buffer_pool.h"
@@ -125,6 +126,11 @@ class FrontendLogger : public Logger {
   // stats
   size_t fsync_count = 0;
 
+  // # of bytes written to the log and flush latency (us) metrics
+  oid_t log_bytes_counter_id;
+
+  oid_t flush_latency_histogram_id;
+
   cid_t max_flushed_commit_id = 0;
 
   cid_t max_collected_commit_id = 0;
@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <condition_variable>
+#include <future>
 #include <memory>
 
 #include "backend/concurrency/transaction_manager_factory.h"
@@ -31,6 +33,14 @@ namespace logging {
 // Each thread gets a backend logger
 thread_local static BackendLogger *backend_logger = nullptr;
 
+// commit id of the last transaction logged by this thread in pipelined
+// commit mode, not yet acknowledged
+thread_local static cid_t pending_commit_id = INVALID_CID;
+
+// acknowledgement of the last commit of this thread deferred until the reply
+// to the client, see DeferCommitAcknowledgement
+thread_local static std::shared_future<void> deferred_ack;
+
 LogManager::LogManager() {
   Configure(peloton_logging_mode, false, DEFAULT_NUM_FRONTEND_LOGGERS,
             LOGGER_MAPPING_ROUND_ROBIN);
@@ -169,6 +179,13 @@ void LogManager::LogBeginTransaction(cid_t commit_id) {
     auto logger = this->GetBackendLogger();
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_BEGIN, commit_id);
     logger->Log(&record);
+
+    // before any version of the transaction becomes visible
+    cid_t max_logged = max_logged_commit_id_.load();
+    while (max_logged < commit_id &&
+           max_logged_commit_id_.compare_exchange_weak(max_logged,
+                                                       commit_id) == false)
+      ;
   }
 }
 
@@ -238,6 +255,61 @@ void LogManager::LogInsert(cid_t commit_id, const ItemPointer &new_location) {
   }
 }
 
+void LogManager::LogInserts(cid_t commit_id, oid_t tile_group_id,
+                            const std::vector<oid_t> &tuple_slots) {
+  if (this->IsInLoggingMode() == false) return;
+
+  if (IsBasedOnWriteAheadLogging(logging_type_) == false) {
+    for (auto tuple_slot : tuple_slots) {
+      LogInsert(commit_id, ItemPointer(tile_group_id, tuple_slot));
+    }
+    return;
+  }
+
+  auto logger = this->GetBackendLogger();
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(tile_group_id);
+  auto schema = manager.GetTableWithOid(tile_group->GetDatabaseId(),
+                                        tile_group->GetTableId())->GetSchema();
+
+  size_t run_begin = 0;
+  while (run_begin < tuple_slots.size()) {
+    // Find the run of consecutive slots
+    size_t run_end = run_begin + 1;
+    while (run_end < tuple_slots.size() &&
+           tuple_slots[run_end] == tuple_slots[run_end - 1] + 1) {
+      run_end++;
+    }
+
+    if (run_end - run_begin == 1) {
+      LogInsert(commit_id, ItemPointer(tile_group_id, tuple_slots[run_begin]));
+      run_begin = run_end;
+      continue;
+    }
+
+    std::vector<std::unique_ptr<storage::Tuple>> tuples;
+    std::vector<storage::Tuple *> record_tuples;
+    for (size_t slot_itr = run_begin; slot_itr < run_end; slot_itr++) {
+      tuples.emplace_back(new storage::Tuple(schema, true));
+      for (oid_t col = 0; col < schema->GetColumnCount(); col++) {
+        tuples.back()->SetValue(
+            col, tile_group->GetValue(tuple_slots[slot_itr], col),
+            logger->GetVarlenPool());
+      }
+      record_tuples.push_back(tuples.back().get());
+    }
+
+    std::unique_ptr<LogRecord> record(logger->GetTupleRecord(
+        LOGRECORD_TYPE_TILE_GROUP_INSERT, commit_id, tile_group->GetTableId(),
+        tile_group->GetDatabaseId(),
+        ItemPointer(tile_group_id, tuple_slots[run_begin]),
+        INVALID_ITEMPOINTER, &record_tuples));
+    logger->Log(record.get());
+
+    run_begin = run_end;
+  }
+}
+
 void LogManager::LogDelete(cid_t commit_id, const ItemPointer &delete_location) {
   if (this->IsInLoggingMode()) {
     auto logger = this->GetBackendLogger();
@@ -258,7 +330,11 @@ void LogManager::LogCommitTransaction(cid_t commit_id) {
     TransactionRecord record(LOGRECORD_TYPE_TRANSACTION_COMMIT, commit_id);
     logger->Log(&record);
     if (syncronization_commit) {
-      WaitForFlush(commit_id);
+      if (pipelined_commit_) {
+        pending_commit_id = commit_id;
+      } else {
+        WaitForFlush(commit_id);
+      }
     }
     logger->GetVarlenPool()->Purge();
   }
@@ -462,6 +538,108 @@ void LogManager::FrontendLoggerFlushed() {
     std::unique_lock<std::mutex> wait_lock(flush_notify_mutex);
     flush_notify_cv.notify_all();
   }
+
+  if (pipelined_commit_) {
+    AcknowledgeDurableCommits();
+  }
+}
+
+/**
+ * @brief Acknowledge the last transaction of the calling thread once the log
+ * is durable up to the greater of its commit id and read_cid.
+ *
+ * In pipelined commit mode, the versions of a transaction are visible to the
+ * other transactions as soon as they are installed, before its commit record
+ * is flushed. A transaction that read them has a greater commit id, and a
+ * read-only one has a begin commit id at least as large, so waiting for the
+ * log to be durable up to that id covers all of its commit dependencies.
+ * Commit ids are flushed in order, so a dependent transaction is never
+ * acknowledged before the transactions it depends on.
+ *
+ * read_cid is capped at the greatest commit id logged so far : no commit
+ * above it can have been read, and commit ids that were never logged (e.g.
+ * clock based begin cids on an idle system) would never be flushed.
+ */
+void LogManager::AcknowledgeCommit(cid_t read_cid, std::function<void()> ack) {
+  cid_t commit_id = std::max(std::min(read_cid, max_logged_commit_id_.load()),
+                             pending_commit_id);
+  pending_commit_id = INVALID_CID;
+
+  if (pipelined_commit_ == false || syncronization_commit == false ||
+      this->IsInLoggingMode() == false) {
+    ack();
+    return;
+  }
+
+  cid_t persistent_commit_id = GetPersistentFlushedCommitId();
+  if (persistent_commit_id != INVALID_CID && persistent_commit_id >= commit_id) {
+    ack();
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(pending_commits_mutex_);
+    pending_commits_.emplace(commit_id, std::move(ack));
+  }
+
+  // the flush may have happened in between
+  AcknowledgeDurableCommits();
+}
+
+void LogManager::AcknowledgeDurableCommits() {
+  std::vector<std::function<void()>> acks;
+  {
+    std::lock_guard<std::mutex> lock(pending_commits_mutex_);
+    if (pending_commits_.empty()) {
+      return;
+    }
+
+    cid_t persistent_commit_id = GetPersistentFlushedCommitId();
+    if (persistent_commit_id == INVALID_CID) {
+      return;
+    }
+
+    auto end = pending_commits_.upper_bound(persistent_commit_id);
+    for (auto itr = pending_commits_.begin(); itr != end; ++itr) {
+      acks.push_back(std::move(itr->second));
+    }
+    pending_commits_.erase(pending_commits_.begin(), end);
+  }
+
+  // run outside of the latch, acks may talk to the clients
+  for (auto &ack : acks) {
+    ack();
+  }
+}
+
+/**
+ * @brief Acknowledge the last transaction of the calling thread like
+ * AcknowledgeCommit, but let the layer replying to the client wait for it
+ * with WaitForDeferredAcknowledgement.
+ *
+ * Commit ids are flushed in order, so when several commits are deferred
+ * before the reply, waiting for the last one covers the others.
+ */
+void LogManager::DeferCommitAcknowledgement(cid_t read_cid) {
+  // shared with the thread running the ack
+  auto acked = std::make_shared<std::promise<void>>();
+  deferred_ack = acked->get_future().share();
+
+  AcknowledgeCommit(read_cid, [acked] { acked->set_value(); });
+}
+
+void LogManager::WaitForDeferredAcknowledgement() {
+  if (deferred_ack.valid() == false) {
+    return;
+  }
+
+  deferred_ack.wait();
+  deferred_ack = std::shared_future<void>();
+}
+
+size_t LogManager::GetPendingCommitCount() {
+  std::lock_guard<std::mutex> lock(pending_commits_mutex_);
+  return pending_commits_.size();
 }
 
 void LogManager::WaitForFlush(cid_t cid) {
@@ -12,6 +12,8 @@
 
 #pragma once
 
+#include <atomic>
+#include <functional>
 #include <mutex>
 #include <map>
 #include <vector>
@@ -127,6 +129,16 @@ class LogManager {
   // get the status of sychronus commit
   bool GetSyncCommit(void) const { return syncronization_commit; }
 
+  // Whether to pipeline synchronous commits ? The versions of a transaction
+  // are visible before its commit record is flushed, and the reply to the
+  // client is held afterwards instead (see
+  // TransactionManager::CommitTransaction)
+  void SetPipelinedCommit(bool pipelined_commit) {
+    pipelined_commit_ = pipelined_commit;
+  }
+
+  bool GetPipelinedCommit(void) const { return pipelined_commit_; }
+
   // returns true if a frontend logger is active
   bool ContainsFrontendLogger(void);
 
@@ -180,12 +192,40 @@ class LogManager {
   // log an insert
   void LogInsert(cid_t commit_id, const ItemPointer &new_location);
 
+  // log the inserts of a transaction into a tile group, the tuple slots
+  // are sorted. Consecutive slots share a single record when write ahead
+  // logging.
+  void LogInserts(cid_t commit_id, oid_t tile_group_id,
+                  const std::vector<oid_t> &tuple_slots);
+
   // log a delete
   void LogDelete(cid_t commit_id, const ItemPointer &delete_location);
 
   // commit a transaction and wait until stable
+  // (only remember the commit id in pipelined commit mode)
   void LogCommitTransaction(cid_t commit_id);
 
+  // acknowledge the last transaction of this thread once it is durable.
+  // read_cid is the commit id up to which the transaction could have read
+  // (its begin commit id) : the transaction depends on every commit below it.
+  // ack is run immediately if the commit is already durable, otherwise by the
+  // first thread observing the flush
+  void AcknowledgeCommit(cid_t read_cid, std::function<void()> ack);
+
+  // acknowledge the last transaction of this thread without waiting, the
+  // wait is left to WaitForDeferredAcknowledgement
+  void DeferCommitAcknowledgement(cid_t read_cid);
+
+  // block until the commits deferred by this thread are acknowledged, called
+  // before replying to the client
+  void WaitForDeferredAcknowledgement();
+
+  // run the acknowledgements of the commits that are now durable
+  void AcknowledgeDurableCommits();
+
+  // number of acknowledgements still waiting for a flush
+  size_t GetPendingCommitCount();
+
   // used by the checkpointer to truncate unneeded log files
   void TruncateLogs(txn_id_t commit_id);
 
@@ -287,6 +327,18 @@ class LogManager {
   bool syncronization_commit =
       true;  // default should be true because it is safest
 
+  // defer the acknowledgement of synchronous commits
+  bool pipelined_commit_ = false;
+
+  // acknowledgements waiting for a flush, ordered by the commit id they
+  // depend on
+  std::multimap<cid_t, std::function<void()>> pending_commits_;
+
+  std::mutex pending_commits_mutex_;
+
+  // greatest commit id of a transaction that started logging its commit
+  std::atomic<cid_t> max_logged_commit_id_{0};
+
   // name of log file (for wbl)
   std::string log_file_name;
 
@@ -51,6 +51,11 @@ LogRecord *WriteAheadBackendLogger::GetTupleRecord(
       break;
     }
 
+    case LOGRECORD_TYPE_TILE_GROUP_INSERT: {
+      log_record_type = LOGRECORD_TYPE_WAL_TILE_GROUP_INSERT;
+      break;
+    }
+
     default: {
       PL_ASSERT(false);
       break;
@@ -143,6 +143,8 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
     if (!test_mode_) {
       fwrite(log_buffer->GetData(), sizeof(char), log_buffer->GetSize(),
              cur_file_handle.file);
+      MetricsRegistry::GetInstance().Increment(log_bytes_counter_id,
+                                               log_buffer->GetSize());
     }
 
     LOG_TRACE("Log buffer get max log id returned %d",
@@ -170,6 +172,8 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
       if (cur_file_handle.fd != -1) {
         fwrite(delimiter_rec.GetMessage(), sizeof(char),
                delimiter_rec.GetMessageLength(), cur_file_handle.file);
+        MetricsRegistry::GetInstance().Increment(
+            log_bytes_counter_id, delimiter_rec.GetMessageLength());
 
         LOG_TRACE("Wrote delimiter to log file with commit_id %ld",
                  this->max_collected_commit_id);
@@ -177,9 +181,14 @@ void WriteAheadFrontendLogger::FlushLogRecords(void) {
         // by moving the fflush and sync here, we ensure that this file will
         // have at least 1 delimiter
         if (Clock::now() > last_flush + flush_frequency) {
+          auto flush_begin = Clock::now();
           LoggingUtil::FFlushFsync(cur_file_handle);
 
           last_flush = Clock::now();
+          MetricsRegistry::GetInstance().Record(
+              flush_latency_histogram_id,
+              std::chrono::duration_cast<std::chrono::microseconds>(
+                  last_flush - flush_begin).count());
           if (this->max_collected_commit_id > max_flushed_commit_id) {
             max_flushed_commit_id = this->max_collected_commit_id;
           }
@@ -305,6 +314,58 @@ void WriteAheadFrontendLogger::DoRecovery() {
         num_inserts++;
         break;
       }
+      case LOGRECORD_TYPE_WAL_TILE_GROUP_INSERT: {
+        TupleRecord tile_group_record(record_type);
+        // Check for torn log write
+        if (LoggingUtil::ReadTupleRecordHeader(tile_group_record,
+                                               cur_file_handle) == false) {
+          LOG_ERROR("Could not read tuple record header.");
+          cur_file_handle = INVALID_FILE_HANDLE;
+          return;
+        }
+
+        log_id = tile_group_record.GetTransactionId();
+        auto table = LoggingUtil::GetTable(tile_group_record);
+
+        if (!table || log_id <= start_commit_id ||
+            log_id > global_max_flushed_id_for_recovery) {
+          LoggingUtil::SkipTupleRecordBody(cur_file_handle);
+          LOG_TRACE("Skip a tile group, log id is %d", (int)log_id);
+          continue;
+        }
+
+        if (recovery_txn_table.find(log_id) == recovery_txn_table.end()) {
+          LOG_ERROR("Insert txd id %d not found in recovery txn table",
+                    (int)log_id);
+          cur_file_handle = INVALID_FILE_HANDLE;
+          return;
+        }
+
+        std::vector<storage::Tuple *> tuples;
+        if (LoggingUtil::ReadTileGroupRecordBody(
+                table->GetSchema(), recovery_pool, cur_file_handle,
+                tuples) == false) {
+          for (auto tuple : tuples) delete tuple;
+          cur_file_handle = INVALID_FILE_HANDLE;
+          return;
+        }
+
+        // Replay the record as the inserts of its consecutive slots
+        auto insert_location = tile_group_record.GetInsertLocation();
+        for (oid_t tuple_itr = 0; tuple_itr < tuples.size(); tuple_itr++) {
+          tuple_record = new TupleRecord(
+              LOGRECORD_TYPE_WAL_TUPLE_INSERT, log_id,
+              tile_group_record.GetTableId(),
+              ItemPointer(insert_location.block,
+                          insert_location.offset + tuple_itr),
+              INVALID_ITEMPOINTER, nullptr,
+              tile_group_record.GetDatabaseOid());
+          tuple_record->SetTuple(tuples[tuple_itr]);
+          recovery_txn_table[log_id].push_back(tuple_record);
+        }
+        num_inserts += tuples.size();
+        continue;
+      }
       case LOGRECORD_TYPE_WAL_TUPLE_DELETE: {
         tuple_record = new TupleRecord(record_type);
         // Check for torn log write
@@ -1152,6 +1213,22 @@ WriteAheadFrontendLogger::ExtractMaxLogIdAndMaxDelimFromLogFileRecords(
 
         break;
       }
+      case LOGRECORD_TYPE_WAL_TILE_GROUP_INSERT: {
+        TupleRecord tile_group_record(record_type);
+
+        if (LoggingUtil::ReadTupleRecordHeader(tile_group_record,
+                                               file_handle) == false) {
+          LOG_ERROR("Could not read tuple record header.");
+          return std::pair<cid_t, cid_t>(UINT64_MAX, UINT64_MAX);
+        }
+
+        auto cid = tile_group_record.GetTransactionId();
+
+        if (cid > max_log_id_so_far) max_log_id_so_far = cid;
+
+        LoggingUtil::SkipTupleRecordBody(file_handle);
+        break;
+      }
       case LOGRECORD_TYPE_WAL_TUPLE_DELETE: {
         tuple_record = new TupleRecord(record_type);
 
@@ -12,6 +12,7 @@
 
 #include <sys/stat.h>
 #include <sys/mman.h>
+#include <chrono>
 
 #include "backend/common/exception.h"
 #include "backend/catalog/manager.h"
@@ -90,11 +91,17 @@ void WriteBehindFrontendLogger::FlushLogRecords(void) {
 	if (!fwrite(&record, sizeof(WriteBehindLogRecord), 1, log_file)){
 		LOG_ERROR("Unable to write log record");
 	}
+	auto &metrics = MetricsRegistry::GetInstance();
+	metrics.Increment(log_bytes_counter_id, sizeof(WriteBehindLogRecord));
 
 	// for now fsync every time because the cost is relatively low
+	auto flush_begin = std::chrono::steady_clock::now();
 	if (fsync(log_file_fd)){
 		LOG_ERROR("Unable to fsync log");
 	}
+	metrics.Record(flush_latency_histogram_id,
+	               std::chrono::duration_cast<std::chrono::microseconds>(
+	                   std::chrono::steady_clock::now() - flush_begin).count());
 
 	// inform backend loggers they can proceed if waiting for sync
 	max_flushed_commit_id = max_collected_commit_id;
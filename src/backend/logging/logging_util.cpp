@@ -218,6 +218,37 @@ storage::Tuple *LoggingUtil::ReadTupleRecordBody(catalog::Schema *schema,
   return tuple;
 }
 
+bool LoggingUtil::ReadTileGroupRecordBody(
+    catalog::Schema *schema, VarlenPool *pool, FileHandle &file_handle,
+    std::vector<storage::Tuple *> &tuples) {
+  // Check if the frame is broken
+  size_t body_size = GetNextFrameSize(file_handle);
+  if (body_size == 0) {
+    LOG_ERROR("Body size is zero ");
+    return false;
+  }
+
+  // Read Body, which can hold a whole tile group
+  std::unique_ptr<char[]> body(new char[body_size]);
+  int ret = fread(body.get(), 1, body_size, file_handle.file);
+  if (ret <= 0) {
+    LOG_ERROR("Error occured in fread ");
+    return false;
+  }
+
+  CopySerializeInputBE record_body(body.get(), body_size);
+  record_body.ReadInt();
+  int tuple_count = record_body.ReadInt();
+
+  for (int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    storage::Tuple *tuple = new storage::Tuple(schema, true);
+    tuple->DeserializeFrom(record_body, pool);
+    tuples.push_back(tuple);
+  }
+
+  return true;
+}
+
 void LoggingUtil::SkipTupleRecordBody(FileHandle &file_handle) {
   // Check if the frame is broken
   size_t body_size = GetNextFrameSize(file_handle);
@@ -52,6 +52,12 @@ class LoggingUtil {
                                              VarlenPool *pool,
                                              FileHandle &file_handle);
 
+  // Read the tuples of a tile group insert record
+  static bool ReadTileGroupRecordBody(catalog::Schema *schema,
+                                      VarlenPool *pool,
+                                      FileHandle &file_handle,
+                                      std::vector<storage::Tuple *> &tuples);
+
   static void SkipTupleRecordBody(FileHandle &file_handle);
 
   static int GetFileSizeFromFileName(const char *);
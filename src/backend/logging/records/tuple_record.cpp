@@ -38,6 +38,19 @@ bool TupleRecord::Serialize(CopySerializeOutput &output) {
       break;
     }
 
+    case LOGRECORD_TYPE_WAL_TILE_GROUP_INSERT: {
+      // The tuples of consecutive slots, starting at the insert location
+      auto tuples = (const std::vector<storage::Tuple *> *)data;
+      size_t start = output.ReserveBytes(sizeof(int32_t));
+      output.WriteInt(static_cast<int32_t>(tuples->size()));
+      for (auto tuple : *tuples) {
+        tuple->SerializeTo(output);
+      }
+      output.WriteIntAt(start, static_cast<int32_t>(output.Position() - start -
+                                                    sizeof(int32_t)));
+      break;
+    }
+
     case LOGRECORD_TYPE_WAL_TUPLE_DELETE:
       // Nothing to do here !
       break;
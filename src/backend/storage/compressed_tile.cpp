@@ -0,0 +1,416 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_tile.cpp
+//
+// Identification: src/backend/storage/compressed_tile.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <map>
+#include <sstream>
+
+#include "backend/common/exception.h"
+#include "backend/common/logger.h"
+#include "backend/common/value_factory.h"
+#include "backend/common/value_peeker.h"
+#include "backend/storage/compressed_tile.h"
+#include "backend/storage/tile_group.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Bit packing helpers
+//===--------------------------------------------------------------------===//
+
+// Number of bits needed to represent the given value
+static uint8_t GetBitWidth(uint64_t value) {
+  uint8_t bit_width = 0;
+  while (value != 0) {
+    bit_width++;
+    value >>= 1;
+  }
+  return bit_width;
+}
+
+static void PackValue(std::vector<uint64_t> &words, const uint8_t bit_width,
+                      const oid_t offset, const uint64_t value) {
+  if (bit_width == 0) return;
+
+  uint64_t bit_offset = static_cast<uint64_t>(offset) * bit_width;
+  size_t word_offset = bit_offset >> 6;
+  uint32_t shift = bit_offset & 63;
+
+  words[word_offset] |= value << shift;
+  if (shift + bit_width > 64) {
+    words[word_offset + 1] |= value >> (64 - shift);
+  }
+}
+
+static uint64_t UnpackValue(const std::vector<uint64_t> &words,
+                            const uint8_t bit_width, const oid_t offset) {
+  if (bit_width == 0) return 0;
+
+  uint64_t bit_offset = static_cast<uint64_t>(offset) * bit_width;
+  size_t word_offset = bit_offset >> 6;
+  uint32_t shift = bit_offset & 63;
+
+  uint64_t value = words[word_offset] >> shift;
+  if (shift + bit_width > 64) {
+    value |= words[word_offset + 1] << (64 - shift);
+  }
+
+  if (bit_width == 64) return value;
+  return value & ((1ULL << bit_width) - 1);
+}
+
+static size_t GetPackedWordCount(const uint8_t bit_width,
+                                 const oid_t value_count) {
+  return (static_cast<uint64_t>(bit_width) * value_count + 63) / 64;
+}
+
+//===--------------------------------------------------------------------===//
+// Integral value helpers (FOR)
+//===--------------------------------------------------------------------===//
+
+static bool IsFrameOfReferenceType(const ValueType value_type) {
+  switch (value_type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static int64_t GetIntegralValue(const Value &value) {
+  switch (value.GetValueType()) {
+    case VALUE_TYPE_TINYINT:
+      return ValuePeeker::PeekTinyInt(value);
+    case VALUE_TYPE_SMALLINT:
+      return ValuePeeker::PeekSmallInt(value);
+    case VALUE_TYPE_INTEGER:
+      return ValuePeeker::PeekInteger(value);
+    case VALUE_TYPE_BIGINT:
+      return ValuePeeker::PeekBigInt(value);
+    case VALUE_TYPE_DATE:
+      return ValuePeeker::PeekDate(value);
+    case VALUE_TYPE_TIMESTAMP:
+      return ValuePeeker::PeekTimestamp(value);
+    default:
+      throw UnknownTypeException(value.GetValueType(),
+                                 "not an integral type");
+  }
+}
+
+static Value GetIntegralValue(const ValueType value_type,
+                              const int64_t value) {
+  switch (value_type) {
+    case VALUE_TYPE_TINYINT:
+      return ValueFactory::GetTinyIntValue(static_cast<int8_t>(value));
+    case VALUE_TYPE_SMALLINT:
+      return ValueFactory::GetSmallIntValue(static_cast<int16_t>(value));
+    case VALUE_TYPE_INTEGER:
+      return ValueFactory::GetIntegerValue(static_cast<int32_t>(value));
+    case VALUE_TYPE_BIGINT:
+      return ValueFactory::GetBigIntValue(value);
+    case VALUE_TYPE_DATE:
+      return ValueFactory::GetDateValue(static_cast<int32_t>(value));
+    case VALUE_TYPE_TIMESTAMP:
+      return ValueFactory::GetTimestampValue(value);
+    default:
+      throw UnknownTypeException(value_type, "not an integral type");
+  }
+}
+
+// Space taken by the value in the varlen pool of a tile
+static size_t GetUninlinedLength(const Value &value, const bool is_inlined) {
+  if (is_inlined == true || value.IsNull() == true) return 0;
+  return ValuePeeker::PeekObjectLengthWithoutNull(value);
+}
+
+//===--------------------------------------------------------------------===//
+// Compressed Tile
+//===--------------------------------------------------------------------===//
+
+CompressedTile::CompressedTile(Tile *source_tile, TileGroup *tile_group)
+    : Tile(source_tile->backend_type, source_tile->tile_group_header,
+           source_tile->schema, tile_group),
+      varlen_pool_(new VarlenPool(source_tile->backend_type)) {
+  database_id = source_tile->database_id;
+  table_id = source_tile->table_id;
+  tile_group_id = source_tile->tile_group_id;
+  tile_id = source_tile->tile_id;
+  num_tuple_slots = source_tile->num_tuple_slots;
+
+  columns_.resize(column_count);
+  column_ids_by_offset_.resize(tuple_length, INVALID_OID);
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    EncodeColumn(source_tile, column_itr);
+    column_ids_by_offset_[schema.GetOffset(column_itr)] = column_itr;
+  }
+
+  LOG_TRACE("Compressed tile %u from %lu to %lu bytes", tile_id,
+            source_tile->GetSize(), compressed_size_);
+}
+
+CompressedTile::~CompressedTile() {}
+
+void CompressedTile::EncodeColumn(Tile *source_tile, const oid_t column_id) {
+  auto &column = columns_[column_id];
+  column.value_type = schema.GetType(column_id);
+  column.is_inlined = schema.IsInlined(column_id);
+  column.column_offset = schema.GetOffset(column_id);
+  column.column_length = schema.GetLength(column_id);
+
+  // First, gather the column and its statistics
+  std::vector<Value> values;
+  values.reserve(num_tuple_slots);
+  std::map<Value, oid_t, Value::ltValue> distinct_values;
+  oid_t run_count = 0;
+  bool has_nulls = false;
+
+  // space taken by uninlined values, in total, per distinct value and per run
+  size_t uninlined_size = 0, distinct_uninlined_size = 0,
+         run_uninlined_size = 0;
+
+  for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+    values.push_back(source_tile->GetValue(tuple_itr, column_id));
+    auto &value = values.back();
+    auto value_length = GetUninlinedLength(value, column.is_inlined);
+
+    uninlined_size += value_length;
+    if (value.IsNull()) has_nulls = true;
+    if (tuple_itr == 0 || value.Compare(values[tuple_itr - 1]) != 0) {
+      run_count++;
+      run_uninlined_size += value_length;
+    }
+    if (distinct_values.insert(std::make_pair(value, 0)).second == true) {
+      distinct_uninlined_size += value_length;
+    }
+  }
+
+  oid_t distinct_count = distinct_values.size();
+  uint8_t code_width = GetBitWidth(distinct_count - 1);
+
+  // Then, estimate the size of each encoding and pick the smallest one
+  size_t none_size = num_tuple_slots * column.column_length + uninlined_size;
+  size_t rle_size =
+      run_count * (sizeof(Value) + sizeof(oid_t)) + run_uninlined_size;
+  size_t dictionary_size =
+      distinct_count * sizeof(Value) + distinct_uninlined_size +
+      GetPackedWordCount(code_width, num_tuple_slots) * sizeof(uint64_t);
+
+  int64_t min_value = 0, max_value = 0;
+  size_t for_size = none_size;
+  bool use_for = (num_tuple_slots > 0) && (has_nulls == false) &&
+                 IsFrameOfReferenceType(column.value_type);
+  if (use_for) {
+    min_value = GetIntegralValue(distinct_values.begin()->first);
+    max_value = GetIntegralValue(distinct_values.rbegin()->first);
+    uint64_t range = static_cast<uint64_t>(max_value) -
+                     static_cast<uint64_t>(min_value);
+    for_size = GetPackedWordCount(GetBitWidth(range), num_tuple_slots) *
+               sizeof(uint64_t);
+  }
+
+  column.compression_type = COMPRESSION_TYPE_NONE;
+  size_t best_size = none_size;
+  if (use_for && for_size < best_size) {
+    column.compression_type = COMPRESSION_TYPE_FOR;
+    best_size = for_size;
+  }
+  if (dictionary_size < best_size) {
+    column.compression_type = COMPRESSION_TYPE_DICTIONARY;
+    best_size = dictionary_size;
+  }
+  if (rle_size < best_size) {
+    column.compression_type = COMPRESSION_TYPE_RLE;
+    best_size = rle_size;
+  }
+
+  // Finally, encode the column
+  switch (column.compression_type) {
+    case COMPRESSION_TYPE_DICTIONARY: {
+      // Assign codes in value order
+      oid_t code = 0;
+      for (auto &entry : distinct_values) {
+        entry.second = code++;
+        column.dictionary.push_back(
+            ValueFactory::Clone(entry.first, varlen_pool_.get()));
+      }
+
+      column.bit_width = code_width;
+      column.packed.resize(GetPackedWordCount(code_width, num_tuple_slots), 0);
+      for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+        PackValue(column.packed, code_width, tuple_itr,
+                  distinct_values[values[tuple_itr]]);
+      }
+    } break;
+
+    case COMPRESSION_TYPE_FOR: {
+      column.base = min_value;
+      column.bit_width = GetBitWidth(static_cast<uint64_t>(max_value) -
+                                     static_cast<uint64_t>(min_value));
+      column.packed.resize(
+          GetPackedWordCount(column.bit_width, num_tuple_slots), 0);
+      for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+        uint64_t delta =
+            static_cast<uint64_t>(GetIntegralValue(values[tuple_itr])) -
+            static_cast<uint64_t>(min_value);
+        PackValue(column.packed, column.bit_width, tuple_itr, delta);
+      }
+    } break;
+
+    case COMPRESSION_TYPE_RLE: {
+      for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+        if (tuple_itr == 0 ||
+            values[tuple_itr].Compare(values[tuple_itr - 1]) != 0) {
+          if (tuple_itr != 0) column.run_ends.push_back(tuple_itr);
+          column.dictionary.push_back(
+              ValueFactory::Clone(values[tuple_itr], varlen_pool_.get()));
+        }
+      }
+      column.run_ends.push_back(num_tuple_slots);
+    } break;
+
+    case COMPRESSION_TYPE_NONE:
+    default: {
+      const bool is_in_bytes = false;
+      size_t column_length = schema.GetAppropriateLength(column_id);
+
+      column.raw.resize(num_tuple_slots * column.column_length, 0);
+      for (oid_t tuple_itr = 0; tuple_itr < num_tuple_slots; tuple_itr++) {
+        char *field_location =
+            column.raw.data() + tuple_itr * column.column_length;
+        values[tuple_itr].SerializeToTupleStorageAllocateForObjects(
+            field_location, column.is_inlined, column_length, is_in_bytes,
+            varlen_pool_.get());
+      }
+    } break;
+  }
+
+  compressed_size_ += best_size;
+}
+
+Value CompressedTile::DecodeValue(const oid_t tuple_offset,
+                                  const CompressedColumn &column) const {
+  switch (column.compression_type) {
+    case COMPRESSION_TYPE_DICTIONARY:
+      return column.dictionary[UnpackValue(column.packed, column.bit_width,
+                                           tuple_offset)];
+
+    case COMPRESSION_TYPE_FOR: {
+      uint64_t delta =
+          UnpackValue(column.packed, column.bit_width, tuple_offset);
+      return GetIntegralValue(
+          column.value_type,
+          static_cast<int64_t>(static_cast<uint64_t>(column.base) + delta));
+    }
+
+    case COMPRESSION_TYPE_RLE: {
+      auto run_itr = std::upper_bound(column.run_ends.begin(),
+                                      column.run_ends.end(), tuple_offset);
+      return column.dictionary[run_itr - column.run_ends.begin()];
+    }
+
+    case COMPRESSION_TYPE_NONE:
+    default: {
+      const char *field_location =
+          column.raw.data() + tuple_offset * column.column_length;
+      return Value::InitFromTupleStorage(field_location, column.value_type,
+                                         column.is_inlined);
+    }
+  }
+}
+
+Value CompressedTile::GetValue(const oid_t tuple_offset,
+                               const oid_t column_id) {
+  PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  PL_ASSERT(column_id < column_count);
+
+  return DecodeValue(tuple_offset, columns_[column_id]);
+}
+
+Value CompressedTile::GetValueFast(const oid_t tuple_offset,
+                                   const size_t column_offset,
+                                   UNUSED_ATTRIBUTE const ValueType column_type,
+                                   UNUSED_ATTRIBUTE const bool is_inlined) {
+  PL_ASSERT(tuple_offset < GetAllocatedTupleCount());
+  PL_ASSERT(column_offset < column_ids_by_offset_.size());
+
+  oid_t column_id = column_ids_by_offset_[column_offset];
+  if (column_id == INVALID_OID) {
+    throw Exception("No column at offset " + std::to_string(column_offset) +
+                    " in compressed tile " + std::to_string(tile_id));
+  }
+
+  return DecodeValue(tuple_offset, columns_[column_id]);
+}
+
+oid_t CompressedTile::GetCodeCount(const oid_t column_id) const {
+  auto &column = columns_[column_id];
+
+  switch (column.compression_type) {
+    case COMPRESSION_TYPE_DICTIONARY:
+    case COMPRESSION_TYPE_RLE:
+      return column.dictionary.size();
+    default:
+      return 0;
+  }
+}
+
+oid_t CompressedTile::GetCode(const oid_t tuple_offset,
+                              const oid_t column_id) const {
+  auto &column = columns_[column_id];
+
+  switch (column.compression_type) {
+    case COMPRESSION_TYPE_DICTIONARY:
+      return UnpackValue(column.packed, column.bit_width, tuple_offset);
+    case COMPRESSION_TYPE_RLE: {
+      auto run_itr = std::upper_bound(column.run_ends.begin(),
+                                      column.run_ends.end(), tuple_offset);
+      return run_itr - column.run_ends.begin();
+    }
+    default:
+      return INVALID_OID;
+  }
+}
+
+//===--------------------------------------------------------------------===//
+// Utilities
+//===--------------------------------------------------------------------===//
+
+const std::string CompressedTile::GetInfo() const {
+  std::ostringstream os;
+
+  os << "\t-----------------------------------------------------------\n";
+
+  os << "\tCOMPRESSED TILE\n";
+  os << "\tCatalog ::"
+     << " DB: " << database_id << " Table: " << table_id
+     << " Tile Group:  " << tile_group_id << " Tile:  " << tile_id << "\n";
+
+  os << "\tCompressed size : " << compressed_size_ << " bytes\n";
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    os << "\tColumn " << column_itr << " : "
+       << CompressionTypeToString(columns_[column_itr].compression_type)
+       << "\n";
+  }
+
+  os << "\t-----------------------------------------------------------\n";
+
+  return os.str();
+}
+
+}  // End storage namespace
+}  // End peloton namespace
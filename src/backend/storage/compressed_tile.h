@@ -0,0 +1,137 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_tile.h
+//
+// Identification: src/backend/storage/compressed_tile.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "backend/storage/tile.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Compressed Tile
+//===--------------------------------------------------------------------===//
+
+/**
+ * An immutable, column-wise compressed copy of a tile.
+ *
+ * Each column picks the smallest of the following encodings :
+ *
+ *  NONE       : fixed-length values, as in a regular tile
+ *  DICTIONARY : sorted distinct values + bit-packed codes
+ *  FOR        : frame of reference + bit-packed offsets (integers only)
+ *  RLE        : run values + run end offsets
+ *
+ * Compressed tiles are only built by the freezer for tile groups without
+ * active versions (see DataTable::CompressTileGroup). They are read through
+ * the GetValue/GetValueFast of this class, the callers checking
+ * Tile::IsCompressed once per tile, and never written. There is no raw tuple
+ * storage, so GetTupleLocation and TupleIterator do not apply.
+ */
+class CompressedTile : public Tile {
+  CompressedTile() = delete;
+  CompressedTile(CompressedTile const &) = delete;
+
+ public:
+  // Encode the contents of the source tile. The compressed tile belongs to
+  // the given tile group.
+  CompressedTile(Tile *source_tile, TileGroup *tile_group);
+
+  ~CompressedTile();
+
+  //===--------------------------------------------------------------------===//
+  // Operations
+  //===--------------------------------------------------------------------===//
+
+  Value GetValue(const oid_t tuple_offset, const oid_t column_id);
+
+  Value GetValueFast(const oid_t tuple_offset, const size_t column_offset,
+                     const ValueType column_type, const bool is_inlined);
+
+  //===--------------------------------------------------------------------===//
+  // Encoded access
+  //===--------------------------------------------------------------------===//
+
+  CompressionType GetCompressionType(const oid_t column_id) const {
+    return columns_[column_id].compression_type;
+  }
+
+  // Number of distinct codes of a DICTIONARY or RLE column (0 otherwise).
+  // Tuples with the same code have the same value, so a predicate on this
+  // column only has to be evaluated once per code.
+  oid_t GetCodeCount(const oid_t column_id) const;
+
+  // Code (dictionary entry or run) of the value in the given slot
+  oid_t GetCode(const oid_t tuple_offset, const oid_t column_id) const;
+
+  // Space occupied by the encoded columns
+  size_t GetCompressedSize() const { return compressed_size_; }
+
+  // Get a string representation for debugging
+  const std::string GetInfo() const;
+
+ private:
+  struct CompressedColumn {
+    CompressionType compression_type = COMPRESSION_TYPE_NONE;
+
+    ValueType value_type = VALUE_TYPE_INVALID;
+
+    bool is_inlined = true;
+
+    // offset and length in an uncompressed tuple slot
+    size_t column_offset = 0;
+
+    size_t column_length = 0;
+
+    // DICTIONARY : distinct values, RLE : value of each run
+    std::vector<Value> dictionary;
+
+    // DICTIONARY : codes, FOR : offsets from the base value
+    std::vector<uint64_t> packed;
+
+    uint8_t bit_width = 0;
+
+    // FOR : smallest value in the column
+    int64_t base = 0;
+
+    // RLE : end offset (exclusive) of each run
+    std::vector<oid_t> run_ends;
+
+    // NONE : fixed-length values
+    std::vector<char> raw;
+  };
+
+  void EncodeColumn(Tile *source_tile, const oid_t column_id);
+
+  Value DecodeValue(const oid_t tuple_offset,
+                    const CompressedColumn &column) const;
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  std::vector<CompressedColumn> columns_;
+
+  // column at each offset in an uncompressed tuple slot, for GetValueFast
+  std::vector<oid_t> column_ids_by_offset_;
+
+  // storage pool for uninlined dictionary and raw values
+  std::unique_ptr<VarlenPool> varlen_pool_;
+
+  size_t compressed_size_ = 0;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
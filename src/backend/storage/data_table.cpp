@@ -10,7 +10,9 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <mutex>
+#include <set>
 #include <utility>
 
 #include "backend/benchmark/hyadapt/hyadapt_configuration.h"
@@ -25,11 +27,14 @@
 #include "backend/gc/gc_manager_factory.h"
 #include "backend/index/index.h"
 #include "backend/logging/log_manager.h"
+#include "backend/storage/table_stats.h"
 #include "backend/storage/tile_group.h"
 #include "backend/storage/tuple.h"
 #include "backend/storage/tile.h"
+#include "backend/storage/compressed_tile.h"
 #include "backend/storage/tile_group_header.h"
 #include "backend/storage/tile_group_factory.h"
+#include "backend/storage/zone_map.h"
 #include "backend/storage/abstract_table.h"
 #include "backend/storage/database.h"
 #include "backend/storage/data_table.h"
@@ -141,6 +146,10 @@ ItemPointer DataTable::GetEmptyTupleSlot(const storage::Tuple *tuple,
   auto &gc_manager = gc::GCManagerFactory::GetInstance();
   auto free_item_pointer = gc_manager.ReturnFreeSlot(this->table_oid);
   if (free_item_pointer.IsNull() == false) {
+    auto &manager = catalog::Manager::GetInstance();
+    auto tile_group = manager.GetTileGroup(free_item_pointer.block);
+    tile_group->CopyTuple(tuple, free_item_pointer.offset);
+    tile_group->GetHeader()->ReleaseRecycledSlot();
     return free_item_pointer;
   }
   //====================================================
@@ -189,7 +198,7 @@ ItemPointer DataTable::InsertEmptyVersion(const storage::Tuple *tuple) {
   }
 
   // Index checks and updates
-  if (InsertInSecondaryIndexes(tuple, location) == false) {
+  if (InsertInSecondaryIndexes(tuple, location, nullptr) == false) {
     LOG_TRACE("Index constraint violated");
     return INVALID_ITEMPOINTER;
   }
@@ -206,7 +215,8 @@ ItemPointer DataTable::InsertEmptyVersion(const storage::Tuple *tuple) {
   return location;
 }
 
-ItemPointer DataTable::InsertVersion(const storage::Tuple *tuple) {
+ItemPointer DataTable::InsertVersion(
+    const storage::Tuple *tuple, const std::vector<oid_t> *updated_columns) {
   // First, do integrity checks and claim a slot
   ItemPointer location = GetEmptyTupleSlot(tuple, true);
   if (location.block == INVALID_OID) {
@@ -215,7 +225,7 @@ ItemPointer DataTable::InsertVersion(const storage::Tuple *tuple) {
   }
 
   // Index checks and updates
-  if (InsertInSecondaryIndexes(tuple, location) == false) {
+  if (InsertInSecondaryIndexes(tuple, location, updated_columns) == false) {
     LOG_TRACE("Index constraint violated");
     return INVALID_ITEMPOINTER;
   }
@@ -262,6 +272,67 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
   return location;
 }
 
+bool DataTable::InsertTuples(const std::vector<const storage::Tuple *> &tuples,
+                             std::vector<ItemPointer> &locations) {
+  locations.clear();
+  locations.reserve(tuples.size());
+
+  // First, do integrity checks
+  for (auto tuple : tuples) {
+    if (CheckConstraints(tuple) == false) return false;
+  }
+
+  // Claim ranges of slots in the last tile group, the recycled slots are
+  // left to the single tuple inserts
+  size_t tuple_itr = 0;
+  while (tuple_itr < tuples.size()) {
+    auto tile_group = GetTileGroup(tile_group_count_ - 1);
+    oid_t allocated_tuple_count = tile_group->GetAllocatedTupleCount();
+    oid_t tuple_count =
+        std::min<size_t>(tuples.size() - tuple_itr, allocated_tuple_count);
+
+    oid_t inserted_count = 0;
+    oid_t first_slot =
+        tile_group->InsertTuples(&tuples[tuple_itr], tuple_count,
+                                 inserted_count);
+
+    // wait for the thread that claimed the last slot to add a tile group
+    if (first_slot == INVALID_OID) continue;
+
+    oid_t tile_group_id = tile_group->GetTileGroupId();
+    for (oid_t slot_itr = 0; slot_itr < inserted_count; slot_itr++) {
+      locations.push_back(ItemPointer(tile_group_id, first_slot + slot_itr));
+    }
+    tuple_itr += inserted_count;
+
+    // if we got the last tuple slot, then create a new tile group
+    if (first_slot + inserted_count == allocated_tuple_count) {
+      AddDefaultTileGroup();
+    }
+  }
+
+  // Index checks and updates
+  if (InsertInIndexes(tuples, locations) == false) {
+    LOG_TRACE("Index constraint violated");
+    return false;
+  }
+
+  // ForeignKey checks
+  if (HasForeignKeys() == true) {
+    for (auto tuple : tuples) {
+      if (CheckForeignKeyConstraints(tuple) == false) {
+        LOG_TRACE("ForeignKey constraint violated");
+        return false;
+      }
+    }
+  }
+
+  IncreaseNumberOfTuplesBy(tuples.size());
+  for (auto index : indexes_) index->IncreaseNumberOfTuplesBy(tuples.size());
+
+  return true;
+}
+
 /**
  * @brief Insert a tuple into all indexes. If index is primary/unique,
  * check visibility of existing
@@ -273,6 +344,10 @@ ItemPointer DataTable::InsertTuple(const storage::Tuple *tuple) {
  */
 bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
                                 ItemPointer location) {
+  // Logged before the indexes are read, so that an index added by a build
+  // either gets the entry or finds the location in the log
+  if (index_build_count_ > 0) LogIndexBuildInsert(location, false);
+
   int index_count = GetIndexCount();
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
@@ -291,8 +366,7 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
     key->SetFromTuple(tuple, indexed_columns, index->GetPool());
 
     switch (index->GetIndexType()) {
-      case INDEX_CONSTRAINT_TYPE_PRIMARY_KEY:
-      case INDEX_CONSTRAINT_TYPE_UNIQUE: {
+      case INDEX_CONSTRAINT_TYPE_PRIMARY_KEY: {
         // TODO: get unique tuple from primary index.
         // if in this index there has been a visible or uncommitted
         // <key, location> pair, this constraint is violated
@@ -302,6 +376,17 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
 
       } break;
 
+      case INDEX_CONSTRAINT_TYPE_UNIQUE: {
+        // an entry may stand for newer versions after heap-only updates
+        std::function<bool(const ItemPointer &)> chain_fn =
+            std::bind(&DataTable::IsIndexedVersionOccupied, this, index,
+                      std::placeholders::_1);
+        if (index->CondInsertEntry(key.get(), location, chain_fn) == false) {
+          return false;
+        }
+
+      } break;
+
       case INDEX_CONSTRAINT_TYPE_DEFAULT:
       default:
         index->InsertEntry(key.get(), location);
@@ -313,32 +398,141 @@ bool DataTable::InsertInIndexes(const storage::Tuple *tuple,
   return true;
 }
 
-bool DataTable::InsertInSecondaryIndexes(const storage::Tuple *tuple,
-                                         ItemPointer location) {
+/**
+ * @brief Insert a batch of tuples into all indexes. The entries of the
+ * primary/unique indexes are checked one at a time, the other indexes get
+ * the whole batch at once. The slots of the batch are not owned by the
+ * transaction yet, so they are taken as occupied by the checks, which
+ * rejects the duplicate keys within the batch.
+ *
+ * @returns True on success, false if a visible entry exists (in case of
+ *primary/unique).
+ */
+bool DataTable::InsertInIndexes(
+    const std::vector<const storage::Tuple *> &tuples,
+    const std::vector<ItemPointer> &locations) {
+  PL_ASSERT(tuples.size() == locations.size());
+
+  if (index_build_count_ > 0) {
+    for (auto &location : locations) LogIndexBuildInsert(location, false);
+  }
+
   int index_count = GetIndexCount();
   auto &transaction_manager =
       concurrency::TransactionManagerFactory::GetInstance();
 
+  std::set<ItemPointer> batch_locations(locations.begin(), locations.end());
+
   std::function<bool(const ItemPointer &)> fn =
-      std::bind(&concurrency::TransactionManager::IsOccupied,
-                &transaction_manager, std::placeholders::_1);
+      [&transaction_manager, &batch_locations](const ItemPointer &location) {
+        return (batch_locations.count(location) > 0 ||
+                transaction_manager.IsOccupied(location) == true);
+      };
+
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+
+    std::vector<std::unique_ptr<storage::Tuple>> key_tuples;
+    std::vector<const storage::Tuple *> keys;
+    key_tuples.reserve(tuples.size());
+    keys.reserve(tuples.size());
+    for (auto tuple : tuples) {
+      key_tuples.emplace_back(new storage::Tuple(index_schema, true));
+      key_tuples.back()->SetFromTuple(tuple, indexed_columns,
+                                      index->GetPool());
+      keys.push_back(key_tuples.back().get());
+    }
+
+    switch (index->GetIndexType()) {
+      case INDEX_CONSTRAINT_TYPE_PRIMARY_KEY: {
+        for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+          if (index->CondInsertEntry(keys[key_itr], locations[key_itr], fn) ==
+              false) {
+            return false;
+          }
+        }
+      } break;
+
+      case INDEX_CONSTRAINT_TYPE_UNIQUE: {
+        std::function<bool(const ItemPointer &)> chain_fn =
+            [this, index, &batch_locations](const ItemPointer &location) {
+              return (batch_locations.count(location) > 0 ||
+                      IsIndexedVersionOccupied(index, location) == true);
+            };
+        for (size_t key_itr = 0; key_itr < keys.size(); key_itr++) {
+          if (index->CondInsertEntry(keys[key_itr], locations[key_itr],
+                                     chain_fn) == false) {
+            return false;
+          }
+        }
+      } break;
+
+      case INDEX_CONSTRAINT_TYPE_DEFAULT:
+      default:
+        index->InsertEntries(keys, locations);
+        break;
+    }
+    LOG_TRACE("Index constraint check on %s passed.", index->GetName().c_str());
+  }
+
+  return true;
+}
+
+/**
+ * @brief Insert a new version into the secondary indexes.
+ *
+ * The entries of the previous version stay in the indexes. If the key of an
+ * index is not modified by the update, the new version is reached through
+ * the version chain from the entry of the previous version, so the index is
+ * not touched at all (heap-only update).
+ *
+ * @returns True on success, false if a visible entry exists in a unique index.
+ */
+bool DataTable::InsertInSecondaryIndexes(
+    const storage::Tuple *tuple, ItemPointer location,
+    const std::vector<oid_t> *updated_columns) {
+  if (index_build_count_ > 0) LogIndexBuildInsert(location, true);
+
+  int index_count = GetIndexCount();
 
   // (A) Check existence for primary/unique indexes
   // FIXME Since this is NOT protected by a lock, concurrent insert may happen.
   for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
     auto index = GetIndex(index_itr);
+    if (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) continue;
+
     auto index_schema = index->GetKeySchema();
     auto indexed_columns = index_schema->GetIndexedColumns();
+
+    // Skip the indexes whose key is not modified
+    if (updated_columns != nullptr) {
+      bool key_updated = false;
+      for (auto column_id : indexed_columns) {
+        if (std::find(updated_columns->begin(), updated_columns->end(),
+                      column_id) != updated_columns->end()) {
+          key_updated = true;
+          break;
+        }
+      }
+      if (key_updated == false) {
+        LOG_TRACE("Heap-only update on %s", index->GetName().c_str());
+        continue;
+      }
+    }
+
     std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
     key->SetFromTuple(tuple, indexed_columns, index->GetPool());
 
     switch (index->GetIndexType()) {
-      case INDEX_CONSTRAINT_TYPE_PRIMARY_KEY:
-        break;
       case INDEX_CONSTRAINT_TYPE_UNIQUE: {
         // if in this index there has been a visible or uncommitted
         // <key, location> pair, this constraint is violated
-        if (index->CondInsertEntry(key.get(), location, fn) == false) {
+        std::function<bool(const ItemPointer &)> chain_fn =
+            std::bind(&DataTable::IsIndexedVersionOccupied, this, index,
+                      std::placeholders::_1);
+        if (index->CondInsertEntry(key.get(), location, chain_fn) == false) {
           return false;
         }
       } break;
@@ -353,6 +547,86 @@ bool DataTable::InsertInSecondaryIndexes(const storage::Tuple *tuple,
   return true;
 }
 
+ItemPointer DataTable::GetNextIndexedVersion(index::Index *index,
+                                             const ItemPointer &location) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(location.block);
+  if (tile_group == nullptr) return INVALID_ITEMPOINTER;
+
+  ItemPointer next_location =
+      tile_group->GetHeader()->GetNextItemPointer(location.offset);
+  if (next_location.IsNull() == true) return INVALID_ITEMPOINTER;
+
+  auto next_tile_group = manager.GetTileGroup(next_location.block);
+  if (next_tile_group == nullptr) return INVALID_ITEMPOINTER;
+
+  // The versions must agree on the key
+  for (auto column_id : index->GetKeySchema()->GetIndexedColumns()) {
+    auto value = tile_group->GetValue(location.offset, column_id);
+    auto next_value =
+        next_tile_group->GetValue(next_location.offset, column_id);
+    if (value.Compare(next_value) != VALUE_COMPARE_EQUAL) {
+      return INVALID_ITEMPOINTER;
+    }
+  }
+
+  return next_location;
+}
+
+bool DataTable::IsIndexedVersionOccupied(index::Index *index,
+                                         ItemPointer location) {
+  auto &transaction_manager =
+      concurrency::TransactionManagerFactory::GetInstance();
+
+  while (location.IsNull() == false) {
+    if (transaction_manager.IsOccupied(location) == true) return true;
+    location = GetNextIndexedVersion(index, location);
+  }
+
+  return false;
+}
+
+/**
+ * @brief Called by the GC before the slot of a garbage version is reused.
+ * The entries of the secondary indexes pointing to the version are deleted.
+ * If the next version has the same key and was inserted by a heap-only
+ * update, it has no entry of its own, so the entry is moved to it instead.
+ */
+void DataTable::PruneSecondaryIndexEntries(const ItemPointer &location) {
+  auto &manager = catalog::Manager::GetInstance();
+  auto tile_group = manager.GetTileGroup(location.block);
+  if (tile_group == nullptr) return;
+
+  int index_count = GetIndexCount();
+  for (int index_itr = index_count - 1; index_itr >= 0; --index_itr) {
+    auto index = GetIndex(index_itr);
+    if (index->GetIndexType() == INDEX_CONSTRAINT_TYPE_PRIMARY_KEY) continue;
+
+    auto index_schema = index->GetKeySchema();
+    auto indexed_columns = index_schema->GetIndexedColumns();
+
+    std::unique_ptr<storage::Tuple> key(new storage::Tuple(index_schema, true));
+    for (oid_t key_itr = 0; key_itr < indexed_columns.size(); key_itr++) {
+      key->SetValue(key_itr, tile_group->GetValue(location.offset,
+                                                  indexed_columns[key_itr]),
+                    index->GetPool());
+    }
+
+    // Nothing to do if the version has no entry of its own
+    if (index->DeleteEntry(key.get(), location) == false) continue;
+
+    ItemPointer next_location = GetNextIndexedVersion(index, location);
+    if (next_location.IsNull() == true) continue;
+
+    // Only if the next version has no entry yet
+    index->CondInsertEntry(key.get(), next_location,
+                           [&next_location](const ItemPointer &entry) {
+      return entry.block == next_location.block &&
+             entry.offset == next_location.offset;
+    });
+  }
+}
+
 /**
  * @brief Check if all the foreign key constraints on this table
  * is satisfied by checking whether the key exist in the referred table
@@ -463,6 +737,30 @@ bool DataTable::IsDirty() const { return dirty_; }
  */
 void DataTable::ResetDirty() { dirty_ = false; }
 
+std::shared_ptr<const TableStats> DataTable::GetStats() {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  return stats_;
+}
+
+/**
+ * @brief Replace the stats of the table, the versions created from now on
+ * make them stale
+ */
+void DataTable::SetStats(std::shared_ptr<const TableStats> stats) {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  stats_ = stats;
+  analyzed_number_of_tuples_ = number_of_tuples_;
+}
+
+bool DataTable::IsStatsStale() {
+  std::lock_guard<std::mutex> lock(stats_mutex_);
+  if (stats_ == nullptr) return (number_of_tuples_ > 0);
+
+  return (number_of_tuples_ - analyzed_number_of_tuples_ >
+          STATS_REFRESH_THRESHOLD +
+              STATS_REFRESH_SCALE_FACTOR * stats_->GetTupleCount());
+}
+
 //===--------------------------------------------------------------------===//
 // TILE GROUP
 //===--------------------------------------------------------------------===//
@@ -728,6 +1026,42 @@ void DataTable::DropIndexWithOid(const oid_t &index_id) {
   }
 }
 
+void DataTable::StartIndexBuild() {
+  std::lock_guard<std::mutex> lock(index_build_mutex_);
+  index_build_count_++;
+}
+
+std::vector<std::pair<ItemPointer, bool>> DataTable::FinishIndexBuild(
+    index::Index *index) {
+  std::lock_guard<std::mutex> lock(index_build_mutex_);
+
+  // The inserts that are not logged anymore find the index in the table
+  AddIndex(index);
+
+  std::vector<std::pair<ItemPointer, bool>> locations(index_build_log_);
+  if (--index_build_count_ == 0) {
+    index_build_log_.clear();
+  }
+
+  return locations;
+}
+
+void DataTable::AbortIndexBuild() {
+  std::lock_guard<std::mutex> lock(index_build_mutex_);
+
+  if (--index_build_count_ == 0) {
+    index_build_log_.clear();
+  }
+}
+
+void DataTable::LogIndexBuildInsert(const ItemPointer &location,
+                                    const bool is_version) {
+  std::lock_guard<std::mutex> lock(index_build_mutex_);
+  if (index_build_count_ > 0) {
+    index_build_log_.emplace_back(location, is_version);
+  }
+}
+
 index::Index *DataTable::GetIndex(const oid_t &index_offset) const {
   PL_ASSERT(index_offset < indexes_.size());
   auto index = indexes_.at(index_offset);
@@ -834,6 +1168,16 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
     auto orig_tile = orig_tile_group->GetTile(orig_tile_offset);
     auto new_tile = new_tile_group->GetTile(new_tile_offset);
 
+    // Decompress the column over to the new tile group
+    if (orig_tile->IsCompressed()) {
+      auto compressed_tile = static_cast<storage::CompressedTile *>(orig_tile);
+      for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+        auto val = compressed_tile->GetValue(tuple_itr, orig_tile_column_offset);
+        new_tile->SetValue(val, tuple_itr, new_tile_column_offset);
+      }
+      continue;
+    }
+
     // Copy the column over to the new tile group
     for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
       auto val = orig_tile->GetValue(tuple_itr, orig_tile_column_offset);
@@ -841,10 +1185,7 @@ void SetTransformedTileGroup(storage::TileGroup *orig_tile_group,
     }
   }
 
-  // Finally, copy over the tile header
-  auto header = orig_tile_group->GetHeader();
-  auto new_header = new_tile_group->GetHeader();
-  *new_header = *header;
+  // The tile header is shared with the orig tile group
 }
 
 storage::TileGroup *DataTable::TransformTileGroup(
@@ -860,7 +1201,11 @@ storage::TileGroup *DataTable::TransformTileGroup(
   // Get orig tile group from catalog
   auto &catalog_manager = catalog::Manager::GetInstance();
   auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
-  auto diff = tile_group->GetSchemaDifference(default_partition_);
+  auto tile_group_header = tile_group->GetHeader();
+
+  auto default_partition = GetDefaultPartition();
+
+  auto diff = tile_group->GetSchemaDifference(default_partition);
 
   // Check threshold for transformation
   if (diff < theta) {
@@ -869,21 +1214,162 @@ storage::TileGroup *DataTable::TransformTileGroup(
 
   // Get the schema for the new transformed tile group
   auto new_schema =
-      TransformTileGroupSchema(tile_group.get(), default_partition_);
+      TransformTileGroupSchema(tile_group.get(), default_partition);
+
+  // No recycled slot can be written while the tiles are copied. The check
+  // is done again after the copy, as a tuple may have been inserted or
+  // updated in place in the meantime.
+  tile_group_header->DisableRecycling();
+  if (IsTileGroupImmutable(tile_group_offset) == false) {
+    tile_group_header->EnableRecycling();
+    return nullptr;
+  }
 
-  // Allocate space for the transformed tile group
+  // Allocate space for the transformed tile group. It shares the header of
+  // the orig tile group, so concurrent transactions keep operating on the
+  // same MVCC metadata across the swap.
   std::shared_ptr<storage::TileGroup> new_tile_group(
-      TileGroupFactory::GetTileGroup(
-          tile_group->GetDatabaseId(), tile_group->GetTableId(),
-          tile_group->GetTileGroupId(), tile_group->GetAbstractTable(),
-          new_schema, default_partition_,
-          tile_group->GetAllocatedTupleCount()));
+      TileGroupFactory::GetTransformedTileGroup(tile_group.get(), new_schema,
+                                                default_partition));
 
   // Set the transformed tile group column-at-a-time
   SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
 
+  if (IsTileGroupImmutable(tile_group_offset) == false) {
+    tile_group_header->EnableRecycling();
+    return nullptr;
+  }
+
   // Set the location of the new tile group
   // and clean up the orig tile group
+  catalog_manager.AddTileGroup(tile_group_id, new_tile_group);
+  tile_group_header->EnableRecycling();
+
+  return new_tile_group.get();
+}
+
+bool DataTable::IsTileGroupImmutable(const oid_t &tile_group_offset) {
+  if (tile_group_offset >= GetTileGroupCount()) {
+    return false;
+  }
+
+  // Rollback segment based protocols update tuples in place
+  if (concurrency::TransactionManagerFactory::GetProtocol() ==
+      CONCURRENCY_TYPE_OCC_RB) {
+    return false;
+  }
+
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group == nullptr) {
+    return false;
+  }
+
+  // No more inserts can go to this tile group
+  auto tile_group_header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  if (tile_group_header->GetCurrentNextTupleSlot() < tuple_count) {
+    return false;
+  }
+
+  // An inserting transaction may still update its own tuple in place, and
+  // a slot without a txn id is either not inserted yet or reset by the GC
+  // and about to be recycled
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (tile_group_header->GetTransactionId(tuple_itr) == INVALID_TXN_ID ||
+        tile_group_header->GetBeginCommitId(tuple_itr) == MAX_CID) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool DataTable::IsTileGroupFrozen(const oid_t &tile_group_offset) {
+  if (IsTileGroupImmutable(tile_group_offset) == false) {
+    return false;
+  }
+
+  auto tile_group = GetTileGroup(tile_group_offset);
+  if (tile_group->IsCompressed()) {
+    return false;
+  }
+
+  // All the tuples must be committed latest versions that are not owned
+  // by any transaction
+  auto tile_group_header = tile_group->GetHeader();
+  auto tuple_count = tile_group->GetAllocatedTupleCount();
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    if (tile_group_header->GetTransactionId(tuple_itr) != INITIAL_TXN_ID ||
+        tile_group_header->GetEndCommitId(tuple_itr) != MAX_CID) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+storage::TileGroup *DataTable::CompressTileGroup(
+    const oid_t &tile_group_offset) {
+  if (tile_group_offset >= GetTileGroupCount()) {
+    return nullptr;
+  }
+
+  std::lock_guard<std::mutex> lock(compression_mutex_);
+
+  auto tile_group = GetTileGroup(tile_group_offset);
+  auto tile_group_header = tile_group->GetHeader();
+  auto tile_group_id = tile_group->GetTileGroupId();
+  auto &catalog_manager = catalog::Manager::GetInstance();
+
+  // As in TransformTileGroup, no recycled slot can be written while the
+  // tiles are compressed, and the check is done again after the copy
+  tile_group_header->DisableRecycling();
+  if (IsTileGroupFrozen(tile_group_offset) == false) {
+    tile_group_header->EnableRecycling();
+    return nullptr;
+  }
+
+  // The compressed tile group shares the header of the orig tile group,
+  // so concurrent readers of either one see the same versions
+  std::shared_ptr<storage::TileGroup> new_tile_group(
+      TileGroupFactory::GetCompressedTileGroup(tile_group.get()));
+
+  if (IsTileGroupFrozen(tile_group_offset) == false) {
+    tile_group_header->EnableRecycling();
+    return nullptr;
+  }
+
+  // Set the location of the new tile group
+  // and clean up the orig tile group
+  catalog_manager.AddTileGroup(tile_group_id, new_tile_group);
+  tile_group_header->EnableRecycling();
+
+  return new_tile_group.get();
+}
+
+storage::TileGroup *DataTable::DecompressTileGroup(
+    const oid_t &tile_group_id) {
+  std::lock_guard<std::mutex> lock(compression_mutex_);
+
+  auto &catalog_manager = catalog::Manager::GetInstance();
+  auto tile_group = catalog_manager.GetTileGroup(tile_group_id);
+  if (tile_group == nullptr) {
+    return nullptr;
+  }
+
+  // Someone else got here first
+  if (tile_group->IsCompressed() == false) {
+    return tile_group.get();
+  }
+
+  // Same layout, and again the header is shared with the compressed copy
+  std::shared_ptr<storage::TileGroup> new_tile_group(
+      TileGroupFactory::GetTransformedTileGroup(tile_group.get(),
+                                                tile_group->GetTileSchemas(),
+                                                tile_group->GetColumnMap()));
+
+  SetTransformedTileGroup(tile_group.get(), new_tile_group.get());
+
   catalog_manager.AddTileGroup(tile_group_id, new_tile_group);
 
   return new_tile_group.get();
@@ -897,7 +1383,13 @@ void DataTable::RecordSample(const brain::Sample &sample) {
   }
 }
 
-const column_map_type &DataTable::GetDefaultPartition() {
+size_t DataTable::GetSampleCount() {
+  std::lock_guard<std::mutex> lock(clustering_mutex_);
+  return samples_.size();
+}
+
+column_map_type DataTable::GetDefaultPartition() {
+  std::lock_guard<std::mutex> lock(clustering_mutex_);
   return default_partition_;
 }
 
@@ -941,7 +1433,12 @@ void DataTable::UpdateDefaultPartition() {
   }
 
   // TODO: Max number of tiles
-  default_partition_ = clusterer.GetPartitioning(2);
+  auto default_partition = clusterer.GetPartitioning(2);
+
+  {
+    std::lock_guard<std::mutex> lock(clustering_mutex_);
+    default_partition_ = default_partition;
+  }
 }
 
 //===--------------------------------------------------------------------===//
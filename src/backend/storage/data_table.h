@@ -71,6 +71,7 @@ namespace storage {
 
 class Tuple;
 class TileGroup;
+class TableStats;
 
 //===--------------------------------------------------------------------===//
 // DataTable
@@ -108,9 +109,17 @@ class DataTable : public AbstractTable {
   //===--------------------------------------------------------------------===//
   // insert version in table
   ItemPointer InsertEmptyVersion(const Tuple *tuple);
-  ItemPointer InsertVersion(const Tuple *tuple);
+  // if updated_columns is given, only the secondary indexes on these columns
+  // get an entry for the new version (heap-only update)
+  ItemPointer InsertVersion(
+      const Tuple *tuple, const std::vector<oid_t> *updated_columns = nullptr);
   // insert tuple in table
   ItemPointer InsertTuple(const Tuple *tuple);
+  // insert a batch of tuples in table (bulk load). Whole ranges of slots are
+  // claimed at once and the index entries are inserted in sorted batches.
+  // Returns false if a constraint is violated.
+  bool InsertTuples(const std::vector<const Tuple *> &tuples,
+                    std::vector<ItemPointer> &locations);
 
   // delete the tuple at given location
   // bool DeleteTuple(const concurrency::Transaction *transaction,
@@ -153,6 +162,18 @@ class DataTable : public AbstractTable {
 
   oid_t GetIndexCount() const;
 
+  // While an index is being built, the locations inserted into the indexes
+  // of the table are logged, so that the build can catch up with them
+  void StartIndexBuild();
+
+  // Add the built index to the table, and return the locations logged since
+  // the build started, with whether they are new versions of a tuple
+  std::vector<std::pair<ItemPointer, bool>> FinishIndexBuild(
+      index::Index *index);
+
+  // Stop logging for a build that failed, without adding its index
+  void AbortIndexBuild();
+
   //===--------------------------------------------------------------------===//
   // FOREIGN KEYS
   //===--------------------------------------------------------------------===//
@@ -172,6 +193,21 @@ class DataTable : public AbstractTable {
   storage::TileGroup *TransformTileGroup(const oid_t &tile_group_offset,
                                          const double &theta);
 
+  // Check if the tuple data in the tile group can no longer change : it is
+  // full, has no inserts in progress, and tuples are not updated in place
+  bool IsTileGroupImmutable(const oid_t &tile_group_offset);
+
+  // Check if the tile group is immutable and all its tuples are committed
+  // latest versions that are not being modified
+  bool IsTileGroupFrozen(const oid_t &tile_group_offset);
+
+  // Replace a frozen tile group with a compressed copy
+  storage::TileGroup *CompressTileGroup(const oid_t &tile_group_offset);
+
+  // Replace a compressed tile group with an uncompressed copy, so that its
+  // slots can be reused again. Returns the tile group now in the catalog.
+  storage::TileGroup *DecompressTileGroup(const oid_t &tile_group_id);
+
   //===--------------------------------------------------------------------===//
   // STATS
   //===--------------------------------------------------------------------===//
@@ -188,7 +224,18 @@ class DataTable : public AbstractTable {
 
   void ResetDirty();
 
-  const column_map_type &GetDefaultPartition();
+  // Stats collected by the last ANALYZE, null if it was never analyzed
+  std::shared_ptr<const TableStats> GetStats();
+
+  void SetStats(std::shared_ptr<const TableStats> stats);
+
+  // Were enough versions created since the last ANALYZE ?
+  bool IsStatsStale();
+
+  column_map_type GetDefaultPartition();
+
+  // Can the layout of this table adapt to the workload ?
+  bool IsAdaptTable() const { return adapt_table_; }
 
   //===--------------------------------------------------------------------===//
   // Clustering
@@ -196,6 +243,9 @@ class DataTable : public AbstractTable {
 
   void RecordSample(const brain::Sample &sample);
 
+  // Number of samples recorded since the last partitioning update
+  size_t GetSampleCount();
+
   void UpdateDefaultPartition();
 
   //===--------------------------------------------------------------------===//
@@ -219,6 +269,20 @@ class DataTable : public AbstractTable {
   // try to insert into the indices
   bool InsertInIndexes(const storage::Tuple *tuple, ItemPointer location);
 
+  // try to insert a batch into the indices
+  bool InsertInIndexes(const std::vector<const storage::Tuple *> &tuples,
+                       const std::vector<ItemPointer> &locations);
+
+  // Get the version following the given one if it has the same key in the
+  // given index, i.e. if it is reached through the index entry of the given
+  // version. Returns INVALID_ITEMPOINTER otherwise.
+  static ItemPointer GetNextIndexedVersion(index::Index *index,
+                                           const ItemPointer &location);
+
+  // Remove the secondary index entries of a garbage version. Entries that
+  // are still needed to reach a newer version are moved to that version.
+  void PruneSecondaryIndexEntries(const ItemPointer &location);
+
   RWLock &GetTileGroupLock() { return tile_group_lock_; }
 
  protected:
@@ -247,10 +311,15 @@ class DataTable : public AbstractTable {
   // INDEX HELPERS
   //===--------------------------------------------------------------------===//
 
-
+  // Log a location for the index builds in progress
+  void LogIndexBuildInsert(const ItemPointer &location, const bool is_version);
 
   bool InsertInSecondaryIndexes(const storage::Tuple *tuple,
-                                ItemPointer location);
+                                ItemPointer location,
+                                const std::vector<oid_t> *updated_columns);
+
+  // Is any version reached through the given index entry occupied ?
+  bool IsIndexedVersionOccupied(index::Index *index, ItemPointer location);
 
   // check the foreign key constraints
   bool CheckForeignKeyConstraints(const storage::Tuple *tuple);
@@ -279,6 +348,14 @@ class DataTable : public AbstractTable {
   // INDEXES
   std::vector<index::Index *> indexes_;
 
+  // # of index builds in progress
+  std::atomic<int> index_build_count_ = ATOMIC_VAR_INIT(0);
+
+  std::mutex index_build_mutex_;
+
+  // locations inserted into the indexes during the builds
+  std::vector<std::pair<ItemPointer, bool>> index_build_log_;
+
   // CONSTRAINTS
   std::vector<catalog::ForeignKey *> foreign_keys_;
 
@@ -294,9 +371,19 @@ class DataTable : public AbstractTable {
   // dirty flag
   bool dirty_ = false;
 
+  // stats of the last ANALYZE, and the # of tuples when it ran
+  std::mutex stats_mutex_;
+
+  std::shared_ptr<const TableStats> stats_;
+
+  float analyzed_number_of_tuples_ = 0.0;
+
   // clustering mutex
   std::mutex clustering_mutex_;
 
+  // serializes compressing and decompressing tile groups
+  std::mutex compression_mutex_;
+
   // adapt table
   bool adapt_table_ = true;
 
@@ -17,6 +17,7 @@
 #include "backend/catalog/foreign_key.h"
 #include "backend/storage/database.h"
 #include "backend/storage/table_factory.h"
+#include "backend/storage/table_stats.h"
 #include "backend/common/logger.h"
 #include "backend/index/index.h"
 
@@ -91,16 +92,7 @@ oid_t Database::GetTableCount() const { return tables.size(); }
 void Database::UpdateStats() const {
   LOG_TRACE("Update All Stats in Database(%u)", database_oid);
   for (oid_t table_offset = 0; table_offset < GetTableCount(); table_offset++) {
-    auto table = GetTable(table_offset);
-    bridge::Bridge::SetNumberOfTuples(table->GetOid(),
-                                      table->GetNumberOfTuples());
-
-    for (oid_t index_offset = 0; index_offset < table->GetIndexCount();
-         index_offset++) {
-      auto index = table->GetIndex(index_offset);
-      bridge::Bridge::SetNumberOfTuples(index->GetOid(),
-                                        index->GetNumberOfTuples());
-    }
+    PublishStats(GetTable(table_offset));
   }
 }
 
@@ -109,13 +101,54 @@ void Database::UpdateStatsWithOid(const oid_t table_oid) const {
            database_oid);
 
   auto table = GetTableWithOid(table_oid);
-  bridge::Bridge::SetNumberOfTuples(table_oid, table->GetNumberOfTuples());
+  PublishStats(table);
+}
+
+oid_t Database::RefreshStats() {
+  oid_t analyzed_count = 0;
+
+  for (oid_t table_offset = 0; table_offset < GetTableCount(); table_offset++) {
+    // The table can not be dropped while it is analyzed
+    std::lock_guard<std::mutex> lock(database_mutex);
+    if (table_offset >= tables.size()) break;
+
+    auto table = tables[table_offset];
+    if (table->IsStatsStale() == false) continue;
+
+    table->SetStats(TableStats::Analyze(table));
+    analyzed_count++;
+  }
+
+  return analyzed_count;
+}
+
+void Database::PublishStats(storage::DataTable *table) const {
+  // Only sample the table again if it changed enough since the last time
+  auto stats = table->GetStats();
+  if (stats == nullptr || table->IsStatsStale() == true) {
+    stats = TableStats::Analyze(table);
+    table->SetStats(stats);
+  }
+
+  auto tuple_count = stats->GetTupleCount();
+  bridge::Bridge::SetNumberOfTuples(table->GetOid(), tuple_count,
+                                    stats->GetDataSize());
+
+  for (oid_t column_itr = 0; column_itr < stats->GetColumnCount();
+       column_itr++) {
+    bridge::Bridge::SetColumnStats(table->GetOid(), column_itr + 1,
+                                   stats->GetColumnStats(column_itr),
+                                   tuple_count);
+  }
 
   for (oid_t index_offset = 0; index_offset < table->GetIndexCount();
        index_offset++) {
     auto index = table->GetIndex(index_offset);
-    bridge::Bridge::SetNumberOfTuples(index->GetOid(),
-                                      index->GetNumberOfTuples());
+    auto entry_count = index->GetNumberOfTuples();
+    double entry_size =
+        index->GetKeySchema()->GetLength() + sizeof(ItemPointer);
+    bridge::Bridge::SetNumberOfTuples(index->GetOid(), entry_count,
+                                      entry_count * entry_size);
   }
 }
 
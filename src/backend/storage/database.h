@@ -67,6 +67,10 @@ class Database : public Printable {
 
   void UpdateStatsWithOid(const oid_t table_oid) const;
 
+  // Re-analyze the tables whose stats are stale.
+  // Returns the # of tables analyzed.
+  oid_t RefreshStats();
+
   //===--------------------------------------------------------------------===//
   // UTILITIES
   //===--------------------------------------------------------------------===//
@@ -75,6 +79,9 @@ class Database : public Printable {
   const std::string GetInfo() const;
 
  protected:
+  // Write the stats of the table and of its indexes into the catalogs
+  void PublishStats(storage::DataTable *table) const;
+
   //===--------------------------------------------------------------------===//
   // MEMBERS
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_refresher.cpp
+//
+// Identification: src/backend/storage/stats_refresher.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "backend/catalog/manager.h"
+#include "backend/common/logger.h"
+#include "backend/storage/database.h"
+#include "backend/storage/stats_refresher.h"
+
+namespace peloton {
+namespace storage {
+
+StatsRefresher &StatsRefresher::GetInstance() {
+  static StatsRefresher stats_refresher;
+  return stats_refresher;
+}
+
+void StatsRefresher::StartRefresher(const int interval_ms) {
+  std::lock_guard<std::mutex> lock(refresher_mutex_);
+  if (is_running_ == true) return;
+
+  is_running_ = true;
+  refresher_thread_ = std::thread(&StatsRefresher::Running, this, interval_ms);
+
+  LOG_INFO("Refreshing table stats every %d ms", interval_ms);
+}
+
+void StatsRefresher::StopRefresher() {
+  {
+    std::lock_guard<std::mutex> lock(refresher_mutex_);
+    if (is_running_ == false) return;
+
+    is_running_ = false;
+  }
+
+  refresher_cv_.notify_all();
+  refresher_thread_.join();
+}
+
+void StatsRefresher::Running(const int interval_ms) {
+  std::unique_lock<std::mutex> lock(refresher_mutex_);
+
+  while (is_running_ == true) {
+    refresher_cv_.wait_for(lock, std::chrono::milliseconds(interval_ms),
+                           [this] { return is_running_ == false; });
+    if (is_running_ == false) break;
+
+    // Do not hold up StopRefresher while sampling
+    lock.unlock();
+    RefreshStats();
+    lock.lock();
+  }
+}
+
+oid_t StatsRefresher::RefreshStats() {
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t analyzed_count = 0;
+
+  auto database_count = manager.GetDatabaseCount();
+  for (oid_t database_itr = 0; database_itr < database_count;
+       database_itr++) {
+    auto database = manager.GetDatabase(database_itr);
+    analyzed_count += database->RefreshStats();
+  }
+
+  return analyzed_count;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,74 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// stats_refresher.h
+//
+// Identification: src/backend/storage/stats_refresher.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "backend/common/types.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Stats Refresher
+//===--------------------------------------------------------------------===//
+
+/**
+ * Background service that re-analyzes the tables whose stats are stale
+ * (see DataTable::IsStatsStale).
+ *
+ * The stats are only kept in the tables, ANALYZE and VACUUM write them into
+ * the postgres catalogs without sampling the fresh tables again.
+ */
+class StatsRefresher {
+ public:
+  StatsRefresher(const StatsRefresher &) = delete;
+  StatsRefresher &operator=(const StatsRefresher &) = delete;
+  StatsRefresher(StatsRefresher &&) = delete;
+  StatsRefresher &operator=(StatsRefresher &&) = delete;
+
+  StatsRefresher() {}
+
+  ~StatsRefresher() { StopRefresher(); }
+
+  // global singleton
+  static StatsRefresher &GetInstance();
+
+  void StartRefresher(const int interval_ms);
+
+  void StopRefresher();
+
+  // Do a single pass over all the tables, returns the number of tables
+  // analyzed
+  oid_t RefreshStats();
+
+ private:
+  void Running(const int interval_ms);
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  std::thread refresher_thread_;
+
+  std::mutex refresher_mutex_;
+
+  std::condition_variable refresher_cv_;
+
+  bool is_running_ = false;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,240 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.cpp
+//
+// Identification: src/backend/storage/table_stats.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <algorithm>
+#include <random>
+
+#include "backend/storage/table_stats.h"
+#include "backend/catalog/schema.h"
+#include "backend/common/hyperloglog.h"
+#include "backend/common/logger.h"
+#include "backend/common/value_peeker.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_header.h"
+
+namespace peloton {
+namespace storage {
+
+// Is the version committed and not yet deleted or updated ?
+static bool IsLiveVersion(const TileGroupHeader *tile_group_header,
+                          const oid_t tuple_id) {
+  return (tile_group_header->GetTransactionId(tuple_id) == INITIAL_TXN_ID &&
+          tile_group_header->GetEndCommitId(tuple_id) == MAX_CID);
+}
+
+std::shared_ptr<const TableStats> TableStats::Analyze(
+    DataTable *table, const size_t sample_size) {
+  std::shared_ptr<TableStats> stats(new TableStats());
+  auto schema = table->GetSchema();
+  oid_t column_count = schema->GetColumnCount();
+
+  std::vector<HyperLogLog> distinct_counters(column_count);
+  std::vector<ItemPointer> sample;
+  sample.reserve(sample_size);
+
+  std::mt19937_64 generator(std::random_device{}());
+  size_t live_count = 0;
+
+  // Scan the live versions once
+  size_t tile_group_count = table->GetTileGroupCount();
+  for (size_t tile_group_offset = 0; tile_group_offset < tile_group_count;
+       tile_group_offset++) {
+    auto tile_group = table->GetTileGroup(tile_group_offset);
+    auto tile_group_header = tile_group->GetHeader();
+    auto tile_group_id = tile_group->GetTileGroupId();
+    oid_t active_tuple_count = tile_group_header->GetCurrentNextTupleSlot();
+
+    for (oid_t tuple_id = 0; tuple_id < active_tuple_count; tuple_id++) {
+      if (IsLiveVersion(tile_group_header, tuple_id) == false) continue;
+
+      for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+        auto value = tile_group->GetValue(tuple_id, column_itr);
+        if (value.IsNull() == false) distinct_counters[column_itr].Add(value);
+      }
+
+      // Reservoir sampling : the i-th version replaces a sampled one with a
+      // probability of sample_size / i
+      if (sample.size() < sample_size) {
+        sample.push_back(ItemPointer(tile_group_id, tuple_id));
+      } else {
+        std::uniform_int_distribution<size_t> distribution(0, live_count);
+        size_t sample_offset = distribution(generator);
+        if (sample_offset < sample_size) {
+          sample[sample_offset] = ItemPointer(tile_group_id, tuple_id);
+        }
+      }
+      live_count++;
+    }
+  }
+
+  stats->tuple_count_ = live_count;
+  stats->column_stats_.resize(column_count);
+
+  // Read the sampled rows, skipping the versions that died since the scan
+  VarlenPool sample_pool(BACKEND_TYPE_MM);
+  std::vector<std::vector<Value>> column_values(column_count);
+  std::vector<double> column_widths(column_count, 0);
+  std::vector<size_t> null_counts(column_count, 0);
+  size_t sample_row_count = 0;
+
+  std::sort(sample.begin(), sample.end(),
+            [](const ItemPointer &lhs, const ItemPointer &rhs) {
+              return (lhs.block < rhs.block ||
+                      (lhs.block == rhs.block && lhs.offset < rhs.offset));
+            });
+
+  for (auto &location : sample) {
+    auto tile_group = table->GetTileGroupById(location.block);
+    if (tile_group == nullptr ||
+        IsLiveVersion(tile_group->GetHeader(), location.offset) == false) {
+      continue;
+    }
+
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      auto value = tile_group->GetValue(location.offset, column_itr);
+      if (value.IsNull() == true) {
+        null_counts[column_itr]++;
+        continue;
+      }
+
+      if (schema->IsInlined(column_itr) == true) {
+        column_widths[column_itr] += schema->GetLength(column_itr);
+      } else {
+        column_widths[column_itr] +=
+            ValuePeeker::PeekObjectLengthWithoutNull(value);
+      }
+      column_values[column_itr].push_back(
+          ValueFactory::Clone(value, &sample_pool));
+    }
+    sample_row_count++;
+  }
+
+  if (sample_row_count == 0) return stats;
+
+  // The sample holds the whole table
+  bool is_complete = (live_count <= sample_size);
+  double tuple_width = 0;
+
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column_stats = stats->column_stats_[column_itr];
+    auto &values = column_values[column_itr];
+
+    column_stats.null_fraction =
+        null_counts[column_itr] / static_cast<double>(sample_row_count);
+    if (values.empty() == false) {
+      column_stats.average_width = column_widths[column_itr] / values.size();
+    }
+    tuple_width +=
+        column_stats.average_width * (1 - column_stats.null_fraction);
+
+    stats->SetValueStats(column_stats, values, sample_row_count, is_complete);
+
+    // The distinct count of the sample is exact for the whole table
+    if (is_complete == false) {
+      double non_null_count = live_count * (1 - column_stats.null_fraction);
+      column_stats.distinct_count = std::max(
+          column_stats.distinct_count,
+          std::min(distinct_counters[column_itr].Estimate(), non_null_count));
+    }
+  }
+
+  stats->data_size_ = live_count * tuple_width;
+
+  LOG_TRACE("Analyzed %s : %lu live versions, %lu sampled",
+            table->GetName().c_str(), live_count, sample_row_count);
+
+  return stats;
+}
+
+void TableStats::SetValueStats(ColumnStats &column_stats,
+                               std::vector<Value> &values,
+                               const size_t sample_row_count,
+                               const bool is_complete) {
+  if (values.empty() == true) return;
+
+  std::sort(values.begin(), values.end(), [](const Value &lhs,
+                                             const Value &rhs) {
+    return lhs.Compare(rhs) < 0;
+  });
+
+  // Runs of equal values : (count, offset of the first value)
+  std::vector<std::pair<size_t, size_t>> runs;
+  for (size_t value_itr = 0; value_itr < values.size(); value_itr++) {
+    if (value_itr == 0 ||
+        values[value_itr].Compare(values[value_itr - 1]) != 0) {
+      runs.push_back(std::make_pair(0, value_itr));
+    }
+    runs.back().first++;
+  }
+
+  column_stats.distinct_count = runs.size();
+
+  // A value is common if it appears notably more often than the average
+  // value of the sample, as in postgres. All the values of a complete sample
+  // are kept if there are few enough of them.
+  double average_count = values.size() / static_cast<double>(runs.size());
+  double min_count = std::max(1.25 * average_count, 2.0);
+  bool keep_all = (is_complete == true && runs.size() <= STATS_TARGET);
+
+  std::vector<size_t> common_runs;
+  for (size_t run_itr = 0; run_itr < runs.size(); run_itr++) {
+    if (keep_all == true || runs[run_itr].first >= min_count) {
+      common_runs.push_back(run_itr);
+    }
+  }
+  std::stable_sort(common_runs.begin(), common_runs.end(),
+                   [&runs](const size_t lhs, const size_t rhs) {
+                     return runs[lhs].first > runs[rhs].first;
+                   });
+  if (common_runs.size() > STATS_TARGET) common_runs.resize(STATS_TARGET);
+
+  std::vector<bool> is_common(runs.size(), false);
+  for (auto run_itr : common_runs) {
+    is_common[run_itr] = true;
+    column_stats.most_common_values.push_back(
+        ValueFactory::Clone(values[runs[run_itr].second], &pool_));
+    column_stats.most_common_frequencies.push_back(
+        runs[run_itr].first / static_cast<double>(sample_row_count));
+  }
+
+  // Equi-depth histogram of the values that are not common
+  std::vector<size_t> other_offsets;
+  size_t other_run_count = 0;
+  for (size_t run_itr = 0; run_itr < runs.size(); run_itr++) {
+    if (is_common[run_itr] == true) continue;
+    other_run_count++;
+    for (size_t value_itr = 0; value_itr < runs[run_itr].first; value_itr++) {
+      other_offsets.push_back(runs[run_itr].second + value_itr);
+    }
+  }
+
+  if (other_run_count < 2) return;
+
+  // Strings are ordered by length first, which is not the order of the
+  // postgres operator the histogram is read with
+  auto value_type = values[0].GetValueType();
+  if (value_type == VALUE_TYPE_VARCHAR || value_type == VALUE_TYPE_VARBINARY) {
+    return;
+  }
+
+  size_t bound_count = std::min<size_t>(STATS_TARGET + 1, other_run_count);
+  for (size_t bound_itr = 0; bound_itr < bound_count; bound_itr++) {
+    size_t other_offset =
+        bound_itr * (other_offsets.size() - 1) / (bound_count - 1);
+    column_stats.histogram_bounds.push_back(
+        ValueFactory::Clone(values[other_offsets[other_offset]], &pool_));
+  }
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,115 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats.h
+//
+// Identification: src/backend/storage/table_stats.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "backend/common/pool.h"
+#include "backend/common/types.h"
+#include "backend/common/value.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+
+// # of most common values and of histogram buckets kept per column, as the
+// default_statistics_target of postgres
+#define STATS_TARGET 100
+
+// # of rows sampled per table, postgres samples 300 rows per target unit
+#define STATS_SAMPLE_SIZE (300 * STATS_TARGET)
+
+// The stats of a table are stale once this many versions, plus this fraction
+// of its analyzed tuples, were created. Same as the autovacuum defaults.
+#define STATS_REFRESH_THRESHOLD 50
+#define STATS_REFRESH_SCALE_FACTOR 0.1
+
+//===--------------------------------------------------------------------===//
+// Column Stats
+//===--------------------------------------------------------------------===//
+
+struct ColumnStats {
+  // fraction of the rows that are null
+  double null_fraction = 0;
+
+  // average width in bytes of the non-null values
+  int32_t average_width = 0;
+
+  // estimated # of distinct non-null values
+  double distinct_count = 0;
+
+  // most common values, with the fraction of the rows holding them
+  std::vector<Value> most_common_values;
+
+  std::vector<double> most_common_frequencies;
+
+  // bounds of an equi-depth histogram of the other non-null values, except
+  // for string columns
+  std::vector<Value> histogram_bounds;
+};
+
+//===--------------------------------------------------------------------===//
+// Table Stats
+//===--------------------------------------------------------------------===//
+
+/**
+ * @brief Statistics of a table, as collected by ANALYZE.
+ *
+ * A single scan of the live versions counts them, feeds every column to a
+ * HyperLogLog distinct count, and keeps a uniform reservoir sample of their
+ * locations. The most common values and the histograms are then computed
+ * from the sampled rows, the same way postgres computes them.
+ */
+class TableStats {
+ public:
+  TableStats(const TableStats &) = delete;
+  TableStats &operator=(const TableStats &) = delete;
+  TableStats(TableStats &&) = delete;
+  TableStats &operator=(TableStats &&) = delete;
+
+  static std::shared_ptr<const TableStats> Analyze(
+      DataTable *table, const size_t sample_size = STATS_SAMPLE_SIZE);
+
+  double GetTupleCount() const { return tuple_count_; }
+
+  // Estimated size of the live versions, in bytes
+  double GetDataSize() const { return data_size_; }
+
+  oid_t GetColumnCount() const { return column_stats_.size(); }
+
+  const ColumnStats &GetColumnStats(const oid_t column_id) const {
+    return column_stats_[column_id];
+  }
+
+ private:
+  TableStats() : pool_(BACKEND_TYPE_MM) {}
+
+  // Compute the most common values and the histogram of a column from its
+  // sampled non-null values
+  void SetValueStats(ColumnStats &column_stats, std::vector<Value> &values,
+                     const size_t sample_row_count, const bool is_complete);
+
+  double tuple_count_ = 0;
+
+  double data_size_ = 0;
+
+  std::vector<ColumnStats> column_stats_;
+
+  // holds the varlen values of the stats
+  VarlenPool pool_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -49,6 +49,7 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
       uninlined_data_size(0),
       column_header(NULL),
       column_header_size(INVALID_OID),
+      compressed(false),
       tile_group_header(tile_header) {
   PL_ASSERT(tuple_count > 0);
 
@@ -67,6 +68,27 @@ Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
   if (schema.IsInlined() == false) pool = new VarlenPool(backend_type);
 }
 
+Tile::Tile(BackendType backend_type, TileGroupHeader *tile_header,
+           const catalog::Schema &tuple_schema, TileGroup *tile_group)
+    : database_id(INVALID_OID),
+      table_id(INVALID_OID),
+      tile_group_id(INVALID_OID),
+      tile_id(INVALID_OID),
+      backend_type(backend_type),
+      schema(tuple_schema),
+      data(NULL),
+      tile_group(tile_group),
+      pool(NULL),
+      num_tuple_slots(0),
+      column_count(tuple_schema.GetColumnCount()),
+      tuple_length(tuple_schema.GetLength()),
+      tile_size(0),
+      uninlined_data_size(0),
+      column_header(NULL),
+      column_header_size(INVALID_OID),
+      compressed(true),
+      tile_group_header(tile_header) {}
+
 Tile::~Tile() {
   // reclaim the tile memory (INLINED data)
   auto &storage_manager = storage::StorageManager::GetInstance();
@@ -41,6 +41,7 @@ class TupleIterator;
  */
 class Tile : public Printable {
   friend class TileFactory;
+  friend class CompressedTile;
   friend class TupleIterator;
   friend class TileGroupHeader;
 
@@ -101,6 +102,11 @@ class Tile : public Printable {
                     const size_t column_offset, const bool is_inlined,
                     const size_t column_length);
 
+  // Is this an immutable compressed tile ? The accessors above do not apply
+  // to compressed tiles: callers check this once per tile and go through
+  // CompressedTile instead.
+  bool IsCompressed() const { return compressed; }
+
   // Get tuple at location
   static Tuple *GetTuple(catalog::Manager *catalog,
                          const ItemPointer *tuple_location);
@@ -171,6 +177,10 @@ class Tile : public Printable {
   void Sync();
 
  protected:
+  // Tile creator for compressed tiles, which manage their own tuple storage
+  Tile(BackendType backend_type, TileGroupHeader *tile_header,
+       const catalog::Schema &tuple_schema, TileGroup *tile_group);
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
@@ -216,6 +226,9 @@ class Tile : public Printable {
 
   oid_t column_header_size;
 
+  // no raw tuple storage (CompressedTile)
+  bool compressed;
+
   /**
    * NOTE : Tiles don't keep track of number of occupied slots.
    * This is maintained by shared Tile Header.
@@ -16,13 +16,16 @@
 
 #include "backend/common/platform.h"
 #include "backend/catalog/manager.h"
+#include "backend/common/exception.h"
 #include "backend/common/logger.h"
 #include "backend/common/types.h"
 #include "backend/storage/abstract_table.h"
 #include "backend/storage/tile.h"
+#include "backend/storage/compressed_tile.h"
 #include "backend/storage/tuple.h"
 #include "backend/storage/tile_group_header.h"
 #include "backend/storage/rollback_segment.h"
+#include "backend/storage/zone_map.h"
 
 namespace peloton {
 namespace storage {
@@ -37,6 +40,8 @@ TileGroup::TileGroup(BackendType backend_type,
       backend_type(backend_type),
       tile_schemas(schemas),
       tile_group_header(tile_group_header),
+      tile_group_header_ref(tile_group_header),
+      compressed(false),
       table(table),
       num_tuple_slots(tuple_count),
       column_map(column_map) {
@@ -53,13 +58,73 @@ TileGroup::TileGroup(BackendType backend_type,
     // Add a reference to the tile in the tile group
     tiles.push_back(tile);
   }
+
+  // Zone map columns follow the table column order
+  std::vector<ValueType> column_types;
+  for (auto &column_map_entry : column_map) {
+    auto &tile_schema = tile_schemas[column_map_entry.second.first];
+    column_types.push_back(tile_schema.GetType(column_map_entry.second.second));
+  }
+  zone_map.reset(new ZoneMap(column_types));
+}
+
+TileGroup::TileGroup(TileGroup *source_tile_group)
+    : database_id(source_tile_group->database_id),
+      table_id(source_tile_group->table_id),
+      tile_group_id(source_tile_group->tile_group_id),
+      backend_type(source_tile_group->backend_type),
+      tile_schemas(source_tile_group->tile_schemas),
+      tile_group_header(source_tile_group->tile_group_header),
+      tile_group_header_ref(source_tile_group->tile_group_header_ref),
+      compressed(true),
+      zone_map(new ZoneMap(*source_tile_group->zone_map)),
+      table(source_tile_group->table),
+      num_tuple_slots(source_tile_group->num_tuple_slots),
+      tile_count(source_tile_group->tile_count),
+      column_map(source_tile_group->column_map) {
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    std::shared_ptr<Tile> tile(
+        new CompressedTile(source_tile_group->GetTile(tile_itr), this));
+
+    // Add a reference to the tile in the tile group
+    tiles.push_back(tile);
+  }
+}
+
+TileGroup::TileGroup(TileGroup *source_tile_group,
+                     const std::vector<catalog::Schema> &schemas,
+                     const column_map_type &column_map)
+    : database_id(source_tile_group->database_id),
+      table_id(source_tile_group->table_id),
+      tile_group_id(source_tile_group->tile_group_id),
+      backend_type(source_tile_group->backend_type),
+      tile_schemas(schemas),
+      tile_group_header(source_tile_group->tile_group_header),
+      tile_group_header_ref(source_tile_group->tile_group_header_ref),
+      compressed(false),
+      zone_map(new ZoneMap(*source_tile_group->zone_map)),
+      table(source_tile_group->table),
+      num_tuple_slots(source_tile_group->num_tuple_slots),
+      column_map(column_map) {
+  tile_count = tile_schemas.size();
+
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    auto &manager = catalog::Manager::GetInstance();
+    oid_t tile_id = manager.GetNextOid();
+
+    std::shared_ptr<Tile> tile(storage::TileFactory::GetTile(
+        backend_type, database_id, table_id, tile_group_id, tile_id,
+        tile_group_header, tile_schemas[tile_itr], this, num_tuple_slots));
+
+    // Add a reference to the tile in the tile group
+    tiles.push_back(tile);
+  }
 }
 
 TileGroup::~TileGroup() {
   // Drop references on all tiles
 
-  // clean up tile group header
-  delete tile_group_header;
+  // the tile group header is cleaned up with the last tile group using it
 }
 
 oid_t TileGroup::GetTileId(const oid_t tile_id) const {
@@ -94,6 +159,11 @@ oid_t TileGroup::GetActiveTupleCount() const {
  * Apply the column delta on the rollback segment to the given tuple
  */
 void TileGroup::ApplyRollbackSegment(char *rb_seg, const oid_t &tuple_slot_id) {
+  // Compressed tile groups only hold frozen tuples, nothing to roll back
+  if (compressed) {
+    throw Exception("Cannot roll back tuple in compressed tile group " +
+                    std::to_string(tile_group_id));
+  }
 
   auto seg_col_count = storage::RollbackSegmentPool::GetColCount(rb_seg);
   auto table_schema = GetAbstractTable()->GetSchema();
@@ -119,6 +189,8 @@ void TileGroup::ApplyRollbackSegment(char *rb_seg, const oid_t &tuple_slot_id) {
     // Write the value to tuple
     auto tile_col_idx = GetTileColumnId(col_id);
     tile_tuple.SetValue(tile_col_idx, col_value, tile->GetPool());
+
+    zone_map->UpdateValue(col_id, col_value);
   }
 }
 
@@ -132,6 +204,11 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
   LOG_TRACE("Tile Group Id :: %u status :: %u out of %u slots ",
             tile_group_id, tuple_slot_id, num_tuple_slots);
 
+  if (compressed) {
+    throw Exception("Cannot write tuple in compressed tile group " +
+                    std::to_string(tile_group_id));
+  }
+
   oid_t tile_column_count;
   oid_t column_itr = 0;
 
@@ -154,6 +231,9 @@ void TileGroup::CopyTuple(const Tuple *tuple, const oid_t &tuple_slot_id) {
       column_itr++;
     }
   }
+
+  // The old values are gone, the zone map may now be too wide
+  zone_map->UpdateTuple(tuple, true);
 }
 
 // This is commented out before merge
@@ -175,6 +255,9 @@ void TileGroup::CopyTuple(const oid_t &tuple_slot_id, Tuple *tuple) {
  * Returns slot where inserted (INVALID_ID if not inserted)
  */
 oid_t TileGroup::InsertTuple(const Tuple *tuple) {
+  // Compressed tile groups are immutable
+  if (compressed) return INVALID_OID;
+
   oid_t tuple_slot_id = tile_group_header->GetNextEmptyTupleSlot();
 
   LOG_TRACE("Tile Group Id :: %u status :: %u out of %u slots ",
@@ -209,6 +292,7 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
     }
   }
 
+  zone_map->UpdateTuple(tuple, false);
 
   // Set MVCC info
   PL_ASSERT(tile_group_header->GetTransactionId(tuple_slot_id) == INVALID_TXN_ID);
@@ -218,6 +302,52 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
   return tuple_slot_id;
 }
 
+oid_t TileGroup::InsertTuples(const Tuple *const *tuples,
+                              const oid_t tuple_count, oid_t &inserted_count) {
+  inserted_count = 0;
+
+  // Compressed tile groups are immutable
+  if (compressed) return INVALID_OID;
+
+  oid_t first_slot_id =
+      tile_group_header->GetNextEmptyTupleSlots(tuple_count, inserted_count);
+
+  // No more slots
+  if (first_slot_id == INVALID_OID) {
+    LOG_TRACE("Failed to get next empty tuple slots within tile group.");
+    return INVALID_OID;
+  }
+
+  oid_t column_itr = 0;
+
+  // Copy a column of the batch at a time, with the schema lookups hoisted
+  for (oid_t tile_itr = 0; tile_itr < tile_count; tile_itr++) {
+    const catalog::Schema &schema = tile_schemas[tile_itr];
+    oid_t tile_column_count = schema.GetColumnCount();
+
+    storage::Tile *tile = GetTile(tile_itr);
+    PL_ASSERT(tile);
+
+    for (oid_t tile_column_itr = 0; tile_column_itr < tile_column_count;
+         tile_column_itr++) {
+      const size_t column_offset = schema.GetOffset(tile_column_itr);
+      const bool is_inlined = schema.IsInlined(tile_column_itr);
+      const size_t column_length = schema.GetAppropriateLength(tile_column_itr);
+
+      for (oid_t tuple_itr = 0; tuple_itr < inserted_count; tuple_itr++) {
+        tile->SetValueFast(tuples[tuple_itr]->GetValue(column_itr),
+                           first_slot_id + tuple_itr, column_offset,
+                           is_inlined, column_length);
+      }
+      column_itr++;
+    }
+  }
+
+  zone_map->UpdateTuples(tuples, inserted_count);
+
+  return first_slot_id;
+}
+
 /**
  * Grab specific slot and fill in the tuple
  * Used by recovery
@@ -225,6 +355,9 @@ oid_t TileGroup::InsertTuple(const Tuple *tuple) {
  */
 oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
                                          const Tuple *tuple) {
+  // Compressed tile groups are immutable
+  if (compressed) return INVALID_OID;
+
   auto status = tile_group_header->GetEmptyTupleSlot(tuple_slot_id);
 
   // No more slots
@@ -264,6 +397,9 @@ oid_t TileGroup::InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
     }
   }
 
+  // Recovery may overwrite a slot
+  zone_map->UpdateTuple(tuple, true);
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -340,6 +476,9 @@ oid_t TileGroup::UpdateTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
 oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
                                            const Tuple *tuple,
                                            cid_t commit_id) {
+  // Compressed tile groups are immutable
+  if (compressed) return INVALID_OID;
+
   auto status = tile_group_header->GetEmptyTupleSlot(tuple_slot_id);
 
   // No more slots
@@ -371,6 +510,9 @@ oid_t TileGroup::InsertTupleFromCheckpoint(oid_t tuple_slot_id,
     }
   }
 
+  // Recovery may overwrite a slot
+  zone_map->UpdateTuple(tuple, true);
+
   // Set MVCC info
   tile_group_header->SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
   tile_group_header->SetBeginCommitId(tuple_slot_id, commit_id);
@@ -410,9 +552,22 @@ Value TileGroup::GetValue(oid_t tuple_id, oid_t column_id) {
   PL_ASSERT(tuple_id < GetNextTupleSlot());
   oid_t tile_column_id, tile_offset;
   LocateTileAndColumn(column_id, tile_offset, tile_column_id);
+  if (compressed) {
+    return static_cast<CompressedTile *>(GetTile(tile_offset))
+        ->GetValue(tuple_id, tile_column_id);
+  }
   return GetTile(tile_offset)->GetValue(tuple_id, tile_column_id);
 }
 
+void TileGroup::PrefetchTuple(const oid_t tuple_id) const {
+  // No raw tuple storage to prefetch in compressed tiles
+  if (compressed) return;
+
+  for (auto &tile : tiles) {
+    __builtin_prefetch(tile->GetTupleLocation(tuple_id));
+  }
+}
+
 Tile *TileGroup::GetTile(const oid_t tile_offset) const {
   PL_ASSERT(tile_offset < tile_count);
   Tile *tile = tiles[tile_offset].get();
@@ -47,6 +47,7 @@ class TileGroupHeader;
 class AbstractTable;
 class TileGroupIterator;
 class RollbackSegment;
+class ZoneMap;
 
 typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
 
@@ -57,6 +58,11 @@ typedef std::map<oid_t, std::pair<oid_t, oid_t>> column_map_type;
  *
  * Look at TileGroupHeader for MVCC implementation.
  *
+ * Compressed and transformed (re-laid out) copies of a tile group share the
+ * header of their source tile group, so that the MVCC metadata stays the
+ * same across the swap. A compressed tile group holds a read-only
+ * CompressedTile for each tile of its source tile group.
+ *
  * TileGroups are only instantiated via TileGroupFactory.
  */
 class TileGroup : public Printable {
@@ -74,6 +80,16 @@ class TileGroup : public Printable {
 
   ~TileGroup();
 
+ private:
+  // Compressed tile group constructor
+  TileGroup(TileGroup *source_tile_group);
+
+  // Transformed tile group constructor (same header, new layout)
+  TileGroup(TileGroup *source_tile_group,
+            const std::vector<catalog::Schema> &schemas,
+            const column_map_type &column_map);
+
+ public:
   //===--------------------------------------------------------------------===//
   // Operations
   //===--------------------------------------------------------------------===//
@@ -88,6 +104,12 @@ class TileGroup : public Printable {
   // insert tuple at next available slot in tile if a slot exists
   oid_t InsertTuple(const Tuple *tuple);
 
+  // insert as many of the tuples as possible into consecutive slots, column
+  // by column. Returns the first slot, and sets inserted_count to the # of
+  // tuples inserted.
+  oid_t InsertTuples(const Tuple *const *tuples, const oid_t tuple_count,
+                     oid_t &inserted_count);
+
   // insert tuple at specific tuple slot
   // used by recovery mode
   oid_t InsertTupleFromRecovery(cid_t commit_id, oid_t tuple_slot_id,
@@ -123,7 +145,11 @@ class TileGroup : public Printable {
 
   TileGroupHeader *GetHeader() const { return tile_group_header; }
 
-  void SetHeader(TileGroupHeader *header) { tile_group_header = header; }
+  // Are the tiles in this tile group compressed (and hence read-only) ?
+  bool IsCompressed() const { return compressed; }
+
+  // Min/max synopses used by scans to skip this tile group
+  ZoneMap *GetZoneMap() const { return zone_map.get(); }
 
   unsigned int NumTiles() const { return tiles.size(); }
 
@@ -164,6 +190,9 @@ class TileGroup : public Printable {
 
   Value GetValue(oid_t tuple_id, oid_t column_id);
 
+  // Hint the cpu to fetch the data of the tuple in every tile
+  void PrefetchTuple(const oid_t tuple_id) const;
+
   double GetSchemaDifference(const storage::column_map_type &new_column_map);
 
   // Sync the contents
@@ -191,6 +220,15 @@ class TileGroup : public Printable {
   // associated tile group
   TileGroupHeader *tile_group_header;
 
+  // owns the header, which is shared with a compressed copy of the tile group
+  std::shared_ptr<TileGroupHeader> tile_group_header_ref;
+
+  // are the tiles compressed ?
+  bool compressed;
+
+  // per-column min/max and null count
+  std::unique_ptr<ZoneMap> zone_map;
+
   // associated table
   AbstractTable *table;  // this design is fantastic!!!
 
@@ -12,6 +12,7 @@
 
 #include "backend/storage/tile_group_factory.h"
 #include "backend/storage/tile_group_header.h"
+#include "backend/common/metrics.h"
 
 //===--------------------------------------------------------------------===//
 // GUC Variables
@@ -41,6 +42,30 @@ TileGroup *TileGroupFactory::GetTileGroup(
   tile_group->tile_group_id = tile_group_id;
   tile_group->table_id = table_id;
 
+  static oid_t allocation_counter_id =
+      MetricsRegistry::GetInstance().RegisterCounter(
+          "storage.tile_group_allocations");
+  MetricsRegistry::GetInstance().Increment(allocation_counter_id);
+
+  return tile_group;
+}
+
+TileGroup *TileGroupFactory::GetCompressedTileGroup(
+    TileGroup *source_tile_group) {
+  TileGroup *tile_group = new TileGroup(source_tile_group);
+
+  tile_group->GetHeader()->SetTileGroup(tile_group);
+
+  return tile_group;
+}
+
+TileGroup *TileGroupFactory::GetTransformedTileGroup(
+    TileGroup *source_tile_group, const std::vector<catalog::Schema> &schemas,
+    const column_map_type &column_map) {
+  TileGroup *tile_group = new TileGroup(source_tile_group, schemas, column_map);
+
+  tile_group->GetHeader()->SetTileGroup(tile_group);
+
   return tile_group;
 }
 
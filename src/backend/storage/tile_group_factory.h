@@ -34,6 +34,17 @@ class TileGroupFactory {
                                  const std::vector<catalog::Schema> &schemas,
                                  const column_map_type &column_map,
                                  int tuple_count);
+
+  // Build a compressed, read-only copy of the given tile group that shares
+  // its header
+  static TileGroup *GetCompressedTileGroup(TileGroup *source_tile_group);
+
+  // Build an empty tile group with the given layout that shares the header
+  // of the source tile group
+  static TileGroup *GetTransformedTileGroup(
+      TileGroup *source_tile_group,
+      const std::vector<catalog::Schema> &schemas,
+      const column_map_type &column_map);
 };
 
 }  // End storage namespace
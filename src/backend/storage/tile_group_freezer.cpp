@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.cpp
+//
+// Identification: src/backend/storage/tile_group_freezer.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <chrono>
+
+#include "backend/catalog/manager.h"
+#include "backend/common/logger.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/database.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_freezer.h"
+#include "backend/storage/zone_map.h"
+
+namespace peloton {
+namespace storage {
+
+TileGroupFreezer &TileGroupFreezer::GetInstance() {
+  static TileGroupFreezer tile_group_freezer;
+  return tile_group_freezer;
+}
+
+void TileGroupFreezer::StartFreezer(const int interval_ms) {
+  LOG_TRACE("Starting tile group freezer");
+  if (this->is_running_ == true) {
+    return;
+  }
+  this->is_running_ = true;
+  freezer_thread_.reset(
+      new std::thread(&TileGroupFreezer::Running, this, interval_ms));
+}
+
+void TileGroupFreezer::StopFreezer() {
+  LOG_TRACE("Stopping tile group freezer");
+  if (this->is_running_ == false) {
+    return;
+  }
+  this->is_running_ = false;
+  this->freezer_thread_->join();
+}
+
+void TileGroupFreezer::Running(const int interval_ms) {
+  while (is_running_ == true) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(interval_ms));
+
+    LOG_TRACE("tile group freezer thread...");
+    FreezeTileGroups();
+  }
+}
+
+oid_t TileGroupFreezer::FreezeTileGroups() {
+  auto &manager = catalog::Manager::GetInstance();
+  oid_t compressed_count = 0;
+
+  auto database_count = manager.GetDatabaseCount();
+  for (oid_t database_itr = 0; database_itr < database_count;
+       database_itr++) {
+    auto database = manager.GetDatabase(database_itr);
+
+    auto table_count = database->GetTableCount();
+    for (oid_t table_itr = 0; table_itr < table_count; table_itr++) {
+      compressed_count += FreezeTileGroups(database->GetTable(table_itr));
+    }
+  }
+
+  return compressed_count;
+}
+
+oid_t TileGroupFreezer::FreezeTileGroups(DataTable *table) {
+  oid_t compressed_count = 0;
+  bool refresh_zone_maps =
+      concurrency::TransactionManagerFactory::GetProtocol() !=
+      CONCURRENCY_TYPE_OCC_RB;
+
+  auto tile_group_count = table->GetTileGroupCount();
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    auto tile_group = table->GetTileGroup(tile_group_itr);
+    if (tile_group == nullptr || tile_group->IsCompressed()) {
+      continue;
+    }
+
+    // Tighten the zone map after in-place updates, off the scan path. With
+    // rollback segments the old versions are not in the tiles, so a zone
+    // map built from the tiles could prune tile groups they are visible in.
+    auto zone_map = tile_group->GetZoneMap();
+    if (zone_map != nullptr && refresh_zone_maps == true) {
+      zone_map->Refresh(tile_group.get());
+    }
+
+    auto tile_group_id = tile_group->GetTileGroupId();
+    if (table->IsTileGroupFrozen(tile_group_itr) == false) {
+      frozen_pass_counts_.erase(tile_group_id);
+      continue;
+    }
+
+    // Wait until the tile group has been frozen for long enough
+    auto &pass_count = frozen_pass_counts_[tile_group_id];
+    if (++pass_count < FREEZER_COLD_PASS_COUNT) {
+      continue;
+    }
+
+    if (table->CompressTileGroup(tile_group_itr) != nullptr) {
+      LOG_TRACE("Compressed tile group %u in table %u", tile_group_id,
+                table->GetOid());
+      frozen_pass_counts_.erase(tile_group_id);
+      compressed_count++;
+    }
+  }
+
+  return compressed_count;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
@@ -0,0 +1,90 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// tile_group_freezer.h
+//
+// Identification: src/backend/storage/tile_group_freezer.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <memory>
+#include <thread>
+#include <unordered_map>
+
+#include "backend/common/types.h"
+
+namespace peloton {
+namespace storage {
+
+class DataTable;
+
+//===--------------------------------------------------------------------===//
+// Tile Group Freezer
+//===--------------------------------------------------------------------===//
+
+#define FREEZER_PERIOD_MILLISECONDS 1000
+
+// Number of consecutive passes a tile group must stay frozen before it is
+// considered cold and gets compressed
+#define FREEZER_COLD_PASS_COUNT 2
+
+/**
+ * Background service that replaces cold tile groups with compressed ones.
+ *
+ * A tile group is frozen when it is full and all its tuples are committed
+ * latest versions (see DataTable::IsTileGroupFrozen). It is compressed once
+ * it has stayed frozen for FREEZER_COLD_PASS_COUNT passes.
+ *
+ * Each pass also recomputes the dirty zone maps of the tile groups, unless
+ * the old versions are kept in rollback segments (CONCURRENCY_TYPE_OCC_RB).
+ */
+class TileGroupFreezer {
+ public:
+  TileGroupFreezer(const TileGroupFreezer &) = delete;
+  TileGroupFreezer &operator=(const TileGroupFreezer &) = delete;
+  TileGroupFreezer(TileGroupFreezer &&) = delete;
+  TileGroupFreezer &operator=(TileGroupFreezer &&) = delete;
+
+  TileGroupFreezer() : is_running_(false) {}
+
+  ~TileGroupFreezer() { StopFreezer(); }
+
+  // global singleton
+  static TileGroupFreezer &GetInstance();
+
+  // Get status of whether freezer thread is running or not
+  bool GetStatus() { return this->is_running_; }
+
+  void StartFreezer(const int interval_ms = FREEZER_PERIOD_MILLISECONDS);
+
+  void StopFreezer();
+
+  // Do a single pass over all the tables, returns the number of tile groups
+  // compressed
+  oid_t FreezeTileGroups();
+
+  // Do a single pass over the given table
+  oid_t FreezeTileGroups(DataTable *table);
+
+ private:
+  void Running(const int interval_ms);
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  volatile bool is_running_;
+
+  std::unique_ptr<std::thread> freezer_thread_;
+
+  // tile group id -> number of consecutive passes it has been frozen
+  std::unordered_map<oid_t, oid_t> frozen_pass_counts_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
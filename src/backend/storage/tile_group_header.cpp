@@ -10,9 +10,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
 #include <iostream>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 #include "backend/common/logger.h"
 #include "backend/common/platform.h"
@@ -28,13 +30,23 @@
 namespace peloton {
 namespace storage {
 
+HeaderLayoutType TileGroupHeader::default_layout_type = HEADER_LAYOUT_TYPE_ROW;
+
 TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
-                                 const int &tuple_count)
+                                 const int &tuple_count,
+                                 const HeaderLayoutType layout_type)
     : backend_type(backend_type),
       data(nullptr),
+      layout_type(layout_type),
+      mvcc_data(nullptr),
       num_tuple_slots(tuple_count),
       next_tuple_slot(0),
-      tile_header_lock() {
+      tile_header_lock(),
+      all_visible_cid(INVALID_CID),
+      all_visible_tuple_count(0),
+      all_visible_generation(0),
+      recycling_disabled_count(0),
+      recycled_slot_writer_count(0) {
   header_size = num_tuple_slots * header_entry_size;
 
   // allocate storage space for header
@@ -46,6 +58,25 @@ TileGroupHeader::TileGroupHeader(const BackendType &backend_type,
   // zero out the data
   PL_MEMSET(data, 0, header_size);
 
+  if (layout_type == HEADER_LAYOUT_TYPE_COLUMN) {
+    size_t mvcc_size = num_tuple_slots * GetMvccDataSize();
+    mvcc_data = reinterpret_cast<char *>(
+        storage_manager.Allocate(backend_type, mvcc_size));
+    PL_ASSERT(mvcc_data != nullptr);
+    PL_MEMSET(mvcc_data, 0, mvcc_size);
+
+    txn_id_data = mvcc_data;
+    begin_cid_data = txn_id_data + num_tuple_slots * sizeof(txn_id_t);
+    end_cid_data = begin_cid_data + num_tuple_slots * sizeof(cid_t);
+    mvcc_stride = sizeof(txn_id_t);
+  } else {
+    PL_ASSERT(layout_type == HEADER_LAYOUT_TYPE_ROW);
+    txn_id_data = data + txn_id_offset;
+    begin_cid_data = data + begin_cid_offset;
+    end_cid_data = data + end_cid_offset;
+    mvcc_stride = header_entry_size;
+  }
+
   // Set MVCC Initial Value
   for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
        tuple_slot_id++) {
@@ -64,8 +95,98 @@ TileGroupHeader::~TileGroupHeader() {
   // reclaim the space
   auto &storage_manager = storage::StorageManager::GetInstance();
   storage_manager.Release(backend_type, data);
+  if (mvcc_data != nullptr) {
+    storage_manager.Release(backend_type, mvcc_data);
+  }
 
   data = nullptr;
+  mvcc_data = nullptr;
+}
+
+TileGroupHeader &TileGroupHeader::operator=(
+    const peloton::storage::TileGroupHeader &other) {
+  // check for self-assignment
+  if (&other == this) return *this;
+
+  PL_ASSERT(num_tuple_slots == other.num_tuple_slots);
+  header_size = other.header_size;
+
+  // copy over all the data
+  PL_MEMCPY(data, other.data, header_size);
+
+  if (layout_type == other.layout_type) {
+    if (mvcc_data != nullptr) {
+      PL_MEMCPY(mvcc_data, other.mvcc_data,
+                num_tuple_slots * GetMvccDataSize());
+    }
+  } else {
+    for (oid_t tuple_slot_id = START_OID; tuple_slot_id < num_tuple_slots;
+         tuple_slot_id++) {
+      SetTransactionId(tuple_slot_id, other.GetTransactionId(tuple_slot_id));
+      SetBeginCommitId(tuple_slot_id, other.GetBeginCommitId(tuple_slot_id));
+      SetEndCommitId(tuple_slot_id, other.GetEndCommitId(tuple_slot_id));
+    }
+  }
+
+  num_tuple_slots = other.num_tuple_slots;
+  oid_t val = other.next_tuple_slot;
+  next_tuple_slot = val;
+
+  all_visible_cid = INVALID_CID;
+
+  return *this;
+}
+
+bool TileGroupHeader::TryMarkAllVisible() {
+  // MAX_CID keeps other markers away, and is overwritten by any write
+  cid_t expected_cid = INVALID_CID;
+  if (all_visible_cid.compare_exchange_strong(expected_cid, MAX_CID) ==
+      false) {
+    return false;
+  }
+
+  oid_t tuple_count = GetCurrentNextTupleSlot();
+  cid_t max_begin_cid = INVALID_CID;
+  bool all_visible = (tuple_count > 0);
+
+  for (oid_t tuple_slot_id = START_OID; tuple_slot_id < tuple_count;
+       tuple_slot_id++) {
+    cid_t begin_cid = GetBeginCommitId(tuple_slot_id);
+    if (GetTransactionId(tuple_slot_id) != INITIAL_TXN_ID ||
+        begin_cid == MAX_CID || GetEndCommitId(tuple_slot_id) != MAX_CID) {
+      all_visible = false;
+      break;
+    }
+    max_begin_cid = std::max(max_begin_cid, begin_cid);
+  }
+
+  expected_cid = MAX_CID;
+  if (all_visible == false || max_begin_cid == INVALID_CID) {
+    all_visible_cid.compare_exchange_strong(expected_cid, INVALID_CID);
+    return false;
+  }
+
+  all_visible_tuple_count = tuple_count;
+  all_visible_generation++;
+  return all_visible_cid.compare_exchange_strong(expected_cid, max_begin_cid);
+}
+
+bool TileGroupHeader::ClaimRecycledSlot() {
+  // Announce the write first, so that DisableRecycling either sees it and
+  // waits, or we see the disabled count and back off
+  recycled_slot_writer_count++;
+  if (recycling_disabled_count.load() > 0) {
+    recycled_slot_writer_count--;
+    return false;
+  }
+  return true;
+}
+
+void TileGroupHeader::DisableRecycling() {
+  recycling_disabled_count++;
+  while (recycled_slot_writer_count.load() > 0) {
+    std::this_thread::yield();
+  }
 }
 
 //===--------------------------------------------------------------------===//
@@ -136,6 +257,10 @@ void TileGroupHeader::Sync() {
   // Sync the tile group data
   auto &storage_manager = storage::StorageManager::GetInstance();
   storage_manager.Sync(backend_type, data, header_size);
+  if (mvcc_data != nullptr) {
+    storage_manager.Sync(backend_type, mvcc_data,
+                         num_tuple_slots * GetMvccDataSize());
+  }
 }
 
 void TileGroupHeader::PrintVisibility(txn_id_t txn_id, cid_t at_cid) {
@@ -12,6 +12,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <iostream>
 #include <queue>
@@ -43,31 +44,25 @@ class TileGroup;
  *  | NextItemPointer (8 bytes) | PrevItemPointer (8 bytes) | IndexCount(4 bytes) | 
  *  | ReservedField (24 bytes) | InsertCommit (1 byte) | DeleteCommit (1 byte)
  *  -----------------------------------------------------------------------------
+ *
+ * With the column layout, the TxnID, BeginTimeStamp and EndTimeStamp of all
+ * the slots are instead stored in three contiguous arrays, so that scans
+ * checking visibility only touch these fields (see GetTransactionIdArray).
+ * Their space in the records above is left unused.
  */
 
 #define TUPLE_HEADER_LOCATION data + (tuple_slot_id * header_entry_size)
 
+#define TUPLE_MVCC_LOCATION(base) base + (tuple_slot_id * mvcc_stride)
+
 class TileGroupHeader : public Printable {
   TileGroupHeader() = delete;
 
  public:
-  TileGroupHeader(const BackendType &backend_type, const int &tuple_count);
-
-  TileGroupHeader &operator=(const peloton::storage::TileGroupHeader &other) {
-    // check for self-assignment
-    if (&other == this) return *this;
-
-    header_size = other.header_size;
+  TileGroupHeader(const BackendType &backend_type, const int &tuple_count,
+                  const HeaderLayoutType layout_type = default_layout_type);
 
-    // copy over all the data
-    PL_MEMCPY(data, other.data, header_size);
-
-    num_tuple_slots = other.num_tuple_slots;
-    oid_t val = other.next_tuple_slot;
-    next_tuple_slot = val;
-
-    return *this;
-  }
+  TileGroupHeader &operator=(const peloton::storage::TileGroupHeader &other);
 
   ~TileGroupHeader();
 
@@ -79,6 +74,23 @@ class TileGroupHeader : public Printable {
     if (tuple_slot_id >= num_tuple_slots) {
       return INVALID_OID;
     } else {
+      MarkModified();
+      return tuple_slot_id;
+    }
+  }
+
+  // Claim up to tuple_count consecutive slots at once (bulk inserts).
+  // Returns the first slot, and sets claimed_count to the # of slots claimed.
+  oid_t GetNextEmptyTupleSlots(const oid_t tuple_count, oid_t &claimed_count) {
+    oid_t tuple_slot_id =
+        next_tuple_slot.fetch_add(tuple_count, std::memory_order_relaxed);
+
+    if (tuple_slot_id >= num_tuple_slots) {
+      claimed_count = 0;
+      return INVALID_OID;
+    } else {
+      claimed_count = std::min(tuple_count, num_tuple_slots - tuple_slot_id);
+      MarkModified();
       return tuple_slot_id;
     }
   }
@@ -93,6 +105,7 @@ class TileGroupHeader : public Printable {
       if (next_tuple_slot <= tuple_slot_id) {
         next_tuple_slot = tuple_slot_id + 1;
       }
+      MarkModified();
       tile_header_lock.Unlock();
       return true;
     } else {
@@ -126,15 +139,15 @@ class TileGroupHeader : public Printable {
   inline txn_id_t GetTransactionId(const oid_t &tuple_slot_id) const {
     // txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
     // return __atomic_load_n(txn_id_ptr, __ATOMIC_RELAXED);
-    return *((txn_id_t *)(TUPLE_HEADER_LOCATION));
+    return *((txn_id_t *)(TUPLE_MVCC_LOCATION(txn_id_data)));
   }
 
   inline cid_t GetBeginCommitId(const oid_t &tuple_slot_id) const {
-    return *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset));
+    return *((cid_t *)(TUPLE_MVCC_LOCATION(begin_cid_data)));
   }
 
   inline cid_t GetEndCommitId(const oid_t &tuple_slot_id) const {
-    return *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset));
+    return *((cid_t *)(TUPLE_MVCC_LOCATION(end_cid_data)));
   }
 
   inline ItemPointer GetNextItemPointer(const oid_t &tuple_slot_id) const {
@@ -170,17 +183,19 @@ class TileGroupHeader : public Printable {
   }
   inline void SetTransactionId(const oid_t &tuple_slot_id,
                                const txn_id_t &transaction_id) {
-    *((txn_id_t *)(TUPLE_HEADER_LOCATION)) = transaction_id;
+    *((txn_id_t *)(TUPLE_MVCC_LOCATION(txn_id_data))) = transaction_id;
+    if (transaction_id != INITIAL_TXN_ID) MarkModified();
   }
 
   inline void SetBeginCommitId(const oid_t &tuple_slot_id,
                                const cid_t &begin_cid) {
-    *((cid_t *)(TUPLE_HEADER_LOCATION + begin_cid_offset)) = begin_cid;
+    *((cid_t *)(TUPLE_MVCC_LOCATION(begin_cid_data))) = begin_cid;
   }
 
   inline void SetEndCommitId(const oid_t &tuple_slot_id,
                              const cid_t &end_cid) const {
-    *((cid_t *)(TUPLE_HEADER_LOCATION + end_cid_offset)) = end_cid;
+    *((cid_t *)(TUPLE_MVCC_LOCATION(end_cid_data))) = end_cid;
+    if (end_cid != MAX_CID) MarkModified();
   }
 
   inline void SetNextItemPointer(const oid_t &tuple_slot_id,
@@ -203,25 +218,131 @@ class TileGroupHeader : public Printable {
     *((bool *)(TUPLE_HEADER_LOCATION + delete_commit_offset)) = commit;
   }
 
+  // Hint the cpu to fetch the txn id, cids and item pointers of a slot,
+  // ahead of the visibility checks of a batch of slots
+  inline void PrefetchTuple(const oid_t &tuple_slot_id) const {
+    __builtin_prefetch(TUPLE_MVCC_LOCATION(txn_id_data));
+    __builtin_prefetch(TUPLE_MVCC_LOCATION(end_cid_data));
+    __builtin_prefetch(TUPLE_HEADER_LOCATION + next_pointer_offset);
+  }
+
   // Getters for addresses
   inline txn_id_t *GetTransactionIdLocation(const oid_t &tuple_slot_id) const {
-    return ((txn_id_t *)(TUPLE_HEADER_LOCATION));
+    return ((txn_id_t *)(TUPLE_MVCC_LOCATION(txn_id_data)));
   }
 
   inline txn_id_t SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                          const txn_id_t &old_txn_id,
                                          const txn_id_t &new_txn_id) const {
-    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
-    return __sync_val_compare_and_swap(txn_id_ptr, old_txn_id, new_txn_id);
+    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_MVCC_LOCATION(txn_id_data));
+    txn_id_t txn_id =
+        __sync_val_compare_and_swap(txn_id_ptr, old_txn_id, new_txn_id);
+    if (txn_id == old_txn_id && new_txn_id != INITIAL_TXN_ID) MarkModified();
+    return txn_id;
   }
 
   inline bool SetAtomicTransactionId(const oid_t &tuple_slot_id,
                                      const txn_id_t &transaction_id) const {
-    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_HEADER_LOCATION);
-    return __sync_bool_compare_and_swap(txn_id_ptr, INITIAL_TXN_ID,
-                                        transaction_id);
+    txn_id_t *txn_id_ptr = (txn_id_t *)(TUPLE_MVCC_LOCATION(txn_id_data));
+    bool success = __sync_bool_compare_and_swap(txn_id_ptr, INITIAL_TXN_ID,
+                                                transaction_id);
+    if (success) MarkModified();
+    return success;
+  }
+
+  //===--------------------------------------------------------------------===//
+  // All-visible tile groups
+  //===--------------------------------------------------------------------===//
+
+  // A tile group is all-visible when none of its allocated tuples is owned
+  // by a transaction or has an end cid other than MAX_CID. Every tuple is then
+  // visible to the snapshots that are not older than its greatest begin cid.
+  // Any write clears the flag, and TryMarkAllVisible sets it again.
+
+  // If the tile group is all-visible to the given snapshot, set tuple_count
+  // to its number of tuples and return true
+  bool IsAllVisible(const cid_t snapshot_cid, oid_t &tuple_count) const {
+    cid_t max_begin_cid = all_visible_cid.load();
+    if (max_begin_cid == INVALID_CID || max_begin_cid == MAX_CID ||
+        max_begin_cid > snapshot_cid) {
+      return false;
+    }
+    tuple_count = all_visible_tuple_count.load();
+    // the count must belong to the same marking
+    return all_visible_cid.load() == max_begin_cid;
+  }
+
+  // Check every allocated tuple and set the all-visible flag if possible
+  bool TryMarkAllVisible();
+
+  // If the tile group is all-visible, set generation to the number of times
+  // it has been marked so and return true. The tile group is not modified as
+  // long as IsAllVisibleSince returns true for that generation.
+  bool GetAllVisibleGeneration(uint64_t &generation) const {
+    cid_t max_begin_cid = all_visible_cid.load();
+    if (max_begin_cid == INVALID_CID || max_begin_cid == MAX_CID) {
+      return false;
+    }
+    generation = all_visible_generation.load();
+    return all_visible_cid.load() == max_begin_cid;
+  }
+
+  bool IsAllVisibleSince(const uint64_t generation) const {
+    uint64_t current_generation;
+    return GetAllVisibleGeneration(current_generation) &&
+           current_generation == generation;
+  }
+
+  // Clear the all-visible flag, called by every write that can make a tuple
+  // owned or invalidated. The writes are ordered by the compare-and-swap or
+  // fetch-and-add that precedes them, so a concurrent TryMarkAllVisible
+  // either sees the write or has its flag cleared.
+  inline void MarkModified() const {
+    if (all_visible_cid.load() != INVALID_CID) {
+      all_visible_cid.store(INVALID_CID);
+    }
+  }
+
+  // The GC recycles reset slots by writing new tuples into the tiles. While
+  // the tiles are copied to a transformed or compressed tile group, recycling
+  // is disabled so that such a write does not land in the orig tiles only.
+  // A recycled slot is claimed before and released after it is written.
+  bool ClaimRecycledSlot();
+
+  void ReleaseRecycledSlot() { recycled_slot_writer_count--; }
+
+  // Disable recycling and wait for the claimed slots to be written
+  void DisableRecycling();
+
+  void EnableRecycling() { recycling_disabled_count--; }
+
+  // Contiguous arrays of txn ids, begin and end cids indexed by tuple slot,
+  // only available with the column layout (nullptr otherwise)
+  inline const txn_id_t *GetTransactionIdArray() const {
+    return IsColumnLayout() ? (const txn_id_t *)txn_id_data : nullptr;
+  }
+
+  inline const cid_t *GetBeginCommitIdArray() const {
+    return IsColumnLayout() ? (const cid_t *)begin_cid_data : nullptr;
+  }
+
+  inline const cid_t *GetEndCommitIdArray() const {
+    return IsColumnLayout() ? (const cid_t *)end_cid_data : nullptr;
+  }
+
+  inline bool IsColumnLayout() const {
+    return layout_type == HEADER_LAYOUT_TYPE_COLUMN;
   }
 
+  HeaderLayoutType GetLayoutType() const { return layout_type; }
+
+  // Layout of the headers of the tile groups created from now on
+  static void SetDefaultLayoutType(const HeaderLayoutType layout_type) {
+    default_layout_type = layout_type;
+  }
+
+  static HeaderLayoutType GetDefaultLayoutType() { return default_layout_type; }
+
   void PrintVisibility(txn_id_t txn_id, cid_t at_cid);
 
   // Getter for spin lock
@@ -267,6 +388,11 @@ class TileGroupHeader : public Printable {
       insert_commit_offset + sizeof(bool);
 
 private:
+  // size of the txn id, begin and end cid of a slot
+  static inline size_t GetMvccDataSize() {
+    return sizeof(txn_id_t) + 2 * sizeof(cid_t);
+  }
+
   //===--------------------------------------------------------------------===//
   // Data members
   //===--------------------------------------------------------------------===//
@@ -282,6 +408,20 @@ private:
   // set of fixed-length tuple slots
   char *data;
 
+  HeaderLayoutType layout_type;
+
+  // txn id, begin and end cid arrays of the column layout
+  char *mvcc_data;
+
+  // location of the txn id, begin and end cid of the first slot, and distance
+  // between two slots (records with the row layout, arrays otherwise)
+  char *txn_id_data;
+  char *begin_cid_data;
+  char *end_cid_data;
+  size_t mvcc_stride;
+
+  static HeaderLayoutType default_layout_type;
+
   // number of tuple slots allocated
   oid_t num_tuple_slots;
 
@@ -291,6 +431,22 @@ private:
   std::atomic<oid_t> next_tuple_slot;
 
   Spinlock tile_header_lock;
+
+  // greatest begin cid of an all-visible tile group,
+  // INVALID_CID if not all-visible and MAX_CID while being marked
+  mutable std::atomic<cid_t> all_visible_cid;
+
+  // number of tuples checked when the tile group was marked all-visible
+  std::atomic<oid_t> all_visible_tuple_count;
+
+  // number of times the tile group was marked all-visible
+  std::atomic<uint64_t> all_visible_generation;
+
+  // number of copies of the tiles in progress, recycling is disabled if > 0
+  std::atomic<int> recycling_disabled_count;
+
+  // number of recycled slots claimed but not written yet
+  std::atomic<int> recycled_slot_writer_count;
 };
 
 }  // End storage namespace
@@ -0,0 +1,259 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.cpp
+//
+// Identification: src/backend/storage/zone_map.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "backend/storage/zone_map.h"
+#include "backend/common/value_factory.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tuple.h"
+
+namespace peloton {
+namespace storage {
+
+// Values of these types do not point to any external storage
+static bool IsTrackedType(const ValueType value_type) {
+  switch (value_type) {
+    case VALUE_TYPE_TINYINT:
+    case VALUE_TYPE_SMALLINT:
+    case VALUE_TYPE_INTEGER:
+    case VALUE_TYPE_BIGINT:
+    case VALUE_TYPE_DOUBLE:
+    case VALUE_TYPE_REAL:
+    case VALUE_TYPE_DECIMAL:
+    case VALUE_TYPE_DATE:
+    case VALUE_TYPE_TIMESTAMP:
+    case VALUE_TYPE_BOOLEAN:
+      return true;
+    default:
+      return false;
+  }
+}
+
+ZoneMap::ZoneMap(const std::vector<ValueType> &column_types)
+    : columns_(column_types.size()), dirty_(false) {
+  auto column_count = column_types.size();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    columns_[column_itr].is_tracked = IsTrackedType(column_types[column_itr]);
+  }
+}
+
+ZoneMap::ZoneMap(const ZoneMap &other) : dirty_(false) {
+  auto &other_lock = const_cast<ZoneMap &>(other).zone_map_lock_;
+
+  other_lock.Lock();
+  columns_ = other.columns_;
+  dirty_ = other.dirty_.load();
+  other_lock.Unlock();
+}
+
+void ZoneMap::Widen(ColumnSynopsis &column, const Value &value) {
+  if (value.IsNull()) {
+    column.null_count++;
+    return;
+  }
+
+  if (column.has_values == false) {
+    column.min_value = value;
+    column.max_value = value;
+    column.has_values = true;
+    return;
+  }
+
+  if (value.Compare(column.min_value) < 0) column.min_value = value;
+  if (value.Compare(column.max_value) > 0) column.max_value = value;
+}
+
+void ZoneMap::Record(const oid_t column_id, const Value &value) {
+  Widen(columns_[column_id], value);
+  if (is_refreshing_ == true) Widen(pending_columns_[column_id], value);
+}
+
+void ZoneMap::UpdateTuple(const Tuple *tuple, const bool is_update) {
+  auto column_count = columns_.size();
+  PL_ASSERT(tuple->GetColumnCount() == column_count);
+
+  zone_map_lock_.Lock();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column = columns_[column_itr];
+    if (column.is_tracked == false) continue;
+
+    Record(column_itr, tuple->GetValue(column_itr));
+  }
+  if (is_update == true) dirty_ = true;
+  zone_map_lock_.Unlock();
+}
+
+void ZoneMap::UpdateTuples(const Tuple *const *tuples,
+                           const oid_t tuple_count) {
+  auto column_count = columns_.size();
+
+  zone_map_lock_.Lock();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column = columns_[column_itr];
+    if (column.is_tracked == false) continue;
+
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      Record(column_itr, tuples[tuple_itr]->GetValue(column_itr));
+    }
+  }
+  zone_map_lock_.Unlock();
+}
+
+void ZoneMap::UpdateValue(const oid_t column_id, const Value &value) {
+  auto &column = columns_[column_id];
+  if (column.is_tracked == false) return;
+
+  zone_map_lock_.Lock();
+  Record(column_id, value);
+  dirty_ = true;
+  zone_map_lock_.Unlock();
+}
+
+void ZoneMap::Refresh(TileGroup *tile_group) {
+  if (dirty_ == false) return;
+
+  auto column_count = columns_.size();
+
+  // Empty synopses of the same columns
+  std::vector<ColumnSynopsis> rebuilt_columns(column_count);
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    rebuilt_columns[column_itr].is_tracked = columns_[column_itr].is_tracked;
+  }
+
+  zone_map_lock_.Lock();
+  if (dirty_ == false || is_refreshing_ == true) {
+    zone_map_lock_.Unlock();
+    return;
+  }
+  // Updates from now on mark the zone map dirty again
+  dirty_ = false;
+  is_refreshing_ = true;
+  pending_columns_ = rebuilt_columns;
+  auto tuple_count = tile_group->GetNextTupleSlot();
+  zone_map_lock_.Unlock();
+
+  // Rebuild the synopses over all the slots in use. Writes to slots we
+  // have already read are caught in the pending synopses.
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column = rebuilt_columns[column_itr];
+    if (column.is_tracked == false) continue;
+
+    for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      Widen(column, tile_group->GetValue(tuple_itr, column_itr));
+    }
+  }
+
+  zone_map_lock_.Lock();
+  for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+    auto &column = rebuilt_columns[column_itr];
+    auto &pending_column = pending_columns_[column_itr];
+    if (column.is_tracked == false) continue;
+
+    if (pending_column.has_values == true) {
+      Widen(column, pending_column.min_value);
+      Widen(column, pending_column.max_value);
+    }
+    column.null_count += pending_column.null_count;
+  }
+  columns_ = rebuilt_columns;
+  pending_columns_.clear();
+  is_refreshing_ = false;
+  zone_map_lock_.Unlock();
+}
+
+bool ZoneMap::ComparisonMayMatch(const oid_t column_id,
+                                 const ExpressionType comparison_type,
+                                 const Value &value) {
+  auto &column = columns_[column_id];
+  if (column.is_tracked == false || value.IsNull() ||
+      IsTrackedType(value.GetValueType()) == false) {
+    return true;
+  }
+
+  bool may_match = true;
+
+  zone_map_lock_.Lock();
+  if (column.has_values == false) {
+    // Only nulls, no comparison can be true
+    may_match = false;
+  } else {
+    switch (comparison_type) {
+      case EXPRESSION_TYPE_COMPARE_EQUAL:
+        may_match = (column.min_value.Compare(value) <= 0 &&
+                     column.max_value.Compare(value) >= 0);
+        break;
+      case EXPRESSION_TYPE_COMPARE_NOTEQUAL:
+        may_match = (column.min_value.Compare(value) != 0 ||
+                     column.max_value.Compare(value) != 0);
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHAN:
+        may_match = (column.min_value.Compare(value) < 0);
+        break;
+      case EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO:
+        may_match = (column.min_value.Compare(value) <= 0);
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHAN:
+        may_match = (column.max_value.Compare(value) > 0);
+        break;
+      case EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO:
+        may_match = (column.max_value.Compare(value) >= 0);
+        break;
+      default:
+        may_match = true;
+        break;
+    }
+  }
+  zone_map_lock_.Unlock();
+
+  return may_match;
+}
+
+bool ZoneMap::IsNullMayMatch(const oid_t column_id) {
+  auto &column = columns_[column_id];
+  if (column.is_tracked == false) return true;
+
+  zone_map_lock_.Lock();
+  bool may_match = (column.null_count > 0);
+  zone_map_lock_.Unlock();
+
+  return may_match;
+}
+
+Value ZoneMap::GetMinValue(const oid_t column_id) {
+  zone_map_lock_.Lock();
+  auto &column = columns_[column_id];
+  Value min_value = column.has_values ? column.min_value
+                                      : ValueFactory::GetNullValue();
+  zone_map_lock_.Unlock();
+
+  return min_value;
+}
+
+Value ZoneMap::GetMaxValue(const oid_t column_id) {
+  zone_map_lock_.Lock();
+  auto &column = columns_[column_id];
+  Value max_value = column.has_values ? column.max_value
+                                      : ValueFactory::GetNullValue();
+  zone_map_lock_.Unlock();
+
+  return max_value;
+}
+
+oid_t ZoneMap::GetNullCount(const oid_t column_id) {
+  zone_map_lock_.Lock();
+  auto null_count = columns_[column_id].null_count;
+  zone_map_lock_.Unlock();
+
+  return null_count;
+}
+
+}  // End storage namespace
+}  // End peloton namespace
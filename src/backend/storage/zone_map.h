@@ -0,0 +1,140 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map.h
+//
+// Identification: src/backend/storage/zone_map.h
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#pragma once
+
+#include <atomic>
+#include <vector>
+
+#include "backend/common/platform.h"
+#include "backend/common/types.h"
+#include "backend/common/value.h"
+
+namespace peloton {
+namespace storage {
+
+//===--------------------------------------------------------------------===//
+// Zone Map
+//===--------------------------------------------------------------------===//
+
+class Tuple;
+class TileGroup;
+
+/**
+ * Min/max and null count of every column in a tile group.
+ *
+ * The synopses are widened on every write through the tile group, so they
+ * always cover all the values in the tile group, including old versions.
+ * In-place updates can leave them wider than necessary; they are then
+ * marked dirty and recomputed lazily in the background by the tile group
+ * freezer (see Refresh). Scans never rebuild them.
+ *
+ * Only fixed-length types are tracked; variable-length columns never let
+ * a tile group be skipped.
+ */
+class ZoneMap {
+  ZoneMap() = delete;
+
+ public:
+  // Zone map over columns of the given types, in table column order
+  ZoneMap(const std::vector<ValueType> &column_types);
+
+  ZoneMap(const ZoneMap &other);
+
+  ZoneMap &operator=(const ZoneMap &other) = delete;
+
+  //===--------------------------------------------------------------------===//
+  // Maintenance
+  //===--------------------------------------------------------------------===//
+
+  // Widen the synopses with a tuple laid out in the table schema. An update
+  // replaces old values, so it also marks the zone map dirty.
+  void UpdateTuple(const Tuple *tuple, const bool is_update);
+
+  // Widen the synopses with a batch of inserted tuples
+  void UpdateTuples(const Tuple *const *tuples, const oid_t tuple_count);
+
+  // Widen the synopsis of a single column (value written in place)
+  void UpdateValue(const oid_t column_id, const Value &value);
+
+  // Recompute the synopses from the tile group contents if dirty. The
+  // tile group is scanned without holding the lock.
+  void Refresh(TileGroup *tile_group);
+
+  // Contents changed behind our back, recompute before the next use
+  void Invalidate() { dirty_ = true; }
+
+  bool IsDirty() const { return dirty_; }
+
+  //===--------------------------------------------------------------------===//
+  // Pruning
+  //===--------------------------------------------------------------------===//
+
+  // Could any value in the column satisfy "column <comparison> value" ?
+  bool ComparisonMayMatch(const oid_t column_id,
+                          const ExpressionType comparison_type,
+                          const Value &value);
+
+  // Could any value in the column be null ?
+  bool IsNullMayMatch(const oid_t column_id);
+
+  // Synopses accessors (for tests and debugging)
+  bool IsTracked(const oid_t column_id) const {
+    return columns_[column_id].is_tracked;
+  }
+
+  Value GetMinValue(const oid_t column_id);
+
+  Value GetMaxValue(const oid_t column_id);
+
+  oid_t GetNullCount(const oid_t column_id);
+
+ private:
+  struct ColumnSynopsis {
+    bool is_tracked = false;
+
+    // has any non-null value been recorded ?
+    bool has_values = false;
+
+    Value min_value;
+
+    Value max_value;
+
+    oid_t null_count = 0;
+  };
+
+  // Must be called with the lock held
+  void Widen(ColumnSynopsis &column, const Value &value);
+
+  // Widen the synopsis of the column, and of the one being rebuilt if any.
+  // Must be called with the lock held.
+  void Record(const oid_t column_id, const Value &value);
+
+  //===--------------------------------------------------------------------===//
+  // Data members
+  //===--------------------------------------------------------------------===//
+
+  std::vector<ColumnSynopsis> columns_;
+
+  // set when an in-place update may have removed a min or max value
+  std::atomic<bool> dirty_;
+
+  // values written while Refresh scans the tile group
+  std::vector<ColumnSynopsis> pending_columns_;
+
+  bool is_refreshing_ = false;
+
+  Spinlock zone_map_lock_;
+};
+
+}  // End storage namespace
+}  // End peloton namespace
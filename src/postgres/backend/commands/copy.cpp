@@ -51,6 +51,9 @@
 #include "utils/rls.h"
 #include "utils/snapmgr.h"
 
+// TODO: Peloton Changes
+#include "postmaster/peloton.h"
+
 
 #define ISOCTAL(c) (((c) >= '0') && ((c) <= '7'))
 #define OCTVALUE(c) ((c) - '0')
@@ -2167,6 +2170,7 @@ CopyFrom(CopyState cstate)
 	BulkInsertState bistate;
 	uint64		processed = 0;
 	bool		useHeapMultiInsert;
+	bool		pelotonCopy;
 	int			nBufferedTuples = 0;
 
 #define MAX_BUFFERED_TUPLES 1000
@@ -2207,6 +2211,9 @@ CopyFrom(CopyState cstate)
 
 	tupDesc = RelationGetDescr(cstate->rel);
 
+	/* Peloton tables are bulk loaded by Peloton, a batch at a time */
+	pelotonCopy = IsPelotonQuery(list_make1_oid(RelationGetRelid(cstate->rel)));
+
 	/*----------
 	 * Check to see if we can avoid writing WAL
 	 *
@@ -2308,10 +2315,11 @@ CopyFrom(CopyState cstate)
 	 * inserting to, and act differently if the tuples that have already been
 	 * processed and prepared for insertion are not there.
 	 */
-	if ((resultRelInfo->ri_TrigDesc != NULL &&
+	if (!pelotonCopy &&
+		((resultRelInfo->ri_TrigDesc != NULL &&
 		 (resultRelInfo->ri_TrigDesc->trig_insert_before_row ||
 		  resultRelInfo->ri_TrigDesc->trig_insert_instead_row)) ||
-		cstate->volatile_defexprs)
+		cstate->volatile_defexprs))
 	{
 		useHeapMultiInsert = false;
 	}
@@ -2338,6 +2346,9 @@ CopyFrom(CopyState cstate)
 	bistate = GetBulkInsertState();
 	econtext = GetPerTupleExprContext(estate);
 
+	if (pelotonCopy)
+		peloton_copy_begin();
+
 	/* Set up callback to identify error line number */
 	errcallback.callback = CopyFromErrorCallback;
 	errcallback.arg = (void *) cstate;
@@ -2424,10 +2435,14 @@ CopyFrom(CopyState cstate)
 				if (nBufferedTuples == MAX_BUFFERED_TUPLES ||
 					bufferedTuplesSize > 65535)
 				{
-					CopyFromInsertBatch(cstate, estate, mycid, hi_options,
-										resultRelInfo, myslot, bistate,
-										nBufferedTuples, bufferedTuples,
-										firstBufferedLineNo);
+					if (pelotonCopy)
+						peloton_copy_from(RelationGetRelid(cstate->rel), tupDesc,
+										  bufferedTuples, nBufferedTuples);
+					else
+						CopyFromInsertBatch(cstate, estate, mycid, hi_options,
+											resultRelInfo, myslot, bistate,
+											nBufferedTuples, bufferedTuples,
+											firstBufferedLineNo);
 					nBufferedTuples = 0;
 					bufferedTuplesSize = 0;
 				}
@@ -2462,10 +2477,19 @@ CopyFrom(CopyState cstate)
 
 	/* Flush any remaining buffered tuples */
 	if (nBufferedTuples > 0)
-		CopyFromInsertBatch(cstate, estate, mycid, hi_options,
-							resultRelInfo, myslot, bistate,
-							nBufferedTuples, bufferedTuples,
-							firstBufferedLineNo);
+	{
+		if (pelotonCopy)
+			peloton_copy_from(RelationGetRelid(cstate->rel), tupDesc,
+							  bufferedTuples, nBufferedTuples);
+		else
+			CopyFromInsertBatch(cstate, estate, mycid, hi_options,
+								resultRelInfo, myslot, bistate,
+								nBufferedTuples, bufferedTuples,
+								firstBufferedLineNo);
+	}
+
+	if (pelotonCopy)
+		peloton_copy_end();
 
 	/* Done, clean up */
 	error_context_stack = errcallback.previous;
@@ -525,6 +525,17 @@ ExplainOnePlan(PlannedStmt *plannedstmt, IntoClause *into, ExplainState *es,
 	if (es->analyze)
 		ExplainPrintTriggers(es, queryDesc);
 
+	/* Print the runtime statistics of the Peloton executors */
+	if (es->analyze && queryDesc->estate->es_peloton_stats != NULL)
+	{
+		if (es->format == EXPLAIN_FORMAT_TEXT)
+			appendStringInfo(es->str, "Peloton Executor Statistics:\n%s",
+							 queryDesc->estate->es_peloton_stats);
+		else
+			ExplainPropertyText("Peloton Executor Statistics",
+								queryDesc->estate->es_peloton_stats, es);
+	}
+
 	/*
 	 * Close down the query and free resources.  Include time for this in the
 	 * total execution time (although it should be pretty minimal).
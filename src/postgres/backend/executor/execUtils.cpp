@@ -129,6 +129,7 @@ CreateExecutorState(void)
 
 	estate->es_top_eflags = 0;
 	estate->es_instrument = 0;
+	estate->es_peloton_stats = NULL;
 	estate->es_finished = false;
 
 	estate->es_exprcontexts = NIL;
@@ -26,6 +26,10 @@
 
 #include "backend/networking/rpc_client.h"
 #include "backend/common/logger.h"
+#include "backend/common/metrics.h"
+#include "backend/storage/stats_refresher.h"
+#include "backend/storage/tile_group_freezer.h"
+#include "backend/brain/layout_reorganizer.h"
 #include "backend/common/serializer.h"
 #include "backend/bridge/ddl/configuration.h"
 #include "backend/bridge/ddl/ddl.h"
@@ -33,6 +37,10 @@
 #include "backend/bridge/ddl/tests/bridge_test.h"
 #include "backend/bridge/dml/executor/plan_executor.h"
 #include "backend/bridge/dml/mapper/mapper.h"
+#include "backend/bridge/dml/tuple/tuple_transformer.h"
+#include "backend/catalog/manager.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/database.h"
 #include "backend/logging/log_manager.h"
 #include "backend/logging/checkpoint_manager.h"
 #include "backend/planner/seq_scan_plan.h"
@@ -40,6 +48,7 @@
 
 #include "postgres.h"
 #include "c.h"
+#include "access/htup_details.h"
 #include "access/xact.h"
 #include "access/transam.h"
 #include "access/tupdesc.h"
@@ -87,6 +96,13 @@ static void peloton_send_output(const peloton_status&  status,
 
 static void __attribute__((unused)) peloton_test_config();
 
+static void peloton_copy_xact_callback(XactEvent event, void *arg);
+
+static void peloton_stop_services(int code, Datum arg);
+
+/* Did the COPY in progress begin its own Peloton transaction ? */
+static bool peloton_copy_txn = false;
+
 /* ----------
  * peloton_bootstrap -
  *
@@ -173,6 +189,40 @@ peloton_bootstrap() {
     	}
       }
     }
+
+    // Periodically write the metrics into the stats file
+    if (peloton_metrics_interval_millis > 0) {
+      peloton::MetricsRegistry::GetInstance().StartReporter(
+          "peloton_metrics", peloton_metrics_interval_millis);
+    }
+
+    // Periodically re-analyze the tables with stale stats
+    if (peloton_stats_refresh_interval_millis > 0) {
+      peloton::storage::StatsRefresher::GetInstance().StartRefresher(
+          peloton_stats_refresh_interval_millis);
+    }
+
+    bool started_services = false;
+
+    // Adapt the table layouts to the sampled column accesses
+    auto &layout_reorganizer = peloton::brain::LayoutReorganizer::GetInstance();
+    if (peloton_reorganizer_interval_millis > 0 &&
+        layout_reorganizer.GetStatus() == false) {
+      layout_reorganizer.StartReorganizer(peloton_reorganizer_interval_millis);
+      started_services = true;
+    }
+
+    // Compress the cold tile groups
+    auto &tile_group_freezer = peloton::storage::TileGroupFreezer::GetInstance();
+    if (peloton_freezer_interval_millis > 0 &&
+        tile_group_freezer.GetStatus() == false) {
+      tile_group_freezer.StartFreezer(peloton_freezer_interval_millis);
+      started_services = true;
+    }
+
+    if (started_services == true) {
+      on_proc_exit(peloton_stop_services, 0);
+    }
   }
   catch(const std::exception &exception) {
     elog(ERROR, "Peloton exception :: %s", exception.what());
@@ -180,6 +230,20 @@ peloton_bootstrap() {
 
 }
 
+/* ----------
+ * peloton_stop_services -
+ *
+ *  Stop the background services of Peloton when the process exits, before
+ *  the tables they work on are destroyed.
+ * ----------
+ */
+static void
+peloton_stop_services(int code __attribute__((unused)),
+                      Datum arg __attribute__((unused))) {
+  peloton::brain::LayoutReorganizer::GetInstance().StopReorganizer();
+  peloton::storage::TileGroupFreezer::GetInstance().StopFreezer();
+}
+
 /* ----------
  * peloton_ddl -
  *
@@ -256,9 +320,13 @@ peloton_dml(const PlanState *planstate,
 
   // Execute the plantree mapped_plan_ptr.get()
   try {
+    // Collect the executor statistics for EXPLAIN ANALYZE
+    bool collect_stats = (planstate->state->es_instrument != 0);
+
     status = peloton::bridge::PlanExecutor::ExecutePlan(mapped_plan_ptr.get(),
                                                         param_values,
-                                                        tuple_desc);
+                                                        tuple_desc,
+                                                        collect_stats);
   }
   catch(const std::exception &exception) {
     elog(ERROR, "Peloton exception :: %s", exception.what());
@@ -267,6 +335,11 @@ peloton_dml(const PlanState *planstate,
   // Wait for the response and process it
   peloton_process_status(status, planstate);
 
+  // Hand over the executor statistics to EXPLAIN ANALYZE
+  if (status.m_executor_stats.empty() == false) {
+    planstate->state->es_peloton_stats = pstrdup(status.m_executor_stats.c_str());
+  }
+
   // Send output to dest
   peloton_send_output(status, sendTuples, dest, backend_state);
 
@@ -409,6 +482,148 @@ bool IsPelotonQuery(List *relationOids) {
   return peloton_query;
 }
 
+/* ----------
+ * peloton_copy_begin -
+ *
+ *  Start a COPY into a Peloton table. All the batches of the COPY are
+ *  inserted in a single Peloton transaction.
+ * ----------
+ */
+void
+peloton_copy_begin() {
+  static bool callback_registered = false;
+
+  // Abort the transaction of a COPY that failed
+  if(callback_registered == false) {
+    RegisterXactCallback(peloton_copy_xact_callback, NULL);
+    callback_registered = true;
+  }
+
+  if(peloton::concurrency::current_txn == nullptr) {
+    auto &txn_manager = peloton::concurrency::TransactionManagerFactory::GetInstance();
+    txn_manager.BeginTransaction();
+    peloton_copy_txn = true;
+  }
+}
+
+/* ----------
+ * peloton_copy_from -
+ *
+ *  Bulk load a batch of COPY tuples into a Peloton table.
+ * ----------
+ */
+void
+peloton_copy_from(Oid relation_id,
+                  TupleDesc tuple_desc,
+                  HeapTuple *tuples,
+                  int tuple_count) {
+  auto &txn_manager = peloton::concurrency::TransactionManagerFactory::GetInstance();
+  bool inserted = true;
+
+  try {
+    auto &manager = peloton::catalog::Manager::GetInstance();
+    auto database = manager.GetDatabaseWithOid(
+        peloton::bridge::Bridge::GetCurrentDatabaseOid());
+    auto table = database->GetTableWithOid(relation_id);
+    auto schema = table->GetSchema();
+
+    peloton::VarlenPool pool(peloton::BACKEND_TYPE_MM);
+    Datum *values = (Datum *) palloc(tuple_desc->natts * sizeof(Datum));
+    bool *nulls = (bool *) palloc(tuple_desc->natts * sizeof(bool));
+
+    // Convert the heap tuples
+    std::vector<std::unique_ptr<peloton::storage::Tuple>> peloton_tuples;
+    std::vector<const peloton::storage::Tuple *> insert_tuples;
+    for(int tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+      heap_deform_tuple(tuples[tuple_itr], tuple_desc, values, nulls);
+
+      peloton_tuples.emplace_back(new peloton::storage::Tuple(schema, true));
+      for(int att_itr = 0; att_itr < tuple_desc->natts; att_itr++) {
+        peloton::Value value;
+        if(nulls[att_itr] == true) {
+          value = peloton::ValueFactory::GetNullValueByType(schema->GetType(att_itr));
+        }
+        else {
+          value = peloton::bridge::TupleTransformer::GetValue(
+              values[att_itr], tuple_desc->attrs[att_itr]->atttypid);
+        }
+        peloton_tuples.back()->SetValue(att_itr, value, &pool);
+      }
+      insert_tuples.push_back(peloton_tuples.back().get());
+    }
+
+    pfree(values);
+    pfree(nulls);
+
+    std::vector<peloton::ItemPointer> locations;
+    inserted = table->InsertTuples(insert_tuples, locations);
+
+    for(auto &location : locations) {
+      if(inserted == false) break;
+      inserted = txn_manager.PerformInsert(location);
+    }
+  }
+  catch(const std::exception &exception) {
+    elog(ERROR, "Peloton exception :: %s", exception.what());
+  }
+
+  if(inserted == false) {
+    txn_manager.SetTransactionResult(peloton::Result::RESULT_FAILURE);
+    elog(ERROR, "Peloton COPY failed to insert into relation %u", relation_id);
+  }
+}
+
+/* ----------
+ * peloton_copy_end -
+ *
+ *  Commit the transaction of the COPY, if it began one.
+ * ----------
+ */
+void
+peloton_copy_end() {
+  if(peloton_copy_txn == false) {
+    return;
+  }
+  peloton_copy_txn = false;
+
+  auto &txn_manager = peloton::concurrency::TransactionManagerFactory::GetInstance();
+  auto result = txn_manager.CommitTransaction();
+
+  if(result != peloton::Result::RESULT_SUCCESS) {
+    elog(ERROR, "Peloton COPY transaction could not commit");
+  }
+}
+
+/* ----------
+ * peloton_wait_for_commit -
+ *
+ *  In pipelined commit mode, the commits return before their log records
+ *  are durable. Hold the reply to the client until they are.
+ * ----------
+ */
+void
+peloton_wait_for_commit() {
+  auto &log_manager = peloton::logging::LogManager::GetInstance();
+  log_manager.WaitForDeferredAcknowledgement();
+}
+
+/* ----------
+ * peloton_copy_xact_callback -
+ *
+ *  Abort the Peloton transaction of a COPY that raised an error.
+ * ----------
+ */
+static void
+peloton_copy_xact_callback(XactEvent event, void *arg __attribute__((unused))) {
+  if(event != XACT_EVENT_ABORT || peloton_copy_txn == false) {
+    return;
+  }
+  peloton_copy_txn = false;
+
+  auto &txn_manager = peloton::concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.AbortTransaction();
+}
+
 //===--------------------------------------------------------------------===//
 // Serialization/Deserialization
 //===--------------------------------------------------------------------===//
@@ -3580,6 +3580,9 @@ void PostgresMain(int argc, char *argv[], const char *dbname,
         pgstat_report_activity(STATE_IDLE, NULL);
       }
 
+      /* Pipelined Peloton commits must be durable before the reply */
+      peloton_wait_for_commit();
+
       ReadyForQuery(whereToSendOutput);
       send_ready_for_query = false;
     }
@@ -444,6 +444,17 @@ static const struct config_enum_entry peloton_checkpoint_mode_options[] = {
     {"normal", CHECKPOINT_TYPE_NORMAL, false},
     {NULL, 0, false}};
 
+/* Possible values for peloton_execution_mode GUC */
+typedef enum ExecutionType {
+  EXECUTION_TYPE_PULL, /* Tile-at-a-time iterators */
+  EXECUTION_TYPE_PUSH  /* Pipelines */
+} ExecutionType;
+
+static const struct config_enum_entry peloton_execution_mode_options[] = {
+    {"pull", EXECUTION_TYPE_PULL, false},
+    {"push", EXECUTION_TYPE_PUSH, false},
+    {NULL, 0, false}};
+
 /*
  * Options for enum values stored in other modules
  */
@@ -521,6 +532,9 @@ GCType peloton_gc_mode;
 // Checkpoint mode
 CheckpointType peloton_checkpoint_mode;
 
+// Execution mode
+ExecutionType peloton_execution_mode;
+
 // Directory for peloton logs
 char *peloton_log_directory;
 
@@ -529,6 +543,18 @@ int64_t peloton_wait_timeout;
 
 int peloton_flush_frequency_micros;
 
+// Metrics stats file interval (0 disables the stats file)
+int peloton_metrics_interval_millis;
+
+// Table stats refresh interval (0 disables the background refresh)
+int peloton_stats_refresh_interval_millis;
+
+// Layout reorganizer interval (0 disables the reorganizer)
+int peloton_reorganizer_interval_millis;
+
+// Tile group freezer interval (0 disables the freezer)
+int peloton_freezer_interval_millis;
+
 /*
  * This really belongs in pg_shmem.c, but is defined here so that it doesn't
  * need to be duplicated in all the different implementations of pg_shmem.c.
@@ -2838,6 +2864,65 @@ struct config_int ConfigureNamesInt[] = {
      NULL,
      NULL},
 
+    {{"peloton_metrics_interval_millis", PGC_POSTMASTER, STATS_MONITORING,
+      gettext_noop("Sets the interval at which Peloton metrics are written."),
+      gettext_noop("The metrics are periodically written to the "
+                   "peloton_metrics file in the data directory. "
+                   "Zero disables the metrics file."),
+      GUC_UNIT_MS},
+     &peloton_metrics_interval_millis,
+     0,
+     0,
+     INT_MAX,
+     NULL,
+     NULL},
+
+    {{"peloton_stats_refresh_interval_millis", PGC_POSTMASTER, AUTOVACUUM,
+      gettext_noop("Sets the interval at which stale Peloton table stats "
+                   "are refreshed."),
+      gettext_noop("Tables modified enough since their last analysis are "
+                   "sampled again in the background. "
+                   "Zero disables the background refresh."),
+      GUC_UNIT_MS},
+     &peloton_stats_refresh_interval_millis,
+     60000,
+     0,
+     INT_MAX,
+     NULL,
+     NULL},
+
+    {{"peloton_reorganizer_interval_millis", PGC_POSTMASTER,
+      PELOTON_LAYOUT_OPTIONS,
+      gettext_noop("Sets the interval at which Peloton table layouts are "
+                   "adapted to the workload."),
+      gettext_noop("The scans sample the columns they access, and the "
+                   "immutable tile groups are transformed into the layout "
+                   "computed from the samples in the background. "
+                   "Zero disables the layout reorganizer."),
+      GUC_UNIT_MS},
+     &peloton_reorganizer_interval_millis,
+     1000,
+     0,
+     INT_MAX,
+     NULL,
+     NULL},
+
+    {{"peloton_freezer_interval_millis", PGC_POSTMASTER,
+      PELOTON_LAYOUT_OPTIONS,
+      gettext_noop("Sets the interval at which cold Peloton tile groups are "
+                   "compressed."),
+      gettext_noop("The tile groups whose tuples stay committed and "
+                   "unmodified across passes are replaced with compressed "
+                   "copies, and the zone maps are refreshed. "
+                   "Zero disables the tile group freezer."),
+      GUC_UNIT_MS},
+     &peloton_freezer_interval_millis,
+     1000,
+     0,
+     INT_MAX,
+     NULL,
+     NULL},
+
     /* End-of-list marker */
     {{NULL, static_cast<GucContext>(0), static_cast<config_group>(0), NULL,
       NULL},
@@ -3853,6 +3938,17 @@ struct config_enum ConfigureNamesEnum[] = {
      NULL,
      NULL},
 
+    {{"peloton_execution_mode", PGC_USERSET, PELOTON_EXECUTION_OPTIONS,
+      gettext_noop("Change peloton execution mode"),
+      gettext_noop("This determines whether plans are run by pull-based "
+                   "executors or push-based pipelines.")},
+     reinterpret_cast<int *>(&peloton_execution_mode),
+     EXECUTION_TYPE_PULL,
+     peloton_execution_mode_options,
+     NULL,
+     NULL,
+     NULL},
+
     /* End-of-list marker */
     {{NULL, static_cast<GucContext>(0), static_cast<config_group>(0), NULL,
       NULL},
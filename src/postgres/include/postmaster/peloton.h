@@ -29,6 +29,11 @@
 
 extern LoggingType peloton_logging_mode;
 extern GCType peloton_gc_mode;
+extern ExecutionType peloton_execution_mode;
+extern int peloton_metrics_interval_millis;
+extern int peloton_stats_refresh_interval_millis;
+extern int peloton_reorganizer_interval_millis;
+extern int peloton_freezer_interval_millis;
 
 //===--------------------------------------------------------------------===//
 // Peloton_Status     Sent by the peloton to share the status with backend.
@@ -41,6 +46,9 @@ typedef struct peloton_status {
   // number of tuples processed
   uint32_t m_processed;
 
+  // runtime statistics of the executors, if requested (not serialized)
+  std::string m_executor_stats;
+
   peloton_status(){
     m_processed = 0;
     m_result = peloton::RESULT_SUCCESS;
@@ -78,5 +86,16 @@ extern void peloton_dml(const PlanState *planstate,
                         const char *prepStmtName,
                         BackendContext *backend_state);
 
+extern void peloton_copy_begin();
+
+extern void peloton_copy_from(Oid relation_id,
+                              TupleDesc tuple_desc,
+                              HeapTuple *tuples,
+                              int tuple_count);
+
+extern void peloton_copy_end();
+
+extern void peloton_wait_for_commit();
+
 #endif   /* PELOTON_H */
 
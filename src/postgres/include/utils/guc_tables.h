@@ -105,7 +105,8 @@ enum config_group
 	PELOTON_GC_OPTIONS,
         PELOTON_CACHING_OPTIONS,
         PELOTON_CLUSTERING_OPTIONS,
-	PELOTON_CHECKPOINT_OPTIONS
+	PELOTON_CHECKPOINT_OPTIONS,
+	PELOTON_EXECUTION_OPTIONS
 };
 
 /*
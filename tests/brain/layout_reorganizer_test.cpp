@@ -0,0 +1,121 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// layout_reorganizer_test.cpp
+//
+// Identification: tests/brain/layout_reorganizer_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "harness.h"
+
+#include "backend/brain/layout_reorganizer.h"
+#include "backend/brain/sample.h"
+#include "backend/catalog/schema.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/table_factory.h"
+#include "backend/storage/tile_group.h"
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Layout Reorganizer Tests
+//===--------------------------------------------------------------------===//
+
+class LayoutReorganizerTests : public PelotonTest {};
+
+TEST_F(LayoutReorganizerTests, ReorganizeTest) {
+  const int tuples_per_tilegroup_count = 10;
+  const int tile_group_count = 4;
+  const int tuple_count = tuples_per_tilegroup_count * tile_group_count;
+
+  // Adaptive table with the same columns as the executor test tables
+  catalog::Schema *table_schema = new catalog::Schema(
+      {ExecutorTestsUtil::GetColumnInfo(0), ExecutorTestsUtil::GetColumnInfo(1),
+       ExecutorTestsUtil::GetColumnInfo(2),
+       ExecutorTestsUtil::GetColumnInfo(3)});
+  std::unique_ptr<storage::DataTable> data_table(
+      storage::TableFactory::GetDataTable(
+          INVALID_OID, INVALID_OID, table_schema, "TEST_TABLE",
+          tuples_per_tilegroup_count, true, true));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, false,
+                                   false);
+  txn_manager.CommitTransaction();
+
+  // Remember the values before the layout changes
+  std::vector<std::vector<Value>> orig_values;
+  for (oid_t tile_group_itr = 0; tile_group_itr < (oid_t)tile_group_count;
+       tile_group_itr++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    for (oid_t tuple_itr = 0; tuple_itr < (oid_t)tuples_per_tilegroup_count;
+         tuple_itr++) {
+      std::vector<Value> tuple_values;
+      for (oid_t column_itr = 0; column_itr < 4; column_itr++) {
+        tuple_values.push_back(tile_group->GetValue(tuple_itr, column_itr));
+      }
+      orig_values.push_back(tuple_values);
+    }
+  }
+
+  // Two queries that access disjoint pairs of columns
+  for (oid_t sample_itr = 0; sample_itr < REORGANIZER_MIN_SAMPLE_COUNT;
+       sample_itr++) {
+    if (sample_itr % 2 == 0) {
+      data_table->RecordSample(brain::Sample({1, 1, 0, 0}));
+    } else {
+      data_table->RecordSample(brain::Sample({0, 0, 1, 1}));
+    }
+  }
+
+  brain::LayoutReorganizer reorganizer;
+
+  // Transform one tile group at a time
+  oid_t transform_count = 0;
+  for (int pass_itr = 0; pass_itr < tile_group_count; pass_itr++) {
+    auto count = reorganizer.Reorganize(data_table.get(), 1);
+    EXPECT_LE(count, 1u);
+    transform_count += count;
+  }
+  EXPECT_EQ(1u, reorganizer.GetPartitionUpdateCount());
+  EXPECT_EQ(transform_count, reorganizer.GetTransformCount());
+
+  // All the full tile groups are now in the default partition
+  auto default_partition = data_table->GetDefaultPartition();
+  for (oid_t tile_group_itr = 0; tile_group_itr < (oid_t)tile_group_count;
+       tile_group_itr++) {
+    if (data_table->IsTileGroupImmutable(tile_group_itr) == false) continue;
+
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    EXPECT_EQ(0, tile_group->GetSchemaDifference(default_partition));
+  }
+
+  // Nothing left to do
+  EXPECT_EQ(0u, reorganizer.Reorganize(data_table.get(), tile_group_count));
+
+  // Values must be the same as before
+  for (oid_t tile_group_itr = 0; tile_group_itr < (oid_t)tile_group_count;
+       tile_group_itr++) {
+    auto tile_group = data_table->GetTileGroup(tile_group_itr);
+    for (oid_t tuple_itr = 0; tuple_itr < (oid_t)tuples_per_tilegroup_count;
+         tuple_itr++) {
+      auto &tuple_values =
+          orig_values[tile_group_itr * tuples_per_tilegroup_count + tuple_itr];
+      for (oid_t column_itr = 0; column_itr < 4; column_itr++) {
+        Value value = tile_group->GetValue(tuple_itr, column_itr);
+        EXPECT_EQ(0, tuple_values[column_itr].Compare(value));
+      }
+    }
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
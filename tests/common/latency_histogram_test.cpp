@@ -0,0 +1,95 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// latency_histogram_test.cpp
+//
+// Identification: tests/common/latency_histogram_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "harness.h"
+
+#include "backend/common/latency_histogram.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Latency Histogram Test
+//===--------------------------------------------------------------------===//
+
+class LatencyHistogramTest : public PelotonTest {};
+
+TEST_F(LatencyHistogramTest, SmallValuesTest) {
+  LatencyHistogram histogram;
+
+  EXPECT_EQ(0U, histogram.GetCount());
+  EXPECT_EQ(0U, histogram.GetPercentile(50));
+
+  // Small values are counted exactly
+  for (uint64_t value = 1; value <= 10; value++) {
+    histogram.Record(value);
+  }
+
+  EXPECT_EQ(10U, histogram.GetCount());
+  EXPECT_EQ(1U, histogram.GetMin());
+  EXPECT_EQ(10U, histogram.GetMax());
+  EXPECT_DOUBLE_EQ(5.5, histogram.GetMean());
+  EXPECT_EQ(1U, histogram.GetPercentile(0));
+  EXPECT_EQ(5U, histogram.GetPercentile(50));
+  EXPECT_EQ(9U, histogram.GetPercentile(90));
+  EXPECT_EQ(10U, histogram.GetPercentile(100));
+}
+
+TEST_F(LatencyHistogramTest, PercentileErrorTest) {
+  LatencyHistogram histogram;
+
+  const uint64_t sample_count = 100000;
+  for (uint64_t value = 1; value <= sample_count; value++) {
+    histogram.Record(value);
+  }
+
+  // Large values are within the relative error of the histogram
+  const double max_error = 1.0 / (1 << LatencyHistogram::precision_bits);
+  for (double percentile : {10.0, 50.0, 90.0, 99.0, 99.9}) {
+    double expected = percentile / 100 * sample_count;
+    double reported = histogram.GetPercentile(percentile);
+
+    EXPECT_GE(reported, expected);
+    EXPECT_LE(reported, expected * (1 + max_error));
+  }
+
+  EXPECT_EQ(sample_count, histogram.GetPercentile(100));
+
+  // Extreme values do not overflow the buckets
+  histogram.Record(UINT64_MAX);
+  EXPECT_EQ(UINT64_MAX, histogram.GetMax());
+  EXPECT_EQ(UINT64_MAX, histogram.GetPercentile(100));
+}
+
+TEST_F(LatencyHistogramTest, MergeTest) {
+  LatencyHistogram first, second;
+
+  for (uint64_t value = 0; value < 100; value++) {
+    first.Record(value);
+    second.Record(value + 1000);
+  }
+
+  first.Merge(second);
+
+  EXPECT_EQ(200U, first.GetCount());
+  EXPECT_EQ(0U, first.GetMin());
+  EXPECT_EQ(1099U, first.GetMax());
+  EXPECT_EQ(99U, first.GetPercentile(50));
+  EXPECT_GE(first.GetPercentile(75), 1049U);
+
+  first.Reset();
+  EXPECT_EQ(0U, first.GetCount());
+  EXPECT_EQ(0U, first.GetMax());
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -0,0 +1,124 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// metrics_test.cpp
+//
+// Identification: tests/common/metrics_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <sstream>
+#include <thread>
+#include <vector>
+
+#include "harness.h"
+
+#include "backend/common/metrics.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Metrics Test
+//===--------------------------------------------------------------------===//
+
+class MetricsTest : public PelotonTest {};
+
+TEST_F(MetricsTest, RegistrationTest) {
+  auto &metrics = MetricsRegistry::GetInstance();
+
+  auto counter_id = metrics.RegisterCounter("test.registration");
+  EXPECT_EQ(counter_id, metrics.RegisterCounter("test.registration"));
+  EXPECT_NE(counter_id, metrics.RegisterCounter("test.registration.other"));
+
+  // Unknown metrics read as empty
+  EXPECT_EQ(0U, metrics.GetCounter("test.unknown"));
+  EXPECT_EQ(0, metrics.GetGauge("test.unknown"));
+  EXPECT_EQ(0U, metrics.GetHistogram("test.unknown").GetCount());
+}
+
+TEST_F(MetricsTest, CounterTest) {
+  auto &metrics = MetricsRegistry::GetInstance();
+  auto counter_id = metrics.RegisterCounter("test.counter");
+
+  const size_t thread_count = 4;
+  const uint64_t increment_count = 10000;
+
+  // The counters of the threads survive the threads
+  std::vector<std::thread> threads;
+  for (size_t thread_itr = 0; thread_itr < thread_count; thread_itr++) {
+    threads.emplace_back([&metrics, counter_id, increment_count] {
+      for (uint64_t increment_itr = 0; increment_itr < increment_count;
+           increment_itr++) {
+        metrics.Increment(counter_id);
+      }
+    });
+  }
+
+  for (auto &thread : threads) {
+    thread.join();
+  }
+
+  metrics.Increment(counter_id, 5);
+
+  EXPECT_EQ(thread_count * increment_count + 5,
+            metrics.GetCounter("test.counter"));
+
+  metrics.Reset();
+  EXPECT_EQ(0U, metrics.GetCounter("test.counter"));
+
+  metrics.Increment(counter_id, 3);
+  EXPECT_EQ(3U, metrics.GetCounter("test.counter"));
+}
+
+TEST_F(MetricsTest, HistogramTest) {
+  auto &metrics = MetricsRegistry::GetInstance();
+  auto histogram_id = metrics.RegisterHistogram("test.histogram");
+
+  std::thread thread([&metrics, histogram_id] {
+    for (uint64_t value = 1; value <= 10; value++) {
+      metrics.Record(histogram_id, value);
+    }
+  });
+  thread.join();
+
+  metrics.Record(histogram_id, 100);
+
+  auto histogram = metrics.GetHistogram("test.histogram");
+  EXPECT_EQ(11U, histogram.GetCount());
+  EXPECT_EQ(1U, histogram.GetMin());
+  EXPECT_EQ(100U, histogram.GetMax());
+
+  metrics.Reset();
+  EXPECT_EQ(0U, metrics.GetHistogram("test.histogram").GetCount());
+}
+
+TEST_F(MetricsTest, DumpTest) {
+  auto &metrics = MetricsRegistry::GetInstance();
+
+  auto counter_id = metrics.RegisterCounter("test.dump.counter");
+  auto gauge_id = metrics.RegisterGauge("test.dump.gauge");
+  auto histogram_id = metrics.RegisterHistogram("test.dump.histogram");
+
+  metrics.Reset();
+  metrics.Increment(counter_id, 7);
+  metrics.SetGauge(gauge_id, 42);
+  metrics.SetGauge(gauge_id, -3);
+  metrics.Record(histogram_id, 12);
+
+  EXPECT_EQ(-3, metrics.GetGauge("test.dump.gauge"));
+
+  std::ostringstream dump;
+  metrics.Dump(dump);
+
+  auto info = dump.str();
+  EXPECT_NE(std::string::npos, info.find("counter test.dump.counter 7\n"));
+  EXPECT_NE(std::string::npos, info.find("gauge test.dump.gauge -3\n"));
+  EXPECT_NE(std::string::npos, info.find("histogram test.dump.histogram "));
+}
+
+}  // End test namespace
+}  // End peloton namespace
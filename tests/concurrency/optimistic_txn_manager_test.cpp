@@ -29,5 +29,47 @@ TEST_F(OptimisticTxnManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+TEST_F(OptimisticTxnManagerTests, ReadRangeTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  std::unique_ptr<storage::DataTable> table(
+      TransactionTestsUtil::CreateTable());
+
+  // the first scan checks every tuple and marks the tile group all-visible
+  {
+    TransactionScheduler scheduler(1, table.get(), &txn_manager);
+    scheduler.Txn(0).Scan(0);
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[0].txn_result);
+  }
+
+  // the next ones record the tile group as a range
+  {
+    auto txn = txn_manager.BeginTransaction();
+    std::vector<int> results;
+    EXPECT_TRUE(
+        TransactionTestsUtil::ExecuteScan(txn, results, table.get(), 0));
+    EXPECT_EQ(10U, results.size());
+    EXPECT_EQ(1U, txn->GetReadRanges().size());
+    EXPECT_TRUE(txn->GetRWSet().empty());
+    EXPECT_EQ(RESULT_SUCCESS, txn_manager.CommitTransaction());
+  }
+
+  // a committed update of the range fails the validation
+  {
+    TransactionScheduler scheduler(2, table.get(), &txn_manager);
+    scheduler.Txn(0).Scan(0);
+    scheduler.Txn(1).Update(3, 1);
+    scheduler.Txn(1).Commit();
+    scheduler.Txn(0).Update(5, 2);
+    scheduler.Txn(0).Commit();
+    scheduler.Run();
+    EXPECT_EQ(RESULT_SUCCESS, scheduler.schedules[1].txn_result);
+    EXPECT_EQ(RESULT_ABORTED, scheduler.schedules[0].txn_result);
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -12,6 +12,9 @@
 
 #include "harness.h"
 #include "concurrency/transaction_tests_util.h"
+#include "backend/common/exception.h"
+#include "backend/concurrency/lock_wait_table.h"
+#include "backend/concurrency/pessimistic_txn_manager.h"
 
 namespace peloton {
 
@@ -29,5 +32,58 @@ TEST_F(PessimisticTxnManagerTests, Test) {
   EXPECT_TRUE(true);
 }
 
+TEST_F(PessimisticTxnManagerTests, WaitDieTest) {
+  concurrency::LockWaitTable lock_wait_table;
+  lock_wait_table.SetTimeout(1000 * 1000);
+  ItemPointer location(1, 1);
+
+  // txn 20 holds a read lock on the tuple
+  lock_wait_table.AddReader(location, 20);
+
+  // a younger txn dies
+  EXPECT_FALSE(lock_wait_table.Wait(location, 30, INITIAL_TXN_ID, false,
+                                    []() { return true; }));
+
+  // an older txn waits until the reader is gone
+  std::atomic<bool> released(false);
+  std::thread reader([&]() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    released = true;
+    lock_wait_table.RemoveReader(location, 20);
+  });
+  EXPECT_TRUE(lock_wait_table.Wait(location, 10, INITIAL_TXN_ID, false,
+                                   [&]() { return released.load(); }));
+  reader.join();
+
+  // a txn dies against an older writer
+  EXPECT_FALSE(lock_wait_table.Wait(location, 15, 12, false,
+                                    []() { return true; }));
+
+  auto stats = lock_wait_table.GetStats();
+  EXPECT_EQ(1U, stats.wait_count);
+  EXPECT_EQ(2U, stats.die_count);
+  EXPECT_EQ(0U, stats.timeout_count);
+  EXPECT_LT(0, stats.average_wait_time);
+}
+
+TEST_F(PessimisticTxnManagerTests, WaitDieTimestampTypeTest) {
+  auto &txn_manager = concurrency::PessimisticTxnManager::GetInstance();
+
+  // decentralized txn ids do not follow the begin order
+  txn_manager.SetTimestampType(TIMESTAMP_TYPE_DECENTRALIZED);
+  EXPECT_THROW(txn_manager.SetLockWaitType(LOCK_WAIT_TYPE_WAIT_DIE),
+               Exception);
+  EXPECT_EQ(LOCK_WAIT_TYPE_NO_WAIT, txn_manager.GetLockWaitType());
+
+  // either way around
+  txn_manager.SetTimestampType(TIMESTAMP_TYPE_CENTRALIZED);
+  txn_manager.SetLockWaitType(LOCK_WAIT_TYPE_WAIT_DIE);
+  EXPECT_THROW(txn_manager.SetTimestampType(TIMESTAMP_TYPE_DECENTRALIZED),
+               Exception);
+  EXPECT_EQ(TIMESTAMP_TYPE_CENTRALIZED, txn_manager.GetTimestampType());
+
+  txn_manager.SetLockWaitType(LOCK_WAIT_TYPE_NO_WAIT);
+}
+
 }  // End test namespace
 }  // End peloton namespace
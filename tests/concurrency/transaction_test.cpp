@@ -10,6 +10,11 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
 #include "harness.h"
 #include "concurrency/transaction_tests_util.h"
 
@@ -230,5 +235,184 @@ TEST_F(TransactionTests, AbortTest) {
   }
 }
 
+void TimestampTest(concurrency::TransactionManager *txn_manager,
+                   std::mutex *timestamp_mutex,
+                   std::vector<txn_id_t> *txn_ids,
+                   std::vector<cid_t> *cids) {
+  std::vector<txn_id_t> local_txn_ids;
+  std::vector<cid_t> local_cids;
+
+  for (oid_t txn_itr = 1; txn_itr <= 2000; txn_itr++) {
+    local_txn_ids.push_back(txn_manager->GetNextTransactionId());
+    local_cids.push_back(txn_manager->GetNextCommitId());
+  }
+
+  // commit ids of a thread are strictly increasing
+  for (size_t cid_itr = 1; cid_itr < local_cids.size(); cid_itr++) {
+    EXPECT_LT(local_cids[cid_itr - 1], local_cids[cid_itr]);
+  }
+
+  std::lock_guard<std::mutex> lock(*timestamp_mutex);
+  txn_ids->insert(txn_ids->end(), local_txn_ids.begin(), local_txn_ids.end());
+  cids->insert(cids->end(), local_cids.begin(), local_cids.end());
+}
+
+TEST_F(TransactionTests, DecentralizedTimestampTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC, ISOLATION_LEVEL_TYPE_FULL,
+      TIMESTAMP_TYPE_DECENTRALIZED);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto start_cid = txn_manager.GetCurrentCommitId();
+
+  std::mutex timestamp_mutex;
+  std::vector<txn_id_t> txn_ids;
+  std::vector<cid_t> cids;
+  LaunchParallelTest(8, TimestampTest, &txn_manager, &timestamp_mutex,
+                     &txn_ids, &cids);
+
+  // transaction ids and commit ids are unique across threads
+  std::sort(txn_ids.begin(), txn_ids.end());
+  std::sort(cids.begin(), cids.end());
+  EXPECT_EQ(txn_ids.end(), std::adjacent_find(txn_ids.begin(), txn_ids.end()));
+  EXPECT_EQ(cids.end(), std::adjacent_find(cids.begin(), cids.end()));
+  EXPECT_LE(start_cid, cids.front());
+
+  // the shared counter takes over from the clock
+  auto last_cid = cids.back();
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  EXPECT_LT(last_cid, txn_manager.GetNextCommitId());
+}
+
+TEST_F(TransactionTests, EpochSlotTest) {
+  // short epochs to get the horizon computed sooner
+  const size_t epoch_length = 5;
+  concurrency::EpochManagerFactory::Configure(EPOCH_TYPE_SLOT, epoch_length);
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+  auto &epoch_manager = concurrency::EpochManagerFactory::GetInstance();
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  auto txn = txn_manager.BeginTransaction();
+  auto begin_cid = txn->GetBeginCommitId();
+
+  // The running transaction holds back the horizon
+  std::this_thread::sleep_for(4 * std::chrono::milliseconds(epoch_length));
+  EXPECT_LE(epoch_manager.GetMaxDeadTxnCid(), begin_cid);
+
+  txn_manager.CommitTransaction();
+
+  // It moves past the transaction once it is done
+  std::this_thread::sleep_for(4 * std::chrono::milliseconds(epoch_length));
+  EXPECT_LT(begin_cid, epoch_manager.GetMaxDeadTxnCid());
+
+  // A published lower bound holds back the horizon, as for a transaction
+  // that is still drawing its begin cid
+  auto lower_bound = txn_manager.GetCurrentCommitId();
+  epoch_manager.PublishBeginCidBound(lower_bound);
+  txn_manager.GetNextCommitId();
+  txn_manager.GetNextCommitId();
+  std::this_thread::sleep_for(4 * std::chrono::milliseconds(epoch_length));
+  EXPECT_LE(epoch_manager.GetMaxDeadTxnCid(), lower_bound);
+
+  txn = txn_manager.BeginTransaction();
+  txn_manager.CommitTransaction();
+
+  concurrency::EpochManagerFactory::Configure(EPOCH_TYPE_QUEUE);
+}
+
+TEST_F(TransactionTests, TimestampSlotReuseTest) {
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC, ISOLATION_LEVEL_TYPE_FULL,
+      TIMESTAMP_TYPE_DECENTRALIZED);
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // More threads in total than there are slots : the slots of the threads
+  // that exited are reused
+  const size_t round_count = ((1U << TIMESTAMP_THREAD_BITS) / 8) + 2;
+
+  std::mutex timestamp_mutex;
+  std::vector<txn_id_t> txn_ids;
+  std::vector<cid_t> cids;
+  for (size_t round_itr = 0; round_itr < round_count; round_itr++) {
+    LaunchParallelTest(8, TimestampTest, &txn_manager, &timestamp_mutex,
+                       &txn_ids, &cids);
+  }
+
+  // still unique across all the threads
+  std::sort(cids.begin(), cids.end());
+  EXPECT_EQ(cids.end(), std::adjacent_find(cids.begin(), cids.end()));
+
+  concurrency::TransactionManagerFactory::Configure(
+      CONCURRENCY_TYPE_OPTIMISTIC);
+}
+
+TEST_F(TransactionTests, BatchVisibilityTest) {
+  const int tuple_count = 23;
+
+  for (auto test_type : TEST_TYPES) {
+    concurrency::TransactionManagerFactory::Configure(test_type);
+    auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+    auto txn = txn_manager.BeginTransaction();
+    cid_t snapshot = txn->GetBeginCommitId();
+    txn_id_t own_txn_id = txn->GetTransactionId();
+
+    storage::TileGroupHeader row_header(BACKEND_TYPE_MM, tuple_count,
+                                        HEADER_LAYOUT_TYPE_ROW);
+    storage::TileGroupHeader column_header(BACKEND_TYPE_MM, tuple_count,
+                                           HEADER_LAYOUT_TYPE_COLUMN);
+    EXPECT_EQ(nullptr, row_header.GetTransactionIdArray());
+    EXPECT_NE(nullptr, column_header.GetTransactionIdArray());
+
+    for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+      txn_id_t txn_id = INITIAL_TXN_ID;
+      cid_t begin_cid = snapshot - 1;
+      cid_t end_cid = MAX_CID;
+      switch (tuple_id % 6) {
+        case 1:  // not activated yet
+          begin_cid = snapshot + 1;
+          break;
+        case 2:  // invalidated
+          end_cid = snapshot;
+          break;
+        case 3:  // empty slot
+          txn_id = INVALID_TXN_ID;
+          break;
+        case 4:  // old version owned by another transaction
+          txn_id = own_txn_id + 1;
+          break;
+        case 5:  // own insert
+          txn_id = own_txn_id;
+          begin_cid = MAX_CID;
+          break;
+      }
+      row_header.SetTransactionId(tuple_id, txn_id);
+      row_header.SetBeginCommitId(tuple_id, begin_cid);
+      row_header.SetEndCommitId(tuple_id, end_cid);
+    }
+    column_header = row_header;
+    EXPECT_EQ(row_header.GetEndCommitId(2), column_header.GetEndCommitId(2));
+
+    std::vector<oid_t> expected;
+    for (oid_t tuple_id = 1; tuple_id < tuple_count; tuple_id++) {
+      if (txn_manager.IsVisible(&row_header, tuple_id)) {
+        expected.push_back(tuple_id);
+      }
+    }
+    EXPECT_FALSE(expected.empty());
+
+    std::vector<oid_t> row_selection;
+    txn_manager.GetVisibleTuples(&row_header, 1, tuple_count, row_selection);
+    EXPECT_EQ(expected, row_selection);
+
+    std::vector<oid_t> column_selection;
+    txn_manager.GetVisibleTuples(&column_header, 1, tuple_count,
+                                 column_selection);
+    EXPECT_EQ(expected, column_selection);
+
+    txn_manager.AbortTransaction();
+  }
+}
+
 }  // End test namespace
 }  // End peloton namespace
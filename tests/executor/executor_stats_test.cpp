@@ -0,0 +1,134 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// executor_stats_test.cpp
+//
+// Identification: tests/executor/executor_stats_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "harness.h"
+
+#include "backend/planner/limit_plan.h"
+
+#include "backend/common/types.h"
+#include "backend/executor/executor_stats.h"
+#include "backend/executor/logical_tile.h"
+#include "backend/executor/limit_executor.h"
+#include "backend/executor/logical_tile_factory.h"
+#include "backend/storage/data_table.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+
+#include "executor/executor_tests_util.h"
+#include "executor/mock_executor.h"
+
+using ::testing::NotNull;
+using ::testing::Return;
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Executor Stats Tests
+//===--------------------------------------------------------------------===//
+
+class ExecutorStatsTests : public PelotonTest {};
+
+TEST_F(ExecutorStatsTests, LimitStatsTest) {
+  size_t tile_size = 50;
+  size_t offset = 0, limit = tile_size * 3 / 2;
+
+  // Create the plan node
+  planner::LimitPlan node(limit, offset);
+
+  // Create and set up executor
+  executor::LimitExecutor executor(&node, nullptr);
+  MockExecutor child_executor;
+  executor.AddChild(&child_executor);
+
+  // Statistics are not collected by default
+  EXPECT_TRUE(executor.GetStats() == nullptr);
+  EXPECT_TRUE(child_executor.GetStats() == nullptr);
+
+  executor.EnableStats();
+  ASSERT_THAT(executor.GetStats(), NotNull());
+  ASSERT_THAT(child_executor.GetStats(), NotNull());
+
+  EXPECT_CALL(child_executor, DInit()).WillOnce(Return(true));
+
+  EXPECT_CALL(child_executor, DExecute())
+      .WillOnce(Return(true))
+      .WillOnce(Return(true));
+
+  // Create a table and wrap it in logical tiles
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tile_size));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tile_size * 3, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile1(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(0)));
+
+  std::unique_ptr<executor::LogicalTile> source_logical_tile2(
+      executor::LogicalTileFactory::WrapTileGroup(data_table->GetTileGroup(1)));
+
+  EXPECT_CALL(child_executor, GetOutput())
+      .WillOnce(Return(source_logical_tile1.release()))
+      .WillOnce(Return(source_logical_tile2.release()));
+
+  EXPECT_TRUE(executor.Init());
+
+  std::vector<std::unique_ptr<executor::LogicalTile>> result_tiles;
+  while (executor.Execute()) {
+    result_tiles.emplace_back(executor.GetOutput());
+  }
+
+  EXPECT_EQ(2U, result_tiles.size());
+
+  // The limit executor is called once more to find out that it is done
+  auto stats = executor.GetStats();
+  EXPECT_EQ(3U, stats->call_count);
+  EXPECT_EQ(2U, stats->tile_count);
+  EXPECT_EQ(limit, stats->tuple_count);
+  EXPECT_EQ(0U, stats->hash_table_size);
+  EXPECT_GE(stats->wall_time, 0);
+  EXPECT_GE(stats->cpu_time, 0);
+
+  // The child is executed from within its parent
+  auto child_stats = child_executor.GetStats();
+  EXPECT_EQ(2U, child_stats->call_count);
+  EXPECT_LE(child_stats->wall_time, stats->wall_time);
+
+  // One line per operator
+  auto info = executor::GetExecutorStatsInfo(&executor);
+  EXPECT_NE(std::string::npos, info.find("LIMIT"));
+  EXPECT_NE(std::string::npos, info.find("rows=" + std::to_string(limit)));
+
+  std::ostringstream dump;
+  executor::DumpExecutorStats(&executor, dump);
+
+  std::istringstream lines(dump.str());
+  std::string line;
+  std::vector<std::string> dump_lines;
+  while (std::getline(lines, line)) {
+    dump_lines.push_back(line);
+  }
+
+  ASSERT_EQ(2U, dump_lines.size());
+  EXPECT_EQ(0U, dump_lines[0].find("0 LIMIT 3 2 "));
+  EXPECT_EQ(0U, dump_lines[1].find("1 UNKNOWN 2 "));
+}
+
+}  // namespace test
+}  // namespace peloton
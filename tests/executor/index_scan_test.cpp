@@ -162,5 +162,200 @@ TEST_F(IndexScanTests, MultiColumnPredicateTest) {
   txn_manager.CommitTransaction();
 }
 
+// Index scan reading only key columns, with and without all-visible hints.
+TEST_F(IndexScanTests, IndexOnlyTest) {
+  // First, generate the table with index
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // Only the key column of the primary index
+  std::vector<oid_t> column_ids({0});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 <= 110
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(0);
+  std::vector<oid_t> key_column_ids({0});
+  std::vector<ExpressionType> expr_types(
+      {ExpressionType::EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO});
+  std::vector<Value> values({ValueFactory::GetIntegerValue(110)});
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+
+  planner::IndexScanPlan node(data_table.get(), nullptr, column_ids,
+                              index_scan_desc);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // The first pass checks the tuples, the second one trusts the hints
+  for (int pass = 0; pass < 2; pass++) {
+    if (pass == 1) {
+      for (oid_t tile_group_itr = 0;
+           tile_group_itr < data_table->GetTileGroupCount(); tile_group_itr++) {
+        data_table->GetTileGroup(tile_group_itr)
+            ->GetHeader()
+            ->TryMarkAllVisible();
+      }
+    }
+
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    executor::IndexScanExecutor executor(&node, context.get());
+    EXPECT_TRUE(executor.Init());
+
+    // The keys come in index order
+    int expected_value = 0;
+    while (executor.Execute() == true) {
+      std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+      EXPECT_EQ(1U, result_tile->GetColumnCount());
+
+      for (auto tuple_id : *result_tile) {
+        auto value = result_tile->GetValue(tuple_id, 0);
+        EXPECT_EQ(expected_value, ValuePeeker::PeekAsInteger(value));
+        expected_value += 10;
+      }
+    }
+
+    EXPECT_EQ(120, expected_value);
+
+    txn_manager.CommitTransaction();
+  }
+}
+
+TEST_F(IndexScanTests, IndexOnlyCountTest) {
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateAndPopulateTable());
+
+  // No column ids : all the columns of the table
+  std::vector<oid_t> column_ids;
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 <= 110
+  //===--------------------------------------------------------------------===//
+
+  auto index = data_table->GetIndex(0);
+  std::vector<oid_t> key_column_ids({0});
+  std::vector<ExpressionType> expr_types(
+      {ExpressionType::EXPRESSION_TYPE_COMPARE_LESSTHANOREQUALTO});
+  std::vector<Value> values({ValueFactory::GetIntegerValue(110)});
+  std::vector<expression::AbstractExpression *> runtime_keys;
+
+  planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+      index, key_column_ids, expr_types, values, runtime_keys);
+
+  planner::IndexScanPlan node(data_table.get(), nullptr, column_ids,
+                              index_scan_desc);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+
+  // The index does not cover the table : full tuples, then only the count
+  for (int pass = 0; pass < 2; pass++) {
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    executor::IndexScanExecutor executor(&node, context.get());
+    EXPECT_TRUE(executor.Init());
+    if (pass == 1) {
+      executor.SkipOutputColumns();
+    }
+
+    size_t tuple_count = 0;
+    while (executor.Execute() == true) {
+      std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+      EXPECT_EQ((pass == 0) ? 4U : 0U, result_tile->GetColumnCount());
+      tuple_count += result_tile->GetTupleCount();
+    }
+
+    EXPECT_EQ(12U, tuple_count);
+
+    txn_manager.CommitTransaction();
+  }
+}
+
+// Index scan of a tile group whose slots are in reverse key order.
+TEST_F(IndexScanTests, IndexOrderTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count));
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  for (int rowid = 0; rowid < tuple_count; rowid++) {
+    int populate_id = tuple_count - 1 - rowid;
+    storage::Tuple tuple(data_table->GetSchema(), true);
+    tuple.SetValue(0, ValueFactory::GetIntegerValue(
+                          ExecutorTestsUtil::PopulatedValue(populate_id, 0)),
+                   testing_pool);
+    tuple.SetValue(1, ValueFactory::GetIntegerValue(
+                          ExecutorTestsUtil::PopulatedValue(populate_id, 1)),
+                   testing_pool);
+    tuple.SetValue(2, ValueFactory::GetDoubleValue(
+                          ExecutorTestsUtil::PopulatedValue(populate_id, 2)),
+                   testing_pool);
+    tuple.SetValue(3, ValueFactory::GetStringValue(std::to_string(
+                          ExecutorTestsUtil::PopulatedValue(populate_id, 3))),
+                   testing_pool);
+
+    ItemPointer location = data_table->InsertTuple(&tuple);
+    EXPECT_NE(INVALID_OID, location.block);
+    txn_manager.PerformInsert(location);
+  }
+  txn_manager.CommitTransaction();
+
+  // A non-key column, so that the table is read
+  std::vector<oid_t> column_ids({0, 2});
+
+  //===--------------------------------------------------------------------===//
+  // ATTR 0 >= 0, through the primary and the secondary index
+  //===--------------------------------------------------------------------===//
+
+  for (oid_t index_itr = 0; index_itr < data_table->GetIndexCount();
+       index_itr++) {
+    auto index = data_table->GetIndex(index_itr);
+    std::vector<oid_t> key_column_ids({0});
+    std::vector<ExpressionType> expr_types(
+        {ExpressionType::EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO});
+    std::vector<Value> values({ValueFactory::GetIntegerValue(0)});
+    std::vector<expression::AbstractExpression *> runtime_keys;
+
+    planner::IndexScanPlan::IndexScanDesc index_scan_desc(
+        index, key_column_ids, expr_types, values, runtime_keys);
+
+    planner::IndexScanPlan node(data_table.get(), nullptr, column_ids,
+                                index_scan_desc);
+
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    executor::IndexScanExecutor executor(&node, context.get());
+    EXPECT_TRUE(executor.Init());
+
+    // The tuples come in index order, not in slot order
+    EXPECT_TRUE(executor.Execute());
+    std::unique_ptr<executor::LogicalTile> result_tile(executor.GetOutput());
+    EXPECT_EQ(tuple_count, static_cast<int>(result_tile->GetTupleCount()));
+
+    int expected_id = 0;
+    for (auto tuple_id : *result_tile) {
+      EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(expected_id, 0),
+                ValuePeeker::PeekAsInteger(result_tile->GetValue(tuple_id, 0)));
+      expected_id++;
+    }
+    EXPECT_EQ(tuple_count, expected_id);
+
+    EXPECT_FALSE(executor.Execute());
+
+    txn_manager.CommitTransaction();
+  }
+}
+
 }  // namespace test
 }  // namespace peloton
@@ -18,10 +18,12 @@
 #include "backend/executor/logical_tile.h"
 #include "backend/executor/logical_tile_factory.h"
 
+#include "backend/executor/executor_context.h"
 #include "backend/executor/hash_join_executor.h"
 #include "backend/executor/hash_executor.h"
 #include "backend/executor/merge_join_executor.h"
 #include "backend/executor/nested_loop_join_executor.h"
+#include "backend/executor/seq_scan_executor.h"
 
 #include "backend/expression/abstract_expression.h"
 #include "backend/expression/tuple_value_expression.h"
@@ -31,6 +33,7 @@
 #include "backend/planner/hash_plan.h"
 #include "backend/planner/merge_join_plan.h"
 #include "backend/planner/nested_loop_join_plan.h"
+#include "backend/planner/seq_scan_plan.h"
 
 #include "backend/storage/data_table.h"
 #include "backend/storage/tile.h"
@@ -206,6 +209,83 @@ TEST_F(JoinTests, SpeedTest) {
   ExecuteJoinTest(PLAN_NODE_TYPE_NESTLOOP, JOIN_TYPE_OUTER, SPEED_TEST);
 }
 
+TEST_F(JoinTests, JoinFilterTest) {
+  const int tuples_per_tile_group = 10;
+  const size_t left_tuple_count = 10 * tuples_per_tile_group;
+  const size_t right_tuple_count = tuples_per_tile_group;
+
+  // The right table holds the first rows of the left table
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> left_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(left_table.get(), left_tuple_count, false,
+                                   false, false);
+  std::unique_ptr<storage::DataTable> right_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(right_table.get(), right_tuple_count, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  // Only the probe side of inner and right joins can be filtered
+  for (auto join_type : {JOIN_TYPE_INNER, JOIN_TYPE_RIGHT, JOIN_TYPE_LEFT}) {
+    auto txn = txn_manager.BeginTransaction();
+    std::unique_ptr<executor::ExecutorContext> context(
+        new executor::ExecutorContext(txn));
+
+    std::vector<oid_t> column_ids = {0, 1};
+    planner::SeqScanPlan left_scan_node(left_table.get(), nullptr, column_ids);
+    executor::SeqScanExecutor left_scan_executor(&left_scan_node,
+                                                 context.get());
+    planner::SeqScanPlan right_scan_node(right_table.get(), nullptr,
+                                         column_ids);
+    executor::SeqScanExecutor right_scan_executor(&right_scan_node,
+                                                  context.get());
+
+    std::vector<std::unique_ptr<const expression::AbstractExpression>>
+        hash_keys;
+    hash_keys.emplace_back(
+        new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 1, 1));
+    planner::HashPlan hash_plan_node(hash_keys);
+    executor::HashExecutor hash_executor(&hash_plan_node, context.get());
+
+    std::unique_ptr<const expression::AbstractExpression> predicate(
+        JoinTestsUtil::CreateJoinPredicate());
+    auto schema = CreateJoinSchema();
+    planner::HashJoinPlan hash_join_plan_node(join_type, std::move(predicate),
+                                              JoinTestsUtil::CreateProjection(),
+                                              schema);
+    executor::HashJoinExecutor hash_join_executor(&hash_join_plan_node,
+                                                  context.get());
+
+    hash_join_executor.AddChild(&left_scan_executor);
+    hash_join_executor.AddChild(&hash_executor);
+    hash_executor.AddChild(&right_scan_executor);
+    hash_join_executor.EnableStats();
+
+    EXPECT_TRUE(hash_join_executor.Init());
+    size_t result_tuple_count = 0;
+    while (hash_join_executor.Execute() == true) {
+      std::unique_ptr<executor::LogicalTile> result_logical_tile(
+          hash_join_executor.GetOutput());
+      result_tuple_count += result_logical_tile->GetTupleCount();
+    }
+
+    txn_manager.CommitTransaction();
+
+    auto left_scan_tuple_count = left_scan_executor.GetStats()->tuple_count;
+    if (join_type == JOIN_TYPE_LEFT) {
+      EXPECT_EQ(left_tuple_count, result_tuple_count);
+      EXPECT_EQ(left_tuple_count, left_scan_tuple_count);
+    } else {
+      // The keys outside the first tile group are dropped by the scan
+      EXPECT_EQ(right_tuple_count, result_tuple_count);
+      EXPECT_LE(right_tuple_count, left_scan_tuple_count);
+      EXPECT_GT(2 * right_tuple_count, left_scan_tuple_count);
+    }
+  }
+}
+
 void ExecuteJoinTest(PlanNodeType join_algorithm, PelotonJoinType join_type,
                      oid_t join_test_type) {
   //===--------------------------------------------------------------------===//
@@ -0,0 +1,290 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// pipeline_executor_test.cpp
+//
+// Identification: tests/executor/pipeline_executor_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "harness.h"
+
+#include "backend/catalog/schema.h"
+#include "backend/common/types.h"
+#include "backend/common/value_factory.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/executor/aggregate_executor.h"
+#include "backend/executor/executor_context.h"
+#include "backend/executor/hash_executor.h"
+#include "backend/executor/hash_join_executor.h"
+#include "backend/executor/logical_tile.h"
+#include "backend/executor/pipeline_executor.h"
+#include "backend/executor/projection_executor.h"
+#include "backend/executor/seq_scan_executor.h"
+#include "backend/expression/expression_util.h"
+#include "backend/expression/tuple_value_expression.h"
+#include "backend/planner/aggregate_plan.h"
+#include "backend/planner/hash_join_plan.h"
+#include "backend/planner/hash_plan.h"
+#include "backend/planner/nested_loop_join_plan.h"
+#include "backend/planner/projection_plan.h"
+#include "backend/planner/seq_scan_plan.h"
+#include "backend/storage/data_table.h"
+
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+class PipelineExecutorTests : public PelotonTest {};
+
+namespace {
+
+const int tuples_per_tile_group = 10;
+
+const int tuple_count = 45;
+
+storage::DataTable *CreateTable() {
+  auto table =
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false);
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, false);
+  txn_manager.CommitTransaction();
+
+  return table;
+}
+
+/**
+ * @brief Run the executor and return its output rows, one string per row.
+ */
+std::multiset<std::string> RunExecutor(executor::AbstractExecutor *executor) {
+  std::multiset<std::string> rows;
+
+  EXPECT_TRUE(executor->Init());
+  while (executor->Execute() == true) {
+    std::unique_ptr<executor::LogicalTile> result_tile(executor->GetOutput());
+    if (result_tile == nullptr) continue;
+
+    for (auto tuple_id : *result_tile) {
+      std::string row;
+      for (oid_t column_itr = 0; column_itr < result_tile->GetColumnCount();
+           column_itr++) {
+        row += result_tile->GetValue(tuple_id, column_itr).GetInfo() + "|";
+      }
+      rows.insert(row);
+    }
+  }
+
+  return rows;
+}
+
+planner::SeqScanPlan *CreateScanPlan(storage::DataTable *table,
+                                     int upper_bound) {
+  // Predicate : ATTR0 < upper_bound
+  auto predicate = expression::ExpressionUtil::ComparisonFactory(
+      EXPRESSION_TYPE_COMPARE_LESSTHAN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0),
+      expression::ExpressionUtil::ConstantValueFactory(
+          ValueFactory::GetIntegerValue(upper_bound)));
+
+  std::vector<oid_t> column_ids = {0, 1, 3};
+  return new planner::SeqScanPlan(table, predicate, column_ids);
+}
+
+}  // namespace
+
+TEST_F(PipelineExecutorTests, SeqScanTest) {
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+  std::unique_ptr<planner::SeqScanPlan> scan_node(
+      CreateScanPlan(table.get(), ExecutorTestsUtil::PopulatedValue(30, 0)));
+
+  EXPECT_TRUE(executor::PipelineExecutor::IsSupported(scan_node.get()));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::SeqScanExecutor pull_executor(scan_node.get(), context.get());
+  executor::PipelineExecutor push_executor(scan_node.get(), context.get());
+
+  auto pull_rows = RunExecutor(&pull_executor);
+  auto push_rows = RunExecutor(&push_executor);
+  txn_manager.CommitTransaction();
+
+  EXPECT_EQ(30, pull_rows.size());
+  EXPECT_EQ(pull_rows, push_rows);
+}
+
+TEST_F(PipelineExecutorTests, ProjectionTest) {
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  // Output : ATTR0 + ATTR1, ATTR0
+  TargetList target_list;
+  target_list.emplace_back(
+      0, expression::ExpressionUtil::OperatorFactory(
+             EXPRESSION_TYPE_OPERATOR_PLUS, VALUE_TYPE_INTEGER,
+             expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                           0, 0),
+             expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER,
+                                                           0, 1)));
+  DirectMapList direct_map_list = {{1, {0, 0}}};
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(std::move(target_list),
+                               std::move(direct_map_list)));
+
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(
+      {ExecutorTestsUtil::GetColumnInfo(0),
+       ExecutorTestsUtil::GetColumnInfo(1)}));
+
+  planner::ProjectionPlan projection_node(std::move(project_info), schema);
+  projection_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      CreateScanPlan(table.get(), ExecutorTestsUtil::PopulatedValue(25, 0))));
+
+  EXPECT_TRUE(executor::PipelineExecutor::IsSupported(&projection_node));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::ProjectionExecutor pull_executor(&projection_node, context.get());
+  executor::SeqScanExecutor scan_executor(
+      projection_node.GetChildren()[0].get(), context.get());
+  pull_executor.AddChild(&scan_executor);
+
+  executor::PipelineExecutor push_executor(&projection_node, context.get());
+
+  auto pull_rows = RunExecutor(&pull_executor);
+  auto push_rows = RunExecutor(&push_executor);
+  txn_manager.CommitTransaction();
+
+  EXPECT_EQ(25, pull_rows.size());
+  EXPECT_EQ(pull_rows, push_rows);
+}
+
+TEST_F(PipelineExecutorTests, AggregateTest) {
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  // SELECT MAX(ATTR0), MIN(ATTR1) FROM table WHERE ATTR0 < ...
+  DirectMapList direct_map_list = {{0, {1, 0}}, {1, {1, 1}}};
+  std::unique_ptr<const planner::ProjectInfo> project_info(
+      new planner::ProjectInfo(TargetList(), std::move(direct_map_list)));
+
+  std::vector<planner::AggregatePlan::AggTerm> agg_terms;
+  agg_terms.emplace_back(
+      EXPRESSION_TYPE_AGGREGATE_MAX,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0));
+  agg_terms.emplace_back(
+      EXPRESSION_TYPE_AGGREGATE_MIN,
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 1));
+
+  std::shared_ptr<const catalog::Schema> schema(new catalog::Schema(
+      {ExecutorTestsUtil::GetColumnInfo(0),
+       ExecutorTestsUtil::GetColumnInfo(1)}));
+
+  planner::AggregatePlan aggregate_node(
+      std::move(project_info), nullptr, std::move(agg_terms),
+      std::vector<oid_t>(), schema, AGGREGATE_TYPE_PLAIN);
+  aggregate_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      CreateScanPlan(table.get(), ExecutorTestsUtil::PopulatedValue(35, 0))));
+
+  EXPECT_TRUE(executor::PipelineExecutor::IsSupported(&aggregate_node));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  executor::AggregateExecutor pull_executor(&aggregate_node, context.get());
+  executor::SeqScanExecutor scan_executor(
+      aggregate_node.GetChildren()[0].get(), context.get());
+  pull_executor.AddChild(&scan_executor);
+
+  executor::PipelineExecutor push_executor(&aggregate_node, context.get());
+
+  auto pull_rows = RunExecutor(&pull_executor);
+  auto push_rows = RunExecutor(&push_executor);
+  txn_manager.CommitTransaction();
+
+  EXPECT_EQ(1, pull_rows.size());
+  EXPECT_EQ(pull_rows, push_rows);
+}
+
+TEST_F(PipelineExecutorTests, HashJoinTest) {
+  std::unique_ptr<storage::DataTable> left_table(CreateTable());
+  std::unique_ptr<storage::DataTable> right_table(CreateTable());
+
+  // Join on ATTR0 : the build side only keeps the first 20 tuples
+  std::vector<std::unique_ptr<const expression::AbstractExpression>> hash_keys;
+  hash_keys.emplace_back(
+      new expression::TupleValueExpression(VALUE_TYPE_INTEGER, 1, 0));
+
+  std::unique_ptr<planner::HashPlan> hash_node(
+      new planner::HashPlan(hash_keys));
+  hash_node->AddChild(std::unique_ptr<planner::AbstractPlan>(
+      CreateScanPlan(right_table.get(),
+                     ExecutorTestsUtil::PopulatedValue(20, 0))));
+
+  std::shared_ptr<const catalog::Schema> schema(nullptr);
+  planner::HashJoinPlan hash_join_node(JOIN_TYPE_INNER, nullptr, nullptr,
+                                       schema);
+  hash_join_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      CreateScanPlan(left_table.get(), tuple_count * 10)));
+  hash_join_node.AddChild(std::move(hash_node));
+
+  EXPECT_TRUE(executor::PipelineExecutor::IsSupported(&hash_join_node));
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  auto txn = txn_manager.BeginTransaction();
+  std::unique_ptr<executor::ExecutorContext> context(
+      new executor::ExecutorContext(txn));
+
+  auto &children = hash_join_node.GetChildren();
+  executor::HashJoinExecutor pull_executor(&hash_join_node, context.get());
+  executor::SeqScanExecutor left_executor(children[0].get(), context.get());
+  executor::HashExecutor hash_executor(children[1].get(), context.get());
+  executor::SeqScanExecutor right_executor(
+      children[1]->GetChildren()[0].get(), context.get());
+  pull_executor.AddChild(&left_executor);
+  pull_executor.AddChild(&hash_executor);
+  hash_executor.AddChild(&right_executor);
+
+  executor::PipelineExecutor push_executor(&hash_join_node, context.get());
+
+  auto pull_rows = RunExecutor(&pull_executor);
+  auto push_rows = RunExecutor(&push_executor);
+  txn_manager.CommitTransaction();
+
+  EXPECT_EQ(20, pull_rows.size());
+  EXPECT_EQ(pull_rows, push_rows);
+}
+
+TEST_F(PipelineExecutorTests, UnsupportedPlanTest) {
+  std::unique_ptr<storage::DataTable> table(CreateTable());
+
+  // Nested loop joins are left to the pull-based executors
+  std::shared_ptr<const catalog::Schema> schema(nullptr);
+  planner::NestedLoopJoinPlan join_node(JOIN_TYPE_INNER, nullptr, nullptr,
+                                        schema);
+  join_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      CreateScanPlan(table.get(), 10)));
+  join_node.AddChild(std::unique_ptr<planner::AbstractPlan>(
+      CreateScanPlan(table.get(), 10)));
+
+  EXPECT_FALSE(executor::PipelineExecutor::IsSupported(&join_node));
+  EXPECT_FALSE(executor::PipelineExecutor::IsSupported(nullptr));
+}
+
+}  // namespace test
+}  // namespace peloton
@@ -0,0 +1,80 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// udf_expression_test.cpp
+//
+// Identification: tests/expression/udf_expression_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "harness.h"
+
+#include "backend/common/types.h"
+#include "backend/common/value_peeker.h"
+#include "backend/common/value_factory.h"
+#include "backend/executor/executor_context.h"
+#include "backend/expression/container_tuple.h"
+#include "backend/expression/expression_util.h"
+#include "utils/fmgroids.h"
+
+namespace peloton {
+namespace test {
+
+class UDFExpressionTest : public PelotonTest {};
+
+TEST_F(UDFExpressionTest, ReuseCallInfoTest) {
+  // int4pl(col 0, col 1), a builtin resolved without the catalog
+  std::vector<std::unique_ptr<expression::AbstractExpression>> args;
+  args.emplace_back(
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 0));
+  args.emplace_back(
+      expression::ExpressionUtil::TupleValueFactory(VALUE_TYPE_INTEGER, 0, 1));
+  std::unique_ptr<expression::AbstractExpression> expr(
+      expression::ExpressionUtil::UDFExpressionFactory(
+          F_INT4PL, InvalidOid, POSTGRES_VALUE_TYPE_INTEGER, args));
+
+  executor::ExecutorContext context(nullptr);
+  void *call_info = nullptr;
+
+  for (int row_itr = 0; row_itr < 5; row_itr++) {
+    std::vector<Value> values;
+    values.push_back(ValueFactory::GetIntegerValue(row_itr));
+    values.push_back(ValueFactory::GetIntegerValue(10 * row_itr));
+    expression::ContainerTuple<std::vector<Value>> row(&values);
+
+    Value result = expr->Evaluate(&row, nullptr, &context);
+    EXPECT_EQ(11 * row_itr, ValuePeeker::PeekInteger(result));
+
+    // the rows of the execution share the same call, and so fn_extra
+    auto &state = context.GetExpressionState(expr.get());
+    EXPECT_NE(nullptr, state.get());
+    if (row_itr == 0) {
+      call_info = state.get();
+    }
+    EXPECT_EQ(call_info, state.get());
+  }
+
+  // int4pl is strict
+  std::vector<Value> values;
+  values.push_back(ValueFactory::GetIntegerValue(1));
+  values.push_back(ValueFactory::GetNullValue());
+  expression::ContainerTuple<std::vector<Value>> row(&values);
+  EXPECT_TRUE(expr->Evaluate(&row, nullptr, &context).IsNull());
+
+  // another execution gets its own call
+  executor::ExecutorContext other_context(nullptr);
+  values[1] = ValueFactory::GetIntegerValue(2);
+  Value result = expr->Evaluate(&row, nullptr, &other_context);
+  EXPECT_EQ(3, ValuePeeker::PeekInteger(result));
+  EXPECT_NE(call_info, other_context.GetExpressionState(expr.get()).get());
+
+  // and evaluating without a context still works
+  result = expr->Evaluate(&row, nullptr, nullptr);
+  EXPECT_EQ(3, ValuePeeker::PeekInteger(result));
+}
+
+}  // End test namespace
+}  // End peloton namespace
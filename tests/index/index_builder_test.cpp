@@ -0,0 +1,151 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// index_builder_test.cpp
+//
+// Identification: tests/index/index_builder_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "harness.h"
+
+#include "backend/catalog/schema.h"
+#include "backend/common/exception.h"
+#include "backend/common/value_factory.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/index/index_builder.h"
+#include "backend/index/index_factory.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/tuple.h"
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Index Builder Tests
+//===--------------------------------------------------------------------===//
+
+class IndexBuilderTests : public PelotonTest {};
+
+static const size_t builder_tuples_per_tile_group = 100;
+static const size_t builder_tile_group_count = 10;
+
+// Column 0 has two values, column 1 is unique
+static void PopulateBuilderTable(storage::DataTable *table,
+                                 const size_t tuple_count) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false, true);
+  txn_manager.CommitTransaction();
+}
+
+static index::Index *CreateBuilderIndex(storage::DataTable *table,
+                                        const oid_t column_id,
+                                        const bool unique = false) {
+  std::vector<oid_t> key_attrs = {column_id};
+  auto tuple_schema = table->GetSchema();
+  auto key_schema = catalog::Schema::CopySchema(tuple_schema, key_attrs);
+  key_schema->SetIndexedColumns(key_attrs);
+
+  auto index_metadata = new index::IndexMetadata(
+      "builder_index", 130 + column_id, INDEX_TYPE_BTREE,
+      unique ? INDEX_CONSTRAINT_TYPE_UNIQUE : INDEX_CONSTRAINT_TYPE_DEFAULT,
+      tuple_schema, key_schema, unique);
+
+  return index::IndexFactory::GetInstance(index_metadata);
+}
+
+// Scan the populated value of the tuple in the indexed column
+static size_t ScanBuilderKey(index::Index *index, const oid_t tuple_id) {
+  auto column_id = index->GetKeySchema()->GetIndexedColumns()[0];
+  storage::Tuple key(index->GetKeySchema(), true);
+  key.SetValue(0, ValueFactory::GetIntegerValue(
+                      ExecutorTestsUtil::PopulatedValue(tuple_id, column_id)),
+               nullptr);
+
+  std::vector<ItemPointer> locations;
+  index->ScanKey(&key, locations);
+
+  return locations.size();
+}
+
+TEST_F(IndexBuilderTests, BuildTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(builder_tuples_per_tile_group, false));
+  const size_t tuple_count =
+      builder_tuples_per_tile_group * builder_tile_group_count;
+
+  PopulateBuilderTable(table.get(), tuple_count);
+
+  // Unique values
+  auto unique_index = CreateBuilderIndex(table.get(), 1);
+  EXPECT_EQ(tuple_count,
+            index::IndexBuilder::BuildIndex(table.get(), unique_index));
+
+  // Duplicate values, with full leaves
+  auto duplicate_index = CreateBuilderIndex(table.get(), 0);
+  EXPECT_EQ(tuple_count,
+            index::IndexBuilder::BuildIndex(table.get(), duplicate_index, 100));
+
+  EXPECT_EQ(2U, table->GetIndexCount());
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id += 97) {
+    EXPECT_EQ(1U, ScanBuilderKey(unique_index, tuple_id));
+  }
+
+  // The populated values of column 0 are those of the tuples 0 and 1
+  EXPECT_EQ(tuple_count / 2, ScanBuilderKey(duplicate_index, 0));
+  EXPECT_EQ(tuple_count / 2, ScanBuilderKey(duplicate_index, 1));
+
+  EXPECT_EQ(0U, ScanBuilderKey(unique_index, tuple_count));
+}
+
+TEST_F(IndexBuilderTests, UniqueBuildTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(builder_tuples_per_tile_group, false));
+  const size_t tuple_count = 2 * builder_tuples_per_tile_group;
+
+  PopulateBuilderTable(table.get(), tuple_count);
+
+  auto unique_index = CreateBuilderIndex(table.get(), 1, true);
+  EXPECT_EQ(tuple_count,
+            index::IndexBuilder::BuildIndex(table.get(), unique_index));
+
+  // The values of column 0 are repeated, so the build fails
+  std::unique_ptr<index::Index> duplicate_index(
+      CreateBuilderIndex(table.get(), 0, true));
+  EXPECT_THROW(
+      index::IndexBuilder::BuildIndex(table.get(), duplicate_index.get()),
+      IndexException);
+
+  EXPECT_EQ(1U, table->GetIndexCount());
+}
+
+TEST_F(IndexBuilderTests, InsertAfterBuildTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(builder_tuples_per_tile_group, false));
+  const size_t tuple_count = builder_tuples_per_tile_group;
+
+  PopulateBuilderTable(table.get(), tuple_count);
+
+  auto index = CreateBuilderIndex(table.get(), 1);
+  index::IndexBuilder::BuildIndex(table.get(), index);
+
+  // The index is maintained once built
+  PopulateBuilderTable(table.get(), tuple_count);
+
+  for (oid_t tuple_id = 0; tuple_id < tuple_count; tuple_id++) {
+    EXPECT_EQ(2U, ScanBuilderKey(index, tuple_id));
+  }
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -16,6 +16,7 @@
 #include "backend/common/logger.h"
 #include "backend/common/platform.h"
 #include "backend/index/index_factory.h"
+#include "backend/index/index_key.h"
 #include "backend/storage/tuple.h"
 
 //#define ALLOW_UNIQUE_KEY
@@ -761,5 +762,130 @@ TEST_F(IndexTests, NonUniqueKeyMultiThreadedStressTest2) {
   delete tuple_schema;
 }
 
+TEST_F(IndexTests, BinaryKeyTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+
+  catalog::Column column1(VALUE_TYPE_DOUBLE, GetTypeSize(VALUE_TYPE_DOUBLE),
+                          "A", true);
+  catalog::Column column2(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                          "B", true);
+  catalog::Column column3(VALUE_TYPE_VARCHAR, 1024, "C", true);
+
+  // KEY SCHEMA -- {column1, column2, column3}
+  std::unique_ptr<catalog::Schema> binary_tuple_schema(
+      new catalog::Schema({column1, column2, column3}));
+  auto binary_key_schema = new catalog::Schema({column1, column2, column3});
+  binary_key_schema->SetIndexedColumns({0, 1, 2});
+  std::unique_ptr<index::IndexMetadata> index_metadata(new index::IndexMetadata(
+      "binary_index", 126, INDEX_TYPE_BTREE, INDEX_CONSTRAINT_TYPE_DEFAULT,
+      binary_tuple_schema.get(), binary_key_schema, false));
+
+  // Keys in increasing order
+  std::vector<std::tuple<double, int, std::string>> key_values = {
+      std::make_tuple(-100.5, 3, "a"), std::make_tuple(-1.0, 3, "a"),
+      std::make_tuple(0.0, -5, "zz"), std::make_tuple(0.0, 3, "b"),
+      std::make_tuple(0.0, 3, "aa"), std::make_tuple(0.0, 3, "abcdefghijk"),
+      std::make_tuple(0.0, 3, "abcdefghijl"), std::make_tuple(2.5, -7, ""),
+      std::make_tuple(2.5, 8, "a")};
+
+  std::vector<index::BinaryKey<24>> keys(key_values.size());
+  for (size_t key_itr = 0; key_itr < key_values.size(); key_itr++) {
+    storage::Tuple key(binary_key_schema, true);
+    key.SetValue(0, ValueFactory::GetDoubleValue(
+                        std::get<0>(key_values[key_itr])), pool);
+    key.SetValue(1, ValueFactory::GetIntegerValue(
+                        std::get<1>(key_values[key_itr])), pool);
+    key.SetValue(2, ValueFactory::GetStringValue(
+                        std::get<2>(key_values[key_itr])), pool);
+    keys[key_itr].SetFromKey(&key);
+  }
+
+  // -0.0 and 0.0 are the same key
+  storage::Tuple negative_zero_key(binary_key_schema, true);
+  negative_zero_key.SetValue(0, ValueFactory::GetDoubleValue(-0.0), pool);
+  negative_zero_key.SetValue(1, ValueFactory::GetIntegerValue(-5), pool);
+  negative_zero_key.SetValue(2, ValueFactory::GetStringValue("zz"), pool);
+  index::BinaryKey<24> negative_zero;
+  negative_zero.SetFromKey(&negative_zero_key);
+
+  index::BinaryComparator<24> comparator(index_metadata.get());
+  index::BinaryEqualityChecker<24> equals(index_metadata.get());
+  EXPECT_FALSE(comparator.complete);
+
+  for (size_t lhs_itr = 0; lhs_itr < keys.size(); lhs_itr++) {
+    for (size_t rhs_itr = 0; rhs_itr < keys.size(); rhs_itr++) {
+      EXPECT_EQ(lhs_itr < rhs_itr, comparator(keys[lhs_itr], keys[rhs_itr]));
+      EXPECT_EQ(lhs_itr == rhs_itr, equals(keys[lhs_itr], keys[rhs_itr]));
+    }
+  }
+
+  EXPECT_TRUE(equals(keys[2], negative_zero));
+  EXPECT_FALSE(comparator(keys[2], negative_zero));
+  EXPECT_FALSE(comparator(negative_zero, keys[2]));
+}
+
+TEST_F(IndexTests, NonPrefixKeyScanTest) {
+  auto pool = TestingHarness::GetInstance().GetTestingPool();
+  std::vector<ItemPointer> locations;
+
+  catalog::Column column1(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                          "A", true);
+  catalog::Column column2(VALUE_TYPE_VARCHAR, 1024, "B", true);
+  catalog::Column column3(VALUE_TYPE_DOUBLE, GetTypeSize(VALUE_TYPE_DOUBLE),
+                          "C", true);
+  catalog::Column column4(VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER),
+                          "D", true);
+
+  // TABLE SCHEMA -- {column1, column2, column3, column4}
+  std::unique_ptr<catalog::Schema> secondary_tuple_schema(
+      new catalog::Schema({column1, column2, column3, column4}));
+
+  // INDEX KEY SCHEMA -- {column4, column1}, not a prefix of the table
+  auto secondary_key_schema = new catalog::Schema({column4, column1});
+  secondary_key_schema->SetIndexedColumns({3, 0});
+
+  index::IndexMetadata *index_metadata = new index::IndexMetadata(
+      "secondary_index", 127, INDEX_TYPE_BTREE, INDEX_CONSTRAINT_TYPE_DEFAULT,
+      secondary_tuple_schema.get(), secondary_key_schema, false);
+  std::unique_ptr<index::Index> index(
+      index::IndexFactory::GetInstance(index_metadata));
+
+  // (D, A) -> location
+  std::vector<std::pair<std::pair<int, int>, ItemPointer>> entries = {
+      {{7, 1}, item0}, {{7, 2}, item1}, {{8, 1}, item2}};
+  for (auto &entry : entries) {
+    storage::Tuple key(secondary_key_schema, true);
+    key.SetValue(0, ValueFactory::GetIntegerValue(entry.first.first), pool);
+    key.SetValue(1, ValueFactory::GetIntegerValue(entry.first.second), pool);
+    index->InsertEntry(&key, entry.second);
+  }
+
+  // The scan keys are offsets in the key schema. Scanning on the leading
+  // one leaves the other unconstrained.
+  index->Scan({ValueFactory::GetIntegerValue(7)}, {0},
+              {EXPRESSION_TYPE_COMPARE_EQUAL}, SCAN_DIRECTION_TYPE_FORWARD,
+              locations);
+  EXPECT_EQ(2, locations.size());
+  for (auto &location : locations) {
+    EXPECT_EQ(item0.block, location.block);
+    EXPECT_TRUE(location.offset == item0.offset ||
+                location.offset == item1.offset);
+  }
+  locations.clear();
+
+  index->Scan({ValueFactory::GetIntegerValue(1)}, {1},
+              {EXPRESSION_TYPE_COMPARE_EQUAL}, SCAN_DIRECTION_TYPE_FORWARD,
+              locations);
+  EXPECT_EQ(2, locations.size());
+  locations.clear();
+
+  index->Scan({ValueFactory::GetIntegerValue(8),
+               ValueFactory::GetIntegerValue(2)},
+              {0, 1}, {EXPRESSION_TYPE_COMPARE_EQUAL,
+                       EXPRESSION_TYPE_COMPARE_EQUAL},
+              SCAN_DIRECTION_TYPE_FORWARD, locations);
+  EXPECT_EQ(0, locations.size());
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -368,5 +368,61 @@ TEST_F(LoggingTests, BasicLogManagerTest) {
   log_manager.EndLogging();
 }
 
+TEST_F(LoggingTests, PipelinedCommitTest) {
+  peloton_logging_mode = LOGGING_TYPE_NVM_WAL;
+  auto &log_manager = logging::LogManager::GetInstance();
+  log_manager.DropFrontendLoggers();
+  log_manager.SetLoggingStatus(LOGGING_STATUS_TYPE_INVALID);
+
+  log_manager.SetSyncCommit(true);
+  log_manager.SetPipelinedCommit(true);
+  log_manager.StartStandbyMode();
+  log_manager.GetFrontendLogger(0)->SetTestMode(true);
+  log_manager.StartRecoveryMode();
+  log_manager.WaitForModeTransition(LOGGING_STATUS_TYPE_LOGGING, true);
+  log_manager.SetGlobalMaxFlushedCommitId(9);
+
+  // commit without waiting for the flush
+  cid_t commit_id = 10;
+  log_manager.PrepareLogging();
+  log_manager.LogBeginTransaction(commit_id);
+  log_manager.LogCommitTransaction(commit_id);
+
+  std::atomic<int> ack_count(0);
+  log_manager.AcknowledgeCommit(INVALID_CID, [&ack_count] { ack_count++; });
+
+  // a read-only txn that could have read the commit above depends on it
+  log_manager.AcknowledgeCommit(commit_id, [&ack_count] { ack_count++; });
+
+  // the acks are run once the commit is flushed
+  for (int i = 0; i < 1000 && ack_count != 2; i++) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  EXPECT_EQ(2, ack_count);
+  EXPECT_GE(log_manager.GetPersistentFlushedCommitId(), commit_id);
+  EXPECT_EQ(0U, log_manager.GetPendingCommitCount());
+
+  // already durable, acknowledged right away
+  bool acked = false;
+  log_manager.AcknowledgeCommit(commit_id, [&acked] { acked = true; });
+  EXPECT_TRUE(acked);
+
+  // nothing was logged above the commit, so a read-only txn with a greater
+  // begin cid has nothing more to wait for
+  acked = false;
+  log_manager.AcknowledgeCommit(commit_id + 1000, [&acked] { acked = true; });
+  EXPECT_TRUE(acked);
+
+  // the commit path defers the acknowledgement, the reply waits for it
+  log_manager.DeferCommitAcknowledgement(commit_id);
+  log_manager.WaitForDeferredAcknowledgement();
+
+  // nothing deferred anymore
+  log_manager.WaitForDeferredAcknowledgement();
+
+  log_manager.SetPipelinedCommit(false);
+  log_manager.EndLogging();
+}
+
 }  // End test namespace
 }  // End peloton namespace
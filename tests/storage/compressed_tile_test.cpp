@@ -0,0 +1,163 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// compressed_tile_test.cpp
+//
+// Identification: tests/storage/compressed_tile_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "harness.h"
+
+#include "backend/common/exception.h"
+#include "backend/common/value_factory.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/compressed_tile.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_freezer.h"
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Compressed Tile Tests
+//===--------------------------------------------------------------------===//
+
+class CompressedTileTests : public PelotonTest {};
+
+TEST_F(CompressedTileTests, CompressTileGroupTest) {
+  const oid_t tuple_count = 600;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, true,
+                                   true);
+  txn_manager.CommitTransaction();
+
+  auto orig_tile_group = data_table->GetTileGroup(0);
+  EXPECT_FALSE(orig_tile_group->IsCompressed());
+  EXPECT_TRUE(data_table->IsTileGroupFrozen(0));
+
+  auto compressed_tile_group = data_table->CompressTileGroup(0);
+  EXPECT_TRUE(compressed_tile_group != nullptr);
+  EXPECT_TRUE(compressed_tile_group->IsCompressed());
+  EXPECT_EQ(orig_tile_group->GetHeader(), compressed_tile_group->GetHeader());
+
+  // The table now refers to the compressed tile group
+  auto tile_group = data_table->GetTileGroup(0);
+  EXPECT_EQ(compressed_tile_group, tile_group.get());
+
+  // Already compressed
+  EXPECT_FALSE(data_table->IsTileGroupFrozen(0));
+  EXPECT_TRUE(data_table->CompressTileGroup(0) == nullptr);
+
+  // Values must be the same as in the orig tile group
+  auto column_count = data_table->GetSchema()->GetColumnCount();
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      Value orig_value = orig_tile_group->GetValue(tuple_itr, column_itr);
+      Value value = tile_group->GetValue(tuple_itr, column_itr);
+      EXPECT_EQ(0, orig_value.Compare(value));
+    }
+  }
+
+  // The first column only has two sorted distinct values, so it is
+  // run-length encoded
+  oid_t tile_offset, tile_column_offset;
+  tile_group->LocateTileAndColumn(0, tile_offset, tile_column_offset);
+  auto tile =
+      static_cast<storage::CompressedTile *>(tile_group->GetTile(tile_offset));
+  EXPECT_EQ(COMPRESSION_TYPE_RLE,
+            tile->GetCompressionType(tile_column_offset));
+  EXPECT_EQ(2u, tile->GetCodeCount(tile_column_offset));
+  EXPECT_EQ(tile->GetCode(0, tile_column_offset),
+            tile->GetCode(1, tile_column_offset));
+  EXPECT_NE(tile->GetCode(0, tile_column_offset),
+            tile->GetCode(tuple_count - 1, tile_column_offset));
+
+  // Compressed tile groups are read-only
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+  auto tuple =
+      ExecutorTestsUtil::GetTuple(data_table.get(), tuple_count, testing_pool);
+  EXPECT_EQ(INVALID_OID, tile_group->InsertTuple(tuple.get()));
+  EXPECT_EQ(INVALID_OID,
+            tile_group->InsertTupleFromCheckpoint(0, tuple.get(), 1));
+  EXPECT_THROW(tile_group->CopyTuple(tuple.get(), 0), Exception);
+
+  // Nothing to prefetch
+  tile_group->PrefetchTuple(0);
+}
+
+TEST_F(CompressedTileTests, DecompressTileGroupTest) {
+  const oid_t tuple_count = 20;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false, true,
+                                   true);
+  txn_manager.CommitTransaction();
+
+  auto orig_tile_group = data_table->GetTileGroup(0);
+  auto compressed_tile_group = data_table->CompressTileGroup(0);
+  EXPECT_TRUE(compressed_tile_group != nullptr);
+  auto tile_group_id = compressed_tile_group->GetTileGroupId();
+
+  // The table now refers to an uncompressed copy with the same header
+  auto tile_group = data_table->DecompressTileGroup(tile_group_id);
+  EXPECT_TRUE(tile_group != nullptr);
+  EXPECT_FALSE(tile_group->IsCompressed());
+  EXPECT_EQ(tile_group, data_table->GetTileGroup(0).get());
+  EXPECT_EQ(orig_tile_group->GetHeader(), tile_group->GetHeader());
+
+  // Already decompressed
+  EXPECT_EQ(tile_group, data_table->DecompressTileGroup(tile_group_id));
+
+  auto column_count = data_table->GetSchema()->GetColumnCount();
+  for (oid_t tuple_itr = 0; tuple_itr < tuple_count; tuple_itr++) {
+    for (oid_t column_itr = 0; column_itr < column_count; column_itr++) {
+      Value orig_value = orig_tile_group->GetValue(tuple_itr, column_itr);
+      Value value = tile_group->GetValue(tuple_itr, column_itr);
+      EXPECT_EQ(0, orig_value.Compare(value));
+    }
+  }
+}
+
+TEST_F(CompressedTileTests, FreezerTest) {
+  const int tuples_per_tile_group = 20;
+  const oid_t tile_group_count = 3;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(
+      data_table.get(), tuples_per_tile_group * tile_group_count, false, false,
+      false);
+  txn_manager.CommitTransaction();
+
+  auto &freezer = storage::TileGroupFreezer::GetInstance();
+
+  // Tile groups are compressed only after they stayed frozen for a while
+  EXPECT_EQ(0u, freezer.FreezeTileGroups(data_table.get()));
+  EXPECT_EQ(tile_group_count, freezer.FreezeTileGroups(data_table.get()));
+
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    EXPECT_TRUE(data_table->GetTileGroup(tile_group_itr)->IsCompressed());
+  }
+
+  // Nothing left to compress
+  EXPECT_EQ(0u, freezer.FreezeTileGroups(data_table.get()));
+}
+
+}  // End test namespace
+}  // End peloton namespace
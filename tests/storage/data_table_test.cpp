@@ -10,10 +10,16 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <set>
+
 #include "harness.h"
 
+#include "backend/common/value_factory.h"
+#include "backend/index/index.h"
 #include "backend/storage/data_table.h"
 #include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_header.h"
+#include "backend/storage/tuple.h"
 #include "backend/concurrency/transaction_manager_factory.h"
 #include "executor/executor_tests_util.h"
 
@@ -69,5 +75,175 @@ TEST_F(DataTableTests, TransformTileGroupTest) {
   data_table->TransformTileGroup(0, theta);
 }
 
+TEST_F(DataTableTests, HeapOnlyUpdateTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // Secondary index on (ATTR0, ATTR1)
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, true));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  auto index = data_table->GetIndex(1);
+  EXPECT_EQ(INDEX_CONSTRAINT_TYPE_DEFAULT, index->GetIndexType());
+
+  std::unique_ptr<storage::Tuple> key(
+      new storage::Tuple(index->GetKeySchema(), true));
+  key->SetValue(0, ValueFactory::GetIntegerValue(
+                       ExecutorTestsUtil::PopulatedValue(0, 0)),
+                testing_pool);
+  key->SetValue(1, ValueFactory::GetIntegerValue(
+                       ExecutorTestsUtil::PopulatedValue(0, 1)),
+                testing_pool);
+
+  std::vector<ItemPointer> locations;
+  index->ScanKey(key.get(), locations);
+  EXPECT_EQ(1, locations.size());
+  ItemPointer old_location = locations[0];
+
+  // Update a column that is not indexed : no new index entry
+  txn_manager.BeginTransaction();
+  auto tuple = ExecutorTestsUtil::GetTuple(data_table.get(), 0, testing_pool);
+  tuple->SetValue(2, ValueFactory::GetDoubleValue(1.5), testing_pool);
+  std::vector<oid_t> updated_columns = {2};
+  ItemPointer new_location =
+      data_table->InsertVersion(tuple.get(), &updated_columns);
+  EXPECT_FALSE(new_location.IsNull());
+
+  locations.clear();
+  index->ScanKey(key.get(), locations);
+  EXPECT_EQ(1, locations.size());
+
+  // The new version is reached through the entry of the old one
+  auto old_tile_group = data_table->GetTileGroupById(old_location.block);
+  old_tile_group->GetHeader()->SetNextItemPointer(old_location.offset,
+                                                  new_location);
+  ItemPointer next_location =
+      storage::DataTable::GetNextIndexedVersion(index, old_location);
+  EXPECT_EQ(new_location.block, next_location.block);
+  EXPECT_EQ(new_location.offset, next_location.offset);
+
+  // Once the old version is garbage, the entry moves to the new one
+  data_table->PruneSecondaryIndexEntries(old_location);
+  locations.clear();
+  index->ScanKey(key.get(), locations);
+  EXPECT_EQ(1, locations.size());
+  EXPECT_EQ(new_location.block, locations[0].block);
+  EXPECT_EQ(new_location.offset, locations[0].offset);
+
+  // Update an indexed column : the new version gets its own entry
+  tuple->SetValue(1, ValueFactory::GetIntegerValue(-1), testing_pool);
+  updated_columns = {1};
+  ItemPointer last_location =
+      data_table->InsertVersion(tuple.get(), &updated_columns);
+  EXPECT_FALSE(last_location.IsNull());
+  txn_manager.CommitTransaction();
+
+  key->SetValue(1, ValueFactory::GetIntegerValue(-1), testing_pool);
+  locations.clear();
+  index->ScanKey(key.get(), locations);
+  EXPECT_EQ(1, locations.size());
+
+  // The versions do not share the key, so the chain stops here
+  auto new_tile_group = data_table->GetTileGroupById(new_location.block);
+  new_tile_group->GetHeader()->SetNextItemPointer(new_location.offset,
+                                                  last_location);
+  EXPECT_TRUE(storage::DataTable::GetNextIndexedVersion(index, new_location)
+                  .IsNull());
+}
+
+TEST_F(DataTableTests, BulkInsertTest) {
+  const int tuple_count = TESTS_TUPLES_PER_TILEGROUP;
+  // Spans a few tile groups, and ends in the middle of one
+  const int insert_count = 2 * tuple_count + tuple_count / 2;
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, true));
+
+  std::vector<std::unique_ptr<storage::Tuple>> tuples;
+  std::vector<const storage::Tuple *> insert_tuples;
+  for (int rowid = 0; rowid < insert_count; rowid++) {
+    tuples.emplace_back(new storage::Tuple(data_table->GetSchema(), true));
+    for (oid_t col_itr = 0; col_itr < 2; col_itr++) {
+      tuples.back()->SetValue(col_itr,
+                              ValueFactory::GetIntegerValue(
+                                  ExecutorTestsUtil::PopulatedValue(rowid,
+                                                                    col_itr)),
+                              testing_pool);
+    }
+    tuples.back()->SetValue(
+        2, ValueFactory::GetDoubleValue(
+               ExecutorTestsUtil::PopulatedValue(rowid, 2)),
+        testing_pool);
+    tuples.back()->SetValue(
+        3, ValueFactory::GetStringValue(
+               std::to_string(ExecutorTestsUtil::PopulatedValue(rowid, 3))),
+        testing_pool);
+    insert_tuples.push_back(tuples.back().get());
+  }
+
+  std::vector<ItemPointer> locations;
+  EXPECT_TRUE(data_table->InsertTuples(insert_tuples, locations));
+  EXPECT_EQ(insert_count, locations.size());
+  for (auto &location : locations) {
+    EXPECT_TRUE(txn_manager.PerformInsert(location));
+  }
+  txn_manager.CommitTransaction();
+
+  // Consecutive slots, across the tile groups
+  std::set<oid_t> tile_group_ids;
+  for (int rowid = 1; rowid < insert_count; rowid++) {
+    tile_group_ids.insert(locations[rowid].block);
+    if (locations[rowid].block == locations[rowid - 1].block) {
+      EXPECT_EQ(locations[rowid - 1].offset + 1, locations[rowid].offset);
+    }
+  }
+  EXPECT_EQ(3, tile_group_ids.size());
+
+  // The tuples were copied into their slots
+  for (int rowid = 0; rowid < insert_count; rowid += 7) {
+    auto tile_group = data_table->GetTileGroupById(locations[rowid].block);
+    EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(rowid, 1),
+              ValuePeeker::PeekAsInteger(
+                  tile_group->GetValue(locations[rowid].offset, 1)));
+    EXPECT_TRUE(tile_group->GetValue(locations[rowid].offset, 3)
+                    .OpEquals(ValueFactory::GetStringValue(std::to_string(
+                        ExecutorTestsUtil::PopulatedValue(rowid, 3))))
+                    .IsTrue());
+  }
+
+  // Every index has an entry for every tuple
+  for (oid_t index_itr = 0; index_itr < data_table->GetIndexCount();
+       index_itr++) {
+    auto index = data_table->GetIndex(index_itr);
+    std::vector<ItemPointer> index_locations;
+    index->ScanAllKeys(index_locations);
+    EXPECT_EQ(insert_count, index_locations.size());
+  }
+
+  // A duplicate primary key fails the whole batch
+  txn_manager.BeginTransaction();
+  std::vector<const storage::Tuple *> duplicate_tuples = {insert_tuples[0]};
+  EXPECT_FALSE(data_table->InsertTuples(duplicate_tuples, locations));
+  txn_manager.AbortTransaction();
+
+  // So does a primary key that is repeated within the batch
+  txn_manager.BeginTransaction();
+  tuples[0]->SetValue(0, ValueFactory::GetIntegerValue(
+                            ExecutorTestsUtil::PopulatedValue(insert_count, 0)),
+                      testing_pool);
+  std::vector<const storage::Tuple *> repeated_tuples = {insert_tuples[0],
+                                                         insert_tuples[0]};
+  EXPECT_FALSE(data_table->InsertTuples(repeated_tuples, locations));
+  txn_manager.AbortTransaction();
+}
+
 }  // End test namespace
 }  // End peloton namespace
@@ -0,0 +1,181 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// table_stats_test.cpp
+//
+// Identification: tests/storage/table_stats_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include <memory>
+#include <vector>
+
+#include "harness.h"
+
+#include "backend/catalog/schema.h"
+#include "backend/common/value_factory.h"
+#include "backend/common/value_peeker.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/table_factory.h"
+#include "backend/storage/table_stats.h"
+#include "backend/storage/tuple.h"
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Table Stats Tests
+//===--------------------------------------------------------------------===//
+
+class TableStatsTests : public PelotonTest {};
+
+static const size_t stats_tuples_per_tile_group = 100;
+
+// Column 0 has two values (unless a single tuple is inserted), the other
+// columns are unique
+static void PopulateStatsTable(storage::DataTable *table,
+                               const size_t tuple_count) {
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  ExecutorTestsUtil::PopulateTable(table, tuple_count, false, false,
+                                   tuple_count > 1);
+  txn_manager.CommitTransaction();
+}
+
+TEST_F(TableStatsTests, AnalyzeTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(stats_tuples_per_tile_group, false));
+  const size_t tuple_count = 1000;
+
+  PopulateStatsTable(table.get(), tuple_count);
+
+  // Sample every row
+  auto stats = storage::TableStats::Analyze(table.get(), tuple_count);
+  EXPECT_EQ(tuple_count, stats->GetTupleCount());
+  EXPECT_EQ(4U, stats->GetColumnCount());
+  EXPECT_LT(0, stats->GetDataSize());
+
+  // Unique values only make a histogram
+  auto &unique_stats = stats->GetColumnStats(1);
+  EXPECT_EQ(0, unique_stats.null_fraction);
+  EXPECT_EQ(tuple_count, unique_stats.distinct_count);
+  EXPECT_TRUE(unique_stats.most_common_values.empty());
+  EXPECT_EQ(STATS_TARGET + 1U, unique_stats.histogram_bounds.size());
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(0, 1),
+            ValuePeeker::PeekInteger(unique_stats.histogram_bounds.front()));
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_count - 1, 1),
+            ValuePeeker::PeekInteger(unique_stats.histogram_bounds.back()));
+
+  for (size_t bound_itr = 1; bound_itr < unique_stats.histogram_bounds.size();
+       bound_itr++) {
+    EXPECT_TRUE(unique_stats.histogram_bounds[bound_itr - 1]
+                    .OpLessThan(unique_stats.histogram_bounds[bound_itr])
+                    .IsTrue());
+  }
+
+  // Few values are all most common values
+  auto &key_stats = stats->GetColumnStats(0);
+  EXPECT_EQ(0, key_stats.null_fraction);
+  EXPECT_EQ(4, key_stats.average_width);
+  EXPECT_DOUBLE_EQ(2, key_stats.distinct_count);
+  EXPECT_EQ(2U, key_stats.most_common_values.size());
+  EXPECT_TRUE(key_stats.histogram_bounds.empty());
+
+  double frequency_sum = 0;
+  for (auto frequency : key_stats.most_common_frequencies) {
+    frequency_sum += frequency;
+  }
+  EXPECT_DOUBLE_EQ(1, frequency_sum);
+
+  // Unique strings have no histogram
+  auto &string_stats = stats->GetColumnStats(3);
+  EXPECT_EQ(tuple_count, string_stats.distinct_count);
+  EXPECT_TRUE(string_stats.most_common_values.empty());
+  EXPECT_TRUE(string_stats.histogram_bounds.empty());
+}
+
+TEST_F(TableStatsTests, NullTest) {
+  std::vector<catalog::Column> columns;
+  columns.push_back(catalog::Column(
+      VALUE_TYPE_INTEGER, GetTypeSize(VALUE_TYPE_INTEGER), "A", true));
+  std::unique_ptr<storage::DataTable> table(storage::TableFactory::GetDataTable(
+      INVALID_OID, INVALID_OID, new catalog::Schema(columns), "STATSTABLE",
+      stats_tuples_per_tile_group, true, false));
+  const size_t tuple_count = 1000;
+
+  // Every fourth row is null
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  for (size_t rowid = 0; rowid < tuple_count; rowid++) {
+    storage::Tuple tuple(table->GetSchema(), true);
+    if (rowid % 4 == 3) {
+      tuple.SetValue(0, ValueFactory::GetNullValueByType(VALUE_TYPE_INTEGER),
+                     nullptr);
+    } else {
+      tuple.SetValue(0, ValueFactory::GetIntegerValue(rowid), nullptr);
+    }
+
+    ItemPointer location = table->InsertTuple(&tuple);
+    EXPECT_NE(INVALID_OID, location.block);
+    txn_manager.PerformInsert(location);
+  }
+  txn_manager.CommitTransaction();
+
+  auto stats = storage::TableStats::Analyze(table.get(), tuple_count);
+  auto &column_stats = stats->GetColumnStats(0);
+  EXPECT_DOUBLE_EQ(0.25, column_stats.null_fraction);
+  EXPECT_DOUBLE_EQ(tuple_count * 3 / 4, column_stats.distinct_count);
+  EXPECT_EQ(STATS_TARGET + 1U, column_stats.histogram_bounds.size());
+}
+
+TEST_F(TableStatsTests, SampleTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(stats_tuples_per_tile_group, false));
+  const size_t tuple_count = 2000;
+  const size_t sample_size = 500;
+
+  PopulateStatsTable(table.get(), tuple_count);
+
+  // The counts cover the whole table, the distinct counts are estimated
+  auto stats = storage::TableStats::Analyze(table.get(), sample_size);
+  EXPECT_EQ(tuple_count, stats->GetTupleCount());
+
+  auto &unique_stats = stats->GetColumnStats(1);
+  EXPECT_NEAR(tuple_count, unique_stats.distinct_count, tuple_count * 0.1);
+  EXPECT_EQ(STATS_TARGET + 1U, unique_stats.histogram_bounds.size());
+
+  auto &key_stats = stats->GetColumnStats(0);
+  EXPECT_NEAR(2, key_stats.distinct_count, 1);
+  EXPECT_EQ(0, key_stats.null_fraction);
+}
+
+TEST_F(TableStatsTests, StaleTest) {
+  std::unique_ptr<storage::DataTable> table(
+      ExecutorTestsUtil::CreateTable(stats_tuples_per_tile_group, false));
+  const size_t tuple_count = 1000;
+
+  EXPECT_FALSE(table->IsStatsStale());
+
+  PopulateStatsTable(table.get(), tuple_count);
+  EXPECT_TRUE(table->IsStatsStale());
+
+  table->SetStats(storage::TableStats::Analyze(table.get()));
+  EXPECT_FALSE(table->IsStatsStale());
+
+  // Stale once the threshold plus the scaled tuple count is exceeded
+  const size_t refresh_count =
+      STATS_REFRESH_THRESHOLD + STATS_REFRESH_SCALE_FACTOR * tuple_count;
+  PopulateStatsTable(table.get(), refresh_count);
+  EXPECT_FALSE(table->IsStatsStale());
+
+  PopulateStatsTable(table.get(), 1);
+  EXPECT_TRUE(table->IsStatsStale());
+}
+
+}  // End test namespace
+}  // End peloton namespace
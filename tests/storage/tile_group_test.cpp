@@ -10,6 +10,8 @@
 //
 //===----------------------------------------------------------------------===//
 
+#include <thread>
+
 #include "harness.h"
 
 #include "backend/common/value_factory.h"
@@ -534,5 +536,71 @@ TEST_F(TileGroupTests, TileCopyTest) {
   delete schema;
 }
 
+TEST_F(TileGroupTests, AllVisibleTest) {
+  const int tuple_count = 8;
+  storage::TileGroupHeader header(BACKEND_TYPE_MM, tuple_count);
+  oid_t visible_count = 0;
+
+  // an empty tile group is never all-visible
+  EXPECT_FALSE(header.TryMarkAllVisible());
+
+  for (cid_t begin_cid = 2; begin_cid <= 5; begin_cid++) {
+    oid_t tuple_slot_id = header.GetNextEmptyTupleSlot();
+    header.SetTransactionId(tuple_slot_id, INITIAL_TXN_ID);
+    header.SetBeginCommitId(tuple_slot_id, begin_cid);
+  }
+  EXPECT_FALSE(header.IsAllVisible(10, visible_count));
+  EXPECT_TRUE(header.TryMarkAllVisible());
+
+  // visible to the snapshots after the last commit only
+  EXPECT_FALSE(header.IsAllVisible(4, visible_count));
+  EXPECT_TRUE(header.IsAllVisible(5, visible_count));
+  EXPECT_EQ(4U, visible_count);
+
+  // taking the ownership of a tuple clears the flag
+  EXPECT_TRUE(header.SetAtomicTransactionId(1, 100));
+  EXPECT_FALSE(header.IsAllVisible(5, visible_count));
+  EXPECT_FALSE(header.TryMarkAllVisible());
+
+  // so does a commit that invalidates it
+  header.SetTransactionId(1, INITIAL_TXN_ID);
+  EXPECT_TRUE(header.TryMarkAllVisible());
+  header.SetEndCommitId(1, 6);
+  EXPECT_FALSE(header.IsAllVisible(7, visible_count));
+
+  // and an insert
+  header.SetEndCommitId(1, MAX_CID);
+  EXPECT_TRUE(header.TryMarkAllVisible());
+  header.GetNextEmptyTupleSlot();
+  EXPECT_FALSE(header.IsAllVisible(7, visible_count));
+}
+
+TEST_F(TileGroupTests, RecyclingTest) {
+  storage::TileGroupHeader header(BACKEND_TYPE_MM, 8);
+
+  EXPECT_TRUE(header.ClaimRecycledSlot());
+
+  // the copy waits for the claimed slot to be written
+  std::atomic<bool> disabled(false);
+  std::thread copier([&header, &disabled] {
+    header.DisableRecycling();
+    disabled = true;
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_FALSE(disabled.load());
+  header.ReleaseRecycledSlot();
+  copier.join();
+  EXPECT_TRUE(disabled.load());
+
+  // and no slot can be claimed until all the copies are done
+  EXPECT_FALSE(header.ClaimRecycledSlot());
+  header.DisableRecycling();
+  header.EnableRecycling();
+  EXPECT_FALSE(header.ClaimRecycledSlot());
+  header.EnableRecycling();
+  EXPECT_TRUE(header.ClaimRecycledSlot());
+  header.ReleaseRecycledSlot();
+}
+
 }  // End test namespace
 }  // End peloton namespace
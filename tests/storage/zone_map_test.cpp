@@ -0,0 +1,149 @@
+//===----------------------------------------------------------------------===//
+//
+//                         Peloton
+//
+// zone_map_test.cpp
+//
+// Identification: tests/storage/zone_map_test.cpp
+//
+// Copyright (c) 2015-16, Carnegie Mellon University Database Group
+//
+//===----------------------------------------------------------------------===//
+
+#include "harness.h"
+
+#include "backend/common/value_factory.h"
+#include "backend/common/value_peeker.h"
+#include "backend/concurrency/transaction_manager_factory.h"
+#include "backend/storage/data_table.h"
+#include "backend/storage/tile_group.h"
+#include "backend/storage/tile_group_freezer.h"
+#include "backend/storage/tuple.h"
+#include "backend/storage/zone_map.h"
+#include "executor/executor_tests_util.h"
+
+namespace peloton {
+namespace test {
+
+//===--------------------------------------------------------------------===//
+// Zone Map Tests
+//===--------------------------------------------------------------------===//
+
+class ZoneMapTests : public PelotonTest {};
+
+TEST_F(ZoneMapTests, InsertTest) {
+  const int tuples_per_tile_group = 10;
+  const oid_t tile_group_count = 3;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuples_per_tile_group, false));
+  ExecutorTestsUtil::PopulateTable(
+      data_table.get(), tuples_per_tile_group * tile_group_count, false, false,
+      false);
+  txn_manager.CommitTransaction();
+
+  // First column is 10 * rowid, so every tile group covers its own range
+  for (oid_t tile_group_itr = 0; tile_group_itr < tile_group_count;
+       tile_group_itr++) {
+    auto zone_map = data_table->GetTileGroup(tile_group_itr)->GetZoneMap();
+    int min_value = ExecutorTestsUtil::PopulatedValue(
+        tile_group_itr * tuples_per_tile_group, 0);
+    int max_value = ExecutorTestsUtil::PopulatedValue(
+        (tile_group_itr + 1) * tuples_per_tile_group - 1, 0);
+
+    EXPECT_TRUE(zone_map->IsTracked(0));
+    EXPECT_FALSE(zone_map->IsTracked(3));
+    EXPECT_EQ(min_value, ValuePeeker::PeekInteger(zone_map->GetMinValue(0)));
+    EXPECT_EQ(max_value, ValuePeeker::PeekInteger(zone_map->GetMaxValue(0)));
+    EXPECT_EQ(0u, zone_map->GetNullCount(0));
+    EXPECT_FALSE(zone_map->IsNullMayMatch(0));
+
+    EXPECT_TRUE(zone_map->ComparisonMayMatch(
+        0, EXPRESSION_TYPE_COMPARE_EQUAL,
+        ValueFactory::GetIntegerValue(min_value)));
+    EXPECT_FALSE(zone_map->ComparisonMayMatch(
+        0, EXPRESSION_TYPE_COMPARE_LESSTHAN,
+        ValueFactory::GetIntegerValue(min_value)));
+    EXPECT_TRUE(zone_map->ComparisonMayMatch(
+        0, EXPRESSION_TYPE_COMPARE_GREATERTHANOREQUALTO,
+        ValueFactory::GetIntegerValue(max_value)));
+    EXPECT_FALSE(zone_map->ComparisonMayMatch(
+        0, EXPRESSION_TYPE_COMPARE_GREATERTHAN,
+        ValueFactory::GetBigIntValue(max_value)));
+
+    // Variable-length columns never exclude anything
+    EXPECT_TRUE(zone_map->ComparisonMayMatch(
+        3, EXPRESSION_TYPE_COMPARE_EQUAL, ValueFactory::GetStringValue("x")));
+  }
+}
+
+TEST_F(ZoneMapTests, UpdateTest) {
+  const int tuple_count = 10;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  auto tile_group = data_table->GetTileGroup(0);
+  auto zone_map = tile_group->GetZoneMap();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  // Overwrite the tuple holding the max value in place
+  oid_t tuple_id = tuple_count - 1;
+  auto tuple =
+      ExecutorTestsUtil::GetTuple(data_table.get(), tuple_id, testing_pool);
+  tuple->SetValue(0, ValueFactory::GetIntegerValue(-1), testing_pool);
+  tile_group->CopyTuple(tuple.get(), tuple_id);
+
+  // Widened right away
+  EXPECT_TRUE(zone_map->IsDirty());
+  EXPECT_EQ(-1, ValuePeeker::PeekInteger(zone_map->GetMinValue(0)));
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_id, 0),
+            ValuePeeker::PeekInteger(zone_map->GetMaxValue(0)));
+
+  // Tightened on refresh
+  zone_map->Refresh(tile_group.get());
+  EXPECT_FALSE(zone_map->IsDirty());
+  EXPECT_EQ(-1, ValuePeeker::PeekInteger(zone_map->GetMinValue(0)));
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_id - 1, 0),
+            ValuePeeker::PeekInteger(zone_map->GetMaxValue(0)));
+}
+
+TEST_F(ZoneMapTests, FreezerRefreshTest) {
+  const int tuple_count = 10;
+
+  auto &txn_manager = concurrency::TransactionManagerFactory::GetInstance();
+  txn_manager.BeginTransaction();
+  std::unique_ptr<storage::DataTable> data_table(
+      ExecutorTestsUtil::CreateTable(tuple_count, false));
+  ExecutorTestsUtil::PopulateTable(data_table.get(), tuple_count, false,
+                                   false, false);
+  txn_manager.CommitTransaction();
+
+  auto tile_group = data_table->GetTileGroup(0);
+  auto zone_map = tile_group->GetZoneMap();
+  auto testing_pool = TestingHarness::GetInstance().GetTestingPool();
+
+  oid_t tuple_id = tuple_count - 1;
+  auto tuple =
+      ExecutorTestsUtil::GetTuple(data_table.get(), tuple_id, testing_pool);
+  tuple->SetValue(0, ValueFactory::GetIntegerValue(-1), testing_pool);
+  tile_group->CopyTuple(tuple.get(), tuple_id);
+  EXPECT_TRUE(zone_map->IsDirty());
+
+  // The freezer tightens the zone map in the background
+  storage::TileGroupFreezer::GetInstance().FreezeTileGroups(data_table.get());
+  EXPECT_FALSE(zone_map->IsDirty());
+  EXPECT_EQ(-1, ValuePeeker::PeekInteger(zone_map->GetMinValue(0)));
+  EXPECT_EQ(ExecutorTestsUtil::PopulatedValue(tuple_id - 1, 0),
+            ValuePeeker::PeekInteger(zone_map->GetMaxValue(0)));
+}
+
+}  // End test namespace
+}  // End peloton namespace
@@ -2399,8 +2399,10 @@ public:
 
     /// Bulk load a sorted range. Loads items into leaves and constructs a
     /// B-tree above them. The tree must be empty when calling this function.
+    /// The leaves are filled up to the given fraction of their slots, which
+    /// leaves room for later inserts.
     template <typename Iterator>
-    void bulk_load(Iterator ibegin, Iterator iend)
+    void bulk_load(Iterator ibegin, Iterator iend, double fill_factor = 1.0)
     {
         BTREE_ASSERT(empty());
 
@@ -2410,6 +2412,13 @@ public:
         size_t num_items = iend - ibegin;
         size_t num_leaves = (num_items + leafslotmax-1) / leafslotmax;
 
+        // spread the items over more leaves to honor the fill factor, but
+        // round down so that no leaf is filled below the minimum.
+        size_t leaf_items = std::max<size_t>(
+            std::max<size_t>(minleafslots, 1),
+            std::min<size_t>(leafslotmax, leafslotmax * fill_factor));
+        num_leaves = std::max(num_leaves, num_items / leaf_items);
+
         BTREE_PRINT("btree::bulk_load, level 0: " << m_stats.itemcount << " items into " << num_leaves << " leaves with up to " << ((iend - ibegin + num_leaves-1) / num_leaves) << " items per leaf.");
 
         Iterator it = ibegin;
@@ -516,11 +516,12 @@ public:
 
     /// Bulk load a sorted range [first,last). Loads items into leaves and
     /// constructs a B-tree above them. The tree must be empty when calling
-    /// this function.
+    /// this function. The leaves are filled up to the fill factor.
     template <typename Iterator>
-    inline void bulk_load(Iterator first, Iterator last)
+    inline void bulk_load(Iterator first, Iterator last,
+                          double fill_factor = 1.0)
     {
-        return tree.bulk_load(first, last);
+        return tree.bulk_load(first, last, fill_factor);
     }
 
 public: